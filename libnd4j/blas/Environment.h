@@ -38,6 +38,7 @@ namespace nd4j{
         std::atomic<nd4j::DataType> _dataType;
         std::atomic<bool> _precBoost;
         std::atomic<bool> _useMKLDNN{true};
+        std::atomic<bool> _graphFusion{false};
 
 #ifdef __ND4J_EXPERIMENTAL__
         const bool _experimental = true;
@@ -72,6 +73,10 @@ namespace nd4j{
         bool isUseMKLDNN() { return _useMKLDNN.load(); }
         void setUseMKLDNN(bool useMKLDNN) { _useMKLDNN.store(useMKLDNN); }
 
+        // if enabled, chains of elementwise legacy ops are fused into single node during Graph::buildGraph()
+        bool isGraphFusion() { return _graphFusion.load(); }
+        void setGraphFusion(bool reallyFuse) { _graphFusion.store(reallyFuse); }
+
         nd4j::DataType defaultFloatDataType();
         void setDefaultFloatDataType(nd4j::DataType dtype);
 
@@ -42,7 +42,18 @@ namespace nd4j {
 
     class ND4J_EXPORT GraphExecutioner {
     protected:
+        /**
+         * This method checks, if given Graph can be executed by dataflow scheduler:
+         * graphs with loop frames (Enter/Exit/NextIteration/LoopCond) or scoped logic are executed sequentially,
+         * as well as linear graphs (no layer with more than one node), so their ops keep intra-op parallelism
+         */
+        static bool isDataflowCompatible(Graph *graph);
 
+        /**
+         * This method executes given Graph via dependency counting: each node gets scheduled as omp task
+         * as soon as all of its input nodes are resolved, so independent nodes run concurrently
+         */
+        static Nd4jStatus executeDataflow(Graph *graph, VariableSpace *variableSpace, FlowPath *flowPath);
 
     public:
         //static Nd4jStatus executeFlatNode(nd4j::graph::Graph *graph, nd4j::graph::Node *node, nd4j::graph::VariableSpace<float> *variableSpace);
@@ -66,6 +77,13 @@ namespace nd4j {
 
         static flatbuffers::Offset<FlatResult> execute(Graph *graph, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
 
+        /**
+        * This method executes given Graph, which already has all inputs in place, and serializes its outputs
+        *
+        * @param requestId id of inference request, used for error reporting only
+        */
+        static flatbuffers::Offset<FlatResult> executePrepared(Graph *graph, flatbuffers::FlatBufferBuilder &builder, Nd4jLong requestId);
+
         static Graph *importFromTensorFlow(const char *fileName);
 
 
@@ -32,6 +32,7 @@
 #include <array/ArrayType.h>
 #include <array/ResultSet.h>
 #include <helpers/ShapeBuilders.h>
+#include <helpers/ConstantShapeHelper.h>
 #include <op_enums.h>
 #include <ops/BroadcastOpsTuple.h>
 #include <ops/BroadcastBoolOpsTuple.h>
@@ -146,6 +147,11 @@ namespace nd4j {
         template<typename T>
         std::string toStringValue(T value);
 
+        /**
+        *  replaces _shapeInfo with interned copy of given shapeInfo, _shapeInfo owned by this array is released
+        */
+        void setConstantShapeInfo(const Nd4jLong *shapeInfo);
+
     public:
         NDArray();
 
@@ -1135,7 +1141,7 @@ namespace nd4j {
         FORCEINLINE void setBuffer(void* buffer);
 
         /**
-        *  set _isBuffAlloc and _isShapeAlloc
+        *  set _isBuffAlloc and _isShapeAlloc, interned shapeInfo is never treated as allocated by this array
         */
         FORCEINLINE void triggerAllocationFlag(bool bufferAllocated, bool shapeAllocated);
         
@@ -1458,7 +1464,7 @@ namespace nd4j {
     //////////////////////////////////////////////////////////////////////////
     void NDArray::triggerAllocationFlag(bool bufferAllocated, bool shapeAllocated) {
         _isBuffAlloc = bufferAllocated;
-        _isShapeAlloc = shapeAllocated;
+        _isShapeAlloc = shapeAllocated && !ConstantShapeHelper::getInstance()->isInterned(_shapeInfo);
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -598,6 +598,12 @@ public:
 
     void initializeFunctions(Nd4jPointer *functions);
 
+    /**
+     * This method sets LAPACKE factorization functions: sgetrf, dgetrf, spotrf, dpotrf.
+     * Backends without LAPACK support have dummy method for JNI compatibility reasons.
+     */
+    void initializeLapackFunctions(Nd4jPointer *functions);
+
     /**
      * This method acquires memory chunk of requested size on host side
      *
@@ -1386,13 +1392,23 @@ public:
     }
 
 
+/**
+ * Map a numpy array from a file, without copying its data.
+ * Returned struct is accessed via getNpyArray* methods, and released with deleteNPArrayStruct
+ * @param path
+ * @param prefetch
+ * @return
+ */
+    void* mapNpyFile(std::string path, bool prefetch) {
+        return reinterpret_cast<void*>(new cnpy::NpyArray(cnpy::npyMap(path, prefetch)));
+    }
+
+
     ////// NPZ //////
 
     void* mapFromNpzFile(std::string path){
-        cnpy::npz_t* mapPtr = new cnpy::npz_t();
-        cnpy::npz_t map = cnpy::npzLoad(path);
-        mapPtr->insert(map.begin(), map.end());
-        return reinterpret_cast<void*>(mapPtr);
+        // arrays share single mapping, which is released once map and all arrays taken from it are deleted
+        return reinterpret_cast<void*>(new cnpy::npz_t(cnpy::npzMap(path)));
     }
 
 
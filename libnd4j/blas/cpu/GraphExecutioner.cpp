@@ -50,10 +50,16 @@
 #include <helpers/ShapeUtils.h>
 #include <Status.h>
 #include <deque>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
 #include <graph/ResultWrapper.h>
 #include <graph/ExecutionResult.h>
 #include <graph/exceptions/graph_execution_exception.h>
 #include <graph/exceptions/no_results_exception.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace nd4j{
 namespace graph {
@@ -86,6 +92,7 @@ namespace graph {
     }
 
     Context context(node->getContextPrototype(), variableSpace);
+    context.setShapeMemo(node->shapeMemo());
 
     if (nd4j::Environment::getInstance()->isDebugAndVerbose()) {
         //nd4j_debug("Input variables: %i\n", node->input()->size());
@@ -198,6 +205,211 @@ namespace graph {
 }
 
 
+/**
+ * This structure holds state shared by all tasks of single dataflow execution
+ */
+struct DataflowState {
+    Graph *graph;
+    VariableSpace *variableSpace;
+    FlowPath *flowPath;
+    bool profiling;
+
+    // nodes in topological (onion) order, and indices of nodes consuming their outputs
+    std::vector<Node*> nodes;
+    std::vector<std::vector<int>> dependants;
+
+    // number of unresolved input nodes per node
+    std::unique_ptr<std::atomic<int>[]> pending;
+
+    // first non-OK status reported by any node
+    std::atomic<int> status;
+};
+
+/**
+ * This method resolves single node within dataflow execution: node is either skipped (inactive inputs or other
+ * divergence branch), or executed. Activity checks are the same as in sequential GraphExecutioner::execute
+ */
+static Nd4jStatus resolveDataflowNode(DataflowState *state, Node *node) {
+    auto graph = state->graph;
+    auto flowPath = state->flowPath;
+
+    Nd4jLong nodeTime = state->profiling ? GraphProfile::currentTime() : 0L;
+
+    if (node->opType() == OpType_LOGIC && node->opNum() == nd4j::logic::Merge) {
+        // Merge node can be skipped only both inputs are inactive
+        auto inputId0 = node->input()->at(0);
+        auto inputId1 = node->input()->at(1);
+
+        if (!flowPath->isNodeActive(inputId0.first) && !flowPath->isNodeActive(inputId1.first))
+            return Status::OK();
+    } else {
+        for (int e = 0; e < node->input()->size(); e++) {
+            auto inputId = node->input()->at(e);
+
+            // not a node. skipping checks
+            if (graph->getMapped()->count(inputId.first) == 0)
+                continue;
+
+            Node *prevNode = graph->getMapped()->at(inputId.first);
+            if (!flowPath->isNodeActive(inputId.first)) {
+                flowPath->markNodeActive(node->id(), false);
+                nd4j_debug("Skipping Node_%i due to inactive input [%i]\n", node->id(), inputId.first);
+                return Status::OK();
+            } else if (prevNode->isDivergencePoint() && flowPath->branch(inputId.first) != inputId.second) {
+                flowPath->markNodeActive(node->id(), false);
+                nd4j_debug("Skipping Node_%i due to divergent branch [%i]\n", node->id(), inputId.first);
+                return Status::OK();
+            }
+        }
+    }
+
+    flowPath->markNodeActive(node->id(), true);
+
+    Nd4jStatus status;
+    if (node->opType() == OpType_LOGIC) {
+        // only Switch & Merge are possible here, see isDataflowCompatible()
+        status = LogicExecutor::processNode(graph, node);
+    } else {
+        auto timeStart = std::chrono::system_clock::now();
+
+        status = GraphExecutioner::executeFlatNode(graph, node, state->variableSpace);
+
+        auto timeEnd = std::chrono::system_clock::now();
+        flowPath->setOuterTime(node->id(), std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count());
+    }
+
+    if (status != Status::OK())
+        return status;
+
+    flowPath->markExecuted(node->id(), true);
+
+    if (state->profiling)
+        flowPath->profile()->nodeById(node->id())->setTotalTime(GraphProfile::relativeTime(nodeTime));
+
+    return status;
+}
+
+/**
+ * This method resolves given node, and then releases its dependants. Dependants which became ready are spawned as
+ * new tasks, except the last one: it's resolved by the current thread, so linear chains stay on the same core
+ */
+static void processDataflowNode(DataflowState *state, int index) {
+    std::vector<int> ready;
+
+    while (index >= 0) {
+        if (state->status.load() != Status::OK())
+            return;
+
+        auto status = resolveDataflowNode(state, state->nodes[index]);
+        if (status != Status::OK()) {
+            int expected = Status::OK();
+            state->status.compare_exchange_strong(expected, status);
+            return;
+        }
+
+        ready.clear();
+        for (auto d: state->dependants[index])
+            if (--state->pending[d] == 0)
+                ready.emplace_back(d);
+
+        index = -1;
+        for (int e = 0; e < (int) ready.size(); e++) {
+            if (e == (int) ready.size() - 1) {
+                index = ready[e];
+            } else {
+                int next = ready[e];
+#pragma omp task default(none) firstprivate(state, next)
+                processDataflowNode(state, next);
+            }
+        }
+    }
+}
+
+bool GraphExecutioner::isDataflowCompatible(Graph *graph) {
+    bool hasIndependent = false;
+    for (auto &layer: *graph->getOnion()) {
+        if (layer.second->size() > 1)
+            hasIndependent = true;
+
+        for (auto node: *layer.second) {
+            if (node->isScoped() || node->getFrameId() >= 0)
+                return false;
+
+            if (node->opType() == OpType_LOGIC && node->opNum() != nd4j::logic::Switch && node->opNum() != nd4j::logic::Merge)
+                return false;
+        }
+    }
+
+    // every node runs as omp task, so kernels lose their own parallelism: that pays off only if there's something to run concurrently
+    return hasIndependent;
+}
+
+Nd4jStatus GraphExecutioner::executeDataflow(Graph *graph, VariableSpace *variableSpace, FlowPath *flowPath) {
+    DataflowState state;
+    state.graph = graph;
+    state.variableSpace = variableSpace;
+    state.flowPath = flowPath;
+    state.profiling = Environment::getInstance()->isProfiling();
+    state.status = Status::OK();
+
+    std::unordered_map<int, int> indices;
+    for (auto &layer: *graph->getOnion()) {
+        for (auto node: *layer.second) {
+            indices[node->id()] = static_cast<int>(state.nodes.size());
+            state.nodes.emplace_back(node);
+        }
+    }
+
+    auto numNodes = static_cast<int>(state.nodes.size());
+    state.dependants.resize(numNodes);
+    state.pending.reset(new std::atomic<int>[numNodes]);
+
+    std::vector<int> roots;
+    for (int e = 0; e < numNodes; e++) {
+        auto node = state.nodes[e];
+
+        // all states are registered upfront, so tasks never modify FlowPath/GraphProfile maps
+        flowPath->registerNode(node->id());
+        for (auto &in: *node->input())
+            flowPath->registerNode(in.first);
+
+        if (state.profiling)
+            flowPath->profile()->nodeById(node->id(), node->name()->c_str());
+
+        // counting distinct input nodes. inputs that aren't nodes (i.e. variables) are resolved already
+        int numPending = 0;
+        for (int i = 0; i < (int) node->input()->size(); i++) {
+            auto inputId = node->input()->at(i).first;
+
+            bool duplicate = false;
+            for (int p = 0; p < i && !duplicate; p++)
+                duplicate = node->input()->at(p).first == inputId;
+
+            if (duplicate || indices.count(inputId) == 0)
+                continue;
+
+            state.dependants[indices[inputId]].emplace_back(e);
+            numPending++;
+        }
+
+        state.pending[e] = numPending;
+        if (numPending == 0)
+            roots.emplace_back(e);
+    }
+
+#pragma omp parallel default(shared)
+#pragma omp single
+    {
+        for (auto root: roots) {
+            DataflowState *ptr = &state;
+#pragma omp task default(none) firstprivate(ptr, root)
+            processDataflowNode(ptr, root);
+        }
+    }
+
+    return state.status.load();
+}
+
 /**
  * This method executes given Graph instance, and returns error code.
  *
@@ -217,8 +429,11 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     Nd4jLong tb0 = Environment::getInstance()->isProfiling() ? GraphProfile::currentTime() : 0L;
     graph->buildGraph();
 
+    // graphs with memory plan keep activations within plan arena, so footprints of unplanned runs don't apply to them
+    bool planned = __variableSpace->memoryPlan() != nullptr;
+
     auto footprintForward = nd4j::memory::MemoryRegistrator::getInstance()->getGraphMemoryFootprint(graph->hashCode());
-    if (footprintForward > 0) {
+    if (footprintForward > 0 && !planned) {
         if (__variableSpace->workspace() != nullptr) {
             // this method will work only if current workspace size is smaller then proposed value
             nd4j_debug("Setting workspace to %lld bytes\n", footprintForward);
@@ -241,6 +456,27 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     bool inFrame =  false;
     bool leftFrame = false;
 
+    // graphs without loop frames are executed as dataflow, so independent nodes can run concurrently
+#ifdef _OPENMP
+    bool multithreaded = omp_get_max_threads() > 1;
+#else
+    bool multithreaded = false;
+#endif
+    if (pe && multithreaded && isDataflowCompatible(graph)) {
+        auto status = executeDataflow(graph, __variableSpace, flowPath);
+
+        if (Environment::getInstance()->isProfiling())
+            flowPath->profile()->setExecutionTime(GraphProfile::relativeTime(timeStart));
+
+        if (status == Status::OK() && __variableSpace->workspace() != nullptr && !planned)
+            nd4j::memory::MemoryRegistrator::getInstance()->setGraphMemoryFootprintIfGreater(graph->hashCode(), __variableSpace->workspace()->getAllocatedSize());
+
+        if (tempFlow)
+            delete flowPath;
+
+        return status;
+    }
+
     auto nodeTime = GraphProfile::currentTime();
     int lastId = -10000000;
     Nd4jLong exec_counter = 0;
@@ -488,7 +724,7 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     }
 
     // saving memory footprint for current run
-    if (__variableSpace->workspace() != nullptr) {
+    if (__variableSpace->workspace() != nullptr && !planned) {
         auto m = __variableSpace->workspace()->getAllocatedSize();
         auto h = graph->hashCode();
         nd4j::memory::MemoryRegistrator::getInstance()->setGraphMemoryFootprintIfGreater(h, m);
@@ -851,7 +1087,6 @@ uint8_t* readFlatBuffers(const char * filename) {
 }
 
 flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
-    ExecutionResult result;
     auto varSpace = graph->getVariableSpace();
 
     if (request != nullptr && request->variables() != nullptr) {
@@ -863,17 +1098,23 @@ flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuff
         }
     }
 
+    return executePrepared(graph, builder, request != nullptr ? request->id() : 0);
+}
+
+flatbuffers::Offset<FlatResult> GraphExecutioner::executePrepared(Graph *graph, flatbuffers::FlatBufferBuilder &builder, Nd4jLong requestId) {
+    ExecutionResult result;
+
     if (Environment::getInstance()->isDebugAndVerbose())
         graph->printOut();
 
     auto status = GraphExecutioner::execute(graph);
     if (status != nd4j::Status::OK())
-        throw graph_execution_exception(request->id());
+        throw graph_execution_exception(requestId);
 
     auto outputs = graph->fetchOutputs();
 
     if (outputs->size() == 0)
-        throw no_results_exception(request->id());
+        throw no_results_exception(requestId);
 
 
     for (auto v: *outputs) {
@@ -35,6 +35,7 @@
 #include <indexing/NDIndex.h>
 #include <indexing/IndicesList.h>
 #include <helpers/ShapeUtils.h>
+#include <helpers/ConstantTadHelper.h>
 #include <sstream>
 #include <helpers/ArrayUtils.h>
 #include <MmulHelper.h>
@@ -133,10 +134,15 @@ NDArray::NDArray(const NDArray& other) {
     _dataType = other._dataType;
 
     ALLOCATE(_buffer, other._workspace, _length * other.sizeOfT(), int8_t);
-    _shapeInfo = ShapeBuilders::copyShapeInfo(other._shapeInfo, false, _workspace);
+
+    // workspace-backed arrays keep their shapeInfo in workspace, all others share interned one
+    if (_workspace == nullptr)
+        _shapeInfo = ConstantShapeHelper::getInstance()->bufferForShapeInfo(other._shapeInfo, false);
+    else
+        _shapeInfo = ShapeBuilders::copyShapeInfo(other._shapeInfo, false, _workspace);
 
     _isBuffAlloc = true;
-    _isShapeAlloc = true;
+    _isShapeAlloc = !ConstantShapeHelper::getInstance()->isInterned(_shapeInfo);
 
     this->assign(&other);
 }
@@ -201,7 +207,10 @@ NDArray::NDArray(const char order, const std::vector<Nd4jLong> &shape, nd4j::Dat
     if ((int) shape.size() > MAX_RANK)
         throw std::invalid_argument("Rank of NDArray can't exceed 32");
 
-    setShapeInfo(ShapeBuilders::createShapeInfo(dtype, order, shape, workspace));
+    if (workspace == nullptr)
+        setConstantShapeInfo(ConstantShapeHelper::getInstance()->createShapeInfo(dtype, order, shape));
+    else
+        setShapeInfo(ShapeBuilders::createShapeInfo(dtype, order, shape, workspace));
     ALLOCATE(_buffer, workspace, _length * DataTypeUtils::sizeOf(dtype), int8_t);
     memset(_buffer, 0, _length * DataTypeUtils::sizeOf(dtype));
     _workspace = workspace;
@@ -214,7 +223,10 @@ NDArray::NDArray(const char order, const std::vector<Nd4jLong> &shape, const std
     if ((int) shape.size() > MAX_RANK)
         throw std::invalid_argument("Rank of NDArray can't exceed 32");
 
-    setShapeInfo(ShapeBuilders::createShapeInfo(dtype, order, shape, workspace));
+    if (workspace == nullptr)
+        setConstantShapeInfo(ConstantShapeHelper::getInstance()->createShapeInfo(dtype, order, shape));
+    else
+        setShapeInfo(ShapeBuilders::createShapeInfo(dtype, order, shape, workspace));
 
     if (_length != data.size()) {
         nd4j_printf("NDArray constructor: data size [%i] doesn't match shape length [%i]\n", data.size(), _length);
@@ -235,7 +247,10 @@ NDArray::NDArray(const char order, const std::vector<Nd4jLong> &shape, const std
 NDArray::NDArray(const NDArray *other, const bool copyStrides, nd4j::memory::Workspace* workspace) {
 
     ALLOCATE(_buffer, workspace, other->_length * DataTypeUtils::sizeOf(other->dataType()), int8_t);
-    setShapeInfo(ShapeBuilders::copyShapeInfo(other->_shapeInfo, copyStrides, workspace));
+    if (workspace == nullptr)
+        setConstantShapeInfo(ConstantShapeHelper::getInstance()->bufferForShapeInfo(other->_shapeInfo, copyStrides));
+    else
+        setShapeInfo(ShapeBuilders::copyShapeInfo(other->_shapeInfo, copyStrides, workspace));
     _workspace = workspace;
     triggerAllocationFlag(true, true);
 }
@@ -246,7 +261,10 @@ NDArray::NDArray(void* buffer, const char order, const std::vector<Nd4jLong> &sh
     if ((int) shape.size() > MAX_RANK)
         throw std::invalid_argument("Rank of NDArray can't exceed 32");
 
-    setShapeInfo(ShapeBuilders::createShapeInfo(dtype, order, shape, workspace));
+    if (workspace == nullptr)
+        setConstantShapeInfo(ConstantShapeHelper::getInstance()->createShapeInfo(dtype, order, shape));
+    else
+        setShapeInfo(ShapeBuilders::createShapeInfo(dtype, order, shape, workspace));
 
     _buffer = reinterpret_cast<int8_t *>(buffer);
     _workspace = workspace;
@@ -260,26 +278,34 @@ NDArray::NDArray(Nd4jLong* shapeInfo, const bool copyStrides, nd4j::memory::Work
     if ((int) shapeInfo[0] > MAX_RANK)
         throw std::invalid_argument("Rank of NDArray can't exceed 32");
 
+    bool shapeAlloc = isShapeAlloc;
     if(isShapeAlloc) {
         setShapeInfo(shapeInfo);
         if(!copyStrides)
             shape::updateStrides(_shapeInfo, shape::order(shapeInfo));
     }
-    else
+    else if (workspace == nullptr) {
+        setConstantShapeInfo(ConstantShapeHelper::getInstance()->bufferForShapeInfo(shapeInfo, copyStrides));
+        shapeAlloc = _isShapeAlloc;
+    }
+    else {
         setShapeInfo(ShapeBuilders::copyShapeInfo(shapeInfo, copyStrides, workspace));
+        shapeAlloc = true;
+    }
 
     if (ArrayOptions::hasPropertyBitSet(shapeInfo, ARRAY_EMPTY)) {
         _buffer = nullptr;
         _length = 0;
-        triggerAllocationFlag(false, true);
+        _isBuffAlloc = false;
     }
     else {
         ALLOCATE(_buffer, workspace, _length * DataTypeUtils::sizeOfElement(_dataType), int8_t);
 
         memset(_buffer, 0, _length * DataTypeUtils::sizeOfElement(_dataType));
 
-        triggerAllocationFlag(true, true);
+        _isBuffAlloc = true;
     }
+    _isShapeAlloc = shapeAlloc;
     _workspace = workspace;
 }
 
@@ -294,32 +320,59 @@ NDArray::NDArray(Nd4jLong* shapeInfo, const nd4j::DataType dtype, const bool cop
         _shapeInfo = shapeInfo;
         if(!copyStrides)
             shape::updateStrides(_shapeInfo, shape::order(shapeInfo));
+        ArrayOptions::setDataType(_shapeInfo, dtype);
+    }
+    else {
+        Nd4jLong shapeInfoNew[MAX_SHAPEINFOLENGTH];
+        memcpy(shapeInfoNew, shapeInfo, shape::shapeInfoByteLength(shapeInfo));
+        if(!copyStrides)
+            shape::updateStrides(shapeInfoNew, shape::order(shapeInfo));
+        ArrayOptions::setDataType(shapeInfoNew, dtype);
+
+        if (workspace == nullptr)
+            _shapeInfo = ConstantShapeHelper::getInstance()->bufferForShapeInfo(shapeInfoNew);
+        else
+            _shapeInfo = ShapeBuilders::copyShapeInfo(shapeInfoNew, true, workspace);
     }
-    else
-        _shapeInfo = ShapeBuilders::copyShapeInfo(shapeInfo, copyStrides, workspace);
 
     _dataType = dtype;
     _length = shape::length(_shapeInfo);
     _workspace = workspace;
-    ArrayOptions::setDataType(_shapeInfo, _dataType);
 
     ALLOCATE(_buffer, _workspace, _length * sizeOfT() , int8_t);
 
     memset(_buffer, 0, _length * DataTypeUtils::sizeOfElement(_dataType));
 
-    triggerAllocationFlag(true, true);
+    _isBuffAlloc = true;
+    _isShapeAlloc = isShapeAlloc || !ConstantShapeHelper::getInstance()->isInterned(_shapeInfo);
 }
 
 ////////////////////////////////////////////////////////////////////////
 NDArray::NDArray(nd4j::DataType dtype, nd4j::memory::Workspace* workspace) {
 
-    setShapeInfo(ShapeBuilders::createScalarShapeInfo(dtype, workspace));
+    if (workspace == nullptr)
+        setConstantShapeInfo(ConstantShapeHelper::getInstance()->scalarShapeInfo(dtype));
+    else
+        setShapeInfo(ShapeBuilders::createScalarShapeInfo(dtype, workspace));
     ALLOCATE(_buffer, workspace, DataTypeUtils::sizeOfElement(dtype), int8_t);
     memset(_buffer, 0, DataTypeUtils::sizeOfElement(dtype));
     _workspace = workspace;
     triggerAllocationFlag(true, true);
 }
 
+////////////////////////////////////////////////////////////////////////
+void NDArray::setConstantShapeInfo(const Nd4jLong *shapeInfo) {
+
+    if(_isShapeAlloc && _shapeInfo != nullptr)
+        RELEASE(_shapeInfo, _workspace);
+
+    // once interning table is full, helper hands out copies owned by caller
+    _shapeInfo = const_cast<Nd4jLong *>(shapeInfo);
+    _isShapeAlloc = !ConstantShapeHelper::getInstance()->isInterned(_shapeInfo);
+    _length = shape::length(_shapeInfo);
+    _dataType = ArrayOptions::dataType(_shapeInfo);
+}
+
 
     template <typename T>
     void NDArray::templatedAssign(void *xBuffer, Nd4jLong xOffset, const void *yBuffer, const Nd4jLong yOffset) const {
@@ -926,11 +979,14 @@ std::vector<int64_t> NDArray::getShapeAsFlatVector() {
         _length = other._length;
         _dataType = other._dataType;
 
-        _shapeInfo = ShapeBuilders::copyShapeInfo(other._shapeInfo, false, _workspace);
+        if (_workspace == nullptr)
+            _shapeInfo = ConstantShapeHelper::getInstance()->bufferForShapeInfo(other._shapeInfo, false);
+        else
+            _shapeInfo = ShapeBuilders::copyShapeInfo(other._shapeInfo, false, _workspace);
         ALLOCATE(_buffer, _workspace, _length * sizeOfT(), int8_t);
 
         _isBuffAlloc = true;
-        _isShapeAlloc = true;
+        _isShapeAlloc = !ConstantShapeHelper::getInstance()->isInterned(_shapeInfo);
         this->assign(&other);
     }
 
@@ -1035,8 +1091,12 @@ void NDArray::replacePointers(void *buffer, Nd4jLong *shapeInfo, const bool rele
                     BUILD_DOUBLE_SELECTOR(_dataType, other._dataType, templatedDoubleAssign, (_buffer, 0, other._buffer, 0), LIBND4J_TYPES, LIBND4J_TYPES);
                 }
                 else if (this->isEmpty() != other.isEmpty()) { // need assign non-empty scalar to empty
-                    if (other.isEmpty())
-                        ArrayOptions::setPropertyBit(this->_shapeInfo, ARRAY_EMPTY);
+                    if (other.isEmpty()) {
+                        Nd4jLong shapeInfoNew[MAX_SHAPEINFOLENGTH];
+                        memcpy(shapeInfoNew, _shapeInfo, shape::shapeInfoByteLength(_shapeInfo));
+                        ArrayOptions::setPropertyBit(shapeInfoNew, ARRAY_EMPTY);
+                        setConstantShapeInfo(ConstantShapeHelper::getInstance()->bufferForShapeInfo(shapeInfoNew));
+                    }
                     else
                         *this = other;
                 }
@@ -2003,17 +2063,9 @@ void NDArray::applyPairwiseTransform(nd4j::pairwise::BoolOps op, const NDArray *
         tad.createTadOnlyShapeInfo();
         tad.createOffsets();
 
-        Nd4jLong* shapeInfo;
-        if (_workspace == nullptr) {
-            shapeInfo = new Nd4jLong[shape::shapeInfoLength(tad.tadOnlyShapeInfo)];
-        } else {
-            shapeInfo = reinterpret_cast<Nd4jLong *>(_workspace->allocateBytes(shape::shapeInfoByteLength(tad.tadOnlyShapeInfo)));
-        }
-        std::memcpy(shapeInfo, tad.tadOnlyShapeInfo, shape::shapeInfoByteLength(tad.tadOnlyShapeInfo));
+        auto shapeInfo = ConstantShapeHelper::getInstance()->bufferForShapeInfo(tad.tadOnlyShapeInfo);
 
         auto array = new NDArray(bufferWithOffset(tad.tadOffsets[index]), shapeInfo, _workspace);
-        array->_isBuffAlloc = false;
-        array->_isShapeAlloc = true;
         array->_isView = true;
 
         return array;
@@ -2374,7 +2426,15 @@ template void NDArray::applyScalar(nd4j::scalar::Ops op, const bool scalar, NDAr
 //////////////////////////////////////////////////////////////////////////
     // calculate strides
     void NDArray::updateStrides(const char order) {
-    	shape::updateStrides(_shapeInfo, order);
+        if (_isShapeAlloc) {
+            shape::updateStrides(_shapeInfo, order);
+            return;
+        }
+
+        Nd4jLong shapeInfoNew[MAX_SHAPEINFOLENGTH];
+        memcpy(shapeInfoNew, _shapeInfo, shape::shapeInfoByteLength(_shapeInfo));
+        shape::updateStrides(shapeInfoNew, order);
+        setConstantShapeInfo(ConstantShapeHelper::getInstance()->bufferForShapeInfo(shapeInfoNew));
     }
 
 //////////////////////////////////////////////////////////////////////////
@@ -2486,6 +2546,9 @@ template void NDArray::applyScalar(nd4j::scalar::Ops op, const bool scalar, NDAr
     for(const auto& item : shape)
         arrLength *= item;
 
+    if (rank > MAX_RANK)
+        throw std::invalid_argument("Rank of NDArray can't exceed 32");
+
     if(_buffer==nullptr || arrLength != this->lengthOf()) {
         this->printShapeInfo("Mismatched shape");
         nd4j::Logger::printv("Shape requested: ", shape);
@@ -2498,20 +2561,15 @@ template void NDArray::applyScalar(nd4j::scalar::Ops op, const bool scalar, NDAr
 
     // we can do this only if there was no permute applied, or there are no weird strides
     if (shape::canReshape(this->rankOf(), this->_shapeInfo, shape.size(), shape.data(), order == 'f')) {
-        Nd4jLong *shapeInfoNew;
-        ALLOCATE(shapeInfoNew, _workspace, shape::shapeInfoLength(rank), Nd4jLong);
+        Nd4jLong shapeInfoNew[MAX_SHAPEINFOLENGTH];
+        memset(shapeInfoNew, 0, sizeof(shapeInfoNew));
 
         shape::reshapeCF(this->rankOf(), this->_shapeInfo, shape.size(), shape.data(), order == 'f', shapeInfoNew);
-
-        if (_isShapeAlloc)
-            RELEASE(_shapeInfo, _workspace);
-
         ArrayOptions::setDataType(shapeInfoNew, this->dataType());
-        _shapeInfo = shapeInfoNew;
-        _isShapeAlloc = true;
+
+        setConstantShapeInfo(ConstantShapeHelper::getInstance()->bufferForShapeInfo(shapeInfoNew));
     } else {
-        Nd4jLong *shapeInfoNew;
-        ALLOCATE(shapeInfoNew, _workspace, shape::shapeInfoLength(rank), Nd4jLong);
+        Nd4jLong shapeInfoNew[MAX_SHAPEINFOLENGTH];
 
         if (order == 'c')
             shape::shapeBuffer(shape.size(), dataType(), shape.data(), shapeInfoNew);
@@ -2526,14 +2584,9 @@ template void NDArray::applyScalar(nd4j::scalar::Ops op, const bool scalar, NDAr
         if (_isBuffAlloc)
             RELEASE(_buffer, _workspace);
 
-
-        if (_isShapeAlloc)
-            RELEASE(_shapeInfo, _workspace);
-
+        setConstantShapeInfo(ConstantShapeHelper::getInstance()->bufferForShapeInfo(shapeInfoNew));
 
         _buffer = newBuffer;
-        _shapeInfo = shapeInfoNew;
-        _isShapeAlloc = true;
         _isBuffAlloc = true;
     }
 
@@ -2565,9 +2618,7 @@ template void NDArray::applyScalar(nd4j::scalar::Ops op, const bool scalar, NDAr
     // create new array with corresponding order and shape, new array will point to the same _buffer as this array
     NDArray* NDArray::reshape(const char order, const std::vector<Nd4jLong>& shape) const {
 
-        int shapeInfoLength = shape::shapeInfoLength(rankOf());
-        Nd4jLong* newShapeInfo = ShapeBuilders::copyShapeInfo(_shapeInfo, true, _workspace);
-        auto newArr = new NDArray(_buffer, newShapeInfo, _workspace, false, true);
+        auto newArr = new NDArray(_buffer, ConstantShapeHelper::getInstance()->bufferForShapeInfo(_shapeInfo), _workspace, false, false);
 
         newArr->reshapei(order, shape);
 
@@ -2820,9 +2871,14 @@ template void NDArray::applyScalar(nd4j::scalar::Ops op, const bool scalar, NDAr
     bool NDArray::permutei(const int* dimensions, const int rank) {
 
         // check if current object is _shapeInfo owner
-        if (!_isShapeAlloc) {             // if _shapeInfo is not its own
-            _shapeInfo = ShapeUtils::evalPermShapeInfo(dimensions, rank, *this, _workspace);
-            _isShapeAlloc = true;
+        if (!_isShapeAlloc) {             // if _shapeInfo is not its own, permuted one is taken from interned shapes
+            if (!nonNull() || rank != rankOf())
+                throw std::runtime_error("NDArray::permutei method: wrong arguments in permutei method: either array is nullptr or rank is not suitable!");
+
+            Nd4jLong shapeInfoNew[MAX_SHAPEINFOLENGTH];
+            memcpy(shapeInfoNew, _shapeInfo, shape::shapeInfoByteLength(_shapeInfo));
+            shape::doPermuteShapeInfo(shapeInfoNew, dimensions);
+            setConstantShapeInfo(ConstantShapeHelper::getInstance()->bufferForShapeInfo(shapeInfoNew));
         } else {
             if (!nonNull() || rank != rankOf())
                 throw std::runtime_error("NDArray::permutei method: wrong arguments in permutei method: either array is nullptr or rank is not suitable!");
@@ -2835,9 +2891,14 @@ template void NDArray::applyScalar(nd4j::scalar::Ops op, const bool scalar, NDAr
     bool NDArray::permutei(const Nd4jLong* dimensions, const int rank) {
 
         // check if current object is _shapeInfo owner
-        if (!_isShapeAlloc) {             // if _shapeInfo is not its own
-            _shapeInfo = ShapeUtils::evalPermShapeInfo(dimensions, rank, *this, _workspace);
-            _isShapeAlloc = true;
+        if (!_isShapeAlloc) {             // if _shapeInfo is not its own, permuted one is taken from interned shapes
+            if (!nonNull() || rank != rankOf())
+                throw std::runtime_error("NDArray::permutei method: wrong arguments in permutei method: either array is nullptr or rank is not suitable!");
+
+            Nd4jLong shapeInfoNew[MAX_SHAPEINFOLENGTH];
+            memcpy(shapeInfoNew, _shapeInfo, shape::shapeInfoByteLength(_shapeInfo));
+            shape::doPermuteShapeInfo(shapeInfoNew, dimensions);
+            setConstantShapeInfo(ConstantShapeHelper::getInstance()->bufferForShapeInfo(shapeInfoNew));
         } else {
             if (!nonNull() || rank != rankOf())
                 throw std::runtime_error("NDArray::permutei method: wrong arguments in permutei method: either array is nullptr or rank is not suitable!");
@@ -2881,10 +2942,16 @@ template void NDArray::applyScalar(nd4j::scalar::Ops op, const bool scalar, NDAr
 
     //////////////////////////////////////////////////////////////////////////
     NDArray* NDArray::permute(const int* dimensions, const int rank) const {
+        if (!nonNull() || rank != rankOf())
+            throw std::runtime_error("NDArray::permute method: wrong arguments in permute method: either array is nullptr or rank is not suitable!");
+
         // evaluate shapeInfo for output (permuted) array ret
-        auto shapeInfoNew = ShapeUtils::evalPermShapeInfo(dimensions, rank, *this, _workspace);
+        Nd4jLong shapeInfoNew[MAX_SHAPEINFOLENGTH];
+        memcpy(shapeInfoNew, _shapeInfo, shape::shapeInfoByteLength(_shapeInfo));
+        shape::doPermuteShapeInfo(shapeInfoNew, dimensions);
+
         // create array to be returned
-        auto ret = new NDArray(_buffer, shapeInfoNew, _workspace, false, true);
+        auto ret = new NDArray(_buffer, ConstantShapeHelper::getInstance()->bufferForShapeInfo(shapeInfoNew), _workspace, false, false);
 	    ret->_isView = true;
 
         return ret;
@@ -3648,8 +3715,13 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
     NDArray* NDArray::subarray(IndicesList& idx, std::vector<Nd4jLong>& strides) const {
         auto raw = subarray(idx);
 
+        Nd4jLong shapeInfoNew[MAX_SHAPEINFOLENGTH];
+        memcpy(shapeInfoNew, raw->_shapeInfo, shape::shapeInfoByteLength(raw->_shapeInfo));
+
         for (int e = 0; e < strides.size(); e++)
-            raw->stridesOf()[e] *= strides[e];
+            shape::stride(shapeInfoNew)[e] *= strides[e];
+
+        raw->setConstantShapeInfo(ConstantShapeHelper::getInstance()->bufferForShapeInfo(shapeInfoNew));
 
         return raw;
     }
@@ -3667,8 +3739,7 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
         if (idx.size() != this->rankOf())
             throw std::runtime_error("Number of indices should match");
 
-        Nd4jLong* newShape;
-        ALLOCATE(newShape, _workspace, shape::shapeInfoLength(this->rankOf()), Nd4jLong);
+        Nd4jLong newShape[MAX_SHAPEINFOLENGTH];
         memcpy(newShape, this->_shapeInfo, shape::shapeInfoByteLength(this->rankOf()));
         newShape[shape::shapeInfoLength(this->rankOf()) - 2] = -1;
 
@@ -3699,8 +3770,7 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
 
         //shape::printShapeInfoLinear(newShape);
 
-        auto result = new NDArray(bufferWithOffset(offset), newShape, this->_workspace);
-        result->_isShapeAlloc = true;
+        auto result = new NDArray(bufferWithOffset(offset), ConstantShapeHelper::getInstance()->bufferForShapeInfo(newShape), this->_workspace);
 
         return result;
     }
@@ -3710,8 +3780,7 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
         if (idx.size() != this->rankOf())
             throw std::runtime_error("NDArray::subarray: number of indices should match the array rank");
 
-        Nd4jLong *newShape;
-        ALLOCATE(newShape, _workspace, shape::shapeInfoLength(this->rankOf()), Nd4jLong);
+        Nd4jLong newShape[MAX_SHAPEINFOLENGTH];
         memcpy(newShape, this->_shapeInfo, shape::shapeInfoByteLength(this->rankOf()));
         newShape[shape::shapeInfoLength(this->rankOf()) - 2] = -1;
 
@@ -3734,8 +3803,7 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
             ++d;
         }
 
-        auto result = new NDArray(bufferWithOffset(offset), newShape, this->_workspace);
-        result->_isShapeAlloc = true;
+        auto result = new NDArray(bufferWithOffset(offset), ConstantShapeHelper::getInstance()->bufferForShapeInfo(newShape), this->_workspace);
 
         for (auto v: idx) {
             delete v;
@@ -3749,8 +3817,7 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
         if (idx.size() != this->rankOf())
             throw std::runtime_error("NDArray::subarray: number of indices should match the rank of array!");
 
-        Nd4jLong *newShape;
-        ALLOCATE(newShape, _workspace, shape::shapeInfoLength(this->rankOf()), Nd4jLong);
+        Nd4jLong newShape[MAX_SHAPEINFOLENGTH];
         memcpy(newShape, this->_shapeInfo, shape::shapeInfoByteLength(this->rankOf()));
         newShape[shape::shapeInfoLength(this->rankOf()) - 2] = -1;
 
@@ -3769,8 +3836,7 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
             }
         }
 
-        auto result = new NDArray(bufferWithOffset(offset), newShape, this->_workspace);
-        result->_isShapeAlloc = true;
+        auto result = new NDArray(bufferWithOffset(offset), ConstantShapeHelper::getInstance()->bufferForShapeInfo(newShape), this->_workspace);
 
         return result;
     }
@@ -4033,8 +4099,7 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
     NDArray NDArray::operator()(const std::vector<Nd4jLong>& idx, bool keepUnitiesInShape)  const {
 
         const int rank = rankOf();
-        Nd4jLong *newShape;
-        ALLOCATE(newShape, _workspace, shape::shapeInfoLength(rank), Nd4jLong);
+        Nd4jLong newShape[MAX_SHAPEINFOLENGTH];
         memcpy(newShape, _shapeInfo, shape::shapeInfoByteLength(rank));
         newShape[shape::shapeInfoLength(rank) - 2] = -1;
 
@@ -4056,7 +4121,7 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
             }
         }
 
-        NDArray result(bufferWithOffset(offset), newShape, _workspace, false, true);
+        NDArray result(bufferWithOffset(offset), ConstantShapeHelper::getInstance()->bufferForShapeInfo(newShape), _workspace, false, false);
 
         if(!keepUnitiesInShape) {
 
@@ -5104,24 +5169,15 @@ template void NDArray::operator/=(const bool scalar);
         auto tadLength = shape::tadLength(_shapeInfo, copy.data(), copy.size());
         auto numTads = _length / tadLength;
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, copy.data(), copy.size()));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
-
-        auto shapeInfo = new Nd4jLong[shape::shapeInfoLength(tad->tadOnlyShapeInfo[0])];
-        std::memcpy(shapeInfo, tad->tadOnlyShapeInfo, shape::shapeInfoByteLength(tad->tadOnlyShapeInfo));
+        auto pack = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, copy);
+        auto shapeInfo = ConstantShapeHelper::getInstance()->bufferForShapeInfo(pack->primaryShapeInfo());
+        auto offsets = pack->primaryOffsets();
 
         for (int idx = 0; idx < numTads; idx++ ) {
-            auto array = new NDArray(bufferWithOffset(tad->tadOffsets[idx]), shapeInfo);
+            auto array = new NDArray(bufferWithOffset(offsets[idx]), shapeInfo);
             result->push_back(array);
         }
 
-        // if we have no indices - just delete shapeInfo
-        if (result->size() > 0)
-            result->at(0)->triggerAllocationFlag(false, true);
-        else
-            delete[] shapeInfo;
-
         return result;
     }
 
@@ -143,7 +143,11 @@ template void NDArrayFactory::memcpyFromVector(void *ptr, const std::vector<int8
         int8_t *buffer;
         ALLOCATE(buffer, workspace, 1 * sizeof(T), int8_t);        
 
-        res->setShapeInfo(ShapeBuilders::createScalarShapeInfo(DataTypeUtils::fromT<T>(), workspace));
+        // workspace-backed arrays keep their shapeInfo in workspace, all others share interned one
+        if (workspace == nullptr)
+            res->setShapeInfo(ConstantShapeHelper::getInstance()->scalarShapeInfo(DataTypeUtils::fromT<T>()));
+        else
+            res->setShapeInfo(ShapeBuilders::createScalarShapeInfo(DataTypeUtils::fromT<T>(), workspace));
         res->setBuffer(buffer);
         res->triggerAllocationFlag(true, true);
         res->setWorkspace(workspace);
@@ -200,7 +204,10 @@ template void NDArrayFactory::memcpyFromVector(void *ptr, const std::vector<int8
         int8_t *buffer;
         ALLOCATE(buffer, workspace, 1 * sizeof(T), int8_t);
 
-        res.setShapeInfo(ShapeBuilders::createScalarShapeInfo(DataTypeUtils::fromT<T>(), workspace));
+        if (workspace == nullptr)
+            res.setShapeInfo(ConstantShapeHelper::getInstance()->scalarShapeInfo(DataTypeUtils::fromT<T>()));
+        else
+            res.setShapeInfo(ShapeBuilders::createScalarShapeInfo(DataTypeUtils::fromT<T>(), workspace));
         res.setBuffer(buffer);
         res.triggerAllocationFlag(true, true);
         res.setWorkspace(workspace);
@@ -230,7 +237,10 @@ NDArray* NDArrayFactory::create_(const char order, const std::vector<Nd4jLong> &
 
     auto result = new NDArray();
 
-    result->setShapeInfo(ShapeBuilders::createShapeInfo(DataTypeUtils::fromT<T>(), order, shape, workspace));
+    if (workspace == nullptr)
+        result->setShapeInfo(ConstantShapeHelper::getInstance()->createShapeInfo(DataTypeUtils::fromT<T>(), order, shape));
+    else
+        result->setShapeInfo(ShapeBuilders::createShapeInfo(DataTypeUtils::fromT<T>(), order, shape, workspace));
 
     if (result->lengthOf() != data.size()) {
         nd4j_printf("Data size [%i] doesn't match shape length [%i]\n", data.size(), shape::length(result->shapeInfo()));
@@ -369,7 +379,10 @@ NDArray NDArrayFactory::create(const char order, const std::vector<Nd4jLong> &sh
 
     NDArray res;        
 
-    res.setShapeInfo(ShapeBuilders::createShapeInfo(dtype, order, shape, workspace));
+    if (workspace == nullptr)
+        res.setShapeInfo(ConstantShapeHelper::getInstance()->createShapeInfo(dtype, order, shape));
+    else
+        res.setShapeInfo(ShapeBuilders::createShapeInfo(dtype, order, shape, workspace));
     
     int8_t *buffer = nullptr;
     ALLOCATE(buffer, workspace, res.lengthOf() * DataTypeUtils::sizeOfElement(dtype), int8_t);
@@ -393,7 +406,10 @@ NDArray NDArrayFactory::create(nd4j::DataType dtype, nd4j::memory::Workspace* wo
     memset(buffer, 0, DataTypeUtils::sizeOfElement(dtype));
     res.setBuffer(buffer);
     res.setWorkspace(workspace);
-    res.setShapeInfo(ShapeBuilders::createScalarShapeInfo(dtype, workspace));
+    if (workspace == nullptr)
+        res.setShapeInfo(ConstantShapeHelper::getInstance()->scalarShapeInfo(dtype));
+    else
+        res.setShapeInfo(ShapeBuilders::createScalarShapeInfo(dtype, workspace));
     res.triggerAllocationFlag(true, true);
     
     return res;
@@ -437,8 +453,13 @@ template NDArray NDArrayFactory::create(const std::vector<bool> &values, nd4j::m
     BUILD_SINGLE_TEMPLATE(template NDArray* NDArrayFactory::empty_, (nd4j::memory::Workspace* workspace), LIBND4J_TYPES);
 
     NDArray* NDArrayFactory::empty_(nd4j::DataType dataType, nd4j::memory::Workspace* workspace) {
-        auto shapeInfo = ShapeBuilders::createScalarShapeInfo(dataType, workspace);
-        ArrayOptions::setPropertyBit(shapeInfo, ARRAY_EMPTY);
+        Nd4jLong* shapeInfo = nullptr;
+        if (workspace == nullptr)
+            shapeInfo = ConstantShapeHelper::getInstance()->emptyShapeInfo(dataType);
+        else {
+            shapeInfo = ShapeBuilders::createScalarShapeInfo(dataType, workspace);
+            ArrayOptions::setPropertyBit(shapeInfo, ARRAY_EMPTY);
+        }
         auto result = new NDArray(nullptr, shapeInfo, workspace);
         result->triggerAllocationFlag(false, true);
 
@@ -453,8 +474,13 @@ template NDArray NDArrayFactory::create(const std::vector<bool> &values, nd4j::m
     BUILD_SINGLE_TEMPLATE(template NDArray NDArrayFactory::empty, (nd4j::memory::Workspace* workspace), LIBND4J_TYPES);
 
     NDArray NDArrayFactory::empty(nd4j::DataType dataType, nd4j::memory::Workspace* workspace) {
-        auto shapeInfo = ShapeBuilders::createScalarShapeInfo(dataType, workspace);
-        ArrayOptions::setPropertyBit(shapeInfo, ARRAY_EMPTY);
+        Nd4jLong* shapeInfo = nullptr;
+        if (workspace == nullptr)
+            shapeInfo = ConstantShapeHelper::getInstance()->emptyShapeInfo(dataType);
+        else {
+            shapeInfo = ShapeBuilders::createScalarShapeInfo(dataType, workspace);
+            ArrayOptions::setPropertyBit(shapeInfo, ARRAY_EMPTY);
+        }
         NDArray result(nullptr, shapeInfo, workspace);
         result.triggerAllocationFlag(false, true);
 
@@ -504,7 +530,10 @@ NDArray NDArrayFactory::create(T* buffer, const char order, const std::initializ
     NDArray result;
 
     result.setBuffer(reinterpret_cast<uint8_t*>(buffer));
-    result.setShapeInfo(ShapeBuilders::createShapeInfo(DataTypeUtils::fromT<T>(), order, shape, workspace));
+    if (workspace == nullptr)
+        result.setShapeInfo(ConstantShapeHelper::getInstance()->createShapeInfo(DataTypeUtils::fromT<T>(), order, shape));
+    else
+        result.setShapeInfo(ShapeBuilders::createShapeInfo(DataTypeUtils::fromT<T>(), order, shape, workspace));
     result.setWorkspace(workspace);
     result.triggerAllocationFlag(false, true);
     
@@ -65,6 +65,7 @@ bool experimentalSupport = false;
 #include <ops/specials.h>
 #include "../Environment.h"
 #include <TAD.h>
+#include <helpers/ConstantTadHelper.h>
 #include <ops/declarable/OpRegistrator.h>
 #include <graph/Context.h>
 #include <graph/ResultWrapper.h>
@@ -1039,6 +1040,10 @@ void NativeOps::initializeFunctions(Nd4jPointer *functions) {
     nd4j::BlasHelper::getInstance()->initializeFunctions(functions);
 }
 
+void NativeOps::initializeLapackFunctions(Nd4jPointer *functions) {
+    nd4j::BlasHelper::getInstance()->initializeLapackFunctions(functions);
+}
+
 /**
        * This method acquires memory chunk of requested size on host side
        *
@@ -1195,15 +1200,10 @@ void NativeOps::setGridLimit(int gridSize) {
 }
 
 void NativeOps::tadOnlyShapeInfo(Nd4jLong *hXShapeInfo, int *dimension, int dimensionLength, Nd4jLong *target, Nd4jLong *offsets) {
-    shape::TAD tad;
-    tad.init(hXShapeInfo, dimension, dimensionLength);
-    //tad->setOutputBuffer(target);
-    tad.createTadOnlyShapeInfo();
-    tad.createOffsets();
-
+    auto tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(hXShapeInfo, dimension, dimensionLength);
 
-    std::memcpy(reinterpret_cast<void *>(target), tad.tadOnlyShapeInfo, shape::shapeInfoByteLength(tad.tadOnlyShapeInfo));
-    std::memcpy(reinterpret_cast<void *>(offsets), tad.tadOffsets, tad.numTads * sizeof(Nd4jLong));
+    std::memcpy(reinterpret_cast<void *>(target), tadPack->primaryShapeInfo(), shape::shapeInfoByteLength(tadPack->primaryShapeInfo()));
+    std::memcpy(reinterpret_cast<void *>(offsets), tadPack->primaryOffsets(), tadPack->numberOfTads() * sizeof(Nd4jLong));
 }
 
 int NativeOps::memcpyConstantAsync(Nd4jLong dst, Nd4jPointer src, Nd4jLong size, int flags, Nd4jPointer reserved) {
@@ -1369,24 +1369,150 @@ void NativeOps::enableP2P(bool enable) {
 
 
 
+// number of elements per block of threshold encoding, must match blockSize used by CUDA encoder
+#define THRESHOLD_BLOCK 1024
+
+template <typename T>
+static void encodeThresholdP1Generic(void *hX, Nd4jLong N, int *dz, float threshold) {
+    auto x = reinterpret_cast<T *>(hX);
+    const T tt = static_cast<T>(threshold);
+    const Nd4jLong numBlocks = (N + THRESHOLD_BLOCK - 1) / THRESHOLD_BLOCK;
+
+    int total = 0;
+
+    // dz[0] gets total number of eligible elements, dz[b + 1] gets number of them within block b
+#pragma omp parallel for schedule(static) reduction(+:total) if (N > nd4j::Environment::getInstance()->elementwiseThreshold())
+    for (Nd4jLong b = 0; b < numBlocks; b++) {
+        const Nd4jLong start = b * THRESHOLD_BLOCK;
+        const Nd4jLong stop = nd4j::math::nd4j_min<Nd4jLong>(start + THRESHOLD_BLOCK, N);
+
+        int cnt = 0;
+#pragma omp simd reduction(+:cnt)
+        for (Nd4jLong e = start; e < stop; e++)
+            cnt += nd4j::math::nd4j_abs<T>(x[e]) >= tt ? 1 : 0;
+
+        dz[b + 1] = cnt;
+        total += cnt;
+    }
+
+    dz[0] = total;
+}
+
+template <typename T>
+static void encodeThresholdP3Generic(void *hX, int *offsets, Nd4jLong N, int *dz) {
+    auto x = reinterpret_cast<T *>(hX);
+
+    // header: encoded length, decoded length, threshold
+    FloatBits fb;
+    const int limit = dz[0];
+    fb.i_ = dz[2];
+    const T tt = static_cast<T>(fb.f_);
+    const T zero = static_cast<T>(0.0f);
+
+    const Nd4jLong numBlocks = (N + THRESHOLD_BLOCK - 1) / THRESHOLD_BLOCK;
+
+    // each block compacts its elements into local buffer without branches, and copies them to offset found by P2
+#pragma omp parallel for schedule(static) if (N > nd4j::Environment::getInstance()->elementwiseThreshold())
+    for (Nd4jLong b = 0; b < numBlocks; b++) {
+        const Nd4jLong start = b * THRESHOLD_BLOCK;
+        const Nd4jLong stop = nd4j::math::nd4j_min<Nd4jLong>(start + THRESHOLD_BLOCK, N);
+        const int available = limit - offsets[b];
+        if (available <= 0)
+            continue;
+
+        int buffer[THRESHOLD_BLOCK];
+        int cnt = 0;
+        for (Nd4jLong e = start; e < stop; e++) {
+            const T value = x[e];
+            const int idx = static_cast<int>(e) + 1;
+            const bool positive = value > zero;
+            const int pass = nd4j::math::nd4j_abs<T>(value) >= tt && cnt < available ? 1 : 0;
+
+            buffer[cnt] = positive ? idx : -idx;
+            x[e] = pass ? (positive ? value - tt : value + tt) : value;
+            cnt += pass;
+        }
+
+        memcpy(dz + 4 + offsets[b], buffer, cnt * sizeof(int));
+    }
+}
+
+template <typename T>
+static void decodeThresholdGeneric(void *hX, void *dz) {
+    auto x = reinterpret_cast<int *>(hX);
+    auto z = reinterpret_cast<T *>(dz);
+
+    FloatBits fb;
+    const int limit = x[0];
+    fb.i_ = x[2];
+    const T tt = static_cast<T>(fb.f_);
+    const T mtt = -tt;
+
+    // each index is encoded at most once, so updates never collide
+#pragma omp parallel for schedule(static) if (limit > nd4j::Environment::getInstance()->elementwiseThreshold())
+    for (int e = 4; e < limit + 4; e++) {
+        const int el = x[e];
+        z[nd4j::math::nd4j_abs<int>(el) - 1] += el > 0 ? tt : mtt;
+    }
+}
+
 void NativeOps::encodeThresholdP1(Nd4jPointer *extraPointers, void *hX, Nd4jLong *hXShapeInfo, Nd4jLong N, int *dz, float threshold) {
-    // TODO: to be implemented
+    auto xType = ArrayOptions::dataType(hXShapeInfo);
+    BUILD_SINGLE_SELECTOR(xType, encodeThresholdP1Generic, (hX, N, dz, threshold), FLOAT_TYPES);
 }
 
 
 void NativeOps::encodeThresholdP2Int(Nd4jPointer *extraPointers, int *hX, Nd4jLong N, int *dz) {
-    // TODO: to be implemented
+    // exclusive prefix sum of per-block counts, which start at hX[1]
+    auto counts = hX + 1;
+    const int numThreads = nd4j::math::nd4j_min<Nd4jLong>(omp_get_max_threads(), N / 4096 + 1);
+
+    if (numThreads <= 1) {
+        int sum = 0;
+        for (Nd4jLong e = 0; e < N; e++) {
+            dz[e] = sum;
+            sum += counts[e];
+        }
+        return;
+    }
+
+    // each thread scans its own chunk, chunk totals are scanned in between
+    std::vector<int> totals(numThreads + 1, 0);
+    const Nd4jLong span = (N + numThreads - 1) / numThreads;
+
+#pragma omp parallel num_threads(numThreads) default(shared)
+    {
+        const int tid = omp_get_thread_num();
+        const Nd4jLong start = nd4j::math::nd4j_min<Nd4jLong>(span * tid, N);
+        const Nd4jLong stop = nd4j::math::nd4j_min<Nd4jLong>(start + span, N);
+
+        int sum = 0;
+        for (Nd4jLong e = start; e < stop; e++)
+            sum += counts[e];
+        totals[tid + 1] = sum;
+
+#pragma omp barrier
+#pragma omp single
+        for (int t = 1; t <= numThreads; t++)
+            totals[t] += totals[t - 1];
+
+        sum = totals[tid];
+        for (Nd4jLong e = start; e < stop; e++) {
+            dz[e] = sum;
+            sum += counts[e];
+        }
+    }
 }
 
 
 void NativeOps::encodeThresholdP3(Nd4jPointer *extraPointers, void *hX, Nd4jLong *hXShapeInfo, int *offsets, Nd4jLong N, int *dz){
-    // offsets won't be used here
-
-    // TODO: to be implemented
+    auto xType = ArrayOptions::dataType(hXShapeInfo);
+    BUILD_SINGLE_SELECTOR(xType, encodeThresholdP3Generic, (hX, offsets, N, dz), FLOAT_TYPES);
 }
 
 void NativeOps::decodeThreshold(Nd4jPointer *extraPointers, void *hX, Nd4jLong N, void *dz, Nd4jLong *hZShapeInfo){
-    // TODO: to be implemented
+    auto zType = ArrayOptions::dataType(hZShapeInfo);
+    BUILD_SINGLE_SELECTOR(zType, decodeThresholdGeneric, (hX, dz), FLOAT_TYPES);
 }
 
 bool NativeOps::isP2PAvailable() {
@@ -2095,27 +2221,24 @@ int NativeOps::registerGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jP
 }
 
 static VariablesSet* executeStoredGraphT(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs) {
-    auto graph = nd4j::graph::GraphHolder::getInstance()->cloneGraph(graphId);
-    auto varSpace = graph->getVariableSpace();
+    auto holder = nd4j::graph::GraphHolder::getInstance();
+    if (!holder->hasGraph(graphId))
+        throw nd4j::graph::unknown_graph_exception(graphId);
 
-    std::vector<nd4j::NDArray*> handles;
+    nd4j::graph::GraphSessionGuard guard(holder, graphId);
+    auto session = guard.session();
 
+    // inputs are just views of external buffers here, session copies them into its own arrays
+    std::vector<nd4j::graph::Variable*> inputs;
     for (int e = 0; e < numInputs; e++) {
-        auto idx = inputIndices[e];
-
-        // we'll delete this array later, together with cloned VariableSpace
         auto array = new nd4j::NDArray(inputBuffers[e], reinterpret_cast<Nd4jLong *>(inputShapes[e]));
-        handles.emplace_back(array);
+        inputs.emplace_back(new nd4j::graph::Variable(array, nullptr, inputIndices[e], 0));
+    }
 
-        if (varSpace->hasVariable(idx)) {
-            auto var = varSpace->getVariable(idx);
-            if (var->hasNDArray())
-                delete var->getNDArray();
+    session->feed(inputs);
 
-            var->setNDArray(array);
-        } else
-            varSpace->putVariable(idx, array);
-    }
+    auto graph = session->graph();
+    auto varSpace = graph->getVariableSpace();
 
     auto hZ = nd4j::graph::GraphExecutioner::execute(graph, varSpace);
     auto varSet = new nd4j::graph::VariablesSet(hZ);
@@ -2124,7 +2247,7 @@ static VariablesSet* executeStoredGraphT(Nd4jPointer *extraPointers, Nd4jLong gr
         // pull back results, and provide them
         auto outputs = graph->fetchOutputs();
         for (int e = 0; e < outputs->size(); e++) {
-            // we're only getting variable ID/Index from original grap. values will be taken from cloned workspace
+            // session arrays will be reused by next request, so caller gets copies
             std::pair<int, int> varId(outputs->at(e)->id(), outputs->at(e)->index());
 
             auto var = varSpace->getVariable(varId);
@@ -2135,13 +2258,13 @@ static VariablesSet* executeStoredGraphT(Nd4jPointer *extraPointers, Nd4jLong gr
         delete outputs;
     }
 
-    delete graph;
+    guard.release();
 
     return varSet;
 }
 
 nd4j::graph::VariablesSet* NativeOps::executeStoredGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs) {
-    return nullptr;
+    return executeStoredGraphT(extraPointers, graphId, inputBuffers, inputShapes, inputIndices, numInputs);
 }
 
 int NativeOps::unregisterGraph(Nd4jPointer *extraPointers, Nd4jLong graphId) {
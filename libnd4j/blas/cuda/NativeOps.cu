@@ -1644,6 +1644,10 @@ void NativeOps::initializeFunctions(Nd4jPointer *functions) {
 	*/
 }
 
+void NativeOps::initializeLapackFunctions(Nd4jPointer *functions) {
+    // no-op
+}
+
 
 /**
  * This method acquires memory chunk of requested size on host side
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_TADPACK_H
+#define LIBND4J_TADPACK_H
+
+#include <pointercast.h>
+#include <dll.h>
+
+namespace nd4j {
+    /**
+     * This class holds immutable TAD information: tadOnlyShapeInfo and offsets of all TADs
+     */
+    class ND4J_EXPORT TadPack {
+    private:
+        Nd4jLong *_tadShapeInfo = nullptr;
+        Nd4jLong *_tadOffsets = nullptr;
+        Nd4jLong _numTads = 0;
+        int _dimensionLength = 0;
+        bool _wholeThing = false;
+    public:
+        /**
+         * Buffers are copied, so TadPack doesn't depend on lifetime of source arrays
+         */
+        TadPack(Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets, Nd4jLong numTads, int dimensionLength, bool wholeThing);
+        ~TadPack();
+
+        TadPack(const TadPack& other) = delete;
+        TadPack& operator=(const TadPack& other) = delete;
+
+        Nd4jLong* primaryShapeInfo() const;
+        Nd4jLong* primaryOffsets() const;
+
+        Nd4jLong numberOfTads() const;
+
+        /**
+         * Squeezed dimension length, as calculated by shape::TAD
+         */
+        int dimensionLength() const;
+        bool wholeThing() const;
+
+        /**
+         * This method returns true if TAD has no dimensions left after squeeze, i.e. it's no-op
+         */
+        bool isEmpty() const;
+    };
+}
+
+#endif //LIBND4J_TADPACK_H
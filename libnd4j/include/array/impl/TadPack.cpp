@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <array/TadPack.h>
+#include <helpers/shape.h>
+#include <cstring>
+
+namespace nd4j {
+    TadPack::TadPack(Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets, Nd4jLong numTads, int dimensionLength, bool wholeThing) {
+        _numTads = numTads;
+        _dimensionLength = dimensionLength;
+        _wholeThing = wholeThing;
+
+        if (tadShapeInfo != nullptr) {
+            auto length = shape::shapeInfoLength(tadShapeInfo);
+            _tadShapeInfo = new Nd4jLong[length];
+            std::memcpy(_tadShapeInfo, tadShapeInfo, length * sizeof(Nd4jLong));
+        }
+
+        if (tadOffsets != nullptr && numTads > 0) {
+            _tadOffsets = new Nd4jLong[numTads];
+            std::memcpy(_tadOffsets, tadOffsets, numTads * sizeof(Nd4jLong));
+        }
+    }
+
+    TadPack::~TadPack() {
+        delete[] _tadShapeInfo;
+        delete[] _tadOffsets;
+    }
+
+    Nd4jLong* TadPack::primaryShapeInfo() const {
+        return _tadShapeInfo;
+    }
+
+    Nd4jLong* TadPack::primaryOffsets() const {
+        return _tadOffsets;
+    }
+
+    Nd4jLong TadPack::numberOfTads() const {
+        return _numTads;
+    }
+
+    int TadPack::dimensionLength() const {
+        return _dimensionLength;
+    }
+
+    bool TadPack::wholeThing() const {
+        return _wholeThing;
+    }
+
+    bool TadPack::isEmpty() const {
+        return _dimensionLength < 1;
+    }
+}
@@ -22,6 +22,13 @@
 #include <stdexcept>
 #include"cnpy.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 
 
 /**
@@ -628,4 +635,377 @@ std::vector<char> cnpy::createNpyHeader(const T *data,
 
 template ND4J_EXPORT std::vector<char> cnpy::createNpyHeader<void>(const void *data, const unsigned int *shape, const unsigned int ndims, unsigned int wordSize);
 
-template ND4J_EXPORT void cnpy::npy_save<float>(std::string fname, const float* data, const unsigned int* shape, const unsigned int ndims, std::string mode);
\ No newline at end of file
+template ND4J_EXPORT void cnpy::npy_save<float>(std::string fname, const float* data, const unsigned int* shape, const unsigned int ndims, std::string mode);
+
+
+/**
+ * Map the whole file
+ * @param fname the fully qualified path for the file
+ * @param prefetch
+ */
+cnpy::MappedFile::MappedFile(const std::string &fname, bool prefetch) {
+#ifndef _WIN32
+    int fd = open(fname.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("MappedFile: unable to open file " + fname);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        throw std::runtime_error("MappedFile: unable to get size of file " + fname);
+    }
+
+    _length = static_cast<size_t>(st.st_size);
+
+    // private writable mapping: writes go to anonymous copies of pages, never to the file
+    void *ptr = mmap(nullptr, _length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+    // mapping stays valid after descriptor is closed
+    ::close(fd);
+
+    if (ptr == MAP_FAILED)
+        throw std::runtime_error("MappedFile: mmap failed for file " + fname);
+
+    _data = reinterpret_cast<char *>(ptr);
+    _mapped = true;
+
+    if (prefetch)
+        this->prefetch(0, _length);
+#else
+    FILE *fp = fopen(fname.c_str(), "rb");
+    if (!fp)
+        throw std::runtime_error("MappedFile: unable to open file " + fname);
+
+    _fseeki64(fp, 0, SEEK_END);
+    _length = static_cast<size_t>(_ftelli64(fp));
+    _fseeki64(fp, 0, SEEK_SET);
+
+    _data = new char[_length];
+    size_t res = fread(_data, sizeof(char), _length, fp);
+    fclose(fp);
+
+    if (res != _length)
+        throw std::runtime_error("MappedFile: failed fread for file " + fname);
+#endif
+}
+
+cnpy::MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (_mapped)
+        munmap(_data, _length);
+#else
+    delete[] _data;
+#endif
+}
+
+void cnpy::MappedFile::prefetch(size_t offset, size_t length) const {
+#ifndef _WIN32
+    if (!_mapped || offset >= _length)
+        return;
+
+    // madvise wants page-aligned address
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t start = offset - offset % page;
+    const size_t stop = std::min(offset + length, _length);
+
+    madvise(_data + start, stop - start, MADV_WILLNEED);
+#endif
+}
+
+// zip and npy headers are little-endian, so is every platform we build for
+template <typename T>
+static FORCEINLINE T readLE(const char *ptr) {
+    T result;
+    memcpy(&result, ptr, sizeof(T));
+    return result;
+}
+
+// true if size bytes starting at offset fit into length bytes, written so that nothing can overflow
+static FORCEINLINE bool fitsInto(uint64_t offset, uint64_t size, uint64_t length) {
+    return offset <= length && size <= length - offset;
+}
+
+/**
+ * Parse the numpy array which starts at given offset of the mapping.
+ * Header length is taken from preamble, so parsing never runs past the header,
+ * and data is checked to fit into available bytes
+ */
+static cnpy::NpyArray parseMappedNpy(const std::shared_ptr<cnpy::MappedFile> &mapping, size_t offset, size_t available, const std::string &fname) {
+    const char *start = mapping->data() + offset;
+    if (available < 10 || static_cast<unsigned char>(start[0]) != 0x93 || memcmp(start + 1, "NUMPY", 5) != 0)
+        throw std::runtime_error("npy_map: not a numpy array: " + fname);
+
+    // version 1.0 stores header length as uint16, versions 2.0 and 3.0 as uint32
+    const int major = start[6];
+    size_t preamble = major == 1 ? 10 : 12;
+    if (available < preamble)
+        throw std::runtime_error("npy_map: truncated header: " + fname);
+
+    size_t headerLength = major == 1 ? readLE<uint16_t>(start + 8) : readLE<uint32_t>(start + 8);
+    if (preamble + headerLength > available)
+        throw std::runtime_error("npy_map: truncated header: " + fname);
+
+    std::string header(start + preamble, headerLength);
+
+    cnpy::NpyArray arr;
+    arr.mapping = mapping;
+
+    auto loc = header.find("fortran_order");
+    if (loc == std::string::npos || (loc = header.find(':', loc)) == std::string::npos)
+        throw std::runtime_error("npy_map: fortran_order is missing: " + fname);
+    loc = header.find_first_not_of(' ', loc + 1);
+    arr.fortranOrder = loc != std::string::npos && header.compare(loc, 4, "True") == 0;
+
+    // descr is like '<f4': byte order, type code, word size
+    loc = header.find("descr");
+    if (loc == std::string::npos || (loc = header.find(':', loc)) == std::string::npos || (loc = header.find('\'', loc)) == std::string::npos || loc + 3 >= header.size())
+        throw std::runtime_error("npy_map: descr is missing: " + fname);
+    loc++;
+    if (header[loc] == '>')
+        throw std::runtime_error("npy_map: big-endian arrays can't be mapped: " + fname);
+    arr.type = header[loc + 1];
+    arr.wordSize = atoi(header.c_str() + loc + 2);
+    if (arr.wordSize == 0)
+        throw std::runtime_error("npy_map: bad descr: " + fname);
+
+    // shape is like (), (5,) or (2, 3)
+    auto open = header.find("shape");
+    if (open != std::string::npos)
+        open = header.find('(', open);
+    auto close = open == std::string::npos ? std::string::npos : header.find(')', open);
+    if (close == std::string::npos)
+        throw std::runtime_error("npy_map: shape is missing: " + fname);
+
+    std::string shape = header.substr(open + 1, close - open - 1);
+    size_t pos = 0;
+    while (pos < shape.size()) {
+        auto next = shape.find(',', pos);
+        if (next == std::string::npos)
+            next = shape.size();
+
+        auto dim = shape.substr(pos, next - pos);
+        if (dim.find_first_not_of(' ') != std::string::npos)
+            arr.shape.push_back(static_cast<unsigned int>(strtoul(dim.c_str(), nullptr, 10)));
+
+        pos = next + 1;
+    }
+
+    // number of bytes is checked against available ones at every step, so huge shapes can't overflow it
+    const size_t dataOffset = preamble + headerLength;
+    const uint64_t limit = available - dataOffset;
+    uint64_t bytes = arr.wordSize;
+    for (auto dim: arr.shape) {
+        if (dim != 0 && bytes > limit / dim)
+            throw std::runtime_error("npy_map: data is truncated: " + fname);
+
+        bytes *= dim;
+    }
+
+    if (bytes > limit)
+        throw std::runtime_error("npy_map: data is truncated: " + fname);
+
+    arr.data = const_cast<char *>(start) + dataOffset;
+    return arr;
+}
+
+/**
+ * Map a numpy array from the given file
+ * @param fname the fully qualified path for the file
+ * @param prefetch
+ * @return the NpArray viewing mapped file
+ */
+cnpy::NpyArray cnpy::npyMap(std::string fname, bool prefetch) {
+    auto mapping = std::make_shared<cnpy::MappedFile>(fname, prefetch);
+    return parseMappedNpy(mapping, 0, mapping->length(), fname);
+}
+
+/**
+ * Map the numpy z archive. Members are located via central directory, with zip64 extensions,
+ * so both large archives and archives written with data descriptors are handled
+ * @param fname the fully qualified path
+ * @param prefetch
+ * @return the arrays
+ */
+cnpy::npz_t cnpy::npzMap(std::string fname, bool prefetch) {
+    auto mapping = std::make_shared<cnpy::MappedFile>(fname, false);
+    const char *base = mapping->data();
+    const size_t length = mapping->length();
+
+    // end of central directory record is the last thing in the file, followed by comment of up to 64K
+    if (length < 22)
+        throw std::runtime_error("npz_map: not a zip archive: " + fname);
+
+    size_t eocd = length - 22;
+    const size_t lowest = length > 22 + 65535 ? length - 22 - 65535 : 0;
+    while (readLE<uint32_t>(base + eocd) != 0x06054b50) {
+        if (eocd == lowest)
+            throw std::runtime_error("npz_map: end of central directory is missing: " + fname);
+        eocd--;
+    }
+
+    uint64_t numRecords = readLE<uint16_t>(base + eocd + 10);
+    uint64_t cdOffset = readLE<uint32_t>(base + eocd + 16);
+
+    // zip64 end of central directory locator precedes classic record
+    if (eocd >= 20 && readLE<uint32_t>(base + eocd - 20) == 0x07064b50) {
+        auto zip64 = readLE<uint64_t>(base + eocd - 20 + 8);
+        if (!fitsInto(zip64, 56, length) || readLE<uint32_t>(base + zip64) != 0x06064b50)
+            throw std::runtime_error("npz_map: broken zip64 end of central directory: " + fname);
+
+        numRecords = readLE<uint64_t>(base + zip64 + 32);
+        cdOffset = readLE<uint64_t>(base + zip64 + 48);
+    }
+
+    cnpy::npz_t arrays;
+    uint64_t cursor = cdOffset;
+    for (uint64_t r = 0; r < numRecords; r++) {
+        if (!fitsInto(cursor, 46, length) || readLE<uint32_t>(base + cursor) != 0x02014b50)
+            throw std::runtime_error("npz_map: broken central directory: " + fname);
+
+        const char *record = base + cursor;
+        auto compression = readLE<uint16_t>(record + 10);
+        uint64_t compressedSize = readLE<uint32_t>(record + 20);
+        uint64_t uncompressedSize = readLE<uint32_t>(record + 24);
+        auto nameLength = readLE<uint16_t>(record + 28);
+        auto extraLength = readLE<uint16_t>(record + 30);
+        auto commentLength = readLE<uint16_t>(record + 32);
+        uint64_t localOffset = readLE<uint32_t>(record + 42);
+
+        const uint64_t recordLength = 46ULL + nameLength + extraLength + commentLength;
+        if (!fitsInto(cursor, recordLength, length))
+            throw std::runtime_error("npz_map: broken central directory: " + fname);
+
+        std::string varname(record + 46, nameLength);
+
+        // zip64 extra field holds only those values, which are saturated in the record itself
+        const char *extra = record + 46 + nameLength;
+        for (size_t e = 0; e + 4 <= extraLength; ) {
+            auto id = readLE<uint16_t>(extra + e);
+            auto size = readLE<uint16_t>(extra + e + 2);
+            if (!fitsInto(e + 4, size, extraLength))
+                throw std::runtime_error("npz_map: broken extra field of member " + varname + ": " + fname);
+
+            if (id == 0x0001) {
+                size_t field = 0;
+                auto next = [&] () -> uint64_t {
+                    if (!fitsInto(field, 8, size))
+                        throw std::runtime_error("npz_map: broken zip64 field of member " + varname + ": " + fname);
+
+                    auto value = readLE<uint64_t>(extra + e + 4 + field);
+                    field += 8;
+                    return value;
+                };
+
+                if (uncompressedSize == 0xFFFFFFFFULL)
+                    uncompressedSize = next();
+
+                if (compressedSize == 0xFFFFFFFFULL)
+                    compressedSize = next();
+
+                if (localOffset == 0xFFFFFFFFULL)
+                    localOffset = next();
+            }
+
+            e += 4 + size;
+        }
+
+        if (compression != 0)
+            throw std::runtime_error("npz_map: compressed member " + varname + " can't be mapped: " + fname);
+
+        if (!fitsInto(localOffset, 30, length) || readLE<uint32_t>(base + localOffset) != 0x04034b50)
+            throw std::runtime_error("npz_map: broken local header of member " + varname + ": " + fname);
+
+        // local header may have its own extra field, different from the one in central directory
+        const uint64_t dataOffset = localOffset + 30 + readLE<uint16_t>(base + localOffset + 26) + readLE<uint16_t>(base + localOffset + 28);
+        if (!fitsInto(dataOffset, uncompressedSize, length))
+            throw std::runtime_error("npz_map: member " + varname + " is truncated: " + fname);
+
+        //erase the lagging .npy
+        if (varname.size() > 4 && varname.compare(varname.size() - 4, 4, ".npy") == 0)
+            varname.erase(varname.end() - 4, varname.end());
+
+        auto arr = parseMappedNpy(mapping, static_cast<size_t>(dataOffset), static_cast<size_t>(uncompressedSize), fname);
+
+        if (prefetch)
+            mapping->prefetch(static_cast<size_t>(arr.data - base), static_cast<size_t>(uncompressedSize) - static_cast<size_t>(arr.data - base - dataOffset));
+
+        arrays[varname] = arr;
+        cursor += recordLength;
+    }
+
+    return arrays;
+}
+
+cnpy::NpyWriter::NpyWriter(const std::string &fname, char type, unsigned int wordSize, const std::vector<unsigned int> &shape, bool fortranOrder) : _fname(fname) {
+    std::string dict = "{'descr': '";
+    dict += type == 'b' || wordSize == 1 ? '|' : BigEndianTest();
+    dict += type;
+    dict += tostring(wordSize);
+    dict += "', 'fortran_order': ";
+    dict += fortranOrder ? "True" : "False";
+    dict += ", 'shape': (";
+
+    _expected = wordSize;
+    for (size_t i = 0; i < shape.size(); i++) {
+        if (i > 0)
+            dict += ", ";
+        dict += tostring(shape[i]);
+        _expected *= shape[i];
+    }
+
+    if (shape.size() == 1)
+        dict += ",";
+    dict += "), }";
+
+    // preamble + dict is padded with spaces up to multiple of 64 bytes, so data stays aligned. dict ends with \n
+    const size_t preamble = 10;
+    dict.append(64 - (preamble + dict.size() + 1) % 64, ' ');
+    dict += '\n';
+
+    if (dict.size() > 65535)
+        throw std::runtime_error("npy_writer: header is too long for " + fname);
+
+    _fp = fopen(fname.c_str(), "wb");
+    if (!_fp)
+        throw std::runtime_error("npy_writer: unable to open file " + fname);
+
+    const unsigned char magic[] = {0x93, 'N', 'U', 'M', 'P', 'Y', 0x01, 0x00};
+    const uint16_t headerLength = static_cast<uint16_t>(dict.size());
+    const unsigned char length[] = {static_cast<unsigned char>(headerLength & 0xFF), static_cast<unsigned char>(headerLength >> 8)};
+
+    fwrite(magic, sizeof(char), sizeof(magic), _fp);
+    fwrite(length, sizeof(char), sizeof(length), _fp);
+    fwrite(dict.data(), sizeof(char), dict.size(), _fp);
+}
+
+cnpy::NpyWriter::~NpyWriter() {
+    if (_fp)
+        fclose(_fp);
+}
+
+void cnpy::NpyWriter::write(const void *data, size_t numBytes) {
+    if (!_fp)
+        throw std::runtime_error("npy_writer: file is already closed: " + _fname);
+
+    if (_written + numBytes > _expected)
+        throw std::runtime_error("npy_writer: data exceeds array shape: " + _fname);
+
+    if (fwrite(data, sizeof(char), numBytes, _fp) != numBytes)
+        throw std::runtime_error("npy_writer: failed fwrite: " + _fname);
+
+    _written += numBytes;
+}
+
+void cnpy::NpyWriter::close() {
+    if (!_fp)
+        return;
+
+    auto res = fclose(_fp);
+    _fp = nullptr;
+
+    if (res != 0)
+        throw std::runtime_error("npy_writer: failed fclose: " + _fname);
+
+    if (_written != _expected)
+        throw std::runtime_error("npy_writer: data doesn't match array shape: " + _fname);
+}
@@ -41,6 +41,7 @@
 #include <string>
 #include <fstream>
 #include <streambuf>
+#include <memory>
 #include <op_boilerplate.h>
 #include <dll.h>
 
@@ -48,6 +49,34 @@
 
 namespace cnpy {
 
+    /**
+     * Read-only mapping of the whole file. Pages are mapped copy-on-write, so arrays viewing them
+     * may still be modified in memory, without touching the file itself.
+     * Where mmap isn't available, file is read into memory instead
+     */
+    class ND4J_EXPORT MappedFile {
+    public:
+        /**
+         * @param prefetch - if true, kernel is asked to read the whole file ahead, otherwise pages are read in lazily
+         */
+        explicit MappedFile(const std::string &fname, bool prefetch = false);
+        ~MappedFile();
+
+        char* data() const { return _data; }
+        size_t length() const { return _length; }
+
+        // hints kernel that given range will be needed soon
+        void prefetch(size_t offset, size_t length) const;
+
+    private:
+        char *_data = nullptr;
+        size_t _length = 0;
+        bool _mapped = false;
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+    };
+
     /**
      * The numpy array
      */
@@ -56,8 +85,18 @@ namespace cnpy {
         std::vector<unsigned int> shape;
         unsigned int wordSize;
         bool fortranOrder;
+
+        // numpy type code, i.e. 'f', 'i', 'u' or 'b'. only known for mapped arrays
+        char type = '?';
+
+        // if set, data points into this mapping instead of owned buffer
+        std::shared_ptr<MappedFile> mapping;
+
         void destruct() {
-            delete[] data;
+            if (mapping)
+                mapping.reset();
+            else
+                delete[] data;
         }
     };
 
@@ -263,6 +302,52 @@ namespace cnpy {
     template<typename T>
     void npy_save(std::string fname, const T* data, const unsigned int* shape, const unsigned int ndims, std::string mode = "w");
 
+    /**
+     * Map the numpy array stored in given file, without reading or copying its data.
+     * Returned array keeps the mapping alive, and so does every copy of it
+     * @param fname the fully qualified path for the file
+     * @param prefetch if true, data pages are read ahead instead of on first access
+     */
+    ND4J_EXPORT NpyArray npyMap(std::string fname, bool prefetch = false);
+
+    /**
+     * Map all arrays of the numpy z archive, without reading or copying their data.
+     * Members must be stored without compression, i.e. written by numpy.savez, not savez_compressed.
+     * All arrays share single mapping of the file
+     * @param fname the fully qualified path for the file
+     * @param prefetch if true, data pages are read ahead instead of on first access
+     */
+    ND4J_EXPORT npz_t npzMap(std::string fname, bool prefetch = false);
+
+    /**
+     * Streaming writer of .npy files: header is written once, then data is appended in chunks of any size,
+     * so arrays don't have to be materialized in memory as a whole
+     */
+    class ND4J_EXPORT NpyWriter {
+    public:
+        /**
+         * @param type numpy type code, i.e. 'f', 'i', 'u' or 'b'
+         * @param wordSize size of single element in bytes
+         */
+        NpyWriter(const std::string &fname, char type, unsigned int wordSize, const std::vector<unsigned int> &shape, bool fortranOrder = false);
+        ~NpyWriter();
+
+        // appends given bytes to array data
+        void write(const void *data, size_t numBytes);
+
+        // flushes and closes file, throws if number of bytes written doesn't match shape
+        void close();
+
+    private:
+        FILE *_fp = nullptr;
+        std::string _fname;
+        size_t _expected = 0;
+        size_t _written = 0;
+
+        NpyWriter(const NpyWriter&) = delete;
+        NpyWriter& operator=(const NpyWriter&) = delete;
+    };
+
 }
 
 /**
@@ -25,6 +25,7 @@
 #include <graph/Variable.h>
 #include <graph/VariableSpace.h>
 #include <graph/ContextPrototype.h>
+#include <graph/ShapeMemo.h>
 #include <memory/Workspace.h>
 
 #ifdef HAVE_MKLDNN
@@ -57,6 +58,9 @@ namespace nd4j {
             // branch for divergent_op
             int _branch = 0;
 
+            // output shapes of this node remembered between executions, if any
+            ShapeMemo* _shapeMemo = nullptr;
+
             std::vector<nd4j::DataType> _dataTypes;
 #ifdef HAVE_MKLDNN
             std::vector<nd4j::MKLDNNStream> _mkldnnStreams;
@@ -118,6 +122,9 @@ namespace nd4j {
             int getBranch();
             void setBranch(int branch);
 
+            void setShapeMemo(ShapeMemo* memo);
+            ShapeMemo* shapeMemo();
+
 #ifdef HAVE_MKLDNN
             std::vector<nd4j::MKLDNNStream>& getMKLDNNStreams() { return _mkldnnStreams; }
 #endif
@@ -49,6 +49,12 @@ namespace nd4j {
             Nd4jLong innerTime(int nodeId);
             Nd4jLong outerTime(int nodeId);
 
+            // this method pre-registers NodeState, so later concurrent access won't modify internal map
+            void registerNode(int nodeId);
+
+            // this method forgets all node and frame states, so FlowPath can be reused for next run
+            void reset();
+
             bool isNodeActive(int nodeId);
             void markNodeActive(int nodeId, bool isActive);
 
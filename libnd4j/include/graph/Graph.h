@@ -79,6 +79,12 @@ namespace nd4j {
 
             void prepareOutputs();
 
+            /**
+             * This method collapses chains of elementwise legacy ops into single fused nodes.
+             * Intermediate node is fused only if its output is consumed by next node of the chain and by nothing else
+             */
+            void fuseElementwise();
+
         public:
             Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr);
 
@@ -21,10 +21,16 @@
 #include <helpers/logger.h>
 #include <pointercast.h>
 #include <map>
+#include <vector>
+#include <mutex>
 #include <graph/Graph.h>
+#include <graph/GraphSession.h>
 #include <helpers/SimpleReadWriteLock.h>
 #include <graph/exceptions/unknown_graph_exception.h>
 
+// max number of idle sessions kept per graph, sessions returned beyond that are released
+#define GRAPH_HOLDER_MAX_IDLE_SESSIONS 16
+
 namespace nd4j {
     namespace graph {
         class ND4J_EXPORT GraphHolder {
@@ -34,8 +40,14 @@ namespace nd4j {
 
             std::map<Nd4jLong, SimpleReadWriteLock> _locks;
 
+            // idle execution sessions, per graph
+            std::map<Nd4jLong, std::vector<GraphSession *>> _sessions;
+            std::mutex _sessionsLock;
+
             GraphHolder() = default;
             ~GraphHolder() = default;
+
+            void dropSessions(Nd4jLong graphId);
         public:
             static GraphHolder* getInstance();
 
@@ -59,6 +71,22 @@ namespace nd4j {
 
             void replaceGraph(Nd4jLong graphId, Graph *graph);
 
+            /**
+             * This method returns idle execution session for given graph, or creates new one if all sessions are busy.
+             * Session must be returned back via releaseSession() once execution is finished.
+             *
+             * PLEASE NOTE: caller is expected to hold read lock for this graph while session is checked out
+             */
+            GraphSession* checkoutSession(Nd4jLong graphId);
+
+            /**
+             * This method returns given session back to the pool, or releases it if pool is full already
+             */
+            void releaseSession(Nd4jLong graphId, GraphSession *session);
+
+            // number of idle sessions pooled for given graph
+            int idleSessions(Nd4jLong graphId);
+
             /////////////////////////////
 
             FORCEINLINE void lockWrite(Nd4jLong graphId) {
@@ -89,5 +117,31 @@ namespace nd4j {
                 _locks[graphId].unlockRead();
             }
         };
+
+        /**
+         * Scoped session checkout: read lock of the graph and the session are held until the end of scope.
+         * Session goes back to the pool only via release(), otherwise its state is unknown (i.e. exception was thrown),
+         * and it's deleted.
+         */
+        class ND4J_EXPORT GraphSessionGuard {
+        private:
+            GraphHolder *_holder;
+            Nd4jLong _graphId;
+            GraphSession *_session = nullptr;
+
+        public:
+            GraphSessionGuard(GraphHolder *holder, Nd4jLong graphId);
+            ~GraphSessionGuard();
+
+            GraphSession* session() const {
+                return _session;
+            }
+
+            // resets session and returns it to the pool
+            void release();
+
+            GraphSessionGuard(const GraphSessionGuard&) = delete;
+            GraphSessionGuard& operator=(const GraphSessionGuard&) = delete;
+        };
     }
 }
\ No newline at end of file
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+//  @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_GRAPHSESSION_H
+#define LIBND4J_GRAPHSESSION_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <graph/Graph.h>
+#include <graph/FlowPath.h>
+#include <graph/MemoryPlan.h>
+#include <graph/Variable.h>
+#include <dll.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class holds pre-built execution state for one stored Graph: proxied VariableSpace (with its own Workspace),
+         * cloned nodes and FlowPath. Session is reused across inference requests, so activations allocated during first run
+         * are reused by subsequent runs, as long as input shapes stay the same.
+         *
+         * PLEASE NOTE: session isn't thread-safe, it's supposed to be used by one thread at a time via GraphHolder::checkoutSession()
+         */
+        class ND4J_EXPORT GraphSession {
+        private:
+            Graph *_origin;
+            Graph *_graph = nullptr;
+            FlowPath *_flowPath = nullptr;
+
+            // built after first successful run, valid as long as input shapes stay the same
+            MemoryPlan *_plan = nullptr;
+            bool _planned = false;
+
+            // inputs fed so far, mapped by name or by "id:index"
+            std::map<std::string, Variable*> _inputs;
+
+            void build();
+            void destroy();
+            void rebuild();
+            void plan();
+
+            static std::string keyOf(Variable *variable);
+        public:
+            explicit GraphSession(Graph *origin);
+            ~GraphSession();
+
+            /**
+             * This method puts given inputs into session VariableSpace. Inputs of known shape are copied into existing arrays,
+             * if shape or data type of any known input changes - session state is rebuilt from scratch.
+             *
+             * PLEASE NOTE: given Variables are consumed and deleted by this method
+             */
+            void feed(std::vector<Variable*> &inputs);
+
+            /**
+             * This method prepares session for next run. Arrays stay in place,
+             * node outputs are reallocated on next run only if their shape changes (i.e. unique, where, boolean_mask).
+             *
+             * After first run, sizes of intermediate arrays are known, so MemoryPlan is built and session is rebuilt with it:
+             * all subsequent runs place intermediate arrays within single arena, at precomputed offsets.
+             */
+            void reset();
+
+            Graph* graph();
+
+            Graph* origin();
+
+            MemoryPlan* memoryPlan();
+        };
+    }
+}
+
+#endif //LIBND4J_GRAPHSESSION_H
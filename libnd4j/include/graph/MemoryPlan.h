@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+//  @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_MEMORYPLAN_H
+#define LIBND4J_MEMORYPLAN_H
+
+#include <map>
+#include <vector>
+#include <pointercast.h>
+#include <NDArray.h>
+#include <memory/Workspace.h>
+#include <dll.h>
+
+// every planned buffer starts at this alignment within arena
+#define PLAN_ALIGNMENT 64
+
+namespace nd4j {
+    namespace graph {
+        class Graph;
+
+        /**
+         * This class holds static placement of intermediate graph arrays within single memory arena.
+         *
+         * Lifetime of each array spans from its producer node to the last of its consumers. Two arrays may share memory
+         * only if all users of one of them are guaranteed to finish before the producer of the other one starts,
+         * which holds for both sequential and dataflow execution. Offsets are assigned greedily, largest arrays first,
+         * each into the lowest gap not used by arrays with overlapping lifetimes.
+         *
+         * Graph outputs, external variables and outputs aliasing other arrays (inplace ops, views) are never planned.
+         */
+        class ND4J_EXPORT MemoryPlan {
+        private:
+            std::map<std::pair<int, int>, Nd4jLong> _offsets;
+            std::map<std::pair<int, int>, Nd4jLong> _sizes;
+
+            Nd4jLong _arenaSize = 0;
+            Nd4jLong _totalSize = 0;
+
+            int8_t *_buffer = nullptr;
+            int8_t *_arena = nullptr;
+
+            void plan(Graph *graph, std::map<std::pair<int, int>, Nd4jLong> &sizes);
+        public:
+            /**
+             * @param graph built Graph
+             * @param sizes number of bytes required for each node output that should be planned
+             */
+            MemoryPlan(Graph *graph, std::map<std::pair<int, int>, Nd4jLong> &sizes);
+            ~MemoryPlan();
+
+            /**
+             * This method collects sizes of node outputs from the VariableSpace of Graph, which was executed at least once.
+             * Outputs sharing memory with any other array are skipped, since their lifetimes are unknown to planner.
+             */
+            static std::map<std::pair<int, int>, Nd4jLong> measure(Graph *graph);
+
+            bool hasOffset(std::pair<int, int> &pair);
+            Nd4jLong offset(std::pair<int, int> &pair);
+
+            /**
+             * This method returns new zero-filled NDArray placed within arena, or nullptr if given output wasn't planned
+             * or doesn't fit into planned space
+             */
+            NDArray* allocate(std::pair<int, int> &pair, Nd4jLong *shapeInfo, nd4j::memory::Workspace *workspace);
+
+            // size of arena, in bytes
+            Nd4jLong arenaSize();
+
+            // total size of all planned arrays, as if each of them had its own buffer
+            Nd4jLong totalSize();
+
+            int numberOfPlanned();
+        };
+    }
+}
+
+#endif //LIBND4J_MEMORYPLAN_H
@@ -26,6 +26,7 @@
 #include <string>
 #include <NDArray.h>
 #include "Context.h"
+#include <graph/ShapeMemo.h>
 #include <ops/declarable/DeclarableOp.h>
 #include <graph/generated/node_generated.h>
 
@@ -92,6 +93,9 @@ namespace nd4j {
 
             Nd4jLong _frameId = -1;
 
+            // output shapes calculated during previous execution
+            ShapeMemo _shapeMemo;
+
         public:
             Node(nd4j::ops::DeclarableOp *customOp, int id = 0, std::initializer_list<int> input = {}, std::initializer_list<int> output = {},  std::initializer_list<int> dimensions = {}, float scalar = 0.0f, std::initializer_list<double> tArgs = {}, std::initializer_list<int> iArgs = {});
             Node(OpType opType = OpType_TRANSFORM_SAME, int opNum = 0, int id = 0, std::initializer_list<int> input = {}, std::initializer_list<int> output = {},  std::initializer_list<int> dimensions = {}, float scalar = 0.0f, std::initializer_list<double> tArgs = {}, std::initializer_list<int> iArgs = {});
@@ -165,6 +169,8 @@ namespace nd4j {
             ContextPrototype* getContextPrototype();
             bool hasBlockAttached();
 
+            ShapeMemo* shapeMemo();
+
             void setCustomOp(nd4j::ops::DeclarableOp *customOp = nullptr);
             nd4j::ops::DeclarableOp* getCustomOp();
             bool hasCustomOp();
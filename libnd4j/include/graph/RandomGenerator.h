@@ -116,6 +116,14 @@ namespace nd4j {
 
             FORCEINLINE _CUDA_HD void rewindH(Nd4jLong steps);
 
+            /**
+             * This method writes 4 random uint32 values for given (counter, stream) pair into out, using Philox4x32-10
+             * keyed by current root and node states. Unlike relativeT(), every counter yields independent block of bits,
+             * so bulk generators can fill whole simd lanes, in any order and from any number of threads.
+             * See helpers/RandomFill.h
+             */
+            FORCEINLINE _CUDA_HD void philox(uint64_t counter, uint64_t stream, uint32_t *out);
+
             /**
              * These methods set up only node states, with non-changed root ones
              */
@@ -254,6 +262,40 @@ namespace nd4j {
             return s0 + s1;
         }
 
+        _CUDA_HD FORCEINLINE void RandomGenerator::philox(uint64_t counter, uint64_t stream, uint32_t *out) {
+            // both states are folded into 64-bit key via splitmix64 finalizer, so similar seeds give unrelated keys
+            uint64_t key = (_rootState._ulong ^ (_nodeState._ulong * 0x9E3779B97F4A7C15ULL)) + 0x9E3779B97F4A7C15ULL;
+            key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+            key ^= key >> 31;
+
+            uint32_t k0 = static_cast<uint32_t>(key);
+            uint32_t k1 = static_cast<uint32_t>(key >> 32);
+
+            uint32_t c0 = static_cast<uint32_t>(counter);
+            uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+            uint32_t c2 = static_cast<uint32_t>(stream);
+            uint32_t c3 = static_cast<uint32_t>(stream >> 32);
+
+            for (int r = 0; r < 10; r++) {
+                uint64_t p0 = static_cast<uint64_t>(0xD2511F53U) * c0;
+                uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57U) * c2;
+
+                c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+                c1 = static_cast<uint32_t>(p1);
+                c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+                c3 = static_cast<uint32_t>(p0);
+
+                k0 += 0x9E3779B9U;
+                k1 += 0xBB67AE85U;
+            }
+
+            out[0] = c0;
+            out[1] = c1;
+            out[2] = c2;
+            out[3] = c3;
+        }
+
         _CUDA_HD FORCEINLINE void RandomGenerator::rewindH(Nd4jLong steps) {
             auto s0 = _nodeState._du32._v0;
             auto s1 = _nodeState._du32._v1;
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+//  @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_SHAPEMEMO_H
+#define LIBND4J_SHAPEMEMO_H
+
+#include <vector>
+#include <string>
+#include <pointercast.h>
+#include <array/ShapeList.h>
+#include <dll.h>
+
+// inputs up to this length are treated as potential shape arguments, and their values become part of the key
+#define SHAPE_MEMO_VALUES 64
+
+namespace nd4j {
+    namespace graph {
+        class Context;
+
+        /**
+         * This class remembers output shapes calculated for one Node during previous execution.
+         *
+         * Key consists of input shapeInfos, values of small inputs and i/t/b arguments, so as long as they stay the same,
+         * shape function isn't called again. Each Node has its own memo, so if input shapes change, only nodes affected by
+         * the change get their shapes recalculated.
+         *
+         * Only ops that declare their output shapes to depend on input shapes, arguments and values of small inputs
+         * are memoized, since values of larger inputs aren't part of the key.
+         */
+        class ND4J_EXPORT ShapeMemo {
+        private:
+            std::vector<Nd4jLong> _key;
+            std::vector<Nd4jLong> _candidate;
+            bool _hasCandidate = false;
+
+            // interned shapeInfos, see ConstantShapeHelper
+            std::vector<Nd4jLong*> _pointers;
+
+            Nd4jLong _hits = 0;
+            Nd4jLong _misses = 0;
+
+            bool buildKey(Context &ctx, ShapeList &inputShapes);
+        public:
+            ShapeMemo() = default;
+            ~ShapeMemo() = default;
+
+            /**
+             * This method returns true if output shapes for given inputs are known already.
+             * @param memoizable false for ops that didn't declare their shapes memoizable, see OpDescriptor::isShapeMemoizable()
+             */
+            bool match(bool memoizable, Context &ctx, ShapeList &inputShapes);
+
+            /**
+             * This method returns remembered output shapes, shapeInfos are interned and never released
+             */
+            std::vector<Nd4jLong*>* shapes();
+
+            /**
+             * This method stores output shapes for inputs given to the last unsuccessful match() call
+             */
+            void update(ShapeList &outputShapes);
+
+            void invalidate();
+
+            Nd4jLong hits();
+            Nd4jLong misses();
+        };
+    }
+}
+
+#endif //LIBND4J_SHAPEMEMO_H
@@ -85,6 +85,9 @@ namespace nd4j {
             virtual nd4j::graph::Stash* getStash();
             virtual void setFlowPath(FlowPath* timers);
             virtual FlowPath* flowPath();
+
+            virtual void setMemoryPlan(MemoryPlan* plan);
+            virtual MemoryPlan* memoryPlan();
         };
     }
 }
\ No newline at end of file
@@ -28,12 +28,14 @@
 #include <list>
 #include <map>
 #include <mutex>
+#include <helpers/SimpleReadWriteLock.h>
 #include <NDArray.h>
 #include <array/NDArrayList.h>
 #include <graph/Variable.h>
 #include <memory/Workspace.h>
 #include <graph/Stash.h>
 #include <graph/FlowPath.h>
+#include <graph/MemoryPlan.h>
 
 
 namespace nd4j {
@@ -57,17 +59,23 @@ namespace nd4j {
 
             std::vector<nd4j::graph::Variable*> _placeholders;
 
+            // methods below expect _varmap to be held by caller
             void silentPutVariable(std::pair<int,int>& pair, Variable *variable);
+            void putVariableUnsafe(int id, Variable *variable);
+            bool hasVariableUnsafe(int id);
+            Variable* getVariableUnsafe(int id);
 
             int _auto_counter = -1;
 
-            std::mutex _varmap;
+            // guards variable maps, since nodes might be executed concurrently. lookups vastly outnumber puts, so readers don't block each other
+            SimpleReadWriteLock _varmap;
 
             std::map<int, nd4j::graph::Variable*> _temporary;
 
             std::vector<nd4j::graph::Variable*> *_handles;
 
             FlowPath* _flow = nullptr;
+            MemoryPlan* _plan = nullptr;
 
         public:
             VariableSpace();
@@ -138,6 +146,10 @@ namespace nd4j {
 
             virtual void setFlowPath(FlowPath* timers);
             virtual FlowPath* flowPath();
+
+            // if plan is set, outputs of nodes are placed within its arena. VariableSpace doesn't own the plan
+            virtual void setMemoryPlan(MemoryPlan* plan);
+            virtual MemoryPlan* memoryPlan();
         };
     }
 }
@@ -100,6 +100,8 @@ namespace nd4j {
             this->_tArgs.clear();
             this->_inputs.clear();
 #ifdef HAVE_MKLDNN
+            // built primitives outlive this context, so the next call with the same shapes doesn't rebuild them
+            nd4j::MKLDNNStream::release(this->_mkldnnStreams);
             this->_mkldnnStreams.clear();
 #endif
         }
@@ -127,6 +129,14 @@ namespace nd4j {
             return _variableSpace;
         }
 
+        void Context::setShapeMemo(ShapeMemo* memo) {
+            _shapeMemo = memo;
+        }
+
+        ShapeMemo* Context::shapeMemo() {
+            return _shapeMemo;
+        }
+
         nd4j::memory::Workspace* Context::getWorkspace() {
             return _workspace;
         }
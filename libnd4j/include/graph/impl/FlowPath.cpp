@@ -61,6 +61,15 @@ namespace nd4j {
             return _states[nodeId].outerTime();
         }
 
+        void FlowPath::registerNode(int nodeId) {
+            ensureNode(nodeId);
+        }
+
+        void FlowPath::reset() {
+            _states.clear();
+            _frames.clear();
+        }
+
         bool FlowPath::isNodeActive(int nodeId) {
             ensureNode(nodeId);
 
@@ -26,6 +26,7 @@
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/OpRegistrator.h>
 #include <graph/VariableProxy.h>
+#include <ops/declarable/LegacyMetaOp.h>
 #include <graph/exceptions/graph_exception.h>
 #include <graph/exceptions/unresolved_input_exception.h>
 #include <graph/exceptions/unresolved_output_exception.h>
@@ -699,11 +700,149 @@ namespace nd4j {
             if (_unmapped.size() == 0)
                 _built.store(true);
 
+            if (_built.load() && Environment::getInstance()->isGraphFusion())
+                fuseElementwise();
+
             prepareOutputs();
 
             return nd4j::Status::OK();
         }
 
+        void Graph::fuseElementwise() {
+            // scopes, logic ops and embedded graphs depend on exact node ids, so such graphs are left as is
+            // if all variables are dumped out, intermediate results must be kept as well
+            if (!_scopes.empty() || _configuration->_outputMode == OutputMode_VARIABLE_SPACE)
+                return;
+
+            for (auto &v: *_mapped) {
+                auto node = v.second;
+                if (node->opType() == OpType_LOGIC || node->hasGraphEmbedded() || node->isScoped())
+                    return;
+            }
+
+            auto fusable = [&] (Node *node) -> bool {
+                if (!node->hasCustomOp() || !node->isDeductable() || node->getContextPrototype()->isInplace())
+                    return false;
+
+                if (!nd4j::ops::LegacyMetaOp::isFusable(node->opType(), (int) node->opNum()))
+                    return false;
+
+                auto numInputs = node->input()->size();
+                switch (node->opType()) {
+                    case OpType_SCALAR:
+                        return numInputs == 1 || numInputs == 2;
+                    case OpType_PAIRWISE:
+                        return numInputs == 2;
+                    case OpType_BROADCAST:
+                        return numInputs == 2 && !node->getContextPrototype()->getAxis()->empty();
+                    default:
+                        return numInputs == 1;
+                }
+            };
+
+            // number of consumers of each node output
+            std::map<std::pair<int, int>, int> consumers;
+            for (auto &v: *_mapped)
+                for (auto &p: *v.second->input())
+                    consumers[p]++;
+
+            // node -> next node of the chain
+            std::map<int, Node*> next;
+            std::map<int, Node*> prev;
+            for (auto &v: *_mapped) {
+                auto node = v.second;
+                if (!fusable(node))
+                    continue;
+
+                auto &in = node->input()->at(0);
+                if (in.second != 0 || _mapped->count(in.first) == 0)
+                    continue;
+
+                auto producer = _mapped->at(in.first);
+                if (!fusable(producer) || consumers[in] != 1 || producer->hasExternalOutputs())
+                    continue;
+
+                if (std::find(_output.begin(), _output.end(), producer->id()) != _output.end() || std::find(_autos.begin(), _autos.end(), producer->id()) != _autos.end())
+                    continue;
+
+                next[producer->id()] = node;
+                prev[node->id()] = producer;
+            }
+
+            for (auto &v: next) {
+                // chains are processed from their heads only
+                if (prev.count(v.first) > 0)
+                    continue;
+
+                std::vector<Node*> chain = {_mapped->at(v.first)};
+                while (next.count(chain.back()->id()) > 0)
+                    chain.emplace_back(next.at(chain.back()->id()));
+
+                std::vector<nd4j::ops::LegacyMetaOp::Stage> stages;
+                std::vector<std::pair<int, int>> inputs = {chain.front()->input()->at(0)};
+
+                for (auto node: chain) {
+                    auto block = node->getContextPrototype();
+                    auto tArgs = block->getTArguments();
+
+                    nd4j::ops::LegacyMetaOp::Stage stage;
+                    stage.opType = node->opType();
+                    stage.opNum = (int) node->opNum();
+
+                    if (node->input()->size() > 1) {
+                        stage.input = (int) inputs.size();
+                        inputs.emplace_back(node->input()->at(1));
+                        stage.extraParams = *tArgs;
+                    } else if (node->opType() == OpType_SCALAR && !tArgs->empty()) {
+                        // same convention as LegacyScalarOp: first T arg is scalar, the rest are extra params
+                        stage.scalar = tArgs->at(0);
+                        stage.extraParams.assign(tArgs->begin() + 1, tArgs->end());
+                    } else {
+                        if (node->opType() == OpType_SCALAR)
+                            stage.scalar = node->scalar();
+
+                        stage.extraParams = *tArgs;
+                    }
+
+                    if (node->opType() == OpType_BROADCAST)
+                        stage.dimensions = *block->getAxis();
+
+                    stages.emplace_back(stage);
+                }
+
+                // tail node takes over the whole chain: it keeps its id, so its consumers stay intact
+                auto tail = chain.back();
+                auto block = tail->getContextPrototype();
+                auto op = new nd4j::ops::LegacyMetaOp(stages);
+
+                tail->input()->clear();
+                block->inputs()->clear();
+                for (auto &p: inputs) {
+                    tail->pickInput(p);
+                    block->inputs()->emplace_back(p);
+                }
+
+                block->getTArguments()->clear();
+                block->getIArguments()->clear();
+                block->getAxis()->clear();
+                block->setOpDescriptor(op->getOpDescriptor());
+
+                // fusable nodes always own their ops, see isDeductable() check above
+                delete tail->getCustomOp();
+                tail->setCustomOp(op);
+
+                // all other nodes of the chain are excluded from execution, but they are still owned via _handles
+                for (int e = 0; e < (int) chain.size() - 1; e++) {
+                    auto node = chain[e];
+                    auto layer = _onion->at(node->getLayer());
+                    layer->erase(std::remove(layer->begin(), layer->end(), node), layer->end());
+                    _mapped->erase(node->id());
+                }
+
+                nd4j_debug("Fused %i nodes into node_%i\n", (int) chain.size(), tail->id());
+            }
+        }
+
         void Graph::tagInplaceNodes() {
             // just calling, in case it wasn't built before
             if (!_built.load())
@@ -1310,7 +1449,7 @@ namespace nd4j {
                 for (auto x: *(ovec)) {
                     auto n = x->clone();
                     vec->emplace_back(n);
-                    _handles.emplace_back(n);
+                    clone->_handles.emplace_back(n);
                     (*clone->_mapped)[n->id()] = n;
                 }
 
@@ -1361,7 +1500,7 @@ namespace nd4j {
                 for (auto x: *(ovec)) {
                     auto n = x->clone();
                     vec->emplace_back(n);
-                    _handles.emplace_back(n);
+                    clone->_handles.emplace_back(n);
                     (*clone->_mapped)[n->id()] = n;
                 }
 
@@ -71,6 +71,8 @@ namespace nd4j {
 
         void GraphHolder::dropGraph(Nd4jLong graphId) {
             if (this->hasGraph(graphId)) {
+                dropSessions(graphId);
+
                 auto g = _graphF[graphId];
                 forgetGraph(graphId);
                 delete g;
@@ -104,6 +106,8 @@ namespace nd4j {
 
             this->lockWrite(graphId);
 
+            // sessions were built for previous graph
+            dropSessions(graphId);
             _graphF[graphId] = graph;
 
             this->unlockWrite(graphId);
@@ -112,21 +116,116 @@ namespace nd4j {
 
 
 
+        GraphSession* GraphHolder::checkoutSession(Nd4jLong graphId) {
+            if (!hasGraph(graphId))
+                throw unknown_graph_exception(graphId);
+
+            std::lock_guard<std::mutex> lock(_sessionsLock);
+
+            auto &pool = _sessions[graphId];
+            if (!pool.empty()) {
+                auto session = pool.back();
+                pool.pop_back();
+                return session;
+            }
+
+            // sessions are cloned from fully built graph, so they don't have to build anything on their own
+            auto graph = _graphF[graphId];
+            graph->buildGraph();
+
+            return new GraphSession(graph);
+        }
+
+        void GraphHolder::releaseSession(Nd4jLong graphId, GraphSession *session) {
+            std::lock_guard<std::mutex> lock(_sessionsLock);
+
+            // graph could have been replaced while session was in use
+            if (!hasGraph(graphId) || _graphF[graphId] != session->origin()) {
+                delete session;
+                return;
+            }
+
+            // sessions are created on demand, so after burst of concurrent requests only some of them are kept
+            auto &pool = _sessions[graphId];
+            if (pool.size() >= GRAPH_HOLDER_MAX_IDLE_SESSIONS) {
+                delete session;
+                return;
+            }
+
+            pool.emplace_back(session);
+        }
+
+        int GraphHolder::idleSessions(Nd4jLong graphId) {
+            std::lock_guard<std::mutex> lock(_sessionsLock);
+
+            return _sessions.count(graphId) > 0 ? static_cast<int>(_sessions[graphId].size()) : 0;
+        }
+
+        void GraphHolder::dropSessions(Nd4jLong graphId) {
+            std::lock_guard<std::mutex> lock(_sessionsLock);
+
+            if (_sessions.count(graphId) == 0)
+                return;
+
+            for (auto session: _sessions[graphId])
+                delete session;
+
+            _sessions.erase(graphId);
+        }
+
         flatbuffers::Offset<FlatResult> GraphHolder::execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
             if (!hasGraph(graphId))
                 throw unknown_graph_exception(graphId);
 
-            lockRead(graphId);
+            GraphSessionGuard guard(this, graphId);
+            auto session = guard.session();
+
+            if (request != nullptr && request->variables() != nullptr) {
+                std::vector<Variable*> inputs;
+                auto vars = request->variables();
+                for (int e = 0; e < (int) vars->size(); e++)
+                    inputs.emplace_back(new Variable(vars->Get(e)));
 
-            auto graph = cloneGraph(graphId);
-            auto res = GraphExecutioner::execute(graph, builder, request);
-            delete graph;
+                session->feed(inputs);
+            }
 
-            unlockRead(graphId);
+            auto res = GraphExecutioner::executePrepared(session->graph(), builder, request != nullptr ? request->id() : 0);
+
+            guard.release();
 
             return res;
         }
 
+        GraphSessionGuard::GraphSessionGuard(GraphHolder *holder, Nd4jLong graphId) : _holder(holder), _graphId(graphId) {
+            _holder->lockRead(_graphId);
+
+            // destructor won't be called if constructor throws
+            try {
+                _session = _holder->checkoutSession(_graphId);
+            } catch (...) {
+                _holder->unlockRead(_graphId);
+                throw;
+            }
+        }
+
+        GraphSessionGuard::~GraphSessionGuard() {
+            // session state is unknown after failure, so it's not going back to the pool
+            delete _session;
+
+            _holder->unlockRead(_graphId);
+        }
+
+        void GraphSessionGuard::release() {
+            if (_session == nullptr)
+                return;
+
+            _session->reset();
+
+            auto session = _session;
+            _session = nullptr;
+            _holder->releaseSession(_graphId, session);
+        }
+
         GraphHolder* GraphHolder::_INSTANCE = 0;
     }
 }
@@ -0,0 +1,156 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+//  @author raver119@gmail.com
+//
+
+#include <graph/GraphSession.h>
+
+namespace nd4j {
+    namespace graph {
+        GraphSession::GraphSession(Graph *origin) {
+            _origin = origin;
+
+            build();
+        }
+
+        GraphSession::~GraphSession() {
+            destroy();
+            delete _plan;
+        }
+
+        void GraphSession::build() {
+            _graph = _origin->cloneWithProxy();
+
+            // states of nodes are stored in original VariableSpace, and would be shared by all sessions otherwise
+            auto varSpace = _graph->getVariableSpace();
+            auto backed = _origin->getVariableSpace();
+            for (auto &v: *_graph->getMapped()) {
+                for (int e = 0; backed->hasVariable(v.first, e); e++) {
+                    auto name = backed->getVariable(v.first, e)->getName();
+                    auto state = new Variable(nullptr, name != nullptr && !name->empty() ? name->c_str() : nullptr, v.first, e);
+                    varSpace->putVariable(v.first, e, state);
+                }
+            }
+
+            _flowPath = new FlowPath();
+            _graph->getVariableSpace()->setFlowPath(_flowPath);
+            _graph->getVariableSpace()->setMemoryPlan(_plan);
+        }
+
+        void GraphSession::destroy() {
+            delete _graph;
+            delete _flowPath;
+
+            _graph = nullptr;
+            _flowPath = nullptr;
+        }
+
+        void GraphSession::rebuild() {
+            destroy();
+            _inputs.clear();
+
+            // input shapes were changed, so previous plan is useless
+            delete _plan;
+            _plan = nullptr;
+            _planned = false;
+
+            build();
+        }
+
+        void GraphSession::plan() {
+            _planned = true;
+
+            auto sizes = MemoryPlan::measure(_graph);
+            if (sizes.empty())
+                return;
+
+            auto plan = new MemoryPlan(_graph, sizes);
+            if (plan->numberOfPlanned() == 0) {
+                delete plan;
+                return;
+            }
+
+            nd4j_debug("Graph memory plan: %lld bytes arena for %lld bytes of intermediate arrays\n", plan->arenaSize(), plan->totalSize());
+
+            // activations of first run live in session workspace, so the whole state is rebuilt around the plan.
+            // inputs will be copied in again on next feed
+            destroy();
+            _inputs.clear();
+            _plan = plan;
+            build();
+        }
+
+        std::string GraphSession::keyOf(Variable *variable) {
+            if (variable->getName() != nullptr && !variable->getName()->empty())
+                return *variable->getName();
+
+            return std::to_string(variable->id()) + ":" + std::to_string(variable->index());
+        }
+
+        void GraphSession::feed(std::vector<Variable*> &inputs) {
+            // if any of known inputs changes its shape, all activations allocated for it are useless now
+            for (auto v: inputs) {
+                auto key = keyOf(v);
+                if (_inputs.count(key) == 0 || !v->hasNDArray())
+                    continue;
+
+                auto array = _inputs[key]->getNDArray();
+                if (array == nullptr || !array->isSameShape(v->getNDArray()) || array->dataType() != v->getNDArray()->dataType()) {
+                    rebuild();
+                    break;
+                }
+            }
+
+            auto varSpace = _graph->getVariableSpace();
+            for (auto v: inputs) {
+                auto key = keyOf(v);
+
+                if (_inputs.count(key) > 0 && v->hasNDArray()) {
+                    _inputs[key]->getNDArray()->assign(v->getNDArray());
+                } else {
+                    // given Variable might be just a view of external memory, so we keep our own copy
+                    auto copy = v->clone();
+                    varSpace->replaceVariable(copy);
+                    _inputs[key] = copy;
+                }
+
+                delete v;
+            }
+        }
+
+        void GraphSession::reset() {
+            _flowPath->reset();
+
+            if (!_planned)
+                plan();
+        }
+
+        Graph* GraphSession::graph() {
+            return _graph;
+        }
+
+        Graph* GraphSession::origin() {
+            return _origin;
+        }
+
+        MemoryPlan* GraphSession::memoryPlan() {
+            return _plan;
+        }
+    }
+}
@@ -0,0 +1,254 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+//  @author raver119@gmail.com
+//
+
+#include <graph/MemoryPlan.h>
+#include <graph/Graph.h>
+#include <helpers/ConstantShapeHelper.h>
+#include <algorithm>
+#include <set>
+#include <cstring>
+
+namespace nd4j {
+    namespace graph {
+        MemoryPlan::MemoryPlan(Graph *graph, std::map<std::pair<int, int>, Nd4jLong> &sizes) {
+            plan(graph, sizes);
+
+            if (_arenaSize > 0) {
+                _buffer = new int8_t[_arenaSize + PLAN_ALIGNMENT];
+
+                auto shift = reinterpret_cast<uintptr_t>(_buffer) % PLAN_ALIGNMENT;
+                _arena = shift == 0 ? _buffer : _buffer + (PLAN_ALIGNMENT - shift);
+            }
+        }
+
+        MemoryPlan::~MemoryPlan() {
+            delete[] _buffer;
+        }
+
+        static FORCEINLINE Nd4jLong alignedSize(Nd4jLong bytes) {
+            return (bytes + PLAN_ALIGNMENT - 1) / PLAN_ALIGNMENT * PLAN_ALIGNMENT;
+        }
+
+        void MemoryPlan::plan(Graph *graph, std::map<std::pair<int, int>, Nd4jLong> &sizes) {
+            // nodes in execution order, and their positions within it
+            std::vector<Node*> order;
+            std::map<int, int> positions;
+
+            auto onion = graph->getOnion();
+            for (int l = 0; l < (int) onion->size(); l++) {
+                if (onion->count(l) == 0)
+                    continue;
+
+                for (auto node: *onion->at(l)) {
+                    // conditional and loop frames make lifetimes unpredictable
+                    if (node->opType() == OpType_LOGIC)
+                        return;
+
+                    positions[node->id()] = order.size();
+                    order.emplace_back(node);
+                }
+            }
+
+            auto numNodes = (int) order.size();
+            if (numNodes == 0)
+                return;
+
+            // reach[u] has bit v set if node v can't start before node u is finished
+            auto words = (numNodes + 63) / 64;
+            std::vector<std::vector<uint64_t>> reach(numNodes, std::vector<uint64_t>(words, 0));
+            std::vector<std::vector<int>> consumers(numNodes);
+            std::map<std::pair<int, int>, std::vector<int>> users;
+
+            for (int e = 0; e < numNodes; e++) {
+                for (auto &in: *order[e]->input()) {
+                    if (positions.count(in.first) == 0)
+                        continue;
+
+                    consumers[positions[in.first]].emplace_back(e);
+                    users[in].emplace_back(e);
+                }
+            }
+
+            for (int e = numNodes - 1; e >= 0; e--)
+                for (auto c: consumers[e]) {
+                    reach[e][c / 64] |= (1ULL << (c % 64));
+                    for (int w = 0; w < words; w++)
+                        reach[e][w] |= reach[c][w];
+                }
+
+            struct Tensor {
+                std::pair<int, int> pair;
+                Nd4jLong size;
+                int producer;
+                std::vector<int> users;
+            };
+
+            std::vector<Tensor> tensors;
+            for (auto &v: sizes) {
+                if (v.second <= 0 || positions.count(v.first.first) == 0)
+                    continue;
+
+                // graph outputs must survive till the end of execution
+                if (std::find(graph->output()->begin(), graph->output()->end(), v.first.first) != graph->output()->end())
+                    continue;
+
+                Tensor t;
+                t.pair = v.first;
+                t.size = alignedSize(v.second);
+                t.producer = positions[v.first.first];
+                t.users.emplace_back(t.producer);
+                if (users.count(v.first) > 0)
+                    t.users.insert(t.users.end(), users[v.first].begin(), users[v.first].end());
+
+                _totalSize += v.second;
+                tensors.emplace_back(t);
+            }
+
+            // a is dead before b is born
+            auto before = [&] (const Tensor &a, const Tensor &b) -> bool {
+                for (auto u: a.users)
+                    if ((reach[u][b.producer / 64] & (1ULL << (b.producer % 64))) == 0)
+                        return false;
+
+                return true;
+            };
+
+            std::sort(tensors.begin(), tensors.end(), [] (const Tensor &a, const Tensor &b) -> bool {
+                return a.size != b.size ? a.size > b.size : a.producer < b.producer;
+            });
+
+            std::vector<std::pair<Nd4jLong, Nd4jLong>> busy;
+            for (int e = 0; e < (int) tensors.size(); e++) {
+                auto &t = tensors[e];
+
+                busy.clear();
+                for (int p = 0; p < e; p++) {
+                    auto &o = tensors[p];
+                    if (!before(t, o) && !before(o, t))
+                        busy.emplace_back(_offsets[o.pair], o.size);
+                }
+
+                std::sort(busy.begin(), busy.end());
+
+                // lowest gap which is large enough
+                Nd4jLong offset = 0;
+                for (auto &b: busy) {
+                    if (b.first - offset >= t.size)
+                        break;
+
+                    offset = nd4j::math::nd4j_max<Nd4jLong>(offset, b.first + b.second);
+                }
+
+                _offsets[t.pair] = offset;
+                _sizes[t.pair] = t.size;
+                _arenaSize = nd4j::math::nd4j_max<Nd4jLong>(_arenaSize, offset + t.size);
+            }
+        }
+
+        std::map<std::pair<int, int>, Nd4jLong> MemoryPlan::measure(Graph *graph) {
+            std::map<std::pair<int, int>, Nd4jLong> result;
+            auto varSpace = graph->getVariableSpace();
+
+            struct Range {
+                std::pair<int, int> pair;
+                uintptr_t start;
+                uintptr_t end;
+                bool planned;
+            };
+
+            // external variables first, and then outputs of every node
+            auto variables = varSpace->getVariables();
+            for (auto &v: *graph->getMapped())
+                for (int e = 0; varSpace->hasVariable(v.first, e); e++)
+                    variables.emplace_back(varSpace->getVariable(v.first, e));
+
+            std::set<Variable*> visited;
+            std::vector<Range> ranges;
+            for (auto v: variables) {
+                if (visited.count(v) > 0)
+                    continue;
+
+                visited.insert(v);
+
+                if (v->variableType() != VariableType::NDARRAY || !v->hasNDArray() || v->getNDArray()->getBuffer() == nullptr)
+                    continue;
+
+                auto array = v->getNDArray();
+                auto start = reinterpret_cast<uintptr_t>(array->getBuffer());
+                auto bytes = array->lengthOf() * array->sizeOfT();
+                if (bytes == 0)
+                    continue;
+
+                ranges.push_back({{v->id(), v->index()}, start, start + bytes, v->id() > 0 && v->isRemovable() && !v->isReadOnly()});
+            }
+
+            // arrays sharing memory with anything else are left as is
+            std::sort(ranges.begin(), ranges.end(), [] (const Range &a, const Range &b) -> bool {
+                return a.start < b.start;
+            });
+
+            uintptr_t leftEnd = 0;
+            for (int e = 0; e < (int) ranges.size(); e++) {
+                bool shared = ranges[e].start < leftEnd || (e + 1 < (int) ranges.size() && ranges[e + 1].start < ranges[e].end);
+                leftEnd = nd4j::math::nd4j_max<uintptr_t>(leftEnd, ranges[e].end);
+
+                if (!shared && ranges[e].planned)
+                    result[ranges[e].pair] = ranges[e].end - ranges[e].start;
+            }
+
+            return result;
+        }
+
+        bool MemoryPlan::hasOffset(std::pair<int, int> &pair) {
+            return _offsets.count(pair) > 0;
+        }
+
+        Nd4jLong MemoryPlan::offset(std::pair<int, int> &pair) {
+            return hasOffset(pair) ? _offsets[pair] : -1;
+        }
+
+        NDArray* MemoryPlan::allocate(std::pair<int, int> &pair, Nd4jLong *shapeInfo, nd4j::memory::Workspace *workspace) {
+            if (_arena == nullptr || !hasOffset(pair) || ArrayOptions::hasPropertyBitSet(shapeInfo, ARRAY_EMPTY))
+                return nullptr;
+
+            Nd4jLong bytes = shape::length(shapeInfo) * static_cast<Nd4jLong>(DataTypeUtils::sizeOfElement(ArrayOptions::dataType(shapeInfo)));
+            if (bytes > _sizes[pair])
+                return nullptr;
+
+            auto buffer = _arena + _offsets[pair];
+            memset(buffer, 0, bytes);
+
+            return new NDArray(buffer, ConstantShapeHelper::getInstance()->bufferForShapeInfo(shapeInfo), workspace, false, false);
+        }
+
+        Nd4jLong MemoryPlan::arenaSize() {
+            return _arenaSize;
+        }
+
+        Nd4jLong MemoryPlan::totalSize() {
+            return _totalSize;
+        }
+
+        int MemoryPlan::numberOfPlanned() {
+            return (int) _offsets.size();
+        }
+    }
+}
@@ -120,6 +120,10 @@ namespace nd4j {
             return _protoContext;
         }
 
+        ShapeMemo* nd4j::graph::Node::shapeMemo() {
+            return &_shapeMemo;
+        }
+
         void nd4j::graph::Node::setContextPrototype(ContextPrototype *block) {
             if (_protoContext != nullptr)
                 throw std::runtime_error("Block already exists");
@@ -0,0 +1,125 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+//  @author raver119@gmail.com
+//
+
+#include <graph/ShapeMemo.h>
+#include <graph/Context.h>
+#include <helpers/shape.h>
+#include <helpers/ConstantShapeHelper.h>
+#include <cstring>
+
+namespace nd4j {
+    namespace graph {
+        static FORCEINLINE void appendDouble(std::vector<Nd4jLong> &key, double value) {
+            Nd4jLong bits;
+            memcpy(&bits, &value, sizeof(bits));
+            key.emplace_back(bits);
+        }
+
+        bool ShapeMemo::buildKey(Context &ctx, ShapeList &inputShapes) {
+            _candidate.clear();
+
+            for (auto shapeInfo: *inputShapes.asVector())
+                _candidate.insert(_candidate.end(), shapeInfo, shapeInfo + shape::shapeInfoLength(shapeInfo));
+
+            // small inputs are likely to be shape arguments: axis, new shape, paddings etc
+            for (auto p: *ctx.inputs()) {
+                auto var = ctx.variable(p);
+
+                // shapes of list ops depend on list contents
+                if (var->variableType() != VariableType::NDARRAY || var->getNDArray() == nullptr)
+                    return false;
+
+                auto array = var->getNDArray();
+                if (array->isEmpty() || array->lengthOf() > SHAPE_MEMO_VALUES)
+                    continue;
+
+                if (DataTypeUtils::isS(array->dataType()))
+                    return false;
+
+                for (Nd4jLong e = 0; e < array->lengthOf(); e++)
+                    appendDouble(_candidate, array->e<double>(e));
+            }
+
+            _candidate.emplace_back(ctx.getIArguments()->size());
+            for (auto v: *ctx.getIArguments())
+                _candidate.emplace_back(v);
+
+            _candidate.emplace_back(ctx.getTArguments()->size());
+            for (auto v: *ctx.getTArguments())
+                appendDouble(_candidate, v);
+
+            _candidate.emplace_back(ctx.getBArguments()->size());
+            for (auto v: *ctx.getBArguments())
+                _candidate.emplace_back(v ? 1 : 0);
+
+            _candidate.emplace_back(ctx.getAxis()->size());
+            for (auto v: *ctx.getAxis())
+                _candidate.emplace_back(v);
+
+            return true;
+        }
+
+        bool ShapeMemo::match(bool memoizable, Context &ctx, ShapeList &inputShapes) {
+            _hasCandidate = memoizable && buildKey(ctx, inputShapes);
+
+            if (_hasCandidate && !_pointers.empty() && _candidate == _key) {
+                _hits++;
+                return true;
+            }
+
+            _misses++;
+            return false;
+        }
+
+        std::vector<Nd4jLong*>* ShapeMemo::shapes() {
+            return &_pointers;
+        }
+
+        void ShapeMemo::update(ShapeList &outputShapes) {
+            if (!_hasCandidate) {
+                invalidate();
+                return;
+            }
+
+            _key.swap(_candidate);
+            _hasCandidate = false;
+
+            _pointers.clear();
+
+            // interned shapes are shared with output arrays, so later comparisons against them are pointer comparisons
+            for (auto shapeInfo: *outputShapes.asVector())
+                _pointers.emplace_back(ConstantShapeHelper::getInstance()->bufferForShapeInfo(shapeInfo));
+        }
+
+        void ShapeMemo::invalidate() {
+            _key.clear();
+            _pointers.clear();
+        }
+
+        Nd4jLong ShapeMemo::hits() {
+            return _hits;
+        }
+
+        Nd4jLong ShapeMemo::misses() {
+            return _misses;
+        }
+    }
+}
@@ -233,6 +233,16 @@ namespace nd4j {
         }
 
         
+        void VariableProxy::setMemoryPlan(MemoryPlan* plan) {
+            _current->setMemoryPlan(plan);
+        }
+
+        
+        MemoryPlan* VariableProxy::memoryPlan() {
+            return _current->memoryPlan();
+        }
+
+        
         void VariableProxy::putOutputVariable(Variable *variable) {
             _current->putOutputVariable(variable);
         }
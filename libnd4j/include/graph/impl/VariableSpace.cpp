@@ -66,6 +66,8 @@ namespace nd4j {
 
         
         void nd4j::graph::VariableSpace::injectVariable(std::pair<int, int> &pair, Variable* variable) {
+            WriteLockGuard lock(_varmap);
+
             if (pair.second == 0) {
                 if (pair.first < 0)
                     this->_variables[pair.first] = variable;
@@ -90,10 +92,14 @@ namespace nd4j {
         }
 
         bool nd4j::graph::VariableSpace::hasVariable(std::string *symbol) {
+            ReadLockGuard lock(_varmap);
+
             return _symbolic.count(*symbol) == 1;
         }
 
         nd4j::graph::Variable * nd4j::graph::VariableSpace::getVariable(std::string *symbol) {
+            ReadLockGuard lock(_varmap);
+
             return _symbolic.at(*symbol);
         }
 
@@ -132,18 +138,20 @@ namespace nd4j {
         }
 
         nd4j::graph::Variable * nd4j::graph::VariableSpace::getVariable(std::pair<int, int>& pair) {
+            ReadLockGuard lock(_varmap);
+
 //            if (pair.first == 0)
 //                throw "0 requested";
 
             //nd4j_debug("Requested variable: [%i:%i]\n", pair.first, pair.second);
 
             if (pair.first < 0)
-                return getVariable(pair.first);
+                return getVariableUnsafe(pair.first);
             else if (_paired.count(pair) > 0)
                 return _paired.at(pair);
             else {
-                if (hasVariable(pair.first) && pair.second == 0)
-                    return getVariable(pair.first);
+                if (hasVariableUnsafe(pair.first) && pair.second == 0)
+                    return getVariableUnsafe(pair.first);
             }
 
             nd4j_printf("Unknown variable requested: [%i,%i]\n", pair.first, pair.second);
@@ -152,10 +160,18 @@ namespace nd4j {
         }
 
         bool nd4j::graph::VariableSpace::hasVariable(int id) {
+            ReadLockGuard lock(_varmap);
+
+            return hasVariableUnsafe(id);
+        }
+
+        bool nd4j::graph::VariableSpace::hasVariableUnsafe(int id) {
             return _variables.count(id) == 1 || _temporary.count(id) == 1;
         }
 
         bool nd4j::graph::VariableSpace::hasVariable(std::pair<int,int>& id) {
+            ReadLockGuard lock(_varmap);
+
             return _paired.count(id) > 0;
         }
 
@@ -226,41 +242,43 @@ namespace nd4j {
         }
 
         void nd4j::graph::VariableSpace::silentPutVariable(std::pair<int,int>& pair, Variable *variable) {
-            _varmap.lock();
-
             //std::pair<std::pair<int, int>, nd4j::graph::Variable *> p(pair, variable);
             _paired[pair] = variable;
-
-            _varmap.unlock();
         }
 
         void nd4j::graph::VariableSpace::putVariable(std::pair<int,int>& pair, Variable *variable) {
+            WriteLockGuard lock(_varmap);
+
             silentPutVariable(pair, variable);
 
             if (variable->isPlaceholder())
                 _placeholders.push_back(variable);
 
             // copying duplicate for compatibility
-            if (pair.second == 0 && !this->hasVariable(pair.first)) {
-                this->putVariable(pair.first, variable);
+            if (pair.second == 0 && !this->hasVariableUnsafe(pair.first)) {
+                this->putVariableUnsafe(pair.first, variable);
             } else {
                 if (variable->getName() != nullptr && variable->getName()->length() != 0) {
                     _symbolic[*(variable->getName())] = variable;
                 }
 
-                _varmap.lock();
-
                 _handles->push_back(variable);
-
-                _varmap.unlock();
             }
         }
 
         void VariableSpace::trackList(nd4j::NDArrayList* list) {
+            WriteLockGuard lock(_varmap);
+
             _lists.emplace_back(list);
         }
 
         void nd4j::graph::VariableSpace::putVariable(int id, Variable *variable) {
+            WriteLockGuard lock(_varmap);
+
+            putVariableUnsafe(id, variable);
+        }
+
+        void nd4j::graph::VariableSpace::putVariableUnsafe(int id, Variable *variable) {
             // we don't want to add variables more then once
             if (_variables.count(id) > 0 || _temporary.count(id) > 0) {
                 // nd4j_verbose("Trying to update variable for node_%i\n", id);
@@ -276,8 +294,6 @@ namespace nd4j {
 
             //nd4j_debug("Adding Variable to Space: id: %i; Array is null: %i;\n", id, variable->getNDArray() == nullptr);
 
-            _varmap.lock();
-
             _handles->emplace_back(variable);
 
             if (_auto_counter >= id)
@@ -303,10 +319,8 @@ namespace nd4j {
                 _temporary[id] = variable;
             }
 
-            _varmap.unlock();
-
             std::pair<int,int> pair(id, 0);
-            if (!hasVariable(pair)) {
+            if (_paired.count(pair) == 0) {
                 this->silentPutVariable(pair, variable);
 
                 if (variable->isPlaceholder())
@@ -320,18 +334,16 @@ namespace nd4j {
         }
 
         nd4j::graph::Variable * nd4j::graph::VariableSpace::getVariable(int id) {
-//            _varmap.lock();
+            ReadLockGuard lock(_varmap);
 
-            if (id < 0) {
-                auto  v = _variables.at(id);
-   //             _varmap.unlock();
+            return getVariableUnsafe(id);
+        }
 
-                return v;
+        nd4j::graph::Variable * nd4j::graph::VariableSpace::getVariableUnsafe(int id) {
+            if (id < 0) {
+                return _variables.at(id);
             } else {
-                auto v = _temporary.at(id);
-    //            _varmap.unlock();
-
-                return v;
+                return _temporary.at(id);
             }
         }
 
@@ -452,6 +464,14 @@ namespace nd4j {
             return _flow;
         }
 
+        void VariableSpace::setMemoryPlan(MemoryPlan* plan) {
+            _plan = plan;
+        }
+
+        MemoryPlan* VariableSpace::memoryPlan() {
+            return _plan;
+        }
+
         VariableSpace::VariableSpace() {
             _handles = new std::vector<Variable *>;
         }
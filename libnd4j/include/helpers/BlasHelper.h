@@ -142,6 +142,16 @@ namespace nd4j {
                            double* u, int ldu, double* vt,
                            int ldvt);
 
+    typedef int (*LapackeSgetrf)(LAPACK_LAYOUT matrix_layout, int m, int n,
+                           float* a, int lda, int* ipiv);
+    typedef int (*LapackeDgetrf)(LAPACK_LAYOUT matrix_layout, int m, int n,
+                           double* a, int lda, int* ipiv);
+
+    typedef int (*LapackeSpotrf)(LAPACK_LAYOUT matrix_layout, char uplo, int n,
+                           float* a, int lda);
+    typedef int (*LapackeDpotrf)(LAPACK_LAYOUT matrix_layout, char uplo, int n,
+                           double* a, int lda);
+
     typedef cublasStatus_t (CUBLASWINAPI *CublasSgemv)(cublasHandle_t handle, 
                                                       cublasOperation_t trans, 
                                                       int m, 
@@ -377,6 +387,11 @@ namespace nd4j {
         bool _hasDgemv = false;
         bool _hasDgemm = false;
         bool _hasDgemmBatch = false;
+
+        bool _hasSgetrf = false;
+        bool _hasDgetrf = false;
+        bool _hasSpotrf = false;
+        bool _hasDpotrf = false;
         
         CblasSgemv cblasSgemv;
         CblasDgemv cblasDgemv;
@@ -388,6 +403,10 @@ namespace nd4j {
         LapackeDgesvd lapackeDgesvd;
         LapackeSgesdd lapackeSgesdd;
         LapackeDgesdd lapackeDgesdd;
+        LapackeSgetrf lapackeSgetrf;
+        LapackeDgetrf lapackeDgetrf;
+        LapackeSpotrf lapackeSpotrf;
+        LapackeDpotrf lapackeDpotrf;
 
         CublasSgemv cublasSgemv;
         CublasDgemv cublasDgemv;
@@ -407,6 +426,12 @@ namespace nd4j {
         static BlasHelper* getInstance();
 
         void initializeFunctions(Nd4jPointer *functions);
+
+        /**
+         * This method sets LAPACKE factorization functions, in order: sgetrf, dgetrf, spotrf, dpotrf.
+         * Kept apart from initializeFunctions, since that one's table has fixed length of 10 entries
+         */
+        void initializeLapackFunctions(Nd4jPointer *functions);
 		void initializeDeviceFunctions(Nd4jPointer *functions);
 
         template <typename T>
@@ -418,6 +443,12 @@ namespace nd4j {
         template <typename T>
         bool hasBatchedGEMM();
 
+        template <typename T>
+        bool hasGETRF();
+
+        template <typename T>
+        bool hasPOTRF();
+
         CblasSgemv sgemv();
         CblasDgemv dgemv();
 
@@ -432,6 +463,12 @@ namespace nd4j {
 
         LapackeSgesdd sgesdd();
         LapackeDgesdd dgesdd();
+
+        LapackeSgetrf sgetrf();
+        LapackeDgetrf dgetrf();
+
+        LapackeSpotrf spotrf();
+        LapackeDpotrf dpotrf();
         
         // destructor
         ~BlasHelper() noexcept; 
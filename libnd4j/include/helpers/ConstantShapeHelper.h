@@ -0,0 +1,122 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+//  @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_CONSTANTSHAPEHELPER_H
+#define LIBND4J_CONSTANTSHAPEHELPER_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <array/DataType.h>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+// number of independently locked parts of interning table
+#define SHAPE_SHARDS 32
+
+// number of Nd4jLong values in one chunk of interned shapeInfos storage, 512KB
+#define SHAPE_ARENA_CHUNK 65536
+
+// max number of storage chunks, i.e. 128MB of interned shapeInfos
+#define SHAPE_ARENA_MAX_CHUNKS 256
+
+namespace nd4j {
+    /**
+     * This class provides process-wide interning table for shapeInfo buffers: identical shapeInfos share one buffer.
+     *
+     * Interned buffers are immutable and are never released, so they can be referenced by any number of arrays
+     * without copying, and two interned shapeInfos are equal if and only if their pointers are equal.
+     *
+     * Since arrays reference interned buffers without ownership, there's no point where an entry could be evicted,
+     * so table grows with number of distinct shapeInfos seen by process. For graphs that's bounded by shapes of the model.
+     * Buffers are carved from fixed-size chunks, which keeps ownership check lock-free (it's a range check over chunks),
+     * and number of chunks is capped: once SHAPE_ARENA_MAX_CHUNKS chunks are used, new shapeInfos aren't interned anymore,
+     * instead caller gets heap copy it owns (isInterned() returns false for it, that's how NDArray decides to release it).
+     * NDArrays created within workspace keep their shapeInfo in workspace.
+     */
+    class ND4J_EXPORT ConstantShapeHelper {
+    private:
+        struct ShapeDescriptor {
+            std::vector<Nd4jLong> shapeInfo;
+            Nd4jLong hash;
+
+            bool operator==(const ShapeDescriptor &other) const;
+        };
+
+        struct ShapeDescriptorHash {
+            size_t operator()(const ShapeDescriptor &descriptor) const;
+        };
+
+        struct Shard {
+            std::mutex mutex;
+            std::unordered_map<ShapeDescriptor, Nd4jLong*, ShapeDescriptorHash> cache;
+        };
+
+        static ConstantShapeHelper* _INSTANCE;
+
+        Shard _shards[SHAPE_SHARDS];
+
+        // storage of interned buffers, chunks are only appended, and never released
+        std::mutex _arenaLock;
+        std::atomic<Nd4jLong*> _chunks[SHAPE_ARENA_MAX_CHUNKS];
+        std::atomic<int> _numChunks;
+        Nd4jLong _chunkOffset;
+
+        std::atomic<bool> _overflow;
+
+        std::atomic<int> _entries;
+        std::atomic<Nd4jLong> _hits;
+        std::atomic<Nd4jLong> _misses;
+
+        ConstantShapeHelper();
+        ~ConstantShapeHelper() = default;
+
+        Nd4jLong* allocateBuffer(size_t length);
+    public:
+        static ConstantShapeHelper* getInstance();
+
+        /**
+         * This method returns interned copy of given shapeInfo, if copyStrides is false then strides are recalculated for its order.
+         * If interning table is full, returned copy isn't interned and belongs to caller
+         */
+        Nd4jLong* bufferForShapeInfo(const Nd4jLong *shapeInfo, const bool copyStrides = true);
+
+        /**
+         * This method returns interned shapeInfo of array with given data type, order and shape.
+         * Empty shape or shape starting with 0 produces scalar shapeInfo, same as ShapeBuilders::createShapeInfo does
+         */
+        Nd4jLong* createShapeInfo(nd4j::DataType dataType, char order, const std::vector<Nd4jLong> &shape);
+        Nd4jLong* scalarShapeInfo(nd4j::DataType dataType);
+        Nd4jLong* emptyShapeInfo(nd4j::DataType dataType);
+
+        /**
+         * This method checks if given pointer was returned by this helper. Doesn't take any locks
+         */
+        bool isInterned(const Nd4jLong *shapeInfo);
+
+        int cachedEntries();
+        int allocatedChunks();
+        Nd4jLong cacheHits();
+        Nd4jLong cacheMisses();
+    };
+}
+
+#endif //LIBND4J_CONSTANTSHAPEHELPER_H
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+//  @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_CONSTANTTADHELPER_H
+#define LIBND4J_CONSTANTTADHELPER_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <array/TadPack.h>
+#include <helpers/SimpleReadWriteLock.h>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+// number of independently locked parts of TAD cache
+#define TAD_SHARDS 32
+
+namespace nd4j {
+    /**
+     * This class provides process-wide cache of TADs, keyed by shapeInfo and dimensions.
+     * Cache is bounded: least recently used entries are evicted once capacity is reached.
+     * TadPacks are immutable and shared, so evicted packs stay valid for callers still holding them.
+     *
+     * Lookups take only read lock of one shard and don't allocate. Recency is tracked by stamping entries on hit
+     * with insertion clock, and entries are ordered only when eviction happens: oldest 1/8 of capacity is dropped at once.
+     */
+    class ND4J_EXPORT ConstantTadHelper {
+    private:
+        struct TadEntry {
+            std::vector<Nd4jLong> shapeInfo;
+            std::vector<int> dimensions;
+            std::shared_ptr<TadPack> pack;
+            std::atomic<Nd4jLong> lastUsed;
+
+            bool matches(const Nd4jLong *shapeInfo, int shapeInfoLength, const int *dimensions, int dimensionLength) const;
+        };
+
+        struct Shard {
+            SimpleReadWriteLock lock;
+            std::unordered_multimap<Nd4jLong, std::unique_ptr<TadEntry>> cache;
+        };
+
+        static ConstantTadHelper* _INSTANCE;
+
+        Shard _shards[TAD_SHARDS];
+
+        // only one thread evicts at a time, others just go on
+        std::mutex _evictionLock;
+
+        std::atomic<int> _capacity;
+        std::atomic<int> _entries;
+        std::atomic<Nd4jLong> _clock;
+
+        std::atomic<Nd4jLong> _hits;
+        std::atomic<Nd4jLong> _misses;
+
+        ConstantTadHelper();
+        ~ConstantTadHelper() = default;
+
+        void evict(int limit);
+    public:
+        static ConstantTadHelper* getInstance();
+
+        /**
+         * This method returns TadPack for given shapeInfo and dimensions, building it once if it's not cached yet
+         */
+        std::shared_ptr<TadPack> tadForDimensions(Nd4jLong *shapeInfo, int *dimensions, int dimensionLength);
+        std::shared_ptr<TadPack> tadForDimensions(Nd4jLong *shapeInfo, const std::vector<int> &dimensions);
+
+        /**
+         * This method changes max number of cached TadPacks
+         */
+        void setCapacity(int capacity);
+
+        int cachedEntries();
+        Nd4jLong cacheHits();
+        Nd4jLong cacheMisses();
+
+        /**
+         * This method drops all cached entries
+         */
+        void purge();
+    };
+}
+
+#endif //LIBND4J_CONSTANTTADHELPER_H
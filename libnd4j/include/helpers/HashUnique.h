@@ -0,0 +1,309 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+//  @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_HASHUNIQUE_H
+#define LIBND4J_HASHUNIQUE_H
+
+#include <helpers/OmpLaunchHelper.h>
+#include <templatemath.h>
+#include <vector>
+#include <cstring>
+
+// minimal number of slots in hash table, must be power of 2
+#define HASH_UNIQUE_MIN_CAPACITY 16
+
+namespace nd4j {
+
+    /**
+     * Open-addressing hash table with linear probing, used to find unique values.
+     *
+     * Values are compared by their bits, with -0.0 folded into 0.0, so NaNs with the same bits are the same value.
+     * Entries are kept densely in insertion order, while slots only hold entry ids, so probing stays within
+     * a single contiguous array and iteration in first-occurrence order is free.
+     */
+    template <typename T>
+    class HashTable {
+    public:
+        struct Entry {
+            uint64_t bits;
+            T key;
+            Nd4jLong first;
+            Nd4jLong count;
+            Nd4jLong position;
+        };
+
+        explicit HashTable(Nd4jLong expected = 0) {
+            reserve(expected);
+        }
+
+        static FORCEINLINE uint64_t bits(T key) {
+            if (key == static_cast<T>(0))
+                key = static_cast<T>(0);
+
+            uint64_t result = 0;
+            memcpy(&result, &key, sizeof(T) < sizeof(uint64_t) ? sizeof(T) : sizeof(uint64_t));
+            return result;
+        }
+
+        // splitmix64 finalizer: low bits select slot, high bits select partition
+        static FORCEINLINE uint64_t hash(uint64_t bits) {
+            bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBULL;
+            return bits ^ (bits >> 31);
+        }
+
+        void reserve(Nd4jLong expected) {
+            Nd4jLong capacity = HASH_UNIQUE_MIN_CAPACITY;
+            while (capacity < expected * 2)
+                capacity *= 2;
+
+            if (capacity <= static_cast<Nd4jLong>(_slots.size()))
+                return;
+
+            _entries.reserve(expected);
+            rehash(capacity);
+        }
+
+        /**
+         * This method adds count occurrences of key, first seen at given index.
+         * Index is ignored if key is already known, so callers must insert in order of indices
+         */
+        FORCEINLINE Entry& insert(T key, Nd4jLong index, Nd4jLong count) {
+            auto b = bits(key);
+            auto slot = locate(b, hash(b));
+
+            if (_slots[slot] >= 0) {
+                auto &entry = _entries[_slots[slot]];
+                entry.count += count;
+                return entry;
+            }
+
+            _slots[slot] = static_cast<Nd4jLong>(_entries.size());
+            _entries.push_back({b, key, index, count, -1});
+
+            if (static_cast<Nd4jLong>(_entries.size()) * 2 > static_cast<Nd4jLong>(_slots.size()))
+                rehash(_slots.size() * 2);
+
+            return _entries.back();
+        }
+
+        // returns nullptr if key isn't present
+        FORCEINLINE const Entry* find(T key) const {
+            auto b = bits(key);
+            auto id = _slots[locate(b, hash(b))];
+            return id >= 0 ? &_entries[id] : nullptr;
+        }
+
+        FORCEINLINE Nd4jLong size() const {
+            return static_cast<Nd4jLong>(_entries.size());
+        }
+
+        FORCEINLINE Entry& at(Nd4jLong id) {
+            return _entries[id];
+        }
+
+    protected:
+        std::vector<Nd4jLong> _slots;
+        std::vector<Entry> _entries;
+
+        FORCEINLINE Nd4jLong locate(uint64_t b, uint64_t h) const {
+            const uint64_t mask = _slots.size() - 1;
+            auto slot = h & mask;
+
+            while (_slots[slot] >= 0 && _entries[_slots[slot]].bits != b)
+                slot = (slot + 1) & mask;
+
+            return static_cast<Nd4jLong>(slot);
+        }
+
+        void rehash(Nd4jLong capacity) {
+            _slots.assign(capacity, -1);
+
+            const uint64_t mask = capacity - 1;
+            for (Nd4jLong e = 0; e < static_cast<Nd4jLong>(_entries.size()); e++) {
+                auto slot = hash(_entries[e].bits) & mask;
+                while (_slots[slot] >= 0)
+                    slot = (slot + 1) & mask;
+
+                _slots[slot] = e;
+            }
+        }
+    };
+
+    /**
+     * This class finds unique values of contiguous buffer in parallel.
+     *
+     * Each thread builds its own table out of contiguous chunk of input. Thread-local entries are then merged into
+     * tables partitioned by hash, one partition per thread, visiting chunks in order, so the first index of each value
+     * is the first index within the whole input. Output positions, in first-occurrence order, are obtained as
+     * prefix sum over first indices, so results don't depend on number of threads.
+     */
+    template <typename T>
+    class HashUnique {
+    public:
+        typedef typename HashTable<T>::Entry Entry;
+
+        /**
+         * @param ordered - if true, positions in first-occurrence order are assigned to unique values
+         */
+        HashUnique(const T *x, Nd4jLong length, bool ordered) {
+            int numThreads = nd4j::math::nd4j_max<int>(1, OmpLaunchHelper::betterThreads(length));
+            auto span = OmpLaunchHelper::betterSpan(length, numThreads);
+
+            if (numThreads == 1) {
+                _partitions.resize(1);
+                _partitions[0].reserve(nd4j::math::nd4j_min<Nd4jLong>(length, 1024));
+                for (Nd4jLong e = 0; e < length; e++)
+                    _partitions[0].insert(x[e], e, 1);
+            } else {
+                std::vector<HashTable<T>> locals(numThreads);
+                std::vector<std::vector<std::vector<Nd4jLong>>> buckets(numThreads, std::vector<std::vector<Nd4jLong>>(numThreads));
+                _partitions.resize(numThreads);
+
+                #pragma omp parallel num_threads(numThreads) default(shared)
+                {
+                    #pragma omp for schedule(static)
+                    for (int t = 0; t < numThreads; t++) {
+                        auto start = nd4j::math::nd4j_min<Nd4jLong>(t * span, length);
+                        auto stop = nd4j::math::nd4j_min<Nd4jLong>(start + span, length);
+                        auto &local = locals[t];
+
+                        local.reserve(nd4j::math::nd4j_min<Nd4jLong>(stop - start, 1024));
+                        for (Nd4jLong e = start; e < stop; e++)
+                            local.insert(x[e], e, 1);
+
+                        for (Nd4jLong i = 0; i < local.size(); i++)
+                            buckets[t][partition(local.at(i).bits, numThreads)].push_back(i);
+                    }
+
+                    #pragma omp for schedule(static)
+                    for (int p = 0; p < numThreads; p++) {
+                        auto &table = _partitions[p];
+
+                        Nd4jLong expected = 0;
+                        for (int t = 0; t < numThreads; t++)
+                            expected += buckets[t][p].size();
+
+                        table.reserve(expected);
+
+                        for (int t = 0; t < numThreads; t++)
+                            for (auto i: buckets[t][p]) {
+                                auto &entry = locals[t].at(i);
+                                table.insert(entry.key, entry.first, entry.count);
+                            }
+                    }
+                }
+            }
+
+            _size = 0;
+            for (auto &table: _partitions)
+                _size += table.size();
+
+            if (ordered)
+                assignPositions(length, numThreads);
+        }
+
+        // number of unique values
+        FORCEINLINE Nd4jLong size() const {
+            return _size;
+        }
+
+        FORCEINLINE bool contains(T key) const {
+            return _partitions[partition(HashTable<T>::bits(key), _partitions.size())].find(key) != nullptr;
+        }
+
+        // position of given value in first-occurrence order, only valid for ordered instances and known values
+        FORCEINLINE Nd4jLong positionOf(T key) const {
+            return _partitions[partition(HashTable<T>::bits(key), _partitions.size())].find(key)->position;
+        }
+
+        /**
+         * This method calls func(entry) for each unique value, in parallel and in no particular order
+         */
+        template <typename Func>
+        void forEach(const Func &func) {
+            int numPartitions = static_cast<int>(_partitions.size());
+
+            #pragma omp parallel for num_threads(numPartitions) if (numPartitions > 1) schedule(static) default(shared)
+            for (int p = 0; p < numPartitions; p++) {
+                auto &table = _partitions[p];
+                for (Nd4jLong i = 0; i < table.size(); i++)
+                    func(table.at(i));
+            }
+        }
+
+    protected:
+        std::vector<HashTable<T>> _partitions;
+        Nd4jLong _size;
+
+        static FORCEINLINE int partition(uint64_t bits, size_t numPartitions) {
+            return static_cast<int>((HashTable<T>::hash(bits) >> 32) % numPartitions);
+        }
+
+        void assignPositions(Nd4jLong length, int numThreads) {
+            // marks[e] is 1 if element e is the first occurrence of its value, and turns into exclusive prefix sum afterwards
+            std::vector<Nd4jLong> marks(length, 0);
+            forEach([&] (Entry &entry) {
+                marks[entry.first] = 1;
+            });
+
+            auto span = OmpLaunchHelper::betterSpan(length, numThreads);
+            std::vector<Nd4jLong> sums(numThreads + 1, 0);
+
+            #pragma omp parallel num_threads(numThreads) if (numThreads > 1) default(shared)
+            {
+                #pragma omp for schedule(static)
+                for (int t = 0; t < numThreads; t++) {
+                    auto start = nd4j::math::nd4j_min<Nd4jLong>(t * span, length);
+                    auto stop = nd4j::math::nd4j_min<Nd4jLong>(start + span, length);
+
+                    Nd4jLong sum = 0;
+                    for (Nd4jLong e = start; e < stop; e++)
+                        sum += marks[e];
+
+                    sums[t + 1] = sum;
+                }
+
+                #pragma omp single
+                for (int t = 0; t < numThreads; t++)
+                    sums[t + 1] += sums[t];
+
+                #pragma omp for schedule(static)
+                for (int t = 0; t < numThreads; t++) {
+                    auto start = nd4j::math::nd4j_min<Nd4jLong>(t * span, length);
+                    auto stop = nd4j::math::nd4j_min<Nd4jLong>(start + span, length);
+
+                    auto sum = sums[t];
+                    for (Nd4jLong e = start; e < stop; e++) {
+                        auto mark = marks[e];
+                        marks[e] = sum;
+                        sum += mark;
+                    }
+                }
+            }
+
+            forEach([&] (Entry &entry) {
+                entry.position = marks[entry.first];
+            });
+        }
+    };
+}
+
+#endif //LIBND4J_HASHUNIQUE_H
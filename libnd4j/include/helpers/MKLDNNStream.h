@@ -23,9 +23,16 @@
 
 #ifdef HAVE_MKLDNN
 #include <mkldnn.hpp>
+#include <dll.h>
+#include <NDArray.h>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace nd4j {
-    class MKLDNNStream {
+    class ND4J_EXPORT MKLDNNStream {
     protected:
         std::string _opName;
 
@@ -34,9 +41,21 @@ namespace nd4j {
         std::vector<float> _floatArguments;
         std::vector<int> _intArguments;
 
+        // descriptor of shapes and arguments this stream was built for, empty if it wasn't built via acquire()
+        std::string _key;
+        // buffers of inputs and outputs at build time, used to figure out which memory belongs to which array
+        std::vector<void*> _buffers;
+        // index of array (inputs first, then outputs) backing each memory, or -1 for memory owned by stream itself
+        std::vector<int> _bindings;
+
         mkldnn::engine _engine = mkldnn::engine(mkldnn::engine::cpu, 0);
         std::vector<mkldnn::memory> _memory;
-        mkldnn::primitive _operation;
+        std::vector<mkldnn::primitive> _operations;
+
+        static std::string buildKey(const std::string &opName, const std::vector<const NDArray*> &inputs, const std::vector<const NDArray*> &outputs,
+                const std::vector<float> &floatArguments, const std::vector<int> &intArguments);
+
+        void bind(const std::vector<const NDArray*> &inputs, const std::vector<const NDArray*> &outputs);
 
     public:
         template <typename X, typename Y>
@@ -55,6 +74,23 @@ namespace nd4j {
 
         MKLDNNStream(const std::string &opName) : _opName(opName) { }
 
+        /**
+         * This method prepares group of streams used by single op call.
+         * If primitives for the same op, shapes, strides and arguments were built before, either within this group
+         * or within any group released into MKLDNNStreamCache, they are adopted and their memory is pointed to
+         * buffers of given arrays. Otherwise streams are reset, and true is returned: caller has to build memory and operations.
+         *
+         * Arrays used by any memory passed to setMemory() must be listed here, temporary arrays included.
+         */
+        static bool acquire(std::vector<MKLDNNStream> &streams, const std::vector<const NDArray*> &inputs, const std::vector<const NDArray*> &outputs,
+                const std::vector<float> &floatArguments, const std::vector<int> &intArguments);
+
+        /**
+         * This method hands built streams over to MKLDNNStreamCache, so subsequent calls with the same shapes can reuse them.
+         * Groups with any stream lacking primitives are dropped instead
+         */
+        static void release(std::vector<MKLDNNStream> &streams);
+
         bool checkAndReset(const std::vector<const NDArray*> &inputs, const std::vector<const NDArray*> &outputs,
                 const std::vector<float> &floatArguments, const std::vector<int> &intArguments) {
             if (inputs != _inputs || outputs != _outputs || floatArguments != _floatArguments || intArguments != _intArguments) {
@@ -62,29 +98,87 @@ namespace nd4j {
                 _outputs = outputs;
                 _floatArguments = floatArguments;
                 _intArguments = intArguments;
-                _operation.reset(nullptr);
+                _key.clear();
+                _operations.clear();
                 _memory.clear();
+                _bindings.clear();
                 return true;
             }
             return false;
         }
 
+        const std::string &getOpName() { return _opName; }
+
         const mkldnn::engine &getEngine() { return _engine; }
         void setEngine(const mkldnn::engine &engine) { _engine = engine; }
 
         const std::vector<mkldnn::memory> &getMemory() { return _memory; }
-        void setMemory(const std::vector<mkldnn::memory> &memory) { _memory = memory; }
+        void setMemory(const std::vector<mkldnn::memory> &memory) { _memory = memory; _bindings.clear(); }
+
+        const mkldnn::primitive &getOperation() { return _operations.back(); }
+        void setOperation(const mkldnn::primitive &operation) { _operations = {operation}; }
 
-        const mkldnn::primitive &getOperation() { return _operation; }
-        void setOperation(const mkldnn::primitive &operation) { _operation = operation; }
+        /**
+         * Operations are executed in given order, i.e. reorders go before primitive consuming their results
+         */
+        const std::vector<mkldnn::primitive> &getOperations() { return _operations; }
+        void setOperations(const std::vector<mkldnn::primitive> &operations) { _operations = operations; }
 
         bool submitAndWait(mkldnn::stream::kind kind = mkldnn::stream::kind::eager) {
             nd4j_debug("Executing %s with MKL-DNN\n", _opName.c_str());
             // need to create a new one because already executed streams become unusable
             mkldnn::stream stream(kind);
-            return stream.submit({_operation}).wait();
+            return stream.submit(_operations).wait();
         }
     };
+
+
+    /**
+     * This class provides process-wide pool of built MKL-DNN streams, keyed by op name, shapes, strides, data types and op arguments.
+     * Each group of streams is checked out by single op call at a time, so concurrent calls never share memory objects.
+     * Pool is bounded: least recently released groups are dropped once capacity is reached.
+     */
+    class ND4J_EXPORT MKLDNNStreamCache {
+    private:
+        typedef std::list<std::pair<std::string, std::vector<MKLDNNStream>>> CacheList;
+
+        static MKLDNNStreamCache* _INSTANCE;
+
+        std::mutex _mutex;
+        CacheList _lru;
+        std::unordered_multimap<std::string, CacheList::iterator> _cache;
+        int _capacity = 1024;
+
+        Nd4jLong _hits = 0;
+        Nd4jLong _misses = 0;
+
+        // drops least recently released groups above capacity, must be called under lock
+        void evict();
+
+        MKLDNNStreamCache() = default;
+        ~MKLDNNStreamCache() = default;
+    public:
+        static MKLDNNStreamCache* getInstance();
+
+        /**
+         * This method moves cached group of streams for given key into streams, returns false if there's none available
+         */
+        bool checkout(const std::string &key, std::vector<MKLDNNStream> &streams);
+
+        /**
+         * This method puts group of streams back into pool
+         */
+        void release(const std::string &key, std::vector<MKLDNNStream> &&streams);
+
+        /**
+         * This method changes max number of pooled groups
+         */
+        void setCapacity(int capacity);
+
+        int cachedEntries();
+        Nd4jLong totalHits();
+        Nd4jLong totalMisses();
+    };
 }
 #endif
 
@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+//  @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_MAPPEDNUMPY_H
+#define LIBND4J_MAPPEDNUMPY_H
+
+#include <NDArray.h>
+#include <cnpy/cnpy.h>
+#include <dll.h>
+#include <string>
+#include <vector>
+
+namespace nd4j {
+
+    /**
+     * This class exposes arrays of memory-mapped .npy/.npz files as NDArrays.
+     *
+     * Arrays are views of the mapping, so nothing is read until data is accessed, and pages are shared with
+     * page cache. Writes to arrays go to private copies of pages, file itself is never modified.
+     * Arrays are owned by this object and become invalid once it's deleted.
+     */
+    class ND4J_EXPORT MappedNumpy {
+    public:
+        ~MappedNumpy();
+
+        /**
+         * This method maps single array stored in .npy file
+         * @param prefetch - if true, data pages are read ahead instead of on first access
+         */
+        static MappedNumpy* fromNpy(const std::string &path, bool prefetch = false);
+
+        /**
+         * This method maps all arrays stored in uncompressed .npz archive
+         * @param prefetch - if true, data pages are read ahead instead of on first access
+         */
+        static MappedNumpy* fromNpz(const std::string &path, bool prefetch = false);
+
+        // number of mapped arrays
+        int size() const;
+
+        // name of i-th array, empty for .npy files
+        const std::string& name(int index) const;
+
+        NDArray* at(int index) const;
+
+        // returns nullptr if there's no array with given name
+        NDArray* at(const std::string &name) const;
+
+        // converts numpy type code and word size into DataType, throws for types without counterpart
+        static nd4j::DataType dataType(char type, unsigned int wordSize);
+
+    protected:
+        // keeps mapping alive for as long as views exist
+        std::vector<cnpy::NpyArray> _sources;
+        std::vector<std::string> _names;
+        std::vector<NDArray*> _arrays;
+
+        MappedNumpy() = default;
+        MappedNumpy(const MappedNumpy&) = delete;
+        MappedNumpy& operator=(const MappedNumpy&) = delete;
+
+        void append(const std::string &name, const cnpy::NpyArray &source);
+    };
+}
+
+#endif //LIBND4J_MAPPEDNUMPY_H
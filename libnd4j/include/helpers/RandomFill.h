@@ -0,0 +1,383 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+//  @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_RANDOMFILL_H
+#define LIBND4J_RANDOMFILL_H
+
+#include <graph/RandomGenerator.h>
+#include <helpers/OmpLaunchHelper.h>
+#include <templatemath.h>
+#include <type_traits>
+#include <cmath>
+
+// number of elements generated at once by single thread. must be multiple of 4
+#define RANDOM_FILL_BLOCK 4096
+
+// streams of counter-based generator, so different distributions never share the same bits
+#define RANDOM_STREAM_UNIFORM 1
+#define RANDOM_STREAM_NORMAL 2
+
+// rejected normal candidates of element e are redrawn from counter e, streams (kind << 32) + attempt
+#define RANDOM_STREAM_NORMAL_RETRY 3
+#define RANDOM_STREAM_TRUNCATED_RETRY 4
+
+// ziggurat constants for 128 layers, as in Doornik's ZIGNOR
+#define ZIGGURAT_LAYERS 128
+#define ZIGGURAT_R 3.442619855899
+#define ZIGGURAT_V 9.91256303526217e-3
+
+namespace nd4j {
+
+    /**
+     * This class fills contiguous buffers with random values, using counter-based RandomGenerator::philox().
+     *
+     * Element e of output depends only on generator state and e itself: float-like types consume one 32-bit word
+     * per element, double consumes two, and single philox() call produces 4 words. So output is identical
+     * regardless of number of threads, and whole blocks of bits are generated in tight simd-friendly loops.
+     *
+     * Normal values are produced with ziggurat: ~99% of elements are accepted right away with single multiplication,
+     * the rest are resolved from per-element retry streams, which keeps results reproducible as well.
+     */
+    class RandomFill {
+    public:
+        // values are computed in double for double outputs and in float for anything else
+        template <typename T>
+        using Compute = typename std::conditional<std::is_same<T, double>::value, double, float>::type;
+
+        /**
+         * This method calls func(e, u) for each e in [0, length), with u uniformly distributed in [0, 1)
+         */
+        template <typename T, typename Func>
+        static void forEachUniform(nd4j::graph::RandomGenerator &rng, Nd4jLong length, const Func &func) {
+            typedef Compute<T> C;
+
+            blocks(length, [&] (Nd4jLong offset, Nd4jLong blockLength) {
+                uint32_t bits[RANDOM_FILL_BLOCK * 2];
+                generate<C>(rng, RANDOM_STREAM_UNIFORM, offset, blockLength, bits);
+
+                for (Nd4jLong e = 0; e < blockLength; e++)
+                    func(offset + e, Bits<C>::unit(bits + e * Bits<C>::words));
+            });
+        }
+
+        /**
+         * This method fills z with values uniformly distributed in [from, to)
+         */
+        template <typename T>
+        static void uniform(nd4j::graph::RandomGenerator &rng, T *z, Nd4jLong length, T from, T to) {
+            typedef Compute<T> C;
+            const C cFrom = static_cast<C>(from);
+            const C cRange = static_cast<C>(to) - cFrom;
+
+            blocks(length, [&] (Nd4jLong offset, Nd4jLong blockLength) {
+                uint32_t bits[RANDOM_FILL_BLOCK * 2];
+                generate<C>(rng, RANDOM_STREAM_UNIFORM, offset, blockLength, bits);
+
+                auto zb = z + offset;
+                #pragma omp simd
+                for (Nd4jLong e = 0; e < blockLength; e++)
+                    zb[e] = static_cast<T>(cFrom + Bits<C>::unit(bits + e * Bits<C>::words) * cRange);
+            });
+        }
+
+        /**
+         * This method fills z with 1 with probability prob, and with 0 otherwise
+         */
+        template <typename T>
+        static void bernoulli(nd4j::graph::RandomGenerator &rng, T *z, Nd4jLong length, T prob) {
+            typedef Compute<T> C;
+            const C cProb = static_cast<C>(prob);
+
+            blocks(length, [&] (Nd4jLong offset, Nd4jLong blockLength) {
+                uint32_t bits[RANDOM_FILL_BLOCK * 2];
+                generate<C>(rng, RANDOM_STREAM_UNIFORM, offset, blockLength, bits);
+
+                auto zb = z + offset;
+                #pragma omp simd
+                for (Nd4jLong e = 0; e < blockLength; e++)
+                    zb[e] = Bits<C>::unit(bits + e * Bits<C>::words) < cProb ? static_cast<T>(1) : static_cast<T>(0);
+            });
+        }
+
+        /**
+         * This method fills z with normally distributed values
+         */
+        template <typename T>
+        static void normal(nd4j::graph::RandomGenerator &rng, T *z, Nd4jLong length, T mean, T stddev) {
+            typedef Compute<T> C;
+            const C cMean = static_cast<C>(mean);
+            const C cStddev = static_cast<C>(stddev);
+            auto &table = ziggurat<C>();
+
+            blocks(length, [&] (Nd4jLong offset, Nd4jLong blockLength) {
+                uint32_t bits[RANDOM_FILL_BLOCK * 2];
+                C buffer[RANDOM_FILL_BLOCK];
+                generate<C>(rng, RANDOM_STREAM_NORMAL, offset, blockLength, bits);
+
+                normalBlock<C>(rng, table, RANDOM_STREAM_NORMAL_RETRY, offset, blockLength, bits, buffer);
+
+                auto zb = z + offset;
+                #pragma omp simd
+                for (Nd4jLong e = 0; e < blockLength; e++)
+                    zb[e] = static_cast<T>(buffer[e] * cStddev + cMean);
+            });
+        }
+
+        /**
+         * This method fills z with normally distributed values within [mean - 2 * stddev, mean + 2 * stddev].
+         * Values outside of that range are redrawn
+         */
+        template <typename T>
+        static void truncatedNormal(nd4j::graph::RandomGenerator &rng, T *z, Nd4jLong length, T mean, T stddev) {
+            typedef Compute<T> C;
+            const C cMean = static_cast<C>(mean);
+            const C cStddev = static_cast<C>(stddev);
+            auto &table = ziggurat<C>();
+
+            blocks(length, [&] (Nd4jLong offset, Nd4jLong blockLength) {
+                uint32_t bits[RANDOM_FILL_BLOCK * 2];
+                C buffer[RANDOM_FILL_BLOCK];
+                generate<C>(rng, RANDOM_STREAM_NORMAL, offset, blockLength, bits);
+
+                normalBlock<C>(rng, table, RANDOM_STREAM_NORMAL_RETRY, offset, blockLength, bits, buffer);
+
+                // ~4.5% of values fall out of 2 sigma
+                for (Nd4jLong e = 0; e < blockLength; e++) {
+                    uint32_t attempt = 0;
+                    while (buffer[e] > static_cast<C>(2) || buffer[e] < static_cast<C>(-2))
+                        buffer[e] = normalAt<C>(rng, table, offset + e, RANDOM_STREAM_TRUNCATED_RETRY, attempt);
+                }
+
+                auto zb = z + offset;
+                #pragma omp simd
+                for (Nd4jLong e = 0; e < blockLength; e++)
+                    zb[e] = static_cast<T>(buffer[e] * cStddev + cMean);
+            });
+        }
+
+    protected:
+        /**
+         * Conversion of raw philox words into values of type C
+         */
+        template <typename C>
+        struct Bits;
+
+        /**
+         * Layer bounds of ziggurat: x[0] is the width of base layer (including tail), x[ZIGGURAT_LAYERS] is 0,
+         * r[i] = x[i + 1] / x[i] is the share of layer i that is accepted without further checks
+         */
+        template <typename C>
+        struct ZigguratTable {
+            C x[ZIGGURAT_LAYERS + 1];
+            C r[ZIGGURAT_LAYERS];
+
+            ZigguratTable() {
+                double f = std::exp(-0.5 * ZIGGURAT_R * ZIGGURAT_R);
+                double t[ZIGGURAT_LAYERS + 1];
+
+                t[0] = ZIGGURAT_V / f;
+                t[1] = ZIGGURAT_R;
+                t[ZIGGURAT_LAYERS] = 0.0;
+
+                for (int i = 2; i < ZIGGURAT_LAYERS; i++) {
+                    t[i] = std::sqrt(-2.0 * std::log(ZIGGURAT_V / t[i - 1] + f));
+                    f = std::exp(-0.5 * t[i] * t[i]);
+                }
+
+                for (int i = 0; i <= ZIGGURAT_LAYERS; i++)
+                    x[i] = static_cast<C>(t[i]);
+
+                for (int i = 0; i < ZIGGURAT_LAYERS; i++)
+                    r[i] = static_cast<C>(t[i + 1] / t[i]);
+            }
+        };
+
+        template <typename C>
+        static const ZigguratTable<C>& ziggurat() {
+            static const ZigguratTable<C> table;
+            return table;
+        }
+
+        // uniform value in (0, 1] out of two words, used for logarithms of slow path
+        static FORCEINLINE double openUnit(const uint32_t *w) {
+            auto v = (static_cast<uint64_t>(w[0]) << 21) | (w[1] >> 11);
+            return (static_cast<double>(v) + 1.0) * (1.0 / 9007199254740992.0);
+        }
+
+        static FORCEINLINE uint64_t stream(uint64_t kind, uint32_t attempt) {
+            return (kind << 32) + attempt;
+        }
+
+        /**
+         * This method splits [0, length) into RANDOM_FILL_BLOCK chunks and calls func(offset, blockLength) for each of them
+         */
+        template <typename Func>
+        static void blocks(Nd4jLong length, const Func &func) {
+            if (length <= 0)
+                return;
+
+            auto numBlocks = (length + RANDOM_FILL_BLOCK - 1) / RANDOM_FILL_BLOCK;
+            int numThreads = nd4j::math::nd4j_min<Nd4jLong>(nd4j::OmpLaunchHelper::betterThreads(length), numBlocks);
+
+            #pragma omp parallel for schedule(static) num_threads(numThreads) if (numThreads > 1) default(shared)
+            for (Nd4jLong b = 0; b < numBlocks; b++)
+                func(b * RANDOM_FILL_BLOCK, nd4j::math::nd4j_min<Nd4jLong>(RANDOM_FILL_BLOCK, length - b * RANDOM_FILL_BLOCK));
+        }
+
+        /**
+         * This method generates raw words for elements [offset, offset + blockLength) of given stream
+         */
+        template <typename C>
+        static FORCEINLINE void generate(nd4j::graph::RandomGenerator &rng, uint64_t stream, Nd4jLong offset, Nd4jLong blockLength, uint32_t *bits) {
+            // offset is multiple of RANDOM_FILL_BLOCK, so blocks never share counters
+            auto first = offset * Bits<C>::words / 4;
+            auto counters = (blockLength * Bits<C>::words + 3) / 4;
+
+            #pragma omp simd
+            for (Nd4jLong c = 0; c < counters; c++)
+                rng.philox(first + c, stream, bits + c * 4);
+        }
+
+        /**
+         * This method converts words into standard normal values: fast path of ziggurat is applied to the whole block,
+         * and the few rejected elements are resolved afterwards
+         */
+        template <typename C>
+        static void normalBlock(nd4j::graph::RandomGenerator &rng, const ZigguratTable<C> &table, uint64_t kind, Nd4jLong offset, Nd4jLong blockLength, const uint32_t *bits, C *buffer) {
+            bool rejected[RANDOM_FILL_BLOCK];
+
+            #pragma omp simd
+            for (Nd4jLong e = 0; e < blockLength; e++) {
+                auto w = bits + e * Bits<C>::words;
+                auto u = Bits<C>::symmetric(w);
+                auto i = Bits<C>::layer(w);
+
+                buffer[e] = u * table.x[i];
+                rejected[e] = nd4j::math::nd4j_abs<C>(u) >= table.r[i];
+            }
+
+            for (Nd4jLong e = 0; e < blockLength; e++)
+                if (rejected[e]) {
+                    auto w = bits + e * Bits<C>::words;
+                    uint32_t attempt = 0;
+                    buffer[e] = normalSlow<C>(rng, table, offset + e, kind, attempt, Bits<C>::symmetric(w), Bits<C>::layer(w));
+                }
+        }
+
+        /**
+         * This method draws complete standard normal value for given counter, starting at given attempt of given kind
+         */
+        template <typename C>
+        static C normalAt(nd4j::graph::RandomGenerator &rng, const ZigguratTable<C> &table, Nd4jLong counter, uint64_t kind, uint32_t &attempt) {
+            uint32_t w[4];
+            rng.philox(counter, stream(kind, attempt++), w);
+
+            auto u = Bits<C>::symmetric(w);
+            auto i = Bits<C>::layer(w);
+            if (nd4j::math::nd4j_abs<C>(u) < table.r[i])
+                return u * table.x[i];
+
+            return normalSlow<C>(rng, table, counter, kind, attempt, u, i);
+        }
+
+        /**
+         * Slow path of ziggurat for candidate (u, i) that failed the fast check: either tail beyond R is sampled,
+         * or candidate is checked against the wedge of density. Each attempt consumes fresh philox block
+         */
+        template <typename C>
+        static C normalSlow(nd4j::graph::RandomGenerator &rng, const ZigguratTable<C> &table, Nd4jLong counter, uint64_t kind, uint32_t &attempt, C u, int i) {
+            uint32_t w[4];
+
+            while (true) {
+                if (i == 0) {
+                    double x, y;
+                    do {
+                        rng.philox(counter, stream(kind, attempt++), w);
+                        x = -std::log(openUnit(w)) / ZIGGURAT_R;
+                        y = -std::log(openUnit(w + 2));
+                    } while (y + y < x * x);
+
+                    return static_cast<C>(u < static_cast<C>(0) ? -(ZIGGURAT_R + x) : ZIGGURAT_R + x);
+                }
+
+                rng.philox(counter, stream(kind, attempt++), w);
+
+                double x = static_cast<double>(u) * table.x[i];
+                double x0 = table.x[i];
+                double x1 = table.x[i + 1];
+                double f0 = std::exp(-0.5 * (x0 * x0 - x * x));
+                double f1 = std::exp(-0.5 * (x1 * x1 - x * x));
+
+                if (f1 + openUnit(w + 2) * (f0 - f1) < 1.0)
+                    return static_cast<C>(x);
+
+                // words 0 and 1 weren't used yet, they provide next candidate
+                u = Bits<C>::symmetric(w);
+                i = Bits<C>::layer(w);
+                if (nd4j::math::nd4j_abs<C>(u) < table.r[i])
+                    return u * table.x[i];
+            }
+        }
+    };
+
+    /**
+     * Single word per value: 24 upper bits give value, 7 lower bits give ziggurat layer
+     */
+    template <>
+    struct RandomFill::Bits<float> {
+        static const int words = 1;
+
+        static FORCEINLINE float unit(const uint32_t *w) {
+            return static_cast<float>(w[0] >> 8) * (1.0f / 16777216.0f);
+        }
+
+        static FORCEINLINE float symmetric(const uint32_t *w) {
+            return (static_cast<float>(w[0] >> 8) + 0.5f) * (1.0f / 8388608.0f) - 1.0f;
+        }
+
+        static FORCEINLINE int layer(const uint32_t *w) {
+            return static_cast<int>(w[0] & (ZIGGURAT_LAYERS - 1));
+        }
+    };
+
+    /**
+     * Two words per value: 53 upper bits give value, 7 lower bits of second word give ziggurat layer
+     */
+    template <>
+    struct RandomFill::Bits<double> {
+        static const int words = 2;
+
+        static FORCEINLINE double unit(const uint32_t *w) {
+            auto v = (static_cast<uint64_t>(w[0]) << 21) | (w[1] >> 11);
+            return static_cast<double>(v) * (1.0 / 9007199254740992.0);
+        }
+
+        static FORCEINLINE double symmetric(const uint32_t *w) {
+            auto v = (static_cast<uint64_t>(w[0]) << 21) | (w[1] >> 11);
+            return (static_cast<double>(v) + 0.5) * (1.0 / 4503599627370496.0) - 1.0;
+        }
+
+        static FORCEINLINE int layer(const uint32_t *w) {
+            return static_cast<int>(w[1] & (ZIGGURAT_LAYERS - 1));
+        }
+    };
+}
+
+#endif //LIBND4J_RANDOMFILL_H
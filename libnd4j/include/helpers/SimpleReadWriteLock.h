@@ -25,8 +25,9 @@
 #include <mutex>
 
 /**
- * This class provides PRIMITIVE read-write lock, and should NOT be used outside of GraphServer due to its inefficiency.
- * However, since GraphServer isn't supposed to have Reads/Writes ration even close to 1.0, it'll work just fine.
+ * This class provides PRIMITIVE read-write lock: waiting is done via spinning, so it's only suitable for short
+ * critical sections with Reads/Writes ratio far above 1.0, i.e. GraphServer or VariableSpace lookups.
+ * Lock isn't recursive, so neither read nor write lock may be obtained twice by the same thread.
  *
  * Basic idea: write lock won't be obtained before all read requests served
  */
@@ -53,6 +54,36 @@ namespace nd4j {
 
         SimpleReadWriteLock& operator= ( const SimpleReadWriteLock &other);
     };
+
+    /**
+     * Scoped read lock, released on scope exit, including exceptions
+     */
+    class ReadLockGuard {
+    private:
+        SimpleReadWriteLock &_lock;
+
+    public:
+        explicit ReadLockGuard(SimpleReadWriteLock &lock) : _lock(lock) { _lock.lockRead(); }
+        ~ReadLockGuard() { _lock.unlockRead(); }
+
+        ReadLockGuard(const ReadLockGuard&) = delete;
+        ReadLockGuard& operator=(const ReadLockGuard&) = delete;
+    };
+
+    /**
+     * Scoped write lock, released on scope exit, including exceptions
+     */
+    class WriteLockGuard {
+    private:
+        SimpleReadWriteLock &_lock;
+
+    public:
+        explicit WriteLockGuard(SimpleReadWriteLock &lock) : _lock(lock) { _lock.lockWrite(); }
+        ~WriteLockGuard() { _lock.unlockWrite(); }
+
+        WriteLockGuard(const WriteLockGuard&) = delete;
+        WriteLockGuard& operator=(const WriteLockGuard&) = delete;
+    };
 }
 
 
@@ -0,0 +1,229 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+//  @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_STRIDEDITERATOR_H
+#define LIBND4J_STRIDEDITERATOR_H
+
+#include <helpers/shape.h>
+#include <op_boilerplate.h>
+#include <templatemath.h>
+
+namespace nd4j {
+
+    /**
+     * This class tracks offset of c-order logical index within arbitrary strided array.
+     *
+     * Unit dimensions are dropped, and adjacent dimensions that are contiguous relative to each other are merged,
+     * so permuted/sliced views usually end up with rank 1 or 2. After single seek() offsets are
+     * updated incrementally: no div/mod chain per element, as shape::getIndexOffset() does.
+     */
+    class StridedCursor {
+    private:
+        int _rank;
+        Nd4jLong _shape[MAX_RANK];
+        Nd4jLong _stride[MAX_RANK];
+        Nd4jLong _coords[MAX_RANK];
+        Nd4jLong _offset;
+        bool _empty;
+
+    public:
+        explicit StridedCursor(const Nd4jLong *shapeInfo) {
+            const int rank = shape::rank(shapeInfo);
+            auto shapeOf = shapeInfo + 1;
+            auto strideOf = shapeInfo + 1 + rank;
+
+            // empty arrays have nothing to visit, and zero dimension would break div/mod in seek()
+            _empty = false;
+            for (int e = 0; e < rank; e++)
+                if (shapeOf[e] == 0)
+                    _empty = true;
+
+            if (_empty) {
+                _rank = 1;
+                _shape[0] = 0;
+                _stride[0] = 0;
+                _coords[0] = 0;
+                _offset = 0;
+                return;
+            }
+
+            _rank = 0;
+            for (int e = 0; e < rank; e++) {
+                if (shapeOf[e] == 1)
+                    continue;
+
+                // previous (outer) dimension is merged into this one if it just continues it
+                if (_rank > 0 && _stride[_rank - 1] == strideOf[e] * shapeOf[e]) {
+                    _shape[_rank - 1] *= shapeOf[e];
+                    _stride[_rank - 1] = strideOf[e];
+                    continue;
+                }
+
+                _shape[_rank] = shapeOf[e];
+                _stride[_rank] = strideOf[e];
+                _rank++;
+            }
+
+            // scalars and arrays of unit dimensions only
+            if (_rank == 0) {
+                _shape[0] = 1;
+                _stride[0] = 0;
+                _rank = 1;
+            }
+
+            seek(0);
+        }
+
+        /**
+         * This method moves cursor to given c-order logical index
+         */
+        FORCEINLINE void seek(Nd4jLong index) {
+            _offset = 0;
+            if (_empty)
+                return;
+
+            for (int e = _rank - 1; e >= 0; e--) {
+                _coords[e] = index % _shape[e];
+                index /= _shape[e];
+                _offset += _coords[e] * _stride[e];
+            }
+        }
+
+        FORCEINLINE Nd4jLong offset() const {
+            return _offset;
+        }
+
+        FORCEINLINE Nd4jLong innerStride() const {
+            return _stride[_rank - 1];
+        }
+
+        /**
+         * This method returns number of elements left till the end of current innermost run
+         */
+        FORCEINLINE Nd4jLong innerRemaining() const {
+            return _shape[_rank - 1] - _coords[_rank - 1];
+        }
+
+        /**
+         * This method moves cursor forward by given number of elements, which must not exceed innerRemaining()
+         */
+        FORCEINLINE void advance(Nd4jLong steps) {
+            const int last = _rank - 1;
+            _coords[last] += steps;
+            _offset += steps * _stride[last];
+
+            if (_coords[last] < _shape[last])
+                return;
+
+            _offset -= _shape[last] * _stride[last];
+            _coords[last] = 0;
+
+            for (int e = last - 1; e >= 0; e--) {
+                _coords[e]++;
+                _offset += _stride[e];
+
+                if (_coords[e] < _shape[e])
+                    return;
+
+                _offset -= _shape[e] * _stride[e];
+                _coords[e] = 0;
+            }
+        }
+    };
+
+
+    /**
+     * This class visits c-order logical range [start, start + length) of one or more arrays of equal length,
+     * passing offsets of each element into given functor. Innermost runs are walked with constant strides.
+     */
+    class StridedIterator {
+    public:
+        template <typename Func>
+        static FORCEINLINE void loop(Nd4jLong start, Nd4jLong length, const Nd4jLong *xShapeInfo, const Func &func) {
+            StridedCursor cx(xShapeInfo);
+            cx.seek(start);
+
+            while (length > 0) {
+                auto run = nd4j::math::nd4j_min<Nd4jLong>(length, cx.innerRemaining());
+                auto xOffset = cx.offset();
+                auto xStride = cx.innerStride();
+
+                for (Nd4jLong e = 0; e < run; e++)
+                    func(xOffset + e * xStride);
+
+                cx.advance(run);
+                length -= run;
+            }
+        }
+
+        template <typename Func>
+        static FORCEINLINE void loop(Nd4jLong start, Nd4jLong length, const Nd4jLong *xShapeInfo, const Nd4jLong *yShapeInfo, const Func &func) {
+            StridedCursor cx(xShapeInfo);
+            StridedCursor cy(yShapeInfo);
+            cx.seek(start);
+            cy.seek(start);
+
+            while (length > 0) {
+                auto run = nd4j::math::nd4j_min<Nd4jLong>(length, nd4j::math::nd4j_min<Nd4jLong>(cx.innerRemaining(), cy.innerRemaining()));
+                auto xOffset = cx.offset();
+                auto yOffset = cy.offset();
+                auto xStride = cx.innerStride();
+                auto yStride = cy.innerStride();
+
+                for (Nd4jLong e = 0; e < run; e++)
+                    func(xOffset + e * xStride, yOffset + e * yStride);
+
+                cx.advance(run);
+                cy.advance(run);
+                length -= run;
+            }
+        }
+
+        template <typename Func>
+        static FORCEINLINE void loop(Nd4jLong start, Nd4jLong length, const Nd4jLong *xShapeInfo, const Nd4jLong *yShapeInfo, const Nd4jLong *zShapeInfo, const Func &func) {
+            StridedCursor cx(xShapeInfo);
+            StridedCursor cy(yShapeInfo);
+            StridedCursor cz(zShapeInfo);
+            cx.seek(start);
+            cy.seek(start);
+            cz.seek(start);
+
+            while (length > 0) {
+                auto run = nd4j::math::nd4j_min<Nd4jLong>(length, nd4j::math::nd4j_min<Nd4jLong>(cx.innerRemaining(), nd4j::math::nd4j_min<Nd4jLong>(cy.innerRemaining(), cz.innerRemaining())));
+                auto xOffset = cx.offset();
+                auto yOffset = cy.offset();
+                auto zOffset = cz.offset();
+                auto xStride = cx.innerStride();
+                auto yStride = cy.innerStride();
+                auto zStride = cz.innerStride();
+
+                for (Nd4jLong e = 0; e < run; e++)
+                    func(xOffset + e * xStride, yOffset + e * yStride, zOffset + e * zStride);
+
+                cx.advance(run);
+                cy.advance(run);
+                cz.advance(run);
+                length -= run;
+            }
+        }
+    };
+}
+
+#endif //LIBND4J_STRIDEDITERATOR_H
@@ -51,6 +51,20 @@ namespace nd4j {
         this->lapackeDgesdd = (LapackeDgesdd)functions[9];
     }
 
+    void BlasHelper::initializeLapackFunctions(Nd4jPointer *functions) {
+        nd4j_debug("Initializing LAPACK\n","");
+
+        _hasSgetrf = functions[0] != nullptr;
+        _hasDgetrf = functions[1] != nullptr;
+        _hasSpotrf = functions[2] != nullptr;
+        _hasDpotrf = functions[3] != nullptr;
+
+        this->lapackeSgetrf = (LapackeSgetrf)functions[0];
+        this->lapackeDgetrf = (LapackeDgetrf)functions[1];
+        this->lapackeSpotrf = (LapackeSpotrf)functions[2];
+        this->lapackeDpotrf = (LapackeDpotrf)functions[3];
+    }
+
     void BlasHelper::initializeDeviceFunctions(Nd4jPointer *functions) {
         nd4j_debug("Initializing device BLAS\n","");
 
@@ -222,6 +236,46 @@ namespace nd4j {
         return false;
     }
 
+    template <>
+    bool BlasHelper::hasGETRF<float>() {
+        return _hasSgetrf;
+    }
+
+    template <>
+    bool BlasHelper::hasGETRF<double>() {
+        return _hasDgetrf;
+    }
+
+    template <>
+    bool BlasHelper::hasGETRF<float16>() {
+        return false;
+    }
+
+    template <>
+    bool BlasHelper::hasGETRF<bfloat16>() {
+        return false;
+    }
+
+    template <>
+    bool BlasHelper::hasPOTRF<float>() {
+        return _hasSpotrf;
+    }
+
+    template <>
+    bool BlasHelper::hasPOTRF<double>() {
+        return _hasDpotrf;
+    }
+
+    template <>
+    bool BlasHelper::hasPOTRF<float16>() {
+        return false;
+    }
+
+    template <>
+    bool BlasHelper::hasPOTRF<bfloat16>() {
+        return false;
+    }
+
     CblasSgemv BlasHelper::sgemv() {
         return this->cblasSgemv;
     }
@@ -261,6 +315,22 @@ namespace nd4j {
         return this->lapackeDgesdd;
     }
 
+    LapackeSgetrf BlasHelper::sgetrf() {
+        return this->lapackeSgetrf;
+    }
+
+    LapackeDgetrf BlasHelper::dgetrf() {
+        return this->lapackeDgetrf;
+    }
+
+    LapackeSpotrf BlasHelper::spotrf() {
+        return this->lapackeSpotrf;
+    }
+
+    LapackeDpotrf BlasHelper::dpotrf() {
+        return this->lapackeDpotrf;
+    }
+
     // destructor
     BlasHelper::~BlasHelper() noexcept { }
 
@@ -0,0 +1,194 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+//  @author raver119@gmail.com
+//
+
+#include <helpers/ConstantShapeHelper.h>
+#include <helpers/shape.h>
+#include <array/ArrayOptions.h>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <helpers/logger.h>
+
+namespace nd4j {
+
+    bool ConstantShapeHelper::ShapeDescriptor::operator==(const ShapeDescriptor &other) const {
+        return hash == other.hash && shapeInfo == other.shapeInfo;
+    }
+
+    size_t ConstantShapeHelper::ShapeDescriptorHash::operator()(const ShapeDescriptor &descriptor) const {
+        return static_cast<size_t>(descriptor.hash);
+    }
+
+    ConstantShapeHelper::ConstantShapeHelper() {
+        for (int e = 0; e < SHAPE_ARENA_MAX_CHUNKS; e++)
+            _chunks[e] = nullptr;
+
+        _numChunks = 0;
+        _chunkOffset = 0;
+        _entries = 0;
+        _hits = 0;
+        _misses = 0;
+        _overflow = false;
+    }
+
+    ConstantShapeHelper* ConstantShapeHelper::getInstance() {
+        if (_INSTANCE == 0)
+            _INSTANCE = new ConstantShapeHelper();
+
+        return _INSTANCE;
+    }
+
+    Nd4jLong* ConstantShapeHelper::bufferForShapeInfo(const Nd4jLong *shapeInfo, const bool copyStrides) {
+        ShapeDescriptor descriptor;
+        descriptor.shapeInfo.assign(shapeInfo, shapeInfo + shape::shapeInfoLength(shapeInfo));
+
+        if (!copyStrides)
+            shape::updateStrides(descriptor.shapeInfo.data(), shape::order(shapeInfo));
+
+        // FNV-1a over shapeInfo
+        Nd4jULong hash = 14695981039346656037ULL;
+        for (auto v: descriptor.shapeInfo)
+            hash = (hash ^ static_cast<Nd4jULong>(v)) * 1099511628211ULL;
+        descriptor.hash = static_cast<Nd4jLong>(hash);
+
+        // low bits are used by unordered_map buckets already, so shard is picked by high bits
+        auto &shard = _shards[(hash >> 32) % SHAPE_SHARDS];
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.cache.find(descriptor);
+        if (it != shard.cache.end()) {
+            _hits++;
+            return it->second;
+        }
+
+        _misses++;
+
+        auto buffer = allocateBuffer(descriptor.shapeInfo.size());
+        if (buffer == nullptr) {
+            // table is full: caller gets its own copy, and owns it
+            if (!_overflow.exchange(true))
+                nd4j_printf("ConstantShapeHelper: interning table is full, shapeInfos won't be shared from now on\n", "");
+
+            buffer = new Nd4jLong[descriptor.shapeInfo.size()];
+            std::memcpy(buffer, descriptor.shapeInfo.data(), descriptor.shapeInfo.size() * sizeof(Nd4jLong));
+            return buffer;
+        }
+
+        std::memcpy(buffer, descriptor.shapeInfo.data(), descriptor.shapeInfo.size() * sizeof(Nd4jLong));
+        shard.cache[descriptor] = buffer;
+        _entries++;
+
+        return buffer;
+    }
+
+    Nd4jLong* ConstantShapeHelper::allocateBuffer(size_t length) {
+        std::lock_guard<std::mutex> lock(_arenaLock);
+
+        int numChunks = _numChunks.load();
+        if (numChunks == 0 || _chunkOffset + (Nd4jLong) length > SHAPE_ARENA_CHUNK) {
+            if (numChunks == SHAPE_ARENA_MAX_CHUNKS)
+                return nullptr;
+
+            // chunk pointer has to be visible before counter is, since isInterned() reads them without lock
+            _chunks[numChunks].store(new Nd4jLong[SHAPE_ARENA_CHUNK], std::memory_order_release);
+            _numChunks.store(++numChunks, std::memory_order_release);
+            _chunkOffset = 0;
+        }
+
+        auto buffer = _chunks[numChunks - 1].load(std::memory_order_relaxed) + _chunkOffset;
+        _chunkOffset += length;
+
+        return buffer;
+    }
+
+    Nd4jLong* ConstantShapeHelper::createShapeInfo(nd4j::DataType dataType, char order, const std::vector<Nd4jLong> &shape) {
+        int rank = shape.size();
+
+        if (rank > MAX_RANK)
+            throw std::invalid_argument("Rank of NDArray can't exceed 32");
+
+        if (rank > 0 && shape[0] == 0)
+            rank = 0;
+
+        if (rank == 0)
+            return scalarShapeInfo(dataType);
+
+        Nd4jLong shapeInfo[MAX_SHAPEINFOLENGTH];
+        std::memset(shapeInfo, 0, sizeof(shapeInfo));
+
+        shapeInfo[0] = rank;
+        for (int e = 0; e < rank; e++)
+            shapeInfo[e + 1] = shape[e];
+
+        shape::updateStrides(shapeInfo, order);
+        ArrayOptions::setDataType(shapeInfo, dataType);
+
+        return bufferForShapeInfo(shapeInfo);
+    }
+
+    Nd4jLong* ConstantShapeHelper::scalarShapeInfo(nd4j::DataType dataType) {
+        Nd4jLong shapeInfo[] = {0, 0, 1, 99};
+        ArrayOptions::setDataType(shapeInfo, dataType);
+
+        return bufferForShapeInfo(shapeInfo);
+    }
+
+    Nd4jLong* ConstantShapeHelper::emptyShapeInfo(nd4j::DataType dataType) {
+        Nd4jLong shapeInfo[] = {0, 0, 1, 99};
+        ArrayOptions::setDataType(shapeInfo, dataType);
+        ArrayOptions::setPropertyBit(shapeInfo, ARRAY_EMPTY);
+
+        return bufferForShapeInfo(shapeInfo);
+    }
+
+    bool ConstantShapeHelper::isInterned(const Nd4jLong *shapeInfo) {
+        if (shapeInfo == nullptr)
+            return false;
+
+        auto pointer = reinterpret_cast<uintptr_t>(shapeInfo);
+        int numChunks = _numChunks.load(std::memory_order_acquire);
+        for (int e = 0; e < numChunks; e++) {
+            auto chunk = reinterpret_cast<uintptr_t>(_chunks[e].load(std::memory_order_acquire));
+            if (pointer >= chunk && pointer < chunk + SHAPE_ARENA_CHUNK * sizeof(Nd4jLong))
+                return true;
+        }
+
+        return false;
+    }
+
+    int ConstantShapeHelper::cachedEntries() {
+        return _entries.load();
+    }
+
+    int ConstantShapeHelper::allocatedChunks() {
+        return _numChunks.load();
+    }
+
+    Nd4jLong ConstantShapeHelper::cacheHits() {
+        return _hits.load();
+    }
+
+    Nd4jLong ConstantShapeHelper::cacheMisses() {
+        return _misses.load();
+    }
+
+    ConstantShapeHelper* ConstantShapeHelper::_INSTANCE = 0;
+}
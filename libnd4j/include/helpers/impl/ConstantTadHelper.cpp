@@ -0,0 +1,182 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+//  @author raver119@gmail.com
+//
+
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/TAD.h>
+#include <helpers/shape.h>
+#include <algorithm>
+
+namespace nd4j {
+
+    bool ConstantTadHelper::TadEntry::matches(const Nd4jLong *shapeInfo, int shapeInfoLength, const int *dimensions, int dimensionLength) const {
+        return (int) this->shapeInfo.size() == shapeInfoLength && (int) this->dimensions.size() == dimensionLength
+                && std::equal(this->dimensions.begin(), this->dimensions.end(), dimensions)
+                && std::equal(this->shapeInfo.begin(), this->shapeInfo.end(), shapeInfo);
+    }
+
+    ConstantTadHelper::ConstantTadHelper() {
+        _capacity = 4096;
+        _entries = 0;
+        _clock = 0;
+        _hits = 0;
+        _misses = 0;
+    }
+
+    ConstantTadHelper* ConstantTadHelper::getInstance() {
+        if (_INSTANCE == 0)
+            _INSTANCE = new ConstantTadHelper();
+
+        return _INSTANCE;
+    }
+
+    std::shared_ptr<TadPack> ConstantTadHelper::tadForDimensions(Nd4jLong *shapeInfo, const std::vector<int> &dimensions) {
+        return tadForDimensions(shapeInfo, const_cast<int *>(dimensions.data()), static_cast<int>(dimensions.size()));
+    }
+
+    std::shared_ptr<TadPack> ConstantTadHelper::tadForDimensions(Nd4jLong *shapeInfo, int *dimensions, int dimensionLength) {
+        const int shapeInfoLength = shape::shapeInfoLength(shapeInfo);
+
+        // FNV-1a over shapeInfo and dimensions
+        Nd4jULong hash = 14695981039346656037ULL;
+        for (int e = 0; e < shapeInfoLength; e++)
+            hash = (hash ^ static_cast<Nd4jULong>(shapeInfo[e])) * 1099511628211ULL;
+        for (int e = 0; e < dimensionLength; e++)
+            hash = (hash ^ static_cast<Nd4jULong>(dimensions[e])) * 1099511628211ULL;
+
+        auto key = static_cast<Nd4jLong>(hash);
+        auto &shard = _shards[(hash >> 32) % TAD_SHARDS];
+
+        {
+            ReadLockGuard lock(shard.lock);
+
+            auto range = shard.cache.equal_range(key);
+            for (auto it = range.first; it != range.second; ++it) {
+                auto entry = it->second.get();
+                if (entry->matches(shapeInfo, shapeInfoLength, dimensions, dimensionLength)) {
+                    _hits++;
+
+                    // clock ticks on insertions only, so hot entries are written once per miss at most
+                    auto now = _clock.load(std::memory_order_relaxed);
+                    if (entry->lastUsed.load(std::memory_order_relaxed) != now)
+                        entry->lastUsed.store(now, std::memory_order_relaxed);
+
+                    return entry->pack;
+                }
+            }
+        }
+
+        _misses++;
+
+        // TAD is built outside of lock, concurrent misses for the same key are resolved below
+        shape::TAD tad(shapeInfo, dimensions, dimensionLength);
+        tad.createTadOnlyShapeInfo();
+        tad.createOffsets();
+
+        auto pack = std::make_shared<TadPack>(tad.tadOnlyShapeInfo, tad.tadOffsets, tad.numTads, tad.dimensionLength, tad.wholeThing);
+
+        {
+            WriteLockGuard lock(shard.lock);
+
+            auto range = shard.cache.equal_range(key);
+            for (auto it = range.first; it != range.second; ++it)
+                if (it->second->matches(shapeInfo, shapeInfoLength, dimensions, dimensionLength))
+                    return it->second->pack;
+
+            std::unique_ptr<TadEntry> entry(new TadEntry());
+            entry->shapeInfo.assign(shapeInfo, shapeInfo + shapeInfoLength);
+            entry->dimensions.assign(dimensions, dimensions + dimensionLength);
+            entry->pack = pack;
+            entry->lastUsed = ++_clock;
+
+            shard.cache.emplace(key, std::move(entry));
+            _entries++;
+        }
+
+        auto capacity = _capacity.load();
+        if (_entries.load() > capacity)
+            evict(capacity - capacity / 8);
+
+        return pack;
+    }
+
+    void ConstantTadHelper::evict(int limit) {
+        std::unique_lock<std::mutex> guard(_evictionLock, std::try_to_lock);
+        if (!guard.owns_lock())
+            return;
+
+        // stamps are collected shard by shard, so entries touched meanwhile might be evicted a bit early. that's fine for cache
+        std::vector<Nd4jLong> stamps;
+        for (auto &shard: _shards) {
+            ReadLockGuard lock(shard.lock);
+            for (auto &v: shard.cache)
+                stamps.emplace_back(v.second->lastUsed.load(std::memory_order_relaxed));
+        }
+
+        if ((int) stamps.size() <= limit)
+            return;
+
+        // everything older than (size - limit)-th stamp goes away
+        auto cut = stamps.size() - limit;
+        std::nth_element(stamps.data(), stamps.data() + cut, stamps.data() + stamps.size());
+        auto threshold = stamps[cut];
+
+        for (auto &shard: _shards) {
+            WriteLockGuard lock(shard.lock);
+            for (auto it = shard.cache.begin(); it != shard.cache.end(); ) {
+                if (it->second->lastUsed.load(std::memory_order_relaxed) < threshold) {
+                    it = shard.cache.erase(it);
+                    _entries--;
+                } else
+                    ++it;
+            }
+        }
+    }
+
+    void ConstantTadHelper::setCapacity(int capacity) {
+        _capacity = capacity < 1 ? 1 : capacity;
+
+        if (_entries.load() > _capacity.load())
+            evict(_capacity.load());
+    }
+
+    int ConstantTadHelper::cachedEntries() {
+        return _entries.load();
+    }
+
+    Nd4jLong ConstantTadHelper::cacheHits() {
+        return _hits.load();
+    }
+
+    Nd4jLong ConstantTadHelper::cacheMisses() {
+        return _misses.load();
+    }
+
+    void ConstantTadHelper::purge() {
+        std::lock_guard<std::mutex> guard(_evictionLock);
+
+        for (auto &shard: _shards) {
+            WriteLockGuard lock(shard.lock);
+            _entries -= static_cast<int>(shard.cache.size());
+            shard.cache.clear();
+        }
+    }
+
+    ConstantTadHelper* ConstantTadHelper::_INSTANCE = 0;
+}
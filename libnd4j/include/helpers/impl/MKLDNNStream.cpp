@@ -0,0 +1,245 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+//  @author raver119@gmail.com
+//
+
+#ifdef HAVE_MKLDNN
+
+#include <helpers/MKLDNNStream.h>
+#include <helpers/shape.h>
+
+namespace nd4j {
+
+    template <typename T>
+    static FORCEINLINE void appendBytes(std::string &key, const T &value) {
+        key.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    std::string MKLDNNStream::buildKey(const std::string &opName, const std::vector<const NDArray*> &inputs, const std::vector<const NDArray*> &outputs,
+            const std::vector<float> &floatArguments, const std::vector<int> &intArguments) {
+        std::string key(opName);
+        key += '\0';
+
+        std::vector<const NDArray*> arrays(inputs);
+        arrays.insert(arrays.end(), outputs.begin(), outputs.end());
+
+        for (int e = 0; e < (int) arrays.size(); e++) {
+            auto array = arrays[e];
+            if (array == nullptr) {
+                appendBytes(key, (Nd4jLong) -1);
+                continue;
+            }
+
+            auto shapeInfo = array->getShapeInfo();
+            key.append(reinterpret_cast<const char *>(shapeInfo), shape::shapeInfoByteLength(shapeInfo));
+
+            // arrays without buffer and arrays sharing buffer with others produce different memory bindings
+            auto buffer = array->getBuffer();
+            int alias = buffer == nullptr ? -2 : -1;
+            for (int i = 0; i < e && alias == -1; i++)
+                if (arrays[i] != nullptr && arrays[i]->getBuffer() == buffer)
+                    alias = i;
+
+            appendBytes(key, alias);
+        }
+
+        appendBytes(key, (Nd4jLong) floatArguments.size());
+        for (auto v: floatArguments)
+            appendBytes(key, v);
+
+        appendBytes(key, (Nd4jLong) intArguments.size());
+        for (auto v: intArguments)
+            appendBytes(key, v);
+
+        return key;
+    }
+
+    void MKLDNNStream::bind(const std::vector<const NDArray*> &inputs, const std::vector<const NDArray*> &outputs) {
+        _inputs = inputs;
+        _outputs = outputs;
+
+        for (int e = 0; e < (int) _bindings.size(); e++) {
+            auto index = _bindings[e];
+            if (index < 0)
+                continue;
+
+            auto array = index < (int) inputs.size() ? inputs[index] : outputs[index - inputs.size()];
+            _memory[e].set_data_handle(array->getBuffer());
+        }
+    }
+
+    bool MKLDNNStream::acquire(std::vector<MKLDNNStream> &streams, const std::vector<const NDArray*> &inputs, const std::vector<const NDArray*> &outputs,
+            const std::vector<float> &floatArguments, const std::vector<int> &intArguments) {
+        auto key = buildKey(streams[0]._opName, inputs, outputs, floatArguments, intArguments);
+
+        // shapes didn't change since last call within this context: only buffers might have been changed
+        if (streams[0]._key == key) {
+            for (auto &stream: streams)
+                stream.bind(inputs, outputs);
+
+            return false;
+        }
+
+        // previous group goes to cache, and fresh streams with the same names take its place
+        if (!streams[0]._key.empty()) {
+            std::vector<MKLDNNStream> fresh;
+            for (auto &stream: streams)
+                fresh.emplace_back(stream._opName);
+
+            release(streams);
+            streams = std::move(fresh);
+        }
+
+        std::vector<MKLDNNStream> cached;
+        if (MKLDNNStreamCache::getInstance()->checkout(key, cached)) {
+            streams = std::move(cached);
+            for (auto &stream: streams)
+                stream.bind(inputs, outputs);
+
+            return false;
+        }
+
+        std::vector<void*> buffers;
+        for (auto array: inputs)
+            buffers.emplace_back(array == nullptr ? nullptr : array->getBuffer());
+        for (auto array: outputs)
+            buffers.emplace_back(array == nullptr ? nullptr : array->getBuffer());
+
+        for (auto &stream: streams) {
+            stream.checkAndReset(inputs, outputs, floatArguments, intArguments);
+            stream._key = key;
+            stream._buffers = buffers;
+        }
+
+        return true;
+    }
+
+    void MKLDNNStream::release(std::vector<MKLDNNStream> &streams) {
+        if (streams.empty() || streams[0]._key.empty())
+            return;
+
+        // group whose build didn't complete (i.e. op failed before setting primitives) can't be reused
+        for (auto &stream: streams)
+            if (stream._operations.empty()) {
+                streams.clear();
+                return;
+            }
+
+        // streams might've been added to the group while building it, they share buffers of the first one
+        const auto &buffers = streams[0]._buffers;
+        for (auto &stream: streams) {
+            if (stream._bindings.size() == stream._memory.size())
+                continue;
+
+            stream._bindings.resize(stream._memory.size());
+            for (int e = 0; e < (int) stream._memory.size(); e++) {
+                auto handle = stream._memory[e].get_data_handle();
+
+                stream._bindings[e] = -1;
+                for (int i = 0; i < (int) buffers.size(); i++)
+                    if (buffers[i] != nullptr && buffers[i] == handle) {
+                        stream._bindings[e] = i;
+                        break;
+                    }
+            }
+        }
+
+        // cached streams must not keep pointers to arrays of finished call
+        for (auto &stream: streams) {
+            stream._inputs.clear();
+            stream._outputs.clear();
+        }
+
+        auto key = streams[0]._key;
+        MKLDNNStreamCache::getInstance()->release(key, std::move(streams));
+        streams.clear();
+    }
+
+
+    MKLDNNStreamCache* MKLDNNStreamCache::getInstance() {
+        if (_INSTANCE == 0)
+            _INSTANCE = new MKLDNNStreamCache();
+
+        return _INSTANCE;
+    }
+
+    bool MKLDNNStreamCache::checkout(const std::string &key, std::vector<MKLDNNStream> &streams) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _cache.find(key);
+        if (it == _cache.end()) {
+            _misses++;
+            return false;
+        }
+
+        _hits++;
+        streams = std::move(it->second->second);
+        _lru.erase(it->second);
+        _cache.erase(it);
+
+        return true;
+    }
+
+    void MKLDNNStreamCache::release(const std::string &key, std::vector<MKLDNNStream> &&streams) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _lru.emplace_front(key, std::move(streams));
+        _cache.emplace(key, _lru.begin());
+
+        evict();
+    }
+
+    void MKLDNNStreamCache::evict() {
+        while ((int) _lru.size() > _capacity) {
+            auto range = _cache.equal_range(_lru.back().first);
+            for (auto it = range.first; it != range.second; ++it)
+                if (it->second == std::prev(_lru.end())) {
+                    _cache.erase(it);
+                    break;
+                }
+
+            _lru.pop_back();
+        }
+    }
+
+    void MKLDNNStreamCache::setCapacity(int capacity) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _capacity = capacity < 1 ? 1 : capacity;
+        evict();
+    }
+
+    int MKLDNNStreamCache::cachedEntries() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return static_cast<int>(_lru.size());
+    }
+
+    Nd4jLong MKLDNNStreamCache::totalHits() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _hits;
+    }
+
+    Nd4jLong MKLDNNStreamCache::totalMisses() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _misses;
+    }
+
+    MKLDNNStreamCache* MKLDNNStreamCache::_INSTANCE = 0;
+}
+
+#endif
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+//  @author raver119@gmail.com
+//
+
+#include <helpers/MappedNumpy.h>
+#include <stdexcept>
+
+namespace nd4j {
+
+    MappedNumpy::~MappedNumpy() {
+        // views go first, mapping is released together with sources
+        for (auto array: _arrays)
+            delete array;
+    }
+
+    MappedNumpy* MappedNumpy::fromNpy(const std::string &path, bool prefetch) {
+        auto result = new MappedNumpy();
+
+        try {
+            result->append("", cnpy::npyMap(path, prefetch));
+        } catch (...) {
+            delete result;
+            throw;
+        }
+
+        return result;
+    }
+
+    MappedNumpy* MappedNumpy::fromNpz(const std::string &path, bool prefetch) {
+        auto result = new MappedNumpy();
+
+        try {
+            auto arrays = cnpy::npzMap(path, prefetch);
+            for (auto &pair: arrays)
+                result->append(pair.first, pair.second);
+        } catch (...) {
+            delete result;
+            throw;
+        }
+
+        return result;
+    }
+
+    int MappedNumpy::size() const {
+        return static_cast<int>(_arrays.size());
+    }
+
+    const std::string& MappedNumpy::name(int index) const {
+        return _names.at(index);
+    }
+
+    NDArray* MappedNumpy::at(int index) const {
+        return _arrays.at(index);
+    }
+
+    NDArray* MappedNumpy::at(const std::string &name) const {
+        for (size_t e = 0; e < _names.size(); e++)
+            if (_names[e] == name)
+                return _arrays[e];
+
+        return nullptr;
+    }
+
+    nd4j::DataType MappedNumpy::dataType(char type, unsigned int wordSize) {
+        switch (type) {
+            case 'f':
+                switch (wordSize) {
+                    case 2: return nd4j::DataType::HALF;
+                    case 4: return nd4j::DataType::FLOAT32;
+                    case 8: return nd4j::DataType::DOUBLE;
+                }
+                break;
+            case 'i':
+                switch (wordSize) {
+                    case 1: return nd4j::DataType::INT8;
+                    case 2: return nd4j::DataType::INT16;
+                    case 4: return nd4j::DataType::INT32;
+                    case 8: return nd4j::DataType::INT64;
+                }
+                break;
+            case 'u':
+                switch (wordSize) {
+                    case 1: return nd4j::DataType::UINT8;
+                    case 2: return nd4j::DataType::UINT16;
+                    case 4: return nd4j::DataType::UINT32;
+                    case 8: return nd4j::DataType::UINT64;
+                }
+                break;
+            case 'b':
+                if (wordSize == 1)
+                    return nd4j::DataType::BOOL;
+                break;
+        }
+
+        throw std::runtime_error(std::string("MappedNumpy: unsupported numpy type ") + type + std::to_string(wordSize));
+    }
+
+    void MappedNumpy::append(const std::string &name, const cnpy::NpyArray &source) {
+        auto dtype = dataType(source.type, source.wordSize);
+
+        std::vector<Nd4jLong> shape(source.shape.begin(), source.shape.end());
+        auto array = new NDArray(source.data, source.fortranOrder ? 'f' : 'c', shape, dtype);
+
+        _sources.emplace_back(source);
+        _names.emplace_back(name);
+        _arrays.emplace_back(array);
+    }
+}
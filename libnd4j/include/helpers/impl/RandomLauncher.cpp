@@ -23,10 +23,30 @@
 #include <helpers/RandomLauncher.h>
 #include <graph/RandomGenerator.h>
 #include <ops/declarable/CustomOperations.h>
+#include <helpers/RandomFill.h>
 
 namespace nd4j {
     // FIXME: implement this
 
+    template <typename T>
+    static void fillUniform_(nd4j::graph::RandomGenerator& rng, NDArray* array, double from, double to) {
+        RandomFill::uniform<T>(rng, array->bufferAsT<T>(), array->lengthOf(), static_cast<T>(from), static_cast<T>(to));
+    }
+
+    template <typename T>
+    static void fillBernoulli_(nd4j::graph::RandomGenerator& rng, NDArray* array, double prob) {
+        RandomFill::bernoulli<T>(rng, array->bufferAsT<T>(), array->lengthOf(), static_cast<T>(prob));
+    }
+
+    // contiguous floating point arrays are filled in bulk on host, via counter-based generator
+    static FORCEINLINE bool isBulkFillable(NDArray* array) {
+#ifdef __CUDABLAS__
+        return false;
+#else
+        return array->isR() && array->ews() == 1;
+#endif
+    }
+
     void RandomLauncher::applyDropOut(nd4j::graph::RandomGenerator& rng, NDArray *array, double retainProb, NDArray* z) {
         if (z == nullptr)
             z = array;
@@ -70,6 +90,12 @@ namespace nd4j {
     }
 
     void RandomLauncher::fillBernoulli(nd4j::graph::RandomGenerator& rng, NDArray* array, double prob) {
+        if (isBulkFillable(array)) {
+            BUILD_SINGLE_SELECTOR(array->dataType(), fillBernoulli_, (rng, array, prob), FLOAT_TYPES);
+            rng.rewindH(array->lengthOf());
+            return;
+        }
+
         auto extra = NDArrayFactory::create(prob);
         auto extraPtr = extra.getBufferAsPointer(array->dataType());
 
@@ -79,6 +105,12 @@ namespace nd4j {
     }
 
     void RandomLauncher::fillUniform(nd4j::graph::RandomGenerator& rng, NDArray* array, double from, double to) {
+        if (isBulkFillable(array)) {
+            BUILD_SINGLE_SELECTOR(array->dataType(), fillUniform_, (rng, array, from, to), FLOAT_TYPES);
+            rng.rewindH(array->lengthOf());
+            return;
+        }
+
         auto extra = NDArrayFactory::create(array->dataType(), {2}, {from, to});
         auto extraPtr = extra.getBufferAsPointer(array->dataType());
 
@@ -132,4 +164,7 @@ namespace nd4j {
 
         delete[] (reinterpret_cast<int8_t *>(extraPtr));
     }
+
+    BUILD_SINGLE_TEMPLATE(template void fillUniform_, (nd4j::graph::RandomGenerator& rng, NDArray* array, double from, double to), FLOAT_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void fillBernoulli_, (nd4j::graph::RandomGenerator& rng, NDArray* array, double prob), FLOAT_TYPES);
 }
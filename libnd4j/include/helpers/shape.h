@@ -3036,6 +3036,10 @@ template <typename T>
      * @return
      */
     INLINEDEF _CUDA_HD bool equalsStrict(Nd4jLong *shapeA, Nd4jLong *shapeB) {
+        // shared (i.e. interned) shapeInfo needs no comparison
+        if (shapeA == shapeB)
+            return true;
+
         if (shapeA[0] != shapeB[0])
             return false;
 
@@ -3066,6 +3070,10 @@ template <typename T>
      * @return
      */
     INLINEDEF _CUDA_HD bool equalsSoft(const Nd4jLong *shapeA, const Nd4jLong *shapeB) {
+        // shared (i.e. interned) shapeInfo needs no comparison
+        if (shapeA == shapeB)
+            return true;
+
         if (shapeA[0] != shapeB[0])
             return false;
 
@@ -3083,6 +3091,8 @@ template <typename T>
     }
 
     INLINEDEF _CUDA_HD bool equalsTypesAndShapesSoft(const Nd4jLong *shapeA, const Nd4jLong *shapeB) {
+        if (shapeA == shapeB)
+            return true;
 
         return equalsSoft(shapeA, shapeB) && shapeA[shapeInfoLength(shapeA) - 3] == shapeB[shapeInfoLength(shapeB) - 3];
     }
@@ -22,6 +22,8 @@
 #include <loops/broadcasting.h>
 #include <loops/legacy_ops.h>
 #include <types/types.h>
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/StridedIterator.h>
 
 using namespace simdOps;
 
@@ -81,15 +83,13 @@ namespace functions {
                 //permuted version of the x shape info for setting up the tad problem
                 auto tadShapeShapeInfo = tadShapeInfo;
                 auto tadOffsets = tadOffset;
-                shape::TAD *tad = nullptr;
+                std::shared_ptr<nd4j::TadPack> tadPack;
 
                 if (tadShapeInfo == nullptr || tadOffsets == nullptr) {
-                    tad = new shape::TAD(xShapeInfo, dimension, dimensionLength);
-                    tad->createTadOnlyShapeInfo();
-                    tad->createOffsets();
+                    tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(xShapeInfo, dimension, dimensionLength);
 
-                    tadShapeShapeInfo = tad->tadOnlyShapeInfo;
-                    tadOffsets = tad->tadOffsets;
+                    tadShapeShapeInfo = tadPack->primaryShapeInfo();
+                    tadOffsets = tadPack->primaryOffsets();
                 }
 
                 //int *resultStride = shape::stride(tadShapeShapeInfo);                
@@ -104,8 +104,6 @@ namespace functions {
                 }
 
                 auto zEWS = shape::elementWiseStride(tadShapeInfoZ);
-                auto lenZ = shape::length(tadShapeInfoZ);
-                auto lenY = shape::length(yShapeInfo);
 
                 int tadsPerThread = tads / TAD_THRESHOLD;
                 int _threads = nd4j::math::nd4j_max<int>(1, tadsPerThread);
@@ -135,19 +133,11 @@ namespace functions {
 
                         // TODO: cover this codebranch with tests
                         // all this stuff already happens within thread                        
-                        for (int f = 0; f < tadLength; f++) {                            
-
-                            auto xOffset = offset + shape::getIndexOffset(f, tadShapeShapeInfo, tadLength);
-                            auto zOffset = offsetZ + shape::getIndexOffset(f, tadShapeInfoZ, lenZ);
-                            auto yOffset = shape::getIndexOffset(f, yShapeInfo, lenY);
-
-                            z[zOffset] = OpType::op(x[xOffset], y[yOffset]);
-                        }
+                        nd4j::StridedIterator::loop(0, tadLength, tadShapeShapeInfo, yShapeInfo, tadShapeInfoZ, [&](Nd4jLong xOffset, Nd4jLong yOffset, Nd4jLong zOffset) {
+                            z[offsetZ + zOffset] = OpType::op(x[offset + xOffset], y[yOffset]);
+                        });
                     }
                 }
-
-                if (tad != nullptr)
-                    delete tad;
         }
     }
 }
\ No newline at end of file
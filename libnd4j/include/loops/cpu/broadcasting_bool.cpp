@@ -22,6 +22,8 @@
 #include <loops/broadcasting_bool.h>
 #include <loops/legacy_ops.h>
 #include <types/types.h>
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/StridedIterator.h>
 
 using namespace simdOps;
 
@@ -81,15 +83,13 @@ namespace functions {
                 //permuted version of the x shape info for setting up the tad problem
                 auto tadShapeShapeInfo = tadShapeInfo;
                 auto tadOffsets = tadOffset;
-                shape::TAD *tad = nullptr;
+                std::shared_ptr<nd4j::TadPack> tadPack;
 
                 if (tadShapeInfo == nullptr || tadOffsets == nullptr) {
-                    tad = new shape::TAD(xShapeInfo, dimension, dimensionLength);
-                    tad->createTadOnlyShapeInfo();
-                    tad->createOffsets();
+                    tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(xShapeInfo, dimension, dimensionLength);
 
-                    tadShapeShapeInfo = tad->tadOnlyShapeInfo;
-                    tadOffsets = tad->tadOffsets;
+                    tadShapeShapeInfo = tadPack->primaryShapeInfo();
+                    tadOffsets = tadPack->primaryOffsets();
                 }
 
                 //int *resultStride = shape::stride(tadShapeShapeInfo);
@@ -133,19 +133,11 @@ namespace functions {
                     else {                        
                         // TODO: cover this codebranch with tests
                         // all this stuff already happens within thread
-                        for (int f = 0; f < tadLength; f++) {
-
-                            auto xOffset = offset + shape::getIndexOffset(f, tadShapeShapeInfo, tadLength);
-                            auto zOffset = offsetZ + shape::getIndexOffset(f, tadShapeInfoZ, tadLength);
-                            auto yOffset = shape::getIndexOffset(f, yShapeInfo, tadLength);
-
-                            z[zOffset] = OpType::op(x[xOffset], y[yOffset]);
-                        }
+                        nd4j::StridedIterator::loop(0, tadLength, tadShapeShapeInfo, yShapeInfo, tadShapeInfoZ, [&](Nd4jLong xOffset, Nd4jLong yOffset, Nd4jLong zOffset) {
+                            z[offsetZ + zOffset] = OpType::op(x[offset + xOffset], y[yOffset]);
+                        });
                     }
                 }
-
-                if (tad != nullptr)
-                    delete tad;
         }
 
         BUILD_DOUBLE_TEMPLATE(template class ND4J_EXPORT BroadcastBool, , LIBND4J_TYPES, BOOL_TYPES);
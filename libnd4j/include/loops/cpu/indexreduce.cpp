@@ -22,6 +22,7 @@
 #include <op_boilerplate.h>
 #include <types/types.h>
 #include "../legacy_ops.h"
+#include <helpers/ConstantTadHelper.h>
 
 using namespace simdOps;
 
@@ -117,20 +118,16 @@ void IndexReduce<X>::exec(void *vx, Nd4jLong *xShapeInfo,
 
     auto tadOnlyShapeInfo = tadShapeInfo;
     Nd4jLong *tadOffsets = tadOffset;
-    shape::TAD *tad = nullptr;
+    std::shared_ptr<nd4j::TadPack> tadPack;
 
     if (tadOnlyShapeInfo == nullptr || tadOffsets == nullptr) {
-        tad = new shape::TAD(xShapeInfo, dimension, dimensionLength);
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(xShapeInfo, dimension, dimensionLength);
 
-        if (tad->dimensionLength < 1) {
-            delete tad;
+        if (tadPack->isEmpty())
             return;
-        }
 
-        tadOnlyShapeInfo = tad->tadOnlyShapeInfo;
-        tadOffsets = tad->tadOffsets;
+        tadOnlyShapeInfo = tadPack->primaryShapeInfo();
+        tadOffsets = tadPack->primaryOffsets();
     }
 
     auto tadEws = shape::elementWiseStride(tadOnlyShapeInfo);
@@ -25,6 +25,7 @@
 #include <helpers/shape.h>
 #include <op_boilerplate.h>
 #include <OmpLaunchHelper.h>
+#include <helpers/StridedIterator.h>
 
 using namespace simdOps;
 
@@ -165,12 +166,9 @@ namespace functions {
                         auto threadNum = omp_get_thread_num();
                         Nd4jLong threadOffset = info.getThreadOffset(threadNum);        
                      
-                        #pragma omp simd
-                        for(Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++)  {
-                            auto xOffset = shape::getIndexOffset(i+threadOffset, xShapeInfo, n);
-                            auto zOffset = shape::getIndexOffset(i+threadOffset, zShapeInfo, n);
+                        nd4j::StridedIterator::loop(threadOffset, info.getItersPerThread(threadNum), xShapeInfo, zShapeInfo, [&](Nd4jLong xOffset, Nd4jLong zOffset) {
                             z[zOffset] = OpType::op(x[xOffset], y[0], extraParams);
-                        }
+                        });
                     }
                 }
                 return;
@@ -199,12 +197,9 @@ namespace functions {
                         auto threadNum = omp_get_thread_num();
                         Nd4jLong threadOffset = info.getThreadOffset(threadNum);        
                      
-                        #pragma omp simd
-                        for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++)  {
-                            auto xOffset = shape::getIndexOffset(i+threadOffset, xShapeInfo, n);
-                            auto yOffset = shape::getIndexOffset(i+threadOffset, yShapeInfo, n);
+                        nd4j::StridedIterator::loop(threadOffset, info.getItersPerThread(threadNum), xShapeInfo, yShapeInfo, [&](Nd4jLong xOffset, Nd4jLong yOffset) {
                             z[xOffset] = OpType::op(x[xOffset], y[yOffset], extraParams);
-                        }
+                        });
                     }
                 }
                 else {
@@ -214,13 +209,9 @@ namespace functions {
                         auto threadNum = omp_get_thread_num();
                         Nd4jLong threadOffset = info.getThreadOffset(threadNum);        
                      
-                        #pragma omp simd
-                        for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++)  {
-                            auto xOffset = shape::getIndexOffset(i+threadOffset, xShapeInfo, n);
-                            auto yOffset = shape::getIndexOffset(i+threadOffset, yShapeInfo, n);
-                            auto zOffset = shape::getIndexOffset(i+threadOffset, zShapeInfo, n);
+                        nd4j::StridedIterator::loop(threadOffset, info.getItersPerThread(threadNum), xShapeInfo, yShapeInfo, zShapeInfo, [&](Nd4jLong xOffset, Nd4jLong yOffset, Nd4jLong zOffset) {
                             z[zOffset] = OpType::op(x[xOffset], y[yOffset], extraParams);
-                        }
+                        });
                     }
                 }
             }
@@ -0,0 +1,199 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+//  @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_REDUCE_LOOPS_HPP
+#define LIBND4J_REDUCE_LOOPS_HPP
+
+#include <helpers/shape.h>
+#include <OmpLaunchHelper.h>
+#include <helpers/StridedIterator.h>
+#include <memory>
+
+// number of independent accumulators within block, keeps simd lanes busy and shortens dependency chains
+#define REDUCE_LANES 8
+
+// number of elements in block. each block is always reduced by single thread
+#define REDUCE_BLOCK 4096
+
+namespace functions {
+    namespace reduce {
+
+        /**
+         * Reduction engine shared by ReduceFloat/Same/Bool/Long.
+         *
+         * Input is split into fixed-size blocks, each block is reduced into REDUCE_LANES independent accumulators,
+         * and then lanes and blocks are combined as a balanced binary tree. The tree shape depends only on length,
+         * so results are identical regardless of number of threads or of the way work was split between them,
+         * and rounding error grows as O(log N) instead of O(N) for plain sequential accumulation.
+         *
+         * E is the type of extraParams for given OpType
+         */
+        template <typename X, typename E, typename OpType>
+        class ReduceLoops {
+        public:
+            typedef decltype(OpType::startingValue(static_cast<X *>(nullptr))) Acc;
+
+            /**
+             * This method reduces all TADs of x into z, either splitting TADs between threads,
+             * or splitting each TAD between threads if there's not enough TADs to keep all threads busy
+             */
+            template <typename Z>
+            static void loopTads(X *x, Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets, Nd4jLong numTads, Nd4jLong tadLength, Z *z, E *extraParams) {
+                auto tadEws = shape::elementWiseStride(tadShapeInfo);
+                bool linear = tadEws > 0 && (numTads == 1 || shape::isVector(tadShapeInfo) || shape::isScalar(tadShapeInfo));
+
+                int numThreads = nd4j::OmpLaunchHelper::betterThreads(numTads * tadLength);
+
+                if (numThreads <= 1 || numTads >= numThreads || tadLength <= REDUCE_BLOCK) {
+                    numThreads = nd4j::math::nd4j_min<Nd4jLong>(numThreads, numTads);
+
+                    #pragma omp parallel for schedule(guided) num_threads(numThreads) if (numThreads > 1) default(shared)
+                    for (Nd4jLong i = 0; i < numTads; i++) {
+                        auto tx = x + tadOffsets[i];
+                        auto start = OpType::startingValue(tx);
+
+                        if (linear)
+                            z[i] = OpType::postProcess(reduceStrided(tx, tadEws, tadLength, start, extraParams, false), tadLength, extraParams);
+                        else
+                            z[i] = OpType::postProcess(reduceShaped(tx, tadShapeInfo, tadLength, start, extraParams, false), tadLength, extraParams);
+                    }
+                }
+                else {
+                    // few long TADs: threads are spread within each TAD instead
+                    for (Nd4jLong i = 0; i < numTads; i++) {
+                        auto tx = x + tadOffsets[i];
+                        auto start = OpType::startingValue(tx);
+
+                        if (linear)
+                            z[i] = OpType::postProcess(reduceStrided(tx, tadEws, tadLength, start, extraParams, true), tadLength, extraParams);
+                        else
+                            z[i] = OpType::postProcess(reduceShaped(tx, tadShapeInfo, tadLength, start, extraParams, true), tadLength, extraParams);
+                    }
+                }
+            }
+
+            /**
+             * This method reduces length elements of x located with given element-wise stride.
+             * Returned value is not postProcessed yet
+             */
+            static Acc reduceStrided(X *x, Nd4jLong ews, Nd4jLong length, Acc start, E *extraParams, bool parallel) {
+                if (ews == 1)
+                    return reduce([&] (Nd4jLong offset, Nd4jLong blockLength) -> Acc {
+                        return reduceBlock([x] (Nd4jLong e) -> X { return x[e]; }, offset, blockLength, start, extraParams);
+                    }, length, start, extraParams, parallel);
+                else
+                    return reduce([&] (Nd4jLong offset, Nd4jLong blockLength) -> Acc {
+                        return reduceBlock([x, ews] (Nd4jLong e) -> X { return x[e * ews]; }, offset, blockLength, start, extraParams);
+                    }, length, start, extraParams, parallel);
+            }
+
+            /**
+             * This method reduces all elements of array described by given shapeInfo, regardless of its strides and order.
+             * Each block is gathered into local buffer via StridedIterator first, so tree shape is the same as for reduceStrided.
+             * Returned value is not postProcessed yet
+             */
+            static Acc reduceShaped(X *x, Nd4jLong *shapeInfo, Nd4jLong length, Acc start, E *extraParams, bool parallel) {
+                return reduce([&] (Nd4jLong offset, Nd4jLong blockLength) -> Acc {
+                    X buffer[REDUCE_BLOCK];
+                    Nd4jLong cnt = 0;
+                    nd4j::StridedIterator::loop(offset, blockLength, shapeInfo, [&] (Nd4jLong xOffset) {
+                        buffer[cnt++] = x[xOffset];
+                    });
+
+                    return reduceBlock([&buffer] (Nd4jLong e) -> X { return buffer[e]; }, 0, blockLength, start, extraParams);
+                }, length, start, extraParams, parallel);
+            }
+
+        protected:
+            template <typename BlockFunc>
+            static Acc reduce(const BlockFunc &block, Nd4jLong length, Acc start, E *extraParams, bool parallel) {
+                auto numBlocks = (length + REDUCE_BLOCK - 1) / REDUCE_BLOCK;
+                int numThreads = parallel ? nd4j::OmpLaunchHelper::betterThreads(length) : 1;
+
+                if (numBlocks < 1)
+                    return start;
+
+                if (numBlocks == 1 || numThreads <= 1)
+                    return reduceTree(block, 0, numBlocks, length, extraParams);
+
+                numThreads = nd4j::math::nd4j_min<Nd4jLong>(numThreads, numBlocks);
+                std::unique_ptr<Acc[]> partials(new Acc[numBlocks]);
+
+                #pragma omp parallel for schedule(static) num_threads(numThreads) default(shared)
+                for (Nd4jLong b = 0; b < numBlocks; b++)
+                    partials[b] = block(b * REDUCE_BLOCK, nd4j::math::nd4j_min<Nd4jLong>(REDUCE_BLOCK, length - b * REDUCE_BLOCK));
+
+                return combine(partials.get(), 0, numBlocks, extraParams);
+            }
+
+            // serial counterpart of parallel reduce(): blocks are combined in exactly the same tree
+            template <typename BlockFunc>
+            static Acc reduceTree(const BlockFunc &block, Nd4jLong firstBlock, Nd4jLong numBlocks, Nd4jLong length, E *extraParams) {
+                if (numBlocks == 1) {
+                    auto offset = firstBlock * REDUCE_BLOCK;
+                    return block(offset, nd4j::math::nd4j_min<Nd4jLong>(REDUCE_BLOCK, length - offset));
+                }
+
+                auto half = (numBlocks + 1) / 2;
+                Acc left = reduceTree(block, firstBlock, half, length, extraParams);
+                Acc right = reduceTree(block, firstBlock + half, numBlocks - half, length, extraParams);
+
+                return OpType::update(left, right, extraParams);
+            }
+
+            static Acc combine(Acc *partials, Nd4jLong first, Nd4jLong count, E *extraParams) {
+                if (count == 1)
+                    return partials[first];
+
+                auto half = (count + 1) / 2;
+                Acc left = combine(partials, first, half, extraParams);
+                Acc right = combine(partials, first + half, count - half, extraParams);
+
+                return OpType::update(left, right, extraParams);
+            }
+
+            template <typename Accessor>
+            static Acc reduceBlock(const Accessor &at, Nd4jLong offset, Nd4jLong length, Acc start, E *extraParams) {
+                Acc lanes[REDUCE_LANES];
+                for (int l = 0; l < REDUCE_LANES; l++)
+                    lanes[l] = start;
+
+                Nd4jLong e = 0;
+                for (; e + REDUCE_LANES <= length; e += REDUCE_LANES) {
+                    #pragma omp simd
+                    for (int l = 0; l < REDUCE_LANES; l++)
+                        lanes[l] = OpType::update(lanes[l], OpType::op(at(offset + e + l), extraParams), extraParams);
+                }
+
+                for (int l = 0; e < length; e++, l++)
+                    lanes[l] = OpType::update(lanes[l], OpType::op(at(offset + e), extraParams), extraParams);
+
+                // pairwise collapse of lanes
+                for (int width = REDUCE_LANES / 2; width > 0; width /= 2)
+                    for (int l = 0; l < width; l++)
+                        lanes[l] = OpType::update(lanes[l], lanes[l + width], extraParams);
+
+                return lanes[0];
+            }
+        };
+    }
+}
+
+#endif //LIBND4J_REDUCE_LOOPS_HPP
@@ -22,6 +22,7 @@
 #include <op_boilerplate.h>
 #include <loops/reduce3.h>
 #include <loops/legacy_ops.h>
+#include <helpers/ConstantTadHelper.h>
 
 using namespace simdOps;
 
@@ -148,13 +149,9 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
         
         auto startingVal = OpType::startingValue(x);        
         
-        shape::TAD xTad(xShapeInfo, dimension, dimensionLength);
-        xTad.createTadOnlyShapeInfo();
-        xTad.createOffsets();
+        auto xTad = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(xShapeInfo, dimension, dimensionLength);
 
-        shape::TAD yTad(yShapeInfo, dimension, dimensionLength);
-        yTad.createTadOnlyShapeInfo();
-        yTad.createOffsets();
+        auto yTad = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(yShapeInfo, dimension, dimensionLength);
 
         /**
         * The element wise stride belong longs to a reduction index.
@@ -167,8 +164,8 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
         */
         int largerElementWiseStride;
         int smallerElementWiseStride;
-        auto xEws = shape::elementWiseStride(xTad.tadOnlyShapeInfo);
-        auto yEws = shape::elementWiseStride(yTad.tadOnlyShapeInfo);
+        auto xEws = shape::elementWiseStride(xTad->primaryShapeInfo());
+        auto yEws = shape::elementWiseStride(yTad->primaryShapeInfo());
         int tadLength;
         Nd4jLong xModLength;
         Nd4jLong yModLength;
@@ -176,8 +173,8 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
         bool xTadBigger;
         
         if(shape::length(xShapeInfo) > shape::length(yShapeInfo)) {
-            tadLength = shape::length(xTad.tadOnlyShapeInfo);
-            iterationTadInfo = xTad.tadOnlyShapeInfo;
+            tadLength = shape::length(xTad->primaryShapeInfo());
+            iterationTadInfo = xTad->primaryShapeInfo();
             largerElementWiseStride = shape::elementWiseStride(xShapeInfo);
             smallerElementWiseStride = shape::elementWiseStride(yShapeInfo);
             xModLength = 1;
@@ -185,8 +182,8 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
             xTadBigger = true;
         }
         else {
-            tadLength = shape::length(yTad.tadOnlyShapeInfo);
-            iterationTadInfo = yTad.tadOnlyShapeInfo;
+            tadLength = shape::length(yTad->primaryShapeInfo());
+            iterationTadInfo = yTad->primaryShapeInfo();
             largerElementWiseStride = shape::elementWiseStride(yShapeInfo);
             smallerElementWiseStride = shape::elementWiseStride(xShapeInfo);
             xModLength = tadLength;
@@ -209,8 +206,8 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
                     for (int extraParamsIdx = 0; extraParamsIdx < OpType::extraParamsLen; extraParamsIdx++) 
                         localExtraParams[extraParamsIdx] = startingVal;
                                 
-                    Nd4jLong offset = xTad.tadOffsets[i];
-                    Nd4jLong yOffset = yTad.tadOffsets[i];
+                    Nd4jLong offset = xTad->primaryOffsets()[i];
+                    Nd4jLong yOffset = yTad->primaryOffsets()[i];
                     z[i] = OpType::op(x[offset], y[yOffset], localExtraParams);
                     
                     for (int j = 1; j < tadLength; j++) {
@@ -234,10 +231,10 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
 //#pragma omp  parallel for schedule(guided) num_threads(num_threads) if (num_threads > 1) proc_bind(AFFINITY) default(shared)
                 for (int i = 0; i < zLen; i++) {
                 
-                    Nd4jLong xOffset = xTadBigger ? xTad.tadOffsets[i] : 0;
-                    Nd4jLong yOffset = !xTadBigger ? yTad.tadOffsets[i] : 0;
-                    auto xShapeInf = xTadBigger ? xTad.tadOnlyShapeInfo : xShapeInfo;
-                    auto yShapeInf = !xTadBigger ? yTad.tadOnlyShapeInfo : yShapeInfo;
+                    Nd4jLong xOffset = xTadBigger ? xTad->primaryOffsets()[i] : 0;
+                    Nd4jLong yOffset = !xTadBigger ? yTad->primaryOffsets()[i] : 0;
+                    auto xShapeInf = xTadBigger ? xTad->primaryShapeInfo() : xShapeInfo;
+                    auto yShapeInf = !xTadBigger ? yTad->primaryShapeInfo() : yShapeInfo;
                     auto start = OpType::startingValue(x);
 
                     for (int j = 0; j < tadLength; j++) {
@@ -253,13 +250,9 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
         } 
         else {
         
-            shape::TAD xTad(xShapeInfo, dimension, dimensionLength);
-            xTad.createTadOnlyShapeInfo();
-            xTad.createOffsets();
+            auto xTad = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(xShapeInfo, dimension, dimensionLength);
 
-            shape::TAD yTad(yShapeInfo, dimension, dimensionLength);
-            yTad.createTadOnlyShapeInfo();
-            yTad.createOffsets();
+            auto yTad = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(yShapeInfo, dimension, dimensionLength);
             int tadsPerThread = zLen / TAD_THRESHOLD;
             int num_threads = nd4j::math::nd4j_max<int>(1, tadsPerThread);
             num_threads = nd4j::math::nd4j_min<int>(num_threads, omp_get_max_threads());
@@ -267,13 +260,13 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
 //#pragma omp  parallel for schedule(guided) num_threads(num_threads) if (num_threads > 1) proc_bind(AFFINITY) default(shared) private(coord)
             for (int i = 0; i < zLen; i++) {
                 
-                Nd4jLong xOffset = xTad.tadOffsets[i];
-                Nd4jLong yOffset = yTad.tadOffsets[i];
+                Nd4jLong xOffset = xTad->primaryOffsets()[i];
+                Nd4jLong yOffset = yTad->primaryOffsets()[i];
                 auto start = OpType::startingValue(x + xOffset);
                 
                 for (int j = 0; j < tadLength; j++) {
-                    Nd4jLong xOffset2 = xOffset + shape::getIndexOffset(j, xTad.tadOnlyShapeInfo, tadLength);
-                    Nd4jLong yOffset2 = yOffset + shape::getIndexOffset(j, yTad.tadOnlyShapeInfo, tadLength);
+                    Nd4jLong xOffset2 = xOffset + shape::getIndexOffset(j, xTad->primaryShapeInfo(), tadLength);
+                    Nd4jLong yOffset2 = yOffset + shape::getIndexOffset(j, yTad->primaryShapeInfo(), tadLength);
                     start = OpType::update(start, OpType::op(x[xOffset2], y[yOffset2],extraParamsVals), extraParamsVals);
                 }
 
@@ -22,6 +22,7 @@
 #include <op_boilerplate.h>
 #include <types/types.h>
 #include "../legacy_ops.h"
+#include <helpers/StridedIterator.h>
 
 using namespace simdOps;
 
@@ -135,64 +136,16 @@ void ScalarTransform<X, Y, Z>::transform(void *vx, Nd4jLong *xShapeInfo,
     }
     else {
                 
-        const bool xSimpe = shape::isStrideSimple(xShapeInfo);
-        const bool zSimpe = shape::isStrideSimple(zShapeInfo);
-
         nd4j::OmpLaunchHelper info(len);
-                   
-        if(xSimpe) {
-                        
-            #pragma omp parallel num_threads(info._numThreads) if (info._numThreads > 1) default(shared)
-            {
-                auto threadNum = omp_get_thread_num();                    
-                Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
-                auto xi = x + xEws * threadOffset;    
-                #pragma omp simd
-                for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                    Nd4jLong zOffset = shape::getIndexOffset(i+threadOffset, zShapeInfo, len);
-                    z[zOffset] = OpType::op(xi[i*xEws], scalar, extraParams);
-                }
-            }
-        }
-        else if(zSimpe) {
-
-            #pragma omp parallel num_threads(info._numThreads) if (info._numThreads > 1) default(shared)
-            {
-                auto threadNum = omp_get_thread_num();                    
-                Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
-                auto zi = z + zEws * threadOffset;    
-                #pragma omp simd
-                for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                    Nd4jLong xOffset = shape::getIndexOffset(i+threadOffset, xShapeInfo, len);
-                    zi[i*zEws] = OpType::op(x[xOffset], scalar, extraParams);
-                }
-            }
-        }
-        else if(shape::equalsStrict(xShapeInfo, zShapeInfo)) {
-                        
-            #pragma omp parallel num_threads(info._numThreads) if (info._numThreads > 1) default(shared)
-            {
-                auto threadNum = omp_get_thread_num();                    
-                Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
-                #pragma omp simd
-                for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                    Nd4jLong offset = shape::getIndexOffset(i+threadOffset, xShapeInfo, len);
-                    z[offset] = OpType::op(x[offset], scalar, extraParams);
-                }
-            }
-        }
-        else {
-            #pragma omp parallel num_threads(info._numThreads) if (info._numThreads > 1) default(shared)
-            {
-                auto threadNum = omp_get_thread_num();                    
-                Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
-                #pragma omp simd
-                for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                    Nd4jLong xOffset = shape::getIndexOffset(i+threadOffset, xShapeInfo, len);
-                    Nd4jLong zOffset = shape::getIndexOffset(i+threadOffset, zShapeInfo, len);
-                    z[zOffset] = OpType::op(x[xOffset], scalar, extraParams);
-                }
-            }
+
+        #pragma omp parallel num_threads(info._numThreads) if (info._numThreads > 1) default(shared)
+        {
+            auto threadNum = omp_get_thread_num();
+            Nd4jLong threadOffset = info.getThreadOffset(threadNum);
+
+            nd4j::StridedIterator::loop(threadOffset, info.getItersPerThread(threadNum), xShapeInfo, zShapeInfo, [&](Nd4jLong xOffset, Nd4jLong zOffset) {
+                z[zOffset] = OpType::op(x[xOffset], scalar, extraParams);
+            });
         }  
     }                        
 }
@@ -23,6 +23,7 @@
 #include <loops/summarystatsreduce.h>
 #include <helpers/shape.h>
 #include <helpers/TAD.h>
+#include <helpers/ConstantTadHelper.h>
 
 using namespace simdOps;
 
@@ -130,12 +131,10 @@ namespace functions {
             }
 
 
-            shape::TAD tad(xShapeInfo, dimension, dimensionLength);
-            tad.createTadOnlyShapeInfo();
-            tad.createOffsets();
+            auto tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(xShapeInfo, dimension, dimensionLength);
 
             //no-op
-            if (tad.dimensionLength < 1)
+            if (tadPack->isEmpty())
                 return;
 
             int resultLength = shape::length(resultShapeInfoBuffer);
@@ -143,13 +142,13 @@ namespace functions {
             //shape information for tad offset
             //the squeezed information doesn't render the right strides for
             //tad offset
-            if (resultLength == 1 || dimensionLength == shape::rank(xShapeInfo) || tad.wholeThing) {
+            if (resultLength == 1 || dimensionLength == shape::rank(xShapeInfo) || tadPack->wholeThing()) {
                 z[0] = execScalar<OpType>(biasCorrected, x, xShapeInfo, extraParams);
                 return;
             }
 
-            if (!(shape::elementWiseStride(tad.tadOnlyShapeInfo) > 0 && (tad.numTads == 1 || shape::isVector(tad.tadOnlyShapeInfo) ||
-                                                                         shape::isScalar(tad.tadOnlyShapeInfo) || tad.wholeThing)) && !(dimensionLength > 1)) {
+            if (!(shape::elementWiseStride(tadPack->primaryShapeInfo()) > 0 && (tadPack->numberOfTads() == 1 || shape::isVector(tadPack->primaryShapeInfo()) ||
+                                                                         shape::isScalar(tadPack->primaryShapeInfo()) || tadPack->wholeThing())) && !(dimensionLength > 1)) {
 
                 /**
                  * The element wise stride belong longs to a reduction index.
@@ -161,14 +160,14 @@ namespace functions {
                  * along long which to iterate.
                  */
 
-                auto tadShapeShapeInfo = tad.tadOnlyShapeInfo;
+                auto tadShapeShapeInfo = tadPack->primaryShapeInfo();
 
                 auto xShape = shape::shapeOf(tadShapeShapeInfo);
                 auto xStride = shape::stride(tadShapeShapeInfo);
                 int rank = shape::rank(tadShapeShapeInfo);
 #pragma omp parallel for schedule(guided) default(shared)
                 for (int i = 0; i < resultLength; i++) {
-                    auto offset = tad.tadOffsets[i];
+                    auto offset = tadPack->primaryOffsets()[i];
                     Nd4jLong shapeIter[MAX_RANK];
                     Nd4jLong coord[MAX_RANK];
                     int dim;
@@ -206,12 +205,12 @@ namespace functions {
             }
             else {
                 if (dimensionLength == 1) {
-                    auto tadElementWiseStride = shape::elementWiseStride(tad.tadOnlyShapeInfo);
-                    auto tadLength = shape::length(tad.tadOnlyShapeInfo);
+                    auto tadElementWiseStride = shape::elementWiseStride(tadPack->primaryShapeInfo());
+                    auto tadLength = shape::length(tadPack->primaryShapeInfo());
 
 #pragma omp parallel for schedule(guided) default(shared)
                     for (int i = 0; i < resultLength; i++) {
-                        Nd4jLong baseOffset = tad.tadOffsets[i];
+                        Nd4jLong baseOffset = tadPack->primaryOffsets()[i];
                         SummaryStatsData<X> comp;
                         comp.initWithValue(x[baseOffset]);
 // FIXME: reduction to be used here
@@ -224,13 +223,13 @@ namespace functions {
                         z[i] = OpType::getValue(biasCorrected, comp);
                     }
                 } else {
-                    auto tadShapeShapeInfo = tad.tadOnlyShapeInfo;
-                    auto tadLength = shape::length(tad.tadOnlyShapeInfo);
+                    auto tadShapeShapeInfo = tadPack->primaryShapeInfo();
+                    auto tadLength = shape::length(tadPack->primaryShapeInfo());
 
 #pragma omp parallel for schedule(guided) default(shared)
                     for (int r = 0; r < resultLength; r++) {
                         
-                        auto tadOffsetForBlock = tad.tadOffsets[r];
+                        auto tadOffsetForBlock = tadPack->primaryOffsets()[r];
                         SummaryStatsData<X> comp;
                         comp.initWithValue(x[tadOffsetForBlock]);
 
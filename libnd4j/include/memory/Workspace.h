@@ -55,18 +55,29 @@ namespace nd4j {
             Nd4jLong _initialSize = 0L;
             Nd4jLong _currentSize = 0L;
 
-            std::mutex _mutexAllocation;
+            // unique value, changes every time when previously carved memory becomes invalid (reset or reallocation)
+            // thread-local slabs are only used if their epoch matches this one
+            std::atomic<Nd4jLong> _epoch;
+
             std::mutex _mutexSpills;
 
             bool _externalized = false;
 
+            // spills are served from chunked overflow arena: _spills holds chunks, last one is current
             std::vector<void*> _spills;
+            Nd4jLong _spillChunkSize = 0L;
+            Nd4jLong _spillChunkOffset = 0L;
 
             std::atomic<Nd4jLong> _spillsSize;
             std::atomic<Nd4jLong> _cycleAllocations;
 
             void init(Nd4jLong bytes);
             void freeSpills();
+            void renewEpoch();
+
+            // lock-free bump allocation within main buffer, returns nullptr if there's not enough space
+            char* reserveBytes(Nd4jLong numBytes);
+            void* allocateSpill(Nd4jLong numBytes);
         public:
             explicit Workspace(ExternalWorkspace *external);
             explicit Workspace(Nd4jLong initialSize = 0);
@@ -33,6 +33,34 @@
 
 namespace nd4j {
     namespace memory {
+        // each thread carves small allocations from its own slab, so threads don't contend on shared offset
+        static const Nd4jLong SLAB_SIZE = 65536L;
+        static const Nd4jLong SLAB_MAX_ALLOCATION = 4096L;
+
+        // slabs are used only for large workspaces, small ones are better off with exact bump allocation
+        static const Nd4jLong SLAB_MIN_WORKSPACE = 64L * SLAB_SIZE;
+
+        // number of workspaces each thread keeps slabs for, so threads alternating between workspaces don't drop slabs
+        static const int SLAB_CACHE_SIZE = 4;
+
+        static const Nd4jLong SPILL_CHUNK_SIZE = 1048576L;
+
+        // epochs are unique across all workspaces, so epoch identifies both workspace and its cycle
+        static std::atomic<Nd4jLong> _epochs(0L);
+
+        struct ThreadSlab {
+            Nd4jLong epoch;
+            char *ptr;
+            Nd4jLong available;
+        };
+
+        static thread_local ThreadSlab _slabs[SLAB_CACHE_SIZE] = {{-1L, nullptr, 0L}, {-1L, nullptr, 0L}, {-1L, nullptr, 0L}, {-1L, nullptr, 0L}};
+        static thread_local int _slabVictim = 0;
+
+        void Workspace::renewEpoch() {
+            _epoch = ++_epochs;
+        }
+
         Workspace::Workspace(ExternalWorkspace *external) {
             if (external->sizeHost() > 0) {
                 _ptrHost = (char *) external->pointerHost();
@@ -45,7 +73,13 @@ namespace nd4j {
                 this->_spillsSize = 0;
 
                 _externalized = true;
+            } else {
+                _offset = 0L;
+                this->_cycleAllocations = 0;
+                this->_spillsSize = 0;
             }
+
+            renewEpoch();
         };
 
         Workspace::Workspace(Nd4jLong initialSize) {
@@ -64,6 +98,8 @@ namespace nd4j {
             this->_offset = 0;
             this->_cycleAllocations = 0;
             this->_spillsSize = 0;
+
+            renewEpoch();
         }
 
         void Workspace::init(Nd4jLong bytes) {
@@ -78,6 +114,8 @@ namespace nd4j {
                 memset(this->_ptrHost, 0, bytes);
                 this->_currentSize = bytes;
                 this->_allocatedHost = true;
+
+                renewEpoch();
             }
         }
 
@@ -90,22 +128,32 @@ namespace nd4j {
         }
 
         void Workspace::freeSpills() {
+            std::lock_guard<std::mutex> lock(_mutexSpills);
+
             _spillsSize = 0;
 
             if (_spills.size() < 1)
                 return;
 
+            // current regular chunk is kept for reuse, dedicated chunks are released
+            void *reusable = _spillChunkSize > 0 ? _spills.back() : nullptr;
             for (auto v:_spills)
-                free(v);
+                if (v != reusable)
+                    free(v);
 
             _spills.clear();
+            _spillChunkOffset = 0L;
+
+            if (reusable != nullptr)
+                _spills.push_back(reusable);
         }
 
         Workspace::~Workspace() {
             if (this->_allocatedHost && !_externalized)
                 free((void *)this->_ptrHost);
 
-            freeSpills();
+            for (auto v:_spills)
+                free(v);
         }
 
         Nd4jLong Workspace::getUsedSize() {
@@ -121,41 +169,99 @@ namespace nd4j {
         }
 
 
-        void* Workspace::allocateBytes(Nd4jLong numBytes) {
-            if (numBytes < 1) {
-                nd4j_printf("Bad number of bytes requested for allocation: %i\n", numBytes);
-                throw std::invalid_argument("Number of bytes for allocation should be positive");
-            }
+        char* Workspace::reserveBytes(Nd4jLong numBytes) {
+            auto offset = _offset.load();
+            do {
+                if (offset + numBytes > _currentSize)
+                    return nullptr;
+            } while (!_offset.compare_exchange_weak(offset, offset + numBytes));
 
-            //numBytes += 32;
-            void* result = nullptr;
-            this->_cycleAllocations += numBytes;
-            this->_mutexAllocation.lock();
+            return _ptrHost + offset;
+        }
+
+        void* Workspace::allocateSpill(Nd4jLong numBytes) {
+            nd4j_debug("Allocating %lld bytes in spills\n", numBytes);
 
-            if (_offset.load() + numBytes > _currentSize) {
-                nd4j_debug("Allocating %lld bytes in spills\n", numBytes);
-                this->_mutexAllocation.unlock();
+            std::lock_guard<std::mutex> lock(_mutexSpills);
 
+            _spillsSize += numBytes;
+
+            // big spills get dedicated chunk, placed before current chunk, so current one stays usable
+            if (numBytes > SPILL_CHUNK_SIZE / 4) {
                 void *p = malloc(numBytes);
 
                 CHECK_ALLOC(p, "Failed to allocate new workspace");
 
-                _mutexSpills.lock();
+                _spills.insert(_spills.begin(), p);
+                return p;
+            }
+
+            auto aligned = (numBytes + 7L) & ~7L;
+            if (_spillChunkSize == 0 || _spillChunkOffset + aligned > _spillChunkSize) {
+                void *p = malloc(SPILL_CHUNK_SIZE);
+
+                CHECK_ALLOC(p, "Failed to allocate new workspace");
+
                 _spills.push_back(p);
-                _mutexSpills.unlock();
+                _spillChunkSize = SPILL_CHUNK_SIZE;
+                _spillChunkOffset = 0L;
+            }
 
-                _spillsSize += numBytes;
+            auto result = reinterpret_cast<char *>(_spills.back()) + _spillChunkOffset;
+            _spillChunkOffset += aligned;
 
-                return p;
+            return result;
+        }
+
+        void* Workspace::allocateBytes(Nd4jLong numBytes) {
+            if (numBytes < 1) {
+                nd4j_printf("Bad number of bytes requested for allocation: %i\n", numBytes);
+                throw std::invalid_argument("Number of bytes for allocation should be positive");
             }
 
-            result = (void *)(_ptrHost + _offset.load());
-            _offset += numBytes;
-            //memset(result, 0, (int) numBytes);
+            // small allocations within big workspace are served from thread-local slab, without any shared state
+            if (numBytes <= SLAB_MAX_ALLOCATION && _currentSize >= SLAB_MIN_WORKSPACE) {
+                auto aligned = (numBytes + 7L) & ~7L;
+                auto epoch = _epoch.load(std::memory_order_relaxed);
+
+                ThreadSlab *slab = nullptr;
+                for (int e = 0; e < SLAB_CACHE_SIZE && slab == nullptr; e++)
+                    if (_slabs[e].epoch == epoch)
+                        slab = &_slabs[e];
+
+                if (slab == nullptr || slab->available < aligned) {
+                    auto ptr = reserveBytes(SLAB_SIZE);
+                    if (ptr != nullptr) {
+                        if (slab == nullptr) {
+                            slab = &_slabs[_slabVictim];
+                            _slabVictim = (_slabVictim + 1) % SLAB_CACHE_SIZE;
+                        }
+
+                        slab->epoch = epoch;
+                        slab->ptr = ptr;
+                        slab->available = SLAB_SIZE;
+                    }
+                }
+
+                if (slab != nullptr && slab->available >= aligned) {
+                    // only carved bytes are counted, so unused slab tails don't inflate next cycle
+                    this->_cycleAllocations += aligned;
+
+                    void *result = slab->ptr;
+                    slab->ptr += aligned;
+                    slab->available -= aligned;
+
+                    return result;
+                }
+            }
 
-            nd4j_debug("Allocating %lld bytes from workspace; Current PTR: %p; Current offset: %lld\n", numBytes, result, _offset.load());
+            this->_cycleAllocations += numBytes;
 
-            this->_mutexAllocation.unlock();
+            void *result = reserveBytes(numBytes);
+            if (result == nullptr)
+                return allocateSpill(numBytes);
+
+            nd4j_debug("Allocating %lld bytes from workspace; Current PTR: %p; Current offset: %lld\n", numBytes, result, _offset.load());
 
             return result;
         }
@@ -172,6 +278,9 @@ namespace nd4j {
 
         void Workspace::scopeOut() {
             _offset = 0;
+
+            // memory carved by thread-local slabs is invalid after reset
+            renewEpoch();
         }
 
         Nd4jLong Workspace::getSpilledSize() {
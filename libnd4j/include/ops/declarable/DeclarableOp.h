@@ -126,8 +126,8 @@ namespace nd4j {
             // for LogicalOps
             DeclarableOp(const char *name, bool isLogical);
 
-            // default testructor
-            ~DeclarableOp();
+            // default testructor, virtual since graph nodes own and delete their ops via base pointer
+            virtual ~DeclarableOp();
 
             // this method returns OpDescriptor, describing this Op instance
             OpDescriptor *getOpDescriptor();
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_LEGACYMETAOP_H
+#define LIBND4J_LEGACYMETAOP_H
+
+#include <ops/declarable/LegacyOp.h>
+#include <graph/generated/utils_generated.h>
+#include <array/TadPack.h>
+#include <memory>
+
+namespace nd4j {
+    namespace ops {
+
+        /**
+        *   This class provides wrapper for chain of elementwise legacy ops (transform, scalar, pairwise and broadcast),
+        *   i.e. relu(bias_add(x, b) * s), executed as single op.
+        *
+        *   Input 0 is fed into first stage, and each next stage is applied to output of previous stage.
+        *   Other inputs are side operands (pairwise/broadcast Y, or scalar) referenced by stages.
+        *   Whenever layouts allow, all stages are applied block by block, so each block stays in cache between stages
+        *   and no intermediate arrays are materialized.
+        */
+        class ND4J_EXPORT LegacyMetaOp : public LegacyOp {
+        public:
+            struct Stage {
+                nd4j::graph::OpType opType;
+                int opNum;
+
+                // index of side operand within op inputs, or -1 if stage has none
+                int input = -1;
+
+                // scalar operand, used by scalar stages without side operand
+                double scalar = 0.0;
+
+                std::vector<double> extraParams;
+
+                // broadcast dimensions
+                std::vector<int> dimensions;
+            };
+
+        protected:
+            std::vector<Stage> _stages;
+
+            Nd4jStatus validateAndExecute(Context& block);
+
+            bool canExecuteBlocked(NDArray *x, NDArray *z, std::vector<NDArray *> &operands);
+
+            void executeBlocked(NDArray *x, NDArray *z, std::vector<NDArray *> &operands);
+
+            static void executeStage(const Stage &stage, void *x, Nd4jLong *xShapeInfo, void *z, Nd4jLong *zShapeInfo, void *y, Nd4jLong *yShapeInfo, TadPack *tadX, TadPack *tadZ);
+
+        public:
+            LegacyMetaOp();
+            LegacyMetaOp(const std::vector<Stage> &stages);
+
+            std::vector<Stage>* stages();
+
+            /**
+             * This method returns true if given legacy op is applied to each element independently, so it can be used as stage
+             */
+            static bool isFusable(nd4j::graph::OpType opType, int opNum);
+
+            ShapeList* calculateOutputShape(ShapeList* inputShape, nd4j::graph::Context& block);
+            virtual LegacyOp* clone();
+        };
+    }
+}
+
+
+#endif //LIBND4J_LEGACYMETAOP_H
@@ -80,6 +80,10 @@ namespace nd4j {
 
 
             bool _sameMode = false;
+
+            // flag for ops with output shapes defined by input shapes, arguments and values of small inputs only, see ShapeMemo
+            bool _shapeMemoizable = false;
+
             std::vector<nd4j::DataType> _allowedIns;
             std::vector<nd4j::DataType> _allowedOuts;
 
@@ -165,6 +169,7 @@ namespace nd4j {
             OpDescriptor* setAllowedInputTypes(nd4j::DataType dtype);
             OpDescriptor* setAllowedOutputTypes(nd4j::DataType dtype);
             OpDescriptor* setSameMode(bool reallySame);
+            OpDescriptor* setShapeMemoizable(bool memoizable);
             OpDescriptor* setInputType(int idx, nd4j::DataType dtype);
             OpDescriptor* setOutputType(int idx, nd4j::DataType dtype);
 
@@ -174,6 +179,9 @@ namespace nd4j {
             bool checkOutputMatch(int index, nd4j::DataType dataType);
             bool isSameMode();
 
+            // returns TRUE if output shapes of this op can be remembered between executions
+            bool isShapeMemoizable();
+
             bool isInherit(int index);
         };
     }
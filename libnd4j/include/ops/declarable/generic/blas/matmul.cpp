@@ -126,7 +126,8 @@ DECLARE_SHAPE_FN(matmul) {
         getOpDescriptor()
                 ->setAllowedInputTypes(0, {ALL_FLOATS})
                 ->setAllowedInputTypes(1, {ALL_FLOATS})
-                ->setAllowedOutputTypes(0, {ALL_FLOATS});
+                ->setAllowedOutputTypes(0, {ALL_FLOATS})
+                ->setShapeMemoizable(true);
     }
 
 }
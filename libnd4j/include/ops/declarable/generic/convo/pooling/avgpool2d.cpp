@@ -87,7 +87,8 @@ DECLARE_SYN(avgpool, avgpool2d);
     DECLARE_TYPES(avgpool2d) {
         getOpDescriptor()
                 ->setAllowedInputTypes(nd4j::DataType::ANY)
-                ->setAllowedOutputTypes({ALL_FLOATS});
+                ->setAllowedOutputTypes({ALL_FLOATS})
+                ->setShapeMemoizable(true);
     }
 
 DECLARE_SHAPE_FN(avgpool2d) {
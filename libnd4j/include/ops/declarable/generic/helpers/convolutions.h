@@ -34,6 +34,13 @@ namespace nd4j {
 
         class ConvolutionUtils {
         public:
+            // algorithms available for forward 2D convolution on CPU
+            enum Conv2dAlgorithm {
+                CONV2D_IM2COL = 0,          // im2col into [bS, iC, kH, kW, oH, oW] columns followed by tensorDot, works for everything
+                CONV2D_DIRECT = 1,          // direct loops over input, used for 1x1 and depthwise convolutions
+                CONV2D_WINOGRAD = 2,        // Winograd F(2x2,3x3) / F(4x4,3x3), used for 3x3 convolutions with unit strides and dilations
+            };
+
             static void calcOutSizePool2D(int& oH, int& oW, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int iH, const int iW, const int isSameMode);
 
             static void calcOutSizePool3D(int& oD, int& oH, int& oW, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int iD, const int iH, const int iW, const int isSameMode);
@@ -73,6 +80,18 @@ namespace nd4j {
 #endif
             static void conv2d(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int isSameMode, const int isNCHW);
 
+            // picks algorithm for forward convolution, weights are [kH, kW, iC, oC] for regular and [kH, kW, iC, mC] for depthwise convolution
+            static Conv2dAlgorithm conv2dAlgorithm(const NDArray* input, const NDArray* weights, const NDArray* bias, const NDArray* output, const int kH, const int kW, const int sH, const int sW, const int dH, const int dW, const bool isDepthwise);
+
+            // direct 1x1 convolution, both NCHW and NHWC, paddings must be already calculated
+            static void conv2dPointwiseDirect(const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int sH, const int sW, const int pH, const int pW, const int isNCHW);
+
+            // Winograd 3x3 convolution with unit strides and dilations, both NCHW and NHWC, paddings must be already calculated
+            static void conv2dWinograd(const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int pH, const int pW, const int isNCHW);
+
+            // direct depthwise convolution, both NCHW and NHWC, paddings must be already calculated
+            static void depthwiseConv2dDirect(const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW);
+
             static void conv2d(nd4j::graph::Context& block, const std::vector<NDArray*>& inArrs, NDArray* output, const std::vector<int>& intArgs);
 
             static void conv2dBP(nd4j::graph::Context& block, const std::vector<NDArray*>& inArrs, const std::vector<NDArray*>& outArrs, const std::vector<int>& intArgs);
@@ -601,7 +601,7 @@ static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDA
             streams.push_back(MKLDNNStream("conv2d"));
         }
 
-        if (streams[0].checkAndReset({input, weights, bias}, {output}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, isNCHW})) {
+        if (MKLDNNStream::acquire(streams, {input, weights, bias}, {output}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, isNCHW})) {
             mkldnn_memory_desc_t empty;
             mkldnn::memory::desc conv_src_md(empty), conv_weights_md(empty), conv_bias_md(empty), conv_dst_md(empty);
             mkldnn::memory::dims conv_strides, conv_padding, conv_padding_r;
@@ -611,26 +611,42 @@ static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDA
                     &conv_src_md, nullptr, &conv_weights_md, nullptr, &conv_bias_md, &conv_dst_md,
                     conv_strides, conv_padding, conv_padding_r);
 
+            // weights layout is left up to MKL-DNN, user weights are reordered into blocked layout if it prefers one
+            auto conv_weights_any_md = mkldnn::memory::desc({ oC, iC, kH, kW }, mkldnn::memory::data_type::f32, mkldnn::memory::format::any);
+
             auto conv_desc = bias != nullptr
                     ? convolution_forward::desc(prop_kind::forward,
-                            convolution_direct, conv_src_md, conv_weights_md, conv_bias_md,
+                            convolution_direct, conv_src_md, conv_weights_any_md, conv_bias_md,
                             conv_dst_md, conv_strides, conv_padding, conv_padding_r, padding_kind::zero)
                     : convolution_forward::desc(prop_kind::forward,
-                            convolution_direct, conv_src_md, conv_weights_md,
+                            convolution_direct, conv_src_md, conv_weights_any_md,
                             conv_dst_md, conv_strides, conv_padding, conv_padding_r, padding_kind::zero);
 
             auto conv_prim_desc = convolution_forward::primitive_desc(conv_desc, streams[0].getEngine());
             auto conv_src_memory = mkldnn::memory(conv_prim_desc.src_primitive_desc(), const_cast<NDArray*>(input)->buffer());
-            auto conv_weights_memory = mkldnn::memory(conv_prim_desc.weights_primitive_desc(), const_cast<NDArray*>(weights)->buffer());
+            auto user_weights_memory = mkldnn::memory(mkldnn::memory::primitive_desc(conv_weights_md, streams[0].getEngine()), const_cast<NDArray*>(weights)->buffer());
             auto conv_dst_memory = mkldnn::memory(conv_prim_desc.dst_primitive_desc(), output->buffer());
+
+            std::vector<mkldnn::memory> memory = {conv_src_memory, user_weights_memory, conv_dst_memory};
+            std::vector<mkldnn::primitive> operations;
+
+            bool reorderWeights = conv_prim_desc.weights_primitive_desc() != user_weights_memory.get_primitive_desc();
+            auto conv_weights_memory = reorderWeights ? mkldnn::memory(conv_prim_desc.weights_primitive_desc()) : user_weights_memory;
+            if (reorderWeights) {
+                memory.push_back(conv_weights_memory);
+                operations.push_back(mkldnn::reorder(user_weights_memory, conv_weights_memory));
+            }
+
             if (bias != nullptr) {
                 auto conv_bias_memory = mkldnn::memory(conv_prim_desc.bias_primitive_desc(), const_cast<NDArray*>(bias)->buffer());
-                streams[0].setMemory({conv_src_memory, conv_weights_memory, conv_bias_memory, conv_dst_memory});
-                streams[0].setOperation(convolution_forward(conv_prim_desc, conv_src_memory, conv_weights_memory, conv_bias_memory, conv_dst_memory));
+                memory.push_back(conv_bias_memory);
+                operations.push_back(convolution_forward(conv_prim_desc, conv_src_memory, conv_weights_memory, conv_bias_memory, conv_dst_memory));
             } else {
-                streams[0].setMemory({conv_src_memory, conv_weights_memory, conv_dst_memory});
-                streams[0].setOperation(convolution_forward(conv_prim_desc, conv_src_memory, conv_weights_memory, conv_dst_memory));
+                operations.push_back(convolution_forward(conv_prim_desc, conv_src_memory, conv_weights_memory, conv_dst_memory));
             }
+
+            streams[0].setMemory(memory);
+            streams[0].setOperations(operations);
         }
 
         streams[0].submitAndWait();
@@ -639,6 +655,17 @@ static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDA
 #endif
     nd4j_debug("MKL-DNN is not used for conv2d!\n", 0);
 
+    switch (ConvolutionUtils::conv2dAlgorithm(input, weights, bias, output, kH, kW, sH, sW, dH, dW, false)) {
+        case ConvolutionUtils::CONV2D_DIRECT:
+            ConvolutionUtils::conv2dPointwiseDirect(input, weights, bias, output, sH, sW, pH, pW, isNCHW);
+            return;
+        case ConvolutionUtils::CONV2D_WINOGRAD:
+            ConvolutionUtils::conv2dWinograd(input, weights, bias, output, pH, pW, isNCHW);
+            return;
+        default:
+            break;
+    }
+
     std::vector<int> permutForOutput;
     if(!isNCHW)
         input = input->permute({0, 3, 1, 2});                                       // [bS, iH, iW, iC] -> [bS, iC, iH, iW] if NHWC
@@ -699,9 +726,7 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
             streams.push_back(MKLDNNStream("conv2d_bp_data"));
         }
 
-        bool resetW = streams[0].checkAndReset({input, weights, bias, gradO}, {gradI, gradW, gradB}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, isNCHW});
-        bool resetI = streams[1].checkAndReset({input, weights, bias, gradO}, {gradI, gradW, gradB}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, isNCHW});
-        if (resetW || resetI) {
+        if (MKLDNNStream::acquire(streams, {input, weights, bias, gradO}, {gradI, gradW, gradB}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, isNCHW})) {
             mkldnn_memory_desc_t empty;
             mkldnn::memory::desc conv_src_md(empty), conv_diff_src_md(empty), conv_weights_md(empty),
                                  conv_diff_weights_md(empty), conv_bias_md(empty), conv_dst_md(empty);
@@ -836,6 +861,14 @@ static void depthwiseConv2d_(const NDArray* input, const NDArray* weights, const
     ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, *input, *output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWmC, indWkH, indOoH);
     mC = weights->sizeAt(indWmC);                           // channels multiplier
 
+    if(isSameMode)                       // SAME
+        ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
+
+    if (ConvolutionUtils::conv2dAlgorithm(input, weights, bias, output, kH, kW, sH, sW, dH, dW, true) == ConvolutionUtils::CONV2D_DIRECT) {
+        ConvolutionUtils::depthwiseConv2dDirect(input, weights, bias, output, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+        return;
+    }
+
     std::vector<std::vector<Nd4jLong>> modifColumns = {{1,0,4,5,2,3}, {iC,bS*oH*oW,kH*kW}};  // [bS,iC,kH,kW,oH,oW] -> [iC,bS,oH,oW,kH,kW] -> [iC,bS*oH*oW,kH*kW]
     std::vector<std::vector<Nd4jLong>> modifOutput;
     std::vector<Nd4jLong> outReShape;
@@ -850,9 +883,6 @@ static void depthwiseConv2d_(const NDArray* input, const NDArray* weights, const
         modifOutput = {{1,0,3,4,2},{iC, bS*oH*oW, mC}};                                 // [bS,iC,mC,oH,oW] -> [iC,bS,oH,oW,mC] -> [iC,bS*oH*oW,mC]
     }
 
-    if(isSameMode)                       // SAME
-        ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
-
     NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getWorkspace());
     NDArray* outputReshaped = output->reshape(output->ordering(), outReShape);
 
@@ -1275,7 +1305,7 @@ static void pooling2d_(nd4j::graph::Context& block, const NDArray& input, NDArra
             streams.push_back(MKLDNNStream("pooling2d"));
         }
 
-        if (streams[0].checkAndReset({&input}, {&output}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, poolingMode, extraParam0})) {
+        if (MKLDNNStream::acquire(streams, {&input}, {&output}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, poolingMode, extraParam0})) {
             mkldnn_memory_desc_t empty;
             mkldnn::memory::desc pool_src_md(empty), pool_dst_md(empty);
             mkldnn::memory::dims pool_strides, pool_kernel, pool_padding, pool_padding_r;
@@ -1495,7 +1525,7 @@ static void pooling3d_(nd4j::graph::Context& block, const NDArray& input, NDArra
             streams.push_back(MKLDNNStream("pooling3d"));
         }
 
-        if (streams[0].checkAndReset({&input}, {&output}, {}, {kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, poolingMode, extraParam0})) {
+        if (MKLDNNStream::acquire(streams, {&input}, {&output}, {}, {kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, poolingMode, extraParam0})) {
             mkldnn_memory_desc_t empty;
             mkldnn::memory::desc pool_src_md(empty), pool_dst_md(empty);
             mkldnn::memory::dims pool_strides, pool_kernel, pool_padding, pool_padding_r;
@@ -1758,7 +1788,7 @@ static void pooling2dBP_(nd4j::graph::Context& block, const NDArray& input, cons
             streams.push_back(MKLDNNStream("pooling2d_bp"));
         }
 
-        if (streams[0].checkAndReset({&input, &gradO}, {&gradI}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, poolingMode, extraParam0})) {
+        if (MKLDNNStream::acquire(streams, {&input, &gradO}, {&gradI}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, poolingMode, extraParam0})) {
             mkldnn_memory_desc_t empty;
             mkldnn::memory::desc pool_src_md(empty), pool_diff_src_md(empty), pool_dst_md(empty);
             mkldnn::memory::dims pool_strides, pool_kernel, pool_padding, pool_padding_r;
@@ -2018,7 +2048,7 @@ static void pooling3dBP_(nd4j::graph::Context& block, const NDArray& input, cons
             streams.push_back(MKLDNNStream("pooling3d_bp"));
         }
 
-        if (streams[0].checkAndReset({&input, &gradO}, {&gradI}, {}, {kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, poolingMode, extraParam0})) {
+        if (MKLDNNStream::acquire(streams, {&input, &gradO}, {&gradI}, {}, {kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, poolingMode, extraParam0})) {
             mkldnn_memory_desc_t empty;
             mkldnn::memory::desc pool_src_md(empty), pool_diff_src_md(empty), pool_dst_md(empty);
             mkldnn::memory::dims pool_strides, pool_kernel, pool_padding, pool_padding_r;
@@ -0,0 +1,513 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Forward 2D convolution engines which don't need im2col columns buffer
+//
+
+#include <ops/declarable/generic/helpers/convolutions.h>
+#include <OmpLaunchHelper.h>
+#include <ops/gemm.h>
+#include <templatemath.h>
+#include <vector>
+
+// number of output channels (NHWC) or output pixels (NCHW) accumulated in registers by pointwise kernel
+#define CONV2D_REG_BLOCK 16
+
+// number of Winograd tiles transformed and multiplied at once, transformed weights are reused across all of them
+#define WINOGRAD_TILES 64
+
+// number of output channels in single Winograd GEMM, so that small batches still produce enough parallel GEMMs
+#define WINOGRAD_OC_BLOCK 64
+
+namespace nd4j {
+namespace ops  {
+
+//////////////////////////////////////////////////////////////////////////
+// strides of 4D input/output in [b, c, h, w] order, whatever data format is
+static FORCEINLINE void stridesBCHW(const NDArray* array, const int isNCHW, Nd4jLong& sB, Nd4jLong& sC, Nd4jLong& sH, Nd4jLong& sW) {
+    auto strides = array->stridesOf();
+    sB = strides[0];
+    sC = strides[isNCHW ? 1 : 3];
+    sH = strides[isNCHW ? 2 : 1];
+    sW = strides[isNCHW ? 3 : 2];
+}
+
+//////////////////////////////////////////////////////////////////////////
+// range [start, end) of output positions which read input position o * s + offset within [0, iSize)
+static FORCEINLINE void validRange(const int oSize, const int iSize, const int s, const int offset, int& start, int& end) {
+    start = offset >= 0 ? 0 : (-offset + s - 1) / s;
+    end = iSize - 1 - offset >= 0 ? (iSize - 1 - offset) / s + 1 : 0;
+    end = nd4j::math::nd4j_min<int>(end, oSize);
+    start = nd4j::math::nd4j_min<int>(start, end);
+}
+
+//////////////////////////////////////////////////////////////////////////
+ConvolutionUtils::Conv2dAlgorithm ConvolutionUtils::conv2dAlgorithm(const NDArray* input, const NDArray* weights, const NDArray* bias, const NDArray* output, const int kH, const int kW, const int sH, const int sW, const int dH, const int dW, const bool isDepthwise) {
+
+    // engines below are written for float and double and don't mix types
+    auto dataType = input->dataType();
+    if (dataType != nd4j::DataType::FLOAT32 && dataType != nd4j::DataType::DOUBLE)
+        return CONV2D_IM2COL;
+    if (weights->dataType() != dataType || output->dataType() != dataType || (bias != nullptr && bias->dataType() != dataType))
+        return CONV2D_IM2COL;
+
+    if (isDepthwise || (kH == 1 && kW == 1))
+        return CONV2D_DIRECT;
+
+    if (kH == 3 && kW == 3 && sH == 1 && sW == 1 && dH == 1 && dW == 1)
+        return CONV2D_WINOGRAD;
+
+    return CONV2D_IM2COL;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void conv2dPointwiseDirect_(const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int sH, const int sW, const int pH, const int pW, const int isNCHW) {
+
+    // input   [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW)
+    // weights [1, 1, iC, oC]
+    // bias    [oC]
+    // output  [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW] (NCHW)
+
+    const int bS = input->sizeAt(0);
+    const int iC = input->sizeAt(isNCHW ? 1 : 3);
+    const int iH = input->sizeAt(isNCHW ? 2 : 1);
+    const int iW = input->sizeAt(isNCHW ? 3 : 2);
+    const int oC = output->sizeAt(isNCHW ? 1 : 3);
+    const int oH = output->sizeAt(isNCHW ? 2 : 1);
+    const int oW = output->sizeAt(isNCHW ? 3 : 2);
+
+    Nd4jLong xsB, xsC, xsH, xsW, zsB, zsC, zsH, zsW;
+    stridesBCHW(input, isNCHW, xsB, xsC, xsH, xsW);
+    stridesBCHW(output, isNCHW, zsB, zsC, zsH, zsW);
+    const Nd4jLong wsI = weights->stridesOf()[2];
+    const Nd4jLong wsO = weights->stridesOf()[3];
+
+    auto x = reinterpret_cast<T*>(const_cast<NDArray*>(input)->buffer());
+    auto w = reinterpret_cast<T*>(const_cast<NDArray*>(weights)->buffer());
+    auto b = bias == nullptr ? nullptr : reinterpret_cast<T*>(const_cast<NDArray*>(bias)->buffer());
+    auto z = reinterpret_cast<T*>(output->buffer());
+    const Nd4jLong bEws = bias == nullptr ? 0 : bias->ews();
+
+    int owStart, owEnd;
+    validRange(oW, iW, sW, -pW, owStart, owEnd);
+
+    const int numThreads = nd4j::OmpLaunchHelper::betterThreads(static_cast<Nd4jLong>(bS) * oH * oW * oC * iC);
+
+    #pragma omp parallel for collapse(2) schedule(guided) num_threads(numThreads) if (numThreads > 1)
+    for (int bIdx = 0; bIdx < bS; bIdx++) {
+        for (int oh = 0; oh < oH; oh++) {
+            const int ih = oh * sH - pH;
+            const bool rowInside = ih >= 0 && ih < iH;
+            auto xRow = x + bIdx * xsB + ih * xsH;
+            auto zRow = z + bIdx * zsB + oh * zsH;
+
+            if (isNCHW) {
+                // output pixels of the row are contiguous: block of them is accumulated for each output channel
+                for (int oc = 0; oc < oC; oc++) {
+                    const T start = b == nullptr ? static_cast<T>(0) : b[oc * bEws];
+
+                    for (int ow0 = 0; ow0 < oW; ow0 += CONV2D_REG_BLOCK) {
+                        const int len = nd4j::math::nd4j_min<int>(CONV2D_REG_BLOCK, oW - ow0);
+                        T acc[CONV2D_REG_BLOCK];
+                        for (int j = 0; j < CONV2D_REG_BLOCK; j++)
+                            acc[j] = start;
+
+                        // padded positions get bias only
+                        const int jStart = rowInside ? nd4j::math::nd4j_max<int>(owStart - ow0, 0) : 0;
+                        const int jEnd = rowInside ? nd4j::math::nd4j_min<int>(owEnd - ow0, len) : 0;
+
+                        for (int ic = 0; ic < iC; ic++) {
+                            const T wv = w[ic * wsI + oc * wsO];
+                            auto xp = xRow + ic * xsC + (ow0 * sW - pW) * xsW;
+
+                            #pragma omp simd
+                            for (int j = jStart; j < jEnd; j++)
+                                acc[j] += wv * xp[j * sW * xsW];
+                        }
+
+                        for (int j = 0; j < len; j++)
+                            zRow[oc * zsC + (ow0 + j) * zsW] = acc[j];
+                    }
+                }
+            }
+            else {
+                // output channels of the pixel are contiguous: block of them is accumulated for each pixel
+                for (int ow = 0; ow < oW; ow++) {
+                    const bool inside = rowInside && ow >= owStart && ow < owEnd;
+                    auto xp = xRow + (ow * sW - pW) * xsW;
+                    auto zp = zRow + ow * zsW;
+
+                    for (int oc0 = 0; oc0 < oC; oc0 += CONV2D_REG_BLOCK) {
+                        const int len = nd4j::math::nd4j_min<int>(CONV2D_REG_BLOCK, oC - oc0);
+                        T acc[CONV2D_REG_BLOCK];
+                        for (int j = 0; j < len; j++)
+                            acc[j] = b == nullptr ? static_cast<T>(0) : b[(oc0 + j) * bEws];
+
+                        if (inside) {
+                            for (int ic = 0; ic < iC; ic++) {
+                                const T xv = xp[ic * xsC];
+                                auto wp = w + ic * wsI + oc0 * wsO;
+
+                                #pragma omp simd
+                                for (int j = 0; j < len; j++)
+                                    acc[j] += xv * wp[j * wsO];
+                            }
+                        }
+
+                        for (int j = 0; j < len; j++)
+                            zp[(oc0 + j) * zsC] = acc[j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void depthwiseConv2dDirect_(const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW) {
+
+    // input   [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW)
+    // weights [kH, kW, iC, mC]
+    // bias    [oC] = iC*mC
+    // output  [bS, oH, oW, iC*mC] (NHWC) or [bS, iC*mC, oH, oW] (NCHW)
+
+    const int bS = input->sizeAt(0);
+    const int iC = input->sizeAt(isNCHW ? 1 : 3);
+    const int iH = input->sizeAt(isNCHW ? 2 : 1);
+    const int iW = input->sizeAt(isNCHW ? 3 : 2);
+    const int oH = output->sizeAt(isNCHW ? 2 : 1);
+    const int oW = output->sizeAt(isNCHW ? 3 : 2);
+    const int mC = weights->sizeAt(3);
+
+    Nd4jLong xsB, xsC, xsH, xsW, zsB, zsC, zsH, zsW;
+    stridesBCHW(input, isNCHW, xsB, xsC, xsH, xsW);
+    stridesBCHW(output, isNCHW, zsB, zsC, zsH, zsW);
+    const Nd4jLong wsKH = weights->stridesOf()[0];
+    const Nd4jLong wsKW = weights->stridesOf()[1];
+    const Nd4jLong wsI  = weights->stridesOf()[2];
+    const Nd4jLong wsM  = weights->stridesOf()[3];
+
+    auto x = reinterpret_cast<T*>(const_cast<NDArray*>(input)->buffer());
+    auto w = reinterpret_cast<T*>(const_cast<NDArray*>(weights)->buffer());
+    auto b = bias == nullptr ? nullptr : reinterpret_cast<T*>(const_cast<NDArray*>(bias)->buffer());
+    auto z = reinterpret_cast<T*>(output->buffer());
+    const Nd4jLong bEws = bias == nullptr ? 0 : bias->ews();
+
+    const int numThreads = nd4j::OmpLaunchHelper::betterThreads(static_cast<Nd4jLong>(bS) * iC * mC * oH * oW * kH * kW);
+
+    // each output row is accumulated in place, so each kernel tap is a strided axpy over valid part of the row
+    #pragma omp parallel for collapse(3) schedule(guided) num_threads(numThreads) if (numThreads > 1)
+    for (int bIdx = 0; bIdx < bS; bIdx++) {
+        for (int oc = 0; oc < iC * mC; oc++) {
+            for (int oh = 0; oh < oH; oh++) {
+                const int ic = oc / mC;
+                const int m = oc % mC;
+                auto xChannel = x + bIdx * xsB + ic * xsC;
+                auto zRow = z + bIdx * zsB + oc * zsC + oh * zsH;
+                const T start = b == nullptr ? static_cast<T>(0) : b[oc * bEws];
+
+                for (int ow = 0; ow < oW; ow++)
+                    zRow[ow * zsW] = start;
+
+                for (int kh = 0; kh < kH; kh++) {
+                    const int ih = oh * sH - pH + kh * dH;
+                    if (ih < 0 || ih >= iH)
+                        continue;
+
+                    auto xRow = xChannel + ih * xsH;
+
+                    for (int kw = 0; kw < kW; kw++) {
+                        const int offset = kw * dW - pW;
+                        int owStart, owEnd;
+                        validRange(oW, iW, sW, offset, owStart, owEnd);
+
+                        const T wv = w[kh * wsKH + kw * wsKW + ic * wsI + m * wsM];
+                        const Nd4jLong xStep = sW * xsW;
+                        auto xp = xRow + offset * xsW;
+
+                        #pragma omp simd
+                        for (int ow = owStart; ow < owEnd; ow++)
+                            zRow[ow * zsW] += wv * xp[ow * xStep];
+                    }
+                }
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// transformation matrices of Winograd F(M x M, 3 x 3), tiles are A x A where A = M + 2
+template <int M>
+struct WinogradMatrices;
+
+template <>
+struct WinogradMatrices<2> {
+    static const double* BT() {     // [A, A]
+        static const double m[] = { 1,  0, -1,  0,
+                                    0,  1,  1,  0,
+                                    0, -1,  1,  0,
+                                    0,  1,  0, -1 };
+        return m;
+    }
+    static const double* G() {      // [A, 3]
+        static const double m[] = { 1.0,  0.0, 0.0,
+                                    0.5,  0.5, 0.5,
+                                    0.5, -0.5, 0.5,
+                                    0.0,  0.0, 1.0 };
+        return m;
+    }
+    static const double* AT() {     // [M, A]
+        static const double m[] = { 1, 1,  1,  0,
+                                    0, 1, -1, -1 };
+        return m;
+    }
+};
+
+template <>
+struct WinogradMatrices<4> {
+    static const double* BT() {
+        static const double m[] = { 4,  0, -5,  0, 1, 0,
+                                    0, -4, -4,  1, 1, 0,
+                                    0,  4, -4, -1, 1, 0,
+                                    0, -2, -1,  2, 1, 0,
+                                    0,  2, -1, -2, 1, 0,
+                                    0,  4,  0, -5, 0, 1 };
+        return m;
+    }
+    static const double* G() {
+        static const double m[] = {  1./4,      0.,     0.,
+                                    -1./6,  -1./6,  -1./6,
+                                    -1./6,   1./6,  -1./6,
+                                     1./24,  1./12,  1./6,
+                                     1./24, -1./12,  1./6,
+                                        0.,     0.,     1. };
+        return m;
+    }
+    static const double* AT() {
+        static const double m[] = { 1, 1,  1, 1,  1, 0,
+                                    0, 1, -1, 2, -2, 0,
+                                    0, 1,  1, 4,  4, 0,
+                                    0, 1, -1, 8, -8, 1 };
+        return m;
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// out[R, C] = left[R, K] * in[K, N] * right^T[N, C], right is given as [C, N]
+template <typename T, int R, int K, int N, int C>
+static FORCEINLINE void sandwich(const double* left, const T* in, const double* right, T* out) {
+    T tmp[R * N];
+    for (int r = 0; r < R; r++)
+        for (int n = 0; n < N; n++) {
+            T sum = static_cast<T>(0);
+            for (int k = 0; k < K; k++)
+                sum += static_cast<T>(left[r * K + k]) * in[k * N + n];
+            tmp[r * N + n] = sum;
+        }
+
+    for (int r = 0; r < R; r++)
+        for (int c = 0; c < C; c++) {
+            T sum = static_cast<T>(0);
+            for (int n = 0; n < N; n++)
+                sum += tmp[r * N + n] * static_cast<T>(right[c * N + n]);
+            out[r * C + c] = sum;
+        }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T, int M>
+static void conv2dWinograd_(const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int pH, const int pW, const int isNCHW) {
+
+    // input   [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW)
+    // weights [3, 3, iC, oC]
+    // bias    [oC]
+    // output  [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW] (NCHW)
+
+    const int A = M + 2;
+    const int AA = A * A;
+
+    const int bS = input->sizeAt(0);
+    const int iC = input->sizeAt(isNCHW ? 1 : 3);
+    const int iH = input->sizeAt(isNCHW ? 2 : 1);
+    const int iW = input->sizeAt(isNCHW ? 3 : 2);
+    const int oC = output->sizeAt(isNCHW ? 1 : 3);
+    const int oH = output->sizeAt(isNCHW ? 2 : 1);
+    const int oW = output->sizeAt(isNCHW ? 3 : 2);
+
+    Nd4jLong xsB, xsC, xsH, xsW, zsB, zsC, zsH, zsW;
+    stridesBCHW(input, isNCHW, xsB, xsC, xsH, xsW);
+    stridesBCHW(output, isNCHW, zsB, zsC, zsH, zsW);
+    const Nd4jLong wsKH = weights->stridesOf()[0];
+    const Nd4jLong wsKW = weights->stridesOf()[1];
+    const Nd4jLong wsI  = weights->stridesOf()[2];
+    const Nd4jLong wsO  = weights->stridesOf()[3];
+
+    auto x = reinterpret_cast<T*>(const_cast<NDArray*>(input)->buffer());
+    auto w = reinterpret_cast<T*>(const_cast<NDArray*>(weights)->buffer());
+    auto b = bias == nullptr ? nullptr : reinterpret_cast<T*>(const_cast<NDArray*>(bias)->buffer());
+    auto z = reinterpret_cast<T*>(output->buffer());
+    const Nd4jLong bEws = bias == nullptr ? 0 : bias->ews();
+
+    const double* BT = WinogradMatrices<M>::BT();
+    const double* G  = WinogradMatrices<M>::G();
+    const double* AT = WinogradMatrices<M>::AT();
+
+    // transformed weights U = G * g * G^T, laid out as [AA, iC, oC]
+    std::vector<T> U(static_cast<size_t>(AA) * iC * oC);
+
+    #pragma omp parallel for collapse(2) schedule(static) if (static_cast<Nd4jLong>(iC) * oC > Environment::getInstance()->elementwiseThreshold() / AA)
+    for (int ic = 0; ic < iC; ic++) {
+        for (int oc = 0; oc < oC; oc++) {
+            T g[9], u[AA];
+            for (int kh = 0; kh < 3; kh++)
+                for (int kw = 0; kw < 3; kw++)
+                    g[kh * 3 + kw] = w[kh * wsKH + kw * wsKW + ic * wsI + oc * wsO];
+
+            sandwich<T, A, 3, 3, A>(G, g, G, u);
+
+            for (int xi = 0; xi < AA; xi++)
+                U[(static_cast<size_t>(xi) * iC + ic) * oC + oc] = u[xi];
+        }
+    }
+
+    const int tilesH = (oH + M - 1) / M;
+    const int tilesW = (oW + M - 1) / M;
+    const Nd4jLong numTiles = static_cast<Nd4jLong>(bS) * tilesH * tilesW;
+
+    // tiles are processed in blocks of fixed size, products of each block are AA independent GEMMs
+    const int blockTiles = nd4j::math::nd4j_min<Nd4jLong>(numTiles, WINOGRAD_TILES);
+    const Nd4jLong numBlocks = (numTiles + blockTiles - 1) / blockTiles;
+    const int ocBlocks = (oC + WINOGRAD_OC_BLOCK - 1) / WINOGRAD_OC_BLOCK;
+
+    // V is [AA, blockTiles, iC], P is [AA, blockTiles, oC], both are shared by all threads
+    std::vector<T> V(static_cast<size_t>(AA) * blockTiles * iC);
+    std::vector<T> P(static_cast<size_t>(AA) * blockTiles * oC);
+
+    const int numThreads = nd4j::OmpLaunchHelper::betterThreads(numTiles * AA * iC * oC);
+
+    #pragma omp parallel num_threads(numThreads) if (numThreads > 1) default(shared)
+    for (Nd4jLong block = 0; block < numBlocks; block++) {
+        const Nd4jLong firstTile = block * blockTiles;
+        const int tiles = nd4j::math::nd4j_min<Nd4jLong>(blockTiles, numTiles - firstTile);
+
+        // input transform V = B^T * d * B
+        #pragma omp for schedule(static)
+        for (int t = 0; t < tiles; t++) {
+            const Nd4jLong tile = firstTile + t;
+            const int bIdx = tile / (tilesH * tilesW);
+            const int th = (tile / tilesW) % tilesH;
+            const int tw = tile % tilesW;
+            const int ih0 = th * M - pH;
+            const int iw0 = tw * M - pW;
+
+            for (int ic = 0; ic < iC; ic++) {
+                auto xChannel = x + bIdx * xsB + ic * xsC;
+                T d[AA], v[AA];
+                for (int i = 0; i < A; i++) {
+                    const int ih = ih0 + i;
+                    for (int j = 0; j < A; j++) {
+                        const int iw = iw0 + j;
+                        d[i * A + j] = (ih >= 0 && ih < iH && iw >= 0 && iw < iW) ? xChannel[ih * xsH + iw * xsW] : static_cast<T>(0);
+                    }
+                }
+
+                sandwich<T, A, A, A, A>(BT, d, BT, v);
+
+                for (int xi = 0; xi < AA; xi++)
+                    V[(static_cast<size_t>(xi) * blockTiles + t) * iC + ic] = v[xi];
+            }
+        }
+
+        // elementwise products: P[xi] = V[xi] x U[xi], [tiles, iC] x [iC, oC], split by blocks of output channels
+        // in column-major terms that's P^T [oC, tiles] = U^T [oC, iC] x V^T [iC, tiles], so no transposes are needed
+        #pragma omp for collapse(2) schedule(static)
+        for (int xi = 0; xi < AA; xi++) {
+            for (int ob = 0; ob < ocBlocks; ob++) {
+                const int oc0 = ob * WINOGRAD_OC_BLOCK;
+                const int ocLen = nd4j::math::nd4j_min<int>(WINOGRAD_OC_BLOCK, oC - oc0);
+
+                auto u = U.data() + static_cast<size_t>(xi) * iC * oC + oc0;
+                auto v = V.data() + static_cast<size_t>(xi) * blockTiles * iC;
+                auto p = P.data() + static_cast<size_t>(xi) * blockTiles * oC + oc0;
+
+                nd4j::blas::GEMM<T, T, T>::op(CblasColMajor, CblasNoTrans, CblasNoTrans, ocLen, tiles, iC, 1.0, u, oC, v, iC, 0.0, p, oC);
+            }
+        }
+
+        // output transform y = A^T * p * A, tiles at right and bottom edges are cropped
+        #pragma omp for collapse(2) schedule(static)
+        for (int t = 0; t < tiles; t++) {
+            for (int oc = 0; oc < oC; oc++) {
+                const Nd4jLong tile = firstTile + t;
+                const int bIdx = tile / (tilesH * tilesW);
+                const int th = (tile / tilesW) % tilesH;
+                const int tw = tile % tilesW;
+                const int hLen = nd4j::math::nd4j_min<int>(M, oH - th * M);
+                const int wLen = nd4j::math::nd4j_min<int>(M, oW - tw * M);
+
+                T p[AA], y[M * M];
+                for (int xi = 0; xi < AA; xi++)
+                    p[xi] = P[(static_cast<size_t>(xi) * blockTiles + t) * oC + oc];
+
+                sandwich<T, M, A, A, M>(AT, p, AT, y);
+
+                const T start = b == nullptr ? static_cast<T>(0) : b[oc * bEws];
+                auto zp = z + bIdx * zsB + oc * zsC + (th * M) * zsH + (tw * M) * zsW;
+                for (int i = 0; i < hLen; i++)
+                    for (int j = 0; j < wLen; j++)
+                        zp[i * zsH + j * zsW] = y[i * M + j] + start;
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void conv2dWinogradSelector_(const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int pH, const int pW, const int isNCHW) {
+
+    const int iC = input->sizeAt(isNCHW ? 1 : 3);
+    const int oH = output->sizeAt(isNCHW ? 2 : 1);
+    const int oW = output->sizeAt(isNCHW ? 3 : 2);
+
+    // bigger tiles save more multiplications, but transforms cost more and rounding errors grow, so they pay off for wide layers only
+    if (oH >= 8 && oW >= 8 && iC >= 16)
+        conv2dWinograd_<T, 4>(input, weights, bias, output, pH, pW, isNCHW);
+    else
+        conv2dWinograd_<T, 2>(input, weights, bias, output, pH, pW, isNCHW);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::conv2dPointwiseDirect(const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int sH, const int sW, const int pH, const int pW, const int isNCHW) {
+    BUILD_SINGLE_SELECTOR(input->dataType(), conv2dPointwiseDirect_, (input, weights, bias, output, sH, sW, pH, pW, isNCHW), FLOAT_NATIVE);
+}
+
+void ConvolutionUtils::conv2dWinograd(const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int pH, const int pW, const int isNCHW) {
+    BUILD_SINGLE_SELECTOR(input->dataType(), conv2dWinogradSelector_, (input, weights, bias, output, pH, pW, isNCHW), FLOAT_NATIVE);
+}
+
+void ConvolutionUtils::depthwiseConv2dDirect(const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW) {
+    BUILD_SINGLE_SELECTOR(input->dataType(), depthwiseConv2dDirect_, (input, weights, bias, output, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW), FLOAT_NATIVE);
+}
+
+BUILD_SINGLE_TEMPLATE(template void conv2dPointwiseDirect_,  (const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int sH, const int sW, const int pH, const int pW, const int isNCHW), FLOAT_NATIVE);
+BUILD_SINGLE_TEMPLATE(template void conv2dWinogradSelector_, (const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int pH, const int pW, const int isNCHW), FLOAT_NATIVE);
+BUILD_SINGLE_TEMPLATE(template void depthwiseConv2dDirect_,  (const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW), FLOAT_NATIVE);
+
+}
+}
@@ -51,6 +51,9 @@ namespace nd4j {
             auto numWorkers = block.numI() > 0 ? INT_ARG(0) : omp_get_max_threads();
             auto nsRounds = block.numI() > 1 ? INT_ARG(1) : 0;
 
+            // optional: number of pairs sharing negative samples and syn0 write-backs, 0 means per-pair updates
+            auto minibatchSize = block.numI() > 2 ? INT_ARG(2) : 0;
+
             auto isInference = block.numB() > 0 ? B_ARG(0) : false;
             auto isPreciseMode = block.numB() > 1 ? B_ARG(1) : false;
 
@@ -60,7 +63,7 @@ namespace nd4j {
             REQUIRE_TRUE(syn0->dataType() == expTable->dataType(), 0, "SkipGram: expTable must have the same data type as syn0 table");
 
 
-            nd4j::ops::helpers::skipgram(*syn0, *syn1, *syn1neg, *expTable, *negTable, *target, *ngStarter, nsRounds, *indices, *codes, *alpha, *randomValue, *inferenceVector, isPreciseMode, numWorkers);
+            nd4j::ops::helpers::skipgram(*syn0, *syn1, *syn1neg, *expTable, *negTable, *target, *ngStarter, nsRounds, *indices, *codes, *alpha, *randomValue, *inferenceVector, isPreciseMode, numWorkers, minibatchSize);
 
             return Status::OK();
         }
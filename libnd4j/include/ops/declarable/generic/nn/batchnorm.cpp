@@ -118,7 +118,8 @@ CUSTOM_OP_IMPL(batchnorm, 3, 1, false, 1, 2) {
     DECLARE_TYPES(batchnorm) {
         getOpDescriptor()
                 ->setAllowedInputTypes(nd4j::DataType::ANY)
-                ->setAllowedOutputTypes({ALL_FLOATS});
+                ->setAllowedOutputTypes({ALL_FLOATS})
+                ->setShapeMemoizable(true);
     }
 
 
@@ -203,7 +204,7 @@ CUSTOM_OP_IMPL(batchnorm_new, 3, 1, false, 1, 2) {
         weights({0, 1, 0, 0}).assign(1.0f);
         weights({1, 2, 0, 0}).assign(0.0f);
 
-        if (streams[0].checkAndReset({input, mean, variance, gamma, beta}, {output}, {epsilon}, axes)) {
+        if (MKLDNNStream::acquire(streams, {input, mean, variance, gamma, beta, &weights}, {output}, {epsilon}, axes)) {
             mkldnn_memory_desc_t empty;
             mkldnn::memory::desc batchnorm_src_md(empty);
 
@@ -32,7 +32,8 @@ namespace ops {
         getOpDescriptor()
                 ->setAllowedInputTypes({ALL_FLOATS})
                 ->setAllowedOutputTypes({ALL_FLOATS})
-                ->setSameMode(true);
+                ->setSameMode(true)
+                ->setShapeMemoizable(true);
     }
 
 CONFIGURABLE_OP_IMPL(softmax, 1, 1, true, 0, 0) {
@@ -38,6 +38,8 @@ namespace nd4j {
             REQUIRE_TRUE(target->rankOf() == 1, 0, "in_top_k: The target should be a vector");
 
             int k = INT_ARG(0);
+            REQUIRE_TRUE(k > 0, 0, "in_top_k: k should be positive, but %i given", k);
+
             return helpers::inTopKFunctor(predictions, target, result, k);
         }
 
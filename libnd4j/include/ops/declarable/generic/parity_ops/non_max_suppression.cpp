@@ -37,16 +37,22 @@ namespace nd4j {
             else
                 REQUIRE_TRUE(false, 0, "image.non_max_suppression: Max output size argument cannot be retrieved.");
 
-            REQUIRE_TRUE(boxes->rankOf() == 2, 0, "image.non_max_suppression: The rank of boxes array should be 2, but %i is given", boxes->rankOf());
-            REQUIRE_TRUE(scales->rankOf() == 1 && scales->lengthOf() == boxes->sizeAt(0), 0, "image.non_max_suppression: The rank of boxes array should be 2, but %i is given", boxes->rankOf());
+            REQUIRE_TRUE(boxes->rankOf() == 2 || boxes->rankOf() == 3, 0, "image.non_max_suppression: The rank of boxes array should be 2 or 3, but %i is given", boxes->rankOf());
+            REQUIRE_TRUE(scales->rankOf() == boxes->rankOf() - 1, 0, "image.non_max_suppression: The rank of scales array should be %i, but %i is given", boxes->rankOf() - 1, scales->rankOf());
+            for (int e = 0; e < scales->rankOf(); e++)
+                REQUIRE_TRUE(scales->sizeAt(e) == boxes->sizeAt(e), 0, "image.non_max_suppression: Shapes of boxes and scales arrays mismatch at dimension %i", e);
 
-            if (scales->lengthOf() < maxOutputSize)
-                maxOutputSize = scales->lengthOf();
+            if (scales->sizeAt(-1) < maxOutputSize)
+                maxOutputSize = scales->sizeAt(-1);
             double threshold = 0.5;
             if (block.getTArguments()->size() > 0)
                 threshold = T_ARG(0);
 
-            helpers::nonMaxSuppressionV2(boxes, scales, maxOutputSize, threshold, output);
+            if (boxes->rankOf() == 3)
+                helpers::nonMaxSuppressionBatched(boxes, scales, maxOutputSize, threshold, output);
+            else
+                helpers::nonMaxSuppressionV2(boxes, scales, maxOutputSize, threshold, output);
+
             return Status::OK();
         }
 
@@ -56,11 +62,15 @@ namespace nd4j {
             Nd4jLong *outputShape = nullptr;
 
             int maxOutputSize = INT_ARG(0);
-            Nd4jLong boxSize = shape::sizeAt(in, 0);
+            Nd4jLong boxSize = shape::sizeAt(in, outRank - 2);
             if (boxSize < maxOutputSize) 
                 maxOutputSize = boxSize;
 
-            outputShape = ShapeBuilders::createVectorShapeInfo(ArrayOptions::dataType(in), maxOutputSize, block.getWorkspace());
+            // batched mode: one row of selected indices per batch entry
+            if (outRank == 3)
+                outputShape = ShapeBuilders::createShapeInfo(ArrayOptions::dataType(in), 'c', {shape::sizeAt(in, 0), (Nd4jLong) maxOutputSize}, block.getWorkspace());
+            else
+                outputShape = ShapeBuilders::createVectorShapeInfo(ArrayOptions::dataType(in), maxOutputSize, block.getWorkspace());
 
             return SHAPELIST(outputShape);
         }
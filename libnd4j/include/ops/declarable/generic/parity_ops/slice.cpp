@@ -80,7 +80,8 @@ namespace nd4j {
         DECLARE_TYPES(slice) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
-                    ->setSameMode(true);
+                    ->setSameMode(true)
+                    ->setShapeMemoizable(true);
         }
 
         DECLARE_SHAPE_FN(slice) {
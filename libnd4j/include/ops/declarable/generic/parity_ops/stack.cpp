@@ -67,7 +67,8 @@ DECLARE_SYN(Pack, stack);
 		//getOpDescriptor()->setSameMode(true);
 		getOpDescriptor()
 		    ->setAllowedInputTypes(DataType::ANY)
-		    ->setAllowedOutputTypes(DataType::ANY);
+		    ->setAllowedOutputTypes(DataType::ANY)
+		    ->setShapeMemoizable(true);
 
 	}
 
@@ -602,7 +602,8 @@ namespace nd4j {
         DECLARE_TYPES(strided_slice) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
-                    ->setSameMode(true);
+                    ->setSameMode(true)
+                    ->setShapeMemoizable(true);
         }
 
         DECLARE_TYPES(strided_slice_bp) {
@@ -60,7 +60,8 @@ namespace nd4j {
         DECLARE_TYPES(expand_dims) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
-                    ->setSameMode(true);
+                    ->setSameMode(true)
+                    ->setShapeMemoizable(true);
         }
 
         DECLARE_SHAPE_FN(expand_dims) {
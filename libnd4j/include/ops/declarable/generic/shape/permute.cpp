@@ -87,7 +87,8 @@ namespace nd4j {
             getOpDescriptor()
                     ->setAllowedInputTypes(0, nd4j::DataType::ANY)
                     ->setAllowedInputTypes(1, {ALL_INTS})
-                    ->setSameMode(true);
+                    ->setSameMode(true)
+                    ->setShapeMemoizable(true);
         }
 
         DECLARE_SHAPE_FN(permute) {
@@ -84,7 +84,8 @@ namespace nd4j {
         DECLARE_TYPES(squeeze) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
-                    ->setSameMode(true);
+                    ->setSameMode(true)
+                    ->setShapeMemoizable(true);
         }
 
         DECLARE_SHAPE_FN(squeeze) {
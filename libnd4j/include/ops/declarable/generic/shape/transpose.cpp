@@ -93,7 +93,8 @@ namespace ops {
     DECLARE_TYPES(transpose) {
         getOpDescriptor()
                 ->setAllowedInputTypes(nd4j::DataType::ANY)
-                ->setSameMode(true);
+                ->setSameMode(true)
+                ->setShapeMemoizable(true);
     }
 
     DECLARE_SHAPE_FN(transpose) {
@@ -104,7 +104,8 @@ CUSTOM_OP_IMPL(concat, -1, 1, false, 0, 1) {
         DECLARE_TYPES(concat) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
-                    ->setSameMode(true);
+                    ->setSameMode(true)
+                    ->setShapeMemoizable(true);
         }
 
 DECLARE_SHAPE_FN(concat) {
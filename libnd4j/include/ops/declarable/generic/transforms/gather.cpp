@@ -72,6 +72,7 @@ DECLARE_TYPES(gather) {
 	getOpDescriptor()->setAllowedInputTypes(0, {ALL_INTS, ALL_FLOATS});
 	getOpDescriptor()->setAllowedInputTypes(1, {ALL_INTS});
 	getOpDescriptor()->setAllowedOutputTypes(0, {ALL_INTS, ALL_FLOATS});
+	getOpDescriptor()->setShapeMemoizable(true);
 }
 
 
@@ -80,7 +80,8 @@ DECLARE_TYPES(pad) {
     getOpDescriptor()
     	->setAllowedInputTypes(0, nd4j::DataType::ANY)
     	->setAllowedInputTypes(1, {DataType::INT32, DataType::INT64}) // INT32 with TF, but used also INT64 due long shapes
-    	->setSameMode(true);
+    	->setSameMode(true)
+    	->setShapeMemoizable(true);
 }
 
 DECLARE_SHAPE_FN(pad) {
@@ -1560,14 +1560,19 @@ namespace nd4j {
         /*
          * image.non_max_suppression op.
          * input:
-         *     0 - boxes - 2D-tensor with shape (num_boxes, 4) by float type
-         *     1 - scales - 1D-tensor with shape (num_boxes) by float type
+         *     0 - boxes - 2D-tensor with shape (num_boxes, 4) by float type,
+         *                 or 3D-tensor with shape (batch, num_boxes, 4) for batched (e.g. per-class) suppression
+         *     1 - scales - 1D-tensor with shape (num_boxes) by float type, or 2D-tensor with shape (batch, num_boxes)
          *     2 - output_size - 0D-tensor by int type (optional)
          * float args:
          *     0 - threshold - threshold value for overlap checks (optional, by default 0.5)
          * int args:
          *     0 - output_size - as arg 2 used for same target. Eigher this or arg 2 should be provided.
          *
+         * output:
+         *     0 - indices of selected boxes, 1D-tensor with shape (output_size),
+         *         or 2D-tensor with shape (batch, output_size) in batched mode, where unused slots are set to -1
+         *
          * */
         #if NOT_EXCLUDED(OP_image_non_max_suppression)
         DECLARE_CUSTOM_OP(non_max_suppression, 2, 1, false, 0, 0);
@@ -22,12 +22,32 @@
 #include <types/float16.h>
 #include <ops/declarable/helpers/batched_gemm.h>
 #include <helpers/BlasHelper.h>
-
+#include <OmpLaunchHelper.h>
+#include <templatemath.h>
+#include <ops/gemm.h>
 
 namespace nd4j {
     namespace ops {
         namespace helpers {
-        
+
+            /**
+             * Fallback for vendors without batched gemm: each problem goes to packed nd4j::blas::GEMM.
+             * Many small problems are distributed between threads one problem per task, while few big ones
+             * are computed one after another, so GEMM parallelizes each of them over its tiles.
+             *
+             * All matrices are column-major, as in cblas calls above
+             */
+            template <typename T>
+            static void bgemmPacked(std::vector<NDArray*>& vA, std::vector<NDArray*>& vB, std::vector<NDArray*>& vC, NDArray* alphas, NDArray* betas, int transA, int transB, int M, int N, int K, int ldA, int ldB, int ldC) {
+                const int batchSize = vA.size();
+                const int numThreads = OmpLaunchHelper::betterThreads(static_cast<Nd4jLong>(batchSize) * M * N * K);
+                const bool perProblem = numThreads > 1 && batchSize >= numThreads;
+
+                #pragma omp parallel for num_threads(numThreads) if (perProblem) schedule(dynamic)
+                for (int p = 0; p < batchSize; p++)
+                    nd4j::blas::GEMM<T, T, T>::op(CblasColMajor, transA, transB, M, N, K, alphas->e<double>(p), vA[p]->buffer(), ldA, vB[p]->buffer(), ldB, betas->e<double>(p), vC[p]->buffer(), ldC);
+            }
+
 
             template <typename T>
             void __bgemm(std::vector<NDArray*>& vA, std::vector<NDArray*>& vB, std::vector<NDArray*>& vC, NDArray* alphas, NDArray* betas, int transA, int transB, int M, int N, int K, int ldA, int ldB, int ldC) {
@@ -85,28 +105,7 @@ namespace nd4j {
                     RELEASE(tldC, arr->getWorkspace());
                     RELEASE(tsize, arr->getWorkspace());
                 } else {
-                    CBLAS_TRANSPOSE tA = (CBLAS_TRANSPOSE) transA;
-                    CBLAS_TRANSPOSE tB = (CBLAS_TRANSPOSE) transB;
-
-#pragma omp parallel for
-                    for (int p = 0; p < vA.size(); ++p) {
-                        auto A = reinterpret_cast<T*>(vA.at(p)->buffer());
-                        auto B = reinterpret_cast<T*>(vB.at(p)->buffer());
-                        auto C = reinterpret_cast<T*>(vC.at(p)->buffer());
-                        auto alpha = alphas->e<T>(p);
-                        auto beta = betas->e<T>(p);
-                        for (int m = 0; m < M; ++m) {
-                            for (int n = 0; n < N; ++n) {
-                                T c_mnp = 0;
-
-                                #pragma omp simd
-                                for (int k = 0; k < K; ++k)
-                                    c_mnp += A[tA == CblasNoTrans ? (m + k * ldA) : (m * ldA + k)] * B[tB == CblasNoTrans ? (k + n * ldB) : (k * ldB + n)];
-
-                                C[m + n * ldC] = alpha * c_mnp + beta * C[m + n * ldC];
-                            } 
-                        } 
-                    }
+                    bgemmPacked<T>(vA, vB, vC, alphas, betas, transA, transB, M, N, K, ldA, ldB, ldC);
                 }
             };
 
@@ -20,6 +20,7 @@
 
 #include <ops/declarable/helpers/dropout.h>
 #include <NativeOps.h>
+#include <helpers/RandomFill.h>
 #include <vector>
 #include <memory>
 
@@ -32,14 +33,21 @@ namespace helpers {
 
         nd4j::graph::RandomGenerator nodeRng(3019L, seed);
 
-        #pragma omp parallel for if (input->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-        for (Nd4jLong e = 0; e < input->lengthOf(); ++e) {
-            float val = nodeRng.relativeT(e, T(0.f), T(1.f));
-//                nd4j_printf("Random value is %f.\n", val);
+        // mask depends only on seed and element index, so forward and backprop passes always get the same one
+        if (input->ews() == 1 && output->ews() == 1 && input->ordering() == output->ordering()) {
+            auto x = input->bufferAsT<T>();
+            auto z = output->bufferAsT<T>();
 
-            if (val < probValue)
-                output->p<T>(e, input->e<T>(e) / probValue);
-///                else
+            RandomFill::forEachUniform<T>(nodeRng, input->lengthOf(), [&] (Nd4jLong e, RandomFill::Compute<T> val) {
+                if (val < probValue)
+                    z[e] = static_cast<T>(x[e] / probValue);
+            });
+        }
+        else {
+            RandomFill::forEachUniform<T>(nodeRng, input->lengthOf(), [&] (Nd4jLong e, RandomFill::Compute<T> val) {
+                if (val < probValue)
+                    output->p<T>(e, input->e<T>(e) / probValue);
+            });
         }
     }
     BUILD_SINGLE_TEMPLATE(template void dropoutSimple, (NDArray const* input, NDArray* output, double probValue, int seed), FLOAT_TYPES);
@@ -125,12 +133,10 @@ namespace helpers {
         //input->template applyRandom<randomOps::AlphaDropOut<T>>(rng, nullptr, output, probValueArr);
         nd4j::graph::RandomGenerator nodeRng(3019L, seed);
 
-#pragma omp parallel for if (input->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-        for (Nd4jLong e = 0; e < input->lengthOf(); ++e) {
-            float randVal = nodeRng.relativeT(e, T(0.f), T(1.f));
+        RandomFill::forEachUniform<T>(nodeRng, input->lengthOf(), [&] (Nd4jLong e, RandomFill::Compute<T> randVal) {
             float xVal = input->e<float>(e);
             output->p<float>(e, randVal >= probValue ? alpha * beta + alpha1 : alpha * xVal + alpha1);
-        }
+        });
 
         return ND4J_STATUS_OK;
     }
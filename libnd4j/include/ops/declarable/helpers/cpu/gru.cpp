@@ -25,6 +25,8 @@
 
 
 #include<ops/declarable/helpers/gru.h>
+#include <helpers/MmulHelper.h>
+#include <memory>
 
 namespace nd4j 	  {
 namespace ops 	  {
@@ -72,6 +74,102 @@ void gruCell(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArr
     h->assign( u * (*h0) + (1.f - u) * n );
 }
 
+//////////////////////////////////////////////////////////////////////////
+// fused reset/update gates for single time step, all matrices are in f order: element [e, j] of matrix is located at j*ld + e
+// xWb  input projection plus biases for current time step [bS x 3*nU], leading dimension is ldx
+// hW   recurrent projection for gates [bS x 2*nU]
+// u    update gate [bS x nU], rh is r◦h0 [bS x nU]
+template <typename T>
+static void gruGates_(const T* xWb, const Nd4jLong ldx, const T* hW, const T* h0, T* u, T* rh, const Nd4jLong bS, const Nd4jLong nU) {
+
+    #pragma omp parallel for if(bS * nU > Environment::getInstance()->elementwiseThreshold()) schedule(static)
+    for (Nd4jLong j = 0; j < nU; ++j) {
+
+        const T* xr = xWb + j * ldx;
+        const T* xu = xWb + (nU + j) * ldx;
+        const T* hr = hW + j * bS;
+        const T* hu = hW + (nU + j) * bS;
+        const T* hp = h0 + j * bS;
+
+        #pragma omp simd
+        for (Nd4jLong e = 0; e < bS; ++e) {
+            rh[j * bS + e] = nd4j::math::nd4j_sigmoid<T,T>(xr[e] + hr[e]) * hp[e];
+            u[j * bS + e]  = nd4j::math::nd4j_sigmoid<T,T>(xu[e] + hu[e]);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// fused candidate activation and cell output: h = u◦h0 + (1 - u)◦tanh(x*Wxn + bn + (r◦h0)*Whn)
+template <typename T>
+static void gruOutput_(const T* xWb, const Nd4jLong ldx, const T* rhW, const T* h0, const T* u, T* h, const Nd4jLong bS, const Nd4jLong nU) {
+
+    #pragma omp parallel for if(bS * nU > Environment::getInstance()->elementwiseThreshold()) schedule(static)
+    for (Nd4jLong j = 0; j < nU; ++j) {
+
+        const T* xn = xWb + (2*nU + j) * ldx;
+
+        #pragma omp simd
+        for (Nd4jLong e = 0; e < bS; ++e) {
+            const auto i = j * bS + e;
+            const T n = nd4j::math::nd4j_tanh<T,T>(xn[e] + rhW[i]);
+            h[i] = u[i] * h0[i] + ((T) 1.f - u[i]) * n;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void gruTimeLoop_(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h) {
+
+    const Nd4jLong time = x->sizeAt(0);
+    const Nd4jLong bS   = x->sizeAt(1);
+    const Nd4jLong iS   = x->sizeAt(2);
+    const Nd4jLong nU   = h0->sizeAt(1);
+
+    auto workspace = x->getWorkspace();
+    auto dtype = x->dataType();
+
+    // input projection for all time steps is done by single gemm: [time*bS x iS] * [iS x 3*nU] + b
+    std::unique_ptr<NDArray> xC(x->ordering() == 'c' && x->ews() == 1 ? nullptr : const_cast<NDArray*>(x)->dup('c'));
+    std::unique_ptr<NDArray> xFlat((xC ? xC.get() : x)->reshape('c', {time * bS, iS}));
+
+    NDArray xWb('f', {time * bS, 3 * nU}, dtype, workspace);
+    MmulHelper::mmul(xFlat.get(), const_cast<NDArray*>(Wx), &xWb, 1.0, 0.0);
+    xWb.applyBroadcast(broadcast::Add, {1}, b, &xWb, nullptr);
+
+    // recurrent weights are split into gates and candidate parts once
+    std::unique_ptr<NDArray> Whru((*Wh)({0,0, 0,2*nU}).dup('f'));
+    std::unique_ptr<NDArray> Whn((*Wh)({0,0, 2*nU,3*nU}).dup('f'));
+
+    NDArray hW('f', {bS, 2 * nU}, dtype, workspace);
+    NDArray rhW('f', {bS, nU}, dtype, workspace);
+    NDArray u('f', {bS, nU}, dtype, workspace);
+    NDArray rh('f', {bS, nU}, dtype, workspace);
+
+    // double-buffered cell output
+    NDArray hA('f', {bS, nU}, dtype, workspace);
+    NDArray hB('f', {bS, nU}, dtype, workspace);
+    hA.assign(h0);
+
+    NDArray *hPrev = &hA, *hCur = &hB;
+
+    for (Nd4jLong t = 0; t < time; ++t) {
+        auto xWbt = xWb.bufferAsT<T>() + t * bS;
+
+        MmulHelper::mmul(hPrev, Whru.get(), &hW, 1.0, 0.0);
+        gruGates_<T>(xWbt, time * bS, hW.bufferAsT<T>(), hPrev->bufferAsT<T>(), u.bufferAsT<T>(), rh.bufferAsT<T>(), bS, nU);
+
+        MmulHelper::mmul(&rh, Whn.get(), &rhW, 1.0, 0.0);
+        gruOutput_<T>(xWbt, time * bS, rhW.bufferAsT<T>(), hPrev->bufferAsT<T>(), u.bufferAsT<T>(), hCur->bufferAsT<T>(), bS, nU);
+
+        auto ht = (*h)({t,t+1, 0,0, 0,0});
+        ht.assign(hCur);
+
+        std::swap(hPrev, hCur);
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 void gruTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h) {
 
@@ -83,21 +181,11 @@ void gruTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* Wx, const N
     
     // h is cell outputs at each time step [time, bS, nU]
 
-    const int time = x->sizeAt(0);    
-
-    NDArray ht_1(*h0);
-
-    // loop through time steps
-    for (int t = 0; t < time; ++t) {
-
-        auto xt = (*x)({t,t+1, 0,0, 0,0});
-        auto ht = (*h)({t,t+1, 0,0, 0,0});
-
-        helpers::gruCell(&xt, &ht_1, Wx, Wh, b, &ht);
-        ht_1.assign(ht);    
-    }
+    BUILD_SINGLE_SELECTOR(x->dataType(), gruTimeLoop_, (x, h0, Wx, Wh, b, h), FLOAT_TYPES);
 }
 
+BUILD_SINGLE_TEMPLATE(template void gruTimeLoop_, (const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h), FLOAT_TYPES);
+
 //////////////////////////////////////////////////////////////////////////
 void gruCellBP(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, const NDArray* dLdh, const NDArray* dLdWx0,
                const NDArray* dLdWh0, const NDArray* dLdb0, NDArray* dLdx, NDArray* dLdh0, NDArray* dLdWx, NDArray* dLdWh, NDArray* dLdb) {
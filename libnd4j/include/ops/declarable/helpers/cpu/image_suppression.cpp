@@ -19,72 +19,245 @@
 //
 
 #include <ops/declarable/helpers/image_suppression.h>
-//#include <blas/NDArray.h>
+#include <OmpLaunchHelper.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// number of selected boxes, after which they are bucketed into uniform grid instead of being checked linearly
+#define NMS_GRID_THRESHOLD 64
+
+// max number of grid cells along each axis
+#define NMS_GRID_MAX 32
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    /**
+     * Structure-of-arrays storage for selected boxes, so IoU of one candidate against all of them is vectorized
+     */
     template <typename T>
-    static void nonMaxSuppressionV2_(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output) {
-        std::vector<Nd4jLong> indices(scales->lengthOf());
-        for (size_t i = 0; i < indices.size(); ++i)
-            indices[i] = i;
-        std::sort(indices.begin(), indices.end(), [scales](int i, int j) {return scales->e<T>(i) > scales->e<T>(j);});
-
-        std::vector<int> selected;
-        std::vector<int> selectedIndices(output->lengthOf(), 0);
-        auto needToSuppressWithThreshold = [threshold] (NDArray& boxes, int previousIndex, int nextIndex) -> bool {
-            T minYPrev = nd4j::math::nd4j_min(boxes.e<T>(previousIndex, 0), boxes.e<T>(previousIndex, 2));
-            T minXPrev = nd4j::math::nd4j_min(boxes.e<T>(previousIndex, 1), boxes.e<T>(previousIndex, 3));
-            T maxYPrev = nd4j::math::nd4j_max(boxes.e<T>(previousIndex, 0), boxes.e<T>(previousIndex, 2));
-            T maxXPrev = nd4j::math::nd4j_max(boxes.e<T>(previousIndex, 1), boxes.e<T>(previousIndex, 3));
-            T minYNext = nd4j::math::nd4j_min(boxes.e<T>(nextIndex, 0), boxes.e<T>(nextIndex, 2));
-            T minXNext = nd4j::math::nd4j_min(boxes.e<T>(nextIndex, 1), boxes.e<T>(nextIndex, 3));
-            T maxYNext = nd4j::math::nd4j_max(boxes.e<T>(nextIndex, 0), boxes.e<T>(nextIndex, 2));
-            T maxXNext = nd4j::math::nd4j_max(boxes.e<T>(nextIndex, 1), boxes.e<T>(nextIndex, 3));
-            T areaPrev = (maxYPrev - minYPrev) * (maxXPrev - minXPrev);
-            T areaNext = (maxYNext - minYNext) * (maxXNext - minXNext);
-
-            if (areaNext <= T(0.f) || areaPrev <= T(0.f)) return false;
-
-            T minIntersectionY = nd4j::math::nd4j_max(minYPrev, minYNext);
-            T minIntersectionX = nd4j::math::nd4j_max(minXPrev, minXNext);
-            T maxIntersectionY = nd4j::math::nd4j_min(maxYPrev, maxYNext);
-            T maxIntersectionX = nd4j::math::nd4j_min(maxXPrev, maxXNext);
-            T intersectionArea =
-                    nd4j::math::nd4j_max(T(maxIntersectionY - minIntersectionY), T(0.0f)) *
-                            nd4j::math::nd4j_max(T(maxIntersectionX - minIntersectionX), T(0.0f));
-            T intersectionValue = intersectionArea / (areaPrev + areaNext - intersectionArea);
-            return intersectionValue > threshold;
-
-        };
+    struct SuppressionBoxes {
+        std::vector<T> yMin, xMin, yMax, xMax, area;
+
+        void push(T y0, T x0, T y1, T x1, T a) {
+            yMin.push_back(y0);
+            xMin.push_back(x0);
+            yMax.push_back(y1);
+            xMax.push_back(x1);
+            area.push_back(a);
+        }
+
+        void clear() {
+            yMin.clear(); xMin.clear(); yMax.clear(); xMax.clear(); area.clear();
+        }
+
+        /**
+         * This method returns true if given box has IoU above threshold with any of stored boxes
+         */
+        bool suppresses(T y0, T x0, T y1, T x1, T a, T threshold) const {
+            const auto length = static_cast<Nd4jLong>(area.size());
+            auto sy0 = yMin.data(); auto sx0 = xMin.data(); auto sy1 = yMax.data(); auto sx1 = xMax.data(); auto sa = area.data();
+            const T zero = static_cast<T>(0.f);
+            int hit = 0;
+
+#pragma omp simd reduction(|:hit)
+            for (Nd4jLong e = 0; e < length; e++) {
+                T h = nd4j::math::nd4j_max<T>(nd4j::math::nd4j_min<T>(sy1[e], y1) - nd4j::math::nd4j_max<T>(sy0[e], y0), zero);
+                T w = nd4j::math::nd4j_max<T>(nd4j::math::nd4j_min<T>(sx1[e], x1) - nd4j::math::nd4j_max<T>(sx0[e], x0), zero);
+                T intersection = h * w;
+                hit |= intersection / (sa[e] + a - intersection) > threshold ? 1 : 0;
+            }
+
+            return hit != 0;
+        }
+    };
+
+    /**
+     * Selected boxes, optionally bucketed into uniform grid over extent of all boxes.
+     * Boxes overlapping with positive area always share at least one cell, so candidate is checked only against
+     * boxes of cells it covers. Grid is used only for non-negative thresholds: otherwise even disjoint boxes suppress each other
+     */
+    template <typename T>
+    class SuppressionIndex {
+    private:
+        std::vector<SuppressionBoxes<T>> _cells;
+        int _grid = 1;
+        T _minY, _minX, _cellH, _cellW;
+
+        FORCEINLINE int cellOf(T v, T start, T size) const {
+            int c = size > static_cast<T>(0.f) ? static_cast<int>((v - start) / size) : 0;
+            return nd4j::math::nd4j_max<int>(0, nd4j::math::nd4j_min<int>(_grid - 1, c));
+        }
+
+    public:
+        void reset(int grid, T minY, T minX, T maxY, T maxX) {
+            _grid = grid;
+            _minY = minY;
+            _minX = minX;
+            _cellH = (maxY - minY) / static_cast<T>(grid);
+            _cellW = (maxX - minX) / static_cast<T>(grid);
+
+            _cells.resize(grid * grid);
+            for (auto &cell : _cells)
+                cell.clear();
+        }
+
+        void push(T y0, T x0, T y1, T x1, T a) {
+            for (int cy = cellOf(y0, _minY, _cellH); cy <= cellOf(y1, _minY, _cellH); cy++)
+                for (int cx = cellOf(x0, _minX, _cellW); cx <= cellOf(x1, _minX, _cellW); cx++)
+                    _cells[cy * _grid + cx].push(y0, x0, y1, x1, a);
+        }
+
+        bool suppresses(T y0, T x0, T y1, T x1, T a, T threshold) const {
+            for (int cy = cellOf(y0, _minY, _cellH); cy <= cellOf(y1, _minY, _cellH); cy++)
+                for (int cx = cellOf(x0, _minX, _cellW); cx <= cellOf(x1, _minX, _cellW); cx++)
+                    if (_cells[cy * _grid + cx].suppresses(y0, x0, y1, x1, a, threshold))
+                        return true;
+
+            return false;
+        }
+    };
+
+    /**
+     * Per-thread scratch of NMS engine, reused across images/classes of batched mode
+     */
+    template <typename T>
+    struct SuppressionScratch {
+        std::vector<T> yMin, xMin, yMax, xMax, area;
+        std::vector<std::pair<T, Nd4jLong>> order;
+        SuppressionIndex<T> index;
+    };
+
+    /**
+     * Greedy NMS over numBoxes boxes, given as [numBoxes, 4] with element strides (boxStride, coordStride), and their scores.
+     * Indices of selected boxes are written into selected, and their number is returned
+     */
+    template <typename T>
+    static int suppress(const T *boxes, Nd4jLong boxStride, Nd4jLong coordStride, const T *scores, Nd4jLong scoreStride,
+                        Nd4jLong numBoxes, int maxSize, double threshold, SuppressionScratch<T> &scratch, Nd4jLong *selected) {
+        if (maxSize <= 0 || numBoxes == 0)
+            return 0;
+
+        // coordinates are copied once into SoA layout, with corners put in order
+        scratch.yMin.resize(numBoxes); scratch.xMin.resize(numBoxes); scratch.yMax.resize(numBoxes); scratch.xMax.resize(numBoxes);
+        scratch.area.resize(numBoxes);
+        scratch.order.resize(numBoxes);
+
+        T minY = DataTypeUtils::max<T>(), minX = DataTypeUtils::max<T>(), maxY = -DataTypeUtils::max<T>(), maxX = -DataTypeUtils::max<T>();
+        for (Nd4jLong e = 0; e < numBoxes; e++) {
+            auto b = boxes + e * boxStride;
+            T y0 = b[0], x0 = b[coordStride], y1 = b[2 * coordStride], x1 = b[3 * coordStride];
+
+            scratch.yMin[e] = nd4j::math::nd4j_min<T>(y0, y1);
+            scratch.xMin[e] = nd4j::math::nd4j_min<T>(x0, x1);
+            scratch.yMax[e] = nd4j::math::nd4j_max<T>(y0, y1);
+            scratch.xMax[e] = nd4j::math::nd4j_max<T>(x0, x1);
+            scratch.area[e] = (scratch.yMax[e] - scratch.yMin[e]) * (scratch.xMax[e] - scratch.xMin[e]);
+            scratch.order[e] = std::make_pair(scores[e * scoreStride], e);
+
+            minY = nd4j::math::nd4j_min<T>(minY, scratch.yMin[e]);
+            minX = nd4j::math::nd4j_min<T>(minX, scratch.xMin[e]);
+            maxY = nd4j::math::nd4j_max<T>(maxY, scratch.yMax[e]);
+            maxX = nd4j::math::nd4j_max<T>(maxX, scratch.xMax[e]);
+        }
+
+        // higher scores go first, equal scores keep original order
+        std::sort(scratch.order.begin(), scratch.order.end(), [] (const std::pair<T, Nd4jLong> &a, const std::pair<T, Nd4jLong> &b) -> bool {
+            return a.first > b.first || (a.first == b.first && a.second < b.second);
+        });
+
+        int grid = 1;
+        if (threshold >= 0. && maxSize > NMS_GRID_THRESHOLD)
+            grid = nd4j::math::nd4j_min<int>(NMS_GRID_MAX, static_cast<int>(std::sqrt(static_cast<double>(maxSize))));
+
+        scratch.index.reset(grid, minY, minX, maxY, maxX);
+
+        const T zero = static_cast<T>(0.f);
+        const T thr = static_cast<T>(threshold);
         int numSelected = 0;
-        for (int i = 0; i < boxes->sizeAt(0); ++i) {
-            if (selected.size() >= output->lengthOf()) break;
-            bool shouldSelect = true;
-            // Overlapping boxes are likely to have similar scores,
-            // therefore we iterate through the selected boxes backwards.
-            for (int j = numSelected - 1; j >= 0; --j) {
-                if (needToSuppressWithThreshold(*boxes, indices[i], indices[selectedIndices[j]])) {
-                    shouldSelect = false;
-                    break;
-                }
+        for (Nd4jLong i = 0; i < numBoxes && numSelected < maxSize; i++) {
+            auto e = scratch.order[i].second;
+            T y0 = scratch.yMin[e], x0 = scratch.xMin[e], y1 = scratch.yMax[e], x1 = scratch.xMax[e], a = scratch.area[e];
+
+            // boxes without area are never suppressed, and never suppress anything
+            if (a > zero) {
+                if (scratch.index.suppresses(y0, x0, y1, x1, a, thr))
+                    continue;
+
+                scratch.index.push(y0, x0, y1, x1, a);
             }
-            if (shouldSelect) {
-                selected.push_back(indices[i]);
-                selectedIndices[numSelected++] = i;
+
+            selected[numSelected++] = e;
+        }
+
+        return numSelected;
+    }
+
+    template <typename T>
+    static void nonMaxSuppressionV2_(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output) {
+        // scores are read in boxes type
+        std::unique_ptr<NDArray> scores(scales->dataType() == boxes->dataType() ? nullptr : scales->cast(boxes->dataType()));
+        auto s = scores ? scores.get() : scales;
+
+        SuppressionScratch<T> scratch;
+        std::vector<Nd4jLong> selected(maxSize);
+
+        auto numSelected = suppress<T>(reinterpret_cast<T *>(boxes->buffer()), boxes->stridesOf()[0], boxes->stridesOf()[1],
+                                       reinterpret_cast<T *>(s->buffer()), s->stridesOf()[0], boxes->sizeAt(0),
+                                       nd4j::math::nd4j_min<int>(maxSize, output->lengthOf()), threshold, scratch, selected.data());
+
+        for (int e = 0; e < numSelected; ++e)
+            output->p<Nd4jLong>(e, selected[e]);
+    }
+
+    template <typename T>
+    static void nonMaxSuppressionBatched_(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output) {
+        std::unique_ptr<NDArray> scores(scales->dataType() == boxes->dataType() ? nullptr : scales->cast(boxes->dataType()));
+        auto s = scores ? scores.get() : scales;
+
+        const Nd4jLong batchSize = boxes->sizeAt(0);
+        const Nd4jLong numBoxes = boxes->sizeAt(1);
+        maxSize = nd4j::math::nd4j_min<int>(maxSize, output->sizeAt(1));
+
+        auto b = reinterpret_cast<T *>(boxes->buffer());
+        auto sc = reinterpret_cast<T *>(s->buffer());
+        auto bStrides = boxes->stridesOf();
+        auto sStrides = s->stridesOf();
+
+        // slots without selected box are marked with -1
+        output->assign(-1);
+
+        int numThreads = nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(OmpLaunchHelper::betterThreads(batchSize * numBoxes * 16), batchSize));
+
+#pragma omp parallel num_threads(numThreads) if (numThreads > 1) default(shared)
+        {
+            SuppressionScratch<T> scratch;
+            std::vector<Nd4jLong> selected(maxSize);
+
+#pragma omp for schedule(dynamic)
+            for (Nd4jLong batch = 0; batch < batchSize; batch++) {
+                auto numSelected = suppress<T>(b + batch * bStrides[0], bStrides[1], bStrides[2], sc + batch * sStrides[0], sStrides[1],
+                                               numBoxes, maxSize, threshold, scratch, selected.data());
+
+                for (int e = 0; e < numSelected; e++)
+                    output->p<Nd4jLong>(batch, e, selected[e]);
             }
         }
-        for (size_t e = 0; e < selected.size(); ++e)
-            output->p<int>(e, selected[e]);
     }
 
     void nonMaxSuppressionV2(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(output->dataType(), nonMaxSuppressionV2_, (boxes, scales, maxSize, threshold, output), NUMERIC_TYPES);
+        BUILD_SINGLE_SELECTOR(boxes->dataType(), nonMaxSuppressionV2_, (boxes, scales, maxSize, threshold, output), NUMERIC_TYPES);
     }
+
+    void nonMaxSuppressionBatched(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(boxes->dataType(), nonMaxSuppressionBatched_, (boxes, scales, maxSize, threshold, output), NUMERIC_TYPES);
+    }
+
     BUILD_SINGLE_TEMPLATE(template void nonMaxSuppressionV2_, (NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void nonMaxSuppressionBatched_, (NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output), NUMERIC_TYPES);
 
 }
 }
-}
\ No newline at end of file
+}
@@ -19,24 +19,57 @@
 //
 
 #include <ops/declarable/helpers/listdiff.h>
+#include <ops/declarable/helpers/helpers.h>
+#include <helpers/HashUnique.h>
 #include <vector>
-//#include <memory>
+#include <memory>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
+    /**
+     * This method marks values absent in keep, and returns exclusive prefix sums of marks per chunk of values,
+     * so chunk t writes its saved values starting at sums[t]
+     */
     template <typename T>
-    static Nd4jLong listDiffCount_(NDArray* values, NDArray* keep) {
-        Nd4jLong saved = 0L;
-        for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
-            T v = values->e<T>(e);
-            T extras[] = {v, (T) 0.0f, (T) 10.0f};
-            NDArray idx = keep->indexReduceNumber(indexreduce::FirstIndex, extras);
-            Nd4jLong index = idx.e<Nd4jLong>(0);
-            if (index < 0)
-                saved++;
+    static std::vector<Nd4jLong> listDiffMarks_(T *values, Nd4jLong length, NDArray* keep, std::vector<int8_t> &marks, int numThreads) {
+        std::unique_ptr<NDArray> holder;
+        auto k = contiguous(keep, holder);
+        HashUnique<T> keepSet(k->bufferAsT<T>(), k->lengthOf(), false);
+
+        auto span = OmpLaunchHelper::betterSpan(length, numThreads);
+        std::vector<Nd4jLong> sums(numThreads + 1, 0);
+        marks.resize(length);
+
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(static)
+        for (int t = 0; t < numThreads; t++) {
+            auto start = nd4j::math::nd4j_min<Nd4jLong>(t * span, length);
+            auto stop = nd4j::math::nd4j_min<Nd4jLong>(start + span, length);
+
+            Nd4jLong saved = 0;
+            for (Nd4jLong e = start; e < stop; e++) {
+                marks[e] = keepSet.contains(values[e]) ? 0 : 1;
+                saved += marks[e];
+            }
+
+            sums[t + 1] = saved;
         }
-        return saved;
+
+        for (int t = 0; t < numThreads; t++)
+            sums[t + 1] += sums[t];
+
+        return sums;
+    }
+
+    template <typename T>
+    static Nd4jLong listDiffCount_(NDArray* values, NDArray* keep) {
+        std::unique_ptr<NDArray> holder;
+        auto v = contiguous(values, holder);
+        auto length = v->lengthOf();
+        auto numThreads = OmpLaunchHelper::betterThreads(length);
+
+        std::vector<int8_t> marks;
+        return listDiffMarks_<T>(v->bufferAsT<T>(), length, keep, marks, numThreads)[numThreads];
     }
 
     Nd4jLong listDiffCount(NDArray* values, NDArray* keep) {
@@ -50,23 +83,17 @@ namespace helpers {
     template <typename T>
     static int listDiffFunctor_(NDArray* values, NDArray* keep, NDArray* output1, NDArray* output2) {
 
-        std::vector<T> saved;
-        std::vector<Nd4jLong> indices;
+        std::unique_ptr<NDArray> holder;
+        auto v = contiguous(values, holder);
+        auto bv = v->bufferAsT<T>();
+        auto length = v->lengthOf();
+        auto numThreads = OmpLaunchHelper::betterThreads(length);
 
-        for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
-            T v = values->e<T>(e);
-            T extras[] = {v, (T) 0.0f, (T) 10.0f};
-            NDArray idxScalar = keep->indexReduceNumber(indexreduce::FirstIndex, extras);
-            Nd4jLong idx = idxScalar.e<Nd4jLong>(0);
+        std::vector<int8_t> marks;
+        auto sums = listDiffMarks_<T>(bv, length, keep, marks, numThreads);
+        auto numSaved = sums[numThreads];
 
-            if (idx < 0) {
-                saved.emplace_back(v);
-                indices.emplace_back(e);
-            }
-        }
-
-
-        if (saved.size() == 0) {
+        if (numSaved == 0) {
 //            if (nd4j::ops::conditionHelper(__FILE__, __LINE__, false, 0, "ListDiff: search returned no results") != 0)
             nd4j_printf("ListDiff: search returned no results", "");
                 throw std::invalid_argument("Op validation failed");
@@ -74,18 +101,43 @@ namespace helpers {
             auto z0 = output1;//OUTPUT_VARIABLE(0); //new NDArray<T>('c', {(int) saved.size()});
             auto z1 = output2; //OUTPUT_VARIABLE(1); //new NDArray<T>('c', {(int) saved.size()});
 
-            if (z0->lengthOf() != saved.size()) {
+            if (z0->lengthOf() != numSaved) {
                 nd4j_printf("ListDiff: output/actual size mismatch", "");
                 throw std::invalid_argument("Op validation failed");
             }
 
-            if (z1->lengthOf() != saved.size()) {
+            if (z1->lengthOf() != numSaved) {
                 nd4j_printf("ListDiff: output/actual indices size mismatch", "");
                 throw std::invalid_argument("Op validation failed");
             }
-            memcpy(z0->buffer(), saved.data(), saved.size() * sizeof(T));
-            for (int e = 0; e < indices.size(); e++) {
-                z1->p(e, indices[e]);
+
+            const bool directValues = z0->ews() == 1 && z0->ordering() == 'c';
+            const bool directIndices = z1->dataType() == nd4j::DataType::INT64 && z1->ews() == 1 && z1->ordering() == 'c';
+            auto span = OmpLaunchHelper::betterSpan(length, numThreads);
+
+            // each chunk of values already knows its offset within outputs, so chunks are compacted independently
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(static)
+            for (int t = 0; t < numThreads; t++) {
+                auto start = nd4j::math::nd4j_min<Nd4jLong>(t * span, length);
+                auto stop = nd4j::math::nd4j_min<Nd4jLong>(start + span, length);
+                auto pos = sums[t];
+
+                for (Nd4jLong e = start; e < stop; e++) {
+                    if (!marks[e])
+                        continue;
+
+                    if (directValues)
+                        z0->bufferAsT<T>()[pos] = bv[e];
+                    else
+                        z0->p(pos, bv[e]);
+
+                    if (directIndices)
+                        z1->bufferAsT<Nd4jLong>()[pos] = e;
+                    else
+                        z1->p(pos, e);
+
+                    pos++;
+                }
             }
         }
         return ND4J_STATUS_OK;
@@ -76,7 +76,7 @@ static void getMKLDNNMemoryDescLrn(const NDArray* src, const NDArray* diff_src,
             streams.push_back(MKLDNNStream("lrn"));
         }
 
-        if (streams[0].checkAndReset({input}, {output}, {bias, alpha, beta}, {depth})) {
+        if (MKLDNNStream::acquire(streams, {input}, {output}, {bias, alpha, beta}, {depth})) {
             mkldnn_memory_desc_t empty;
             mkldnn::memory::desc lrn_src_md(empty);
 
@@ -135,7 +135,7 @@ static void getMKLDNNMemoryDescLrn(const NDArray* src, const NDArray* diff_src,
             streams.push_back(MKLDNNStream("lrn_bp"));
         }
 
-        if (streams[0].checkAndReset({input, scale}, {output}, {bias, alpha, beta}, {depth})) {
+        if (MKLDNNStream::acquire(streams, {input, scale}, {output}, {bias, alpha, beta}, {depth})) {
             mkldnn_memory_desc_t empty;
             mkldnn::memory::desc lrn_src_md(empty), lrn_diff_src_md(empty);
 
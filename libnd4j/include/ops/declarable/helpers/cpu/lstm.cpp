@@ -27,6 +27,9 @@
 
 
 #include<ops/declarable/helpers/lstm.h>
+#include <helpers/MmulHelper.h>
+#include <ops/ops.h>
+#include <memory>
 
 namespace nd4j 	  {
 namespace ops 	  {
@@ -129,6 +132,119 @@ void lstmCell(const NDArray* xt, const NDArray* ht_1, const NDArray* ct_1, const
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+// fused gates and activations for single time step, all matrices are in f order: element [e, j] of matrix is located at j*ld + e
+// xWb  input projection plus biases for current time step [bS x 4*numUnits], leading dimension is ldx
+// hW   recurrent projection [bS x 4*numUnits]
+template <typename T>
+static void lstmGates_(const T* xWb, const Nd4jLong ldx, const T* hW, const T* cPrev, const T* Wc, T* c, T* h,
+                       const Nd4jLong bS, const Nd4jLong numUnits, const bool peephole, const T clippingCellValue, const T forgetBias) {
+
+    #pragma omp parallel for if(bS * numUnits > Environment::getInstance()->elementwiseThreshold()) schedule(static)
+    for (Nd4jLong u = 0; u < numUnits; ++u) {
+
+        const T* xi = xWb + u * ldx;
+        const T* xf = xWb + (numUnits + u) * ldx;
+        const T* xc = xWb + (2*numUnits + u) * ldx;
+        const T* xo = xWb + (3*numUnits + u) * ldx;
+
+        const T* hi = hW + u * bS;
+        const T* hf = hW + (numUnits + u) * bS;
+        const T* hc = hW + (2*numUnits + u) * bS;
+        const T* ho = hW + (3*numUnits + u) * bS;
+
+        const T* cp = cPrev + u * bS;
+        T* cu = c + u * bS;
+        T* hu = h + u * bS;
+
+        const T wi = peephole ? Wc[u] : (T) 0.f;
+        const T wf = peephole ? Wc[numUnits + u] : (T) 0.f;
+        const T wo = peephole ? Wc[2*numUnits + u] : (T) 0.f;
+
+        #pragma omp simd
+        for (Nd4jLong e = 0; e < bS; ++e) {
+            const T zi = xi[e] + hi[e] + cp[e] * wi;
+            const T zf = xf[e] + hf[e] + cp[e] * wf;
+
+            T ct = nd4j::math::nd4j_sigmoid<T,T>(zf + forgetBias) * cp[e] + nd4j::math::nd4j_sigmoid<T,T>(zi) * nd4j::math::nd4j_tanh<T,T>(xc[e] + hc[e]);
+
+            if(clippingCellValue > (T) 0.f)
+                ct = simdOps::LstmClip<T,T,T>::op(ct, clippingCellValue, nullptr);
+
+            cu[e] = ct;
+            hu[e] = nd4j::math::nd4j_sigmoid<T,T>(xo[e] + ho[e] + ct * wo) * nd4j::math::nd4j_tanh<T,T>(ct);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void lstmTimeLoop_(const NDArray* x, const NDArray* h0, const NDArray* c0, const NDArray* Wx, const NDArray* Wh, const NDArray* Wc, const NDArray* Wp, const NDArray* b,
+                          NDArray* h, NDArray* c, const std::vector<double>& params) {
+
+    const bool peephole   = (bool)params[0];
+    const bool projection = (bool)params[1];
+    const double clippingCellValue = params[2];
+    const double clippingProjValue = params[3];
+    const double forgetBias = params[4];
+
+    const Nd4jLong time     = x->sizeAt(0);
+    const Nd4jLong bS       = x->sizeAt(1);
+    const Nd4jLong inSize   = x->sizeAt(2);
+    const Nd4jLong numProj  = h0->sizeAt(1);
+    const Nd4jLong numUnits = c0->sizeAt(1);
+
+    auto workspace = x->getWorkspace();
+    auto dtype = x->dataType();
+
+    // input projection for all time steps is done by single gemm: [time*bS x inSize] * [inSize x 4*numUnits] + b
+    // f order is used for all per-step matrices, so gemm writes them directly, without intermediate copies
+    std::unique_ptr<NDArray> xC(x->ordering() == 'c' && x->ews() == 1 ? nullptr : const_cast<NDArray*>(x)->dup('c'));
+    std::unique_ptr<NDArray> xFlat((xC ? xC.get() : x)->reshape('c', {time * bS, inSize}));
+
+    NDArray xWb('f', {time * bS, 4 * numUnits}, dtype, workspace);
+    MmulHelper::mmul(xFlat.get(), const_cast<NDArray*>(Wx), &xWb, 1.0, 0.0);
+    xWb.applyBroadcast(broadcast::Add, {1}, b, &xWb, nullptr);
+
+    std::unique_ptr<NDArray> WcC(peephole && Wc->ews() != 1 ? const_cast<NDArray*>(Wc)->dup('c') : nullptr);
+    const T* pWc = peephole ? (WcC ? WcC.get() : Wc)->bufferAsT<T>() : nullptr;
+
+    // double-buffered recurrent state
+    NDArray hW('f', {bS, 4 * numUnits}, dtype, workspace);
+    NDArray hA('f', {bS, numProj}, dtype, workspace);
+    NDArray hB('f', {bS, numProj}, dtype, workspace);
+    NDArray cA('f', {bS, numUnits}, dtype, workspace);
+    NDArray cB('f', {bS, numUnits}, dtype, workspace);
+    std::unique_ptr<NDArray> hRaw(projection ? new NDArray('f', {bS, numUnits}, dtype, workspace) : nullptr);
+
+    hA.assign(h0);
+    cA.assign(c0);
+
+    NDArray *hPrev = &hA, *hCur = &hB, *cPrev = &cA, *cCur = &cB;
+
+    for (Nd4jLong t = 0; t < time; ++t) {
+
+        MmulHelper::mmul(hPrev, const_cast<NDArray*>(Wh), &hW, 1.0, 0.0);
+
+        lstmGates_<T>(xWb.bufferAsT<T>() + t * bS, time * bS, hW.bufferAsT<T>(), cPrev->bufferAsT<T>(), pWc, cCur->bufferAsT<T>(), (projection ? hRaw.get() : hCur)->bufferAsT<T>(),
+                      bS, numUnits, peephole, (T) clippingCellValue, (T) forgetBias);
+
+        if(projection) {
+            MmulHelper::mmul(hRaw.get(), const_cast<NDArray*>(Wp), hCur, 1.0, 0.0);     // [bS x numUnits] * [ numUnits x numProj] = [bS x numProj]
+            if(clippingProjValue != 0.)
+                clipping(hCur, clippingProjValue);
+        }
+
+        auto ht = (*h)({t,t+1, 0,0, 0,0});
+        auto ct = (*c)({t,t+1, 0,0, 0,0});
+        ht.assign(hCur);
+        ct.assign(cCur);
+
+        std::swap(hPrev, hCur);
+        std::swap(cPrev, cCur);
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 void lstmTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* c0, const NDArray* Wx, const NDArray* Wh, const NDArray* Wc, const NDArray* Wp, const NDArray* b,
                   NDArray* h, NDArray* c, const std::vector<double>& params) {
@@ -146,23 +262,10 @@ void lstmTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* c0, const
     // h cell outputs [time x bS x numProj], that is per each time step
     // c cell states  [time x bS x numUnits] that is per each time step
 
-    const int time  = x->sizeAt(0);
-
-    NDArray currentH(*h0);
-    NDArray currentC(*c0);
-
-    // loop through time steps
-    for (int t = 0; t < time; ++t) {
-        auto xt = (*x)({t,t+1, 0,0, 0,0});
-        auto ht = (*h)({t,t+1, 0,0, 0,0});
-        auto ct = (*c)({t,t+1, 0,0, 0,0});
-
-        helpers::lstmCell(&xt,&currentH,&currentC, Wx,Wh,Wc,Wp, b,   &ht, &ct,   params);
-        currentH.assign(ht);
-        currentC.assign(ct);
-    }    
+    BUILD_SINGLE_SELECTOR(x->dataType(), lstmTimeLoop_, (x, h0, c0, Wx, Wh, Wc, Wp, b, h, c, params), FLOAT_TYPES);
 }
 
+BUILD_SINGLE_TEMPLATE(template void lstmTimeLoop_, (const NDArray* x, const NDArray* h0, const NDArray* c0, const NDArray* Wx, const NDArray* Wh, const NDArray* Wc, const NDArray* Wp, const NDArray* b, NDArray* h, NDArray* c, const std::vector<double>& params), FLOAT_TYPES);
 
 }
 }
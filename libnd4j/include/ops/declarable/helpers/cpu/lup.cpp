@@ -18,168 +18,410 @@
 //  @author raver119@gmail.com
 //
 
-#include <ops/declarable/helpers/top_k.h>
-#include <MmulHelper.h>
+#include <ops/declarable/helpers/lup.h>
+#include <helpers/BlasHelper.h>
+#include <OmpLaunchHelper.h>
 #include <NDArrayFactory.h>
 #include <Status.h>
+#include <type_traits>
+#include <limits>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// width of panels in blocked factorizations
+#define LUP_BLOCK 32
+
+// matrices of at least this order are factorized with threads, when there's no batch to spread between threads
+#define LUP_PARALLEL_ORDER 128
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
-    template <typename T> 
-    static void _swapRows(NDArray* matrix, int theFirst, int theSecond) {
+    // matrices are factorized in double for double inputs and in float for anything else
+    template <typename T>
+    using LupCompute = typename std::conditional<std::is_same<T, double>::value, double, float>::type;
 
-        if (theFirst != theSecond)
-            for (int i = 0; i < matrix->columns(); i++) {
-                T _e0 = matrix->e<T>(theFirst, i);
-                T _e1 = matrix->e<T>(theSecond, i);
+    template <typename T>
+    static FORCEINLINE bool lapackGetrf(T *a, int n, int *ipiv);
 
-                matrix->p<T>(theFirst, i, _e1);
-                matrix->p<T>(theSecond, i, _e0);
-            }
+    template <>
+    FORCEINLINE bool lapackGetrf<float>(float *a, int n, int *ipiv) {
+        if (!BlasHelper::getInstance()->hasGETRF<float>())
+            return false;
+
+        BlasHelper::getInstance()->sgetrf()(LAPACK_ROW_MAJOR, n, n, a, n, ipiv);
+        return true;
     }
-    BUILD_SINGLE_TEMPLATE(template void _swapRows, (NDArray* matrix, int theFirst, int theSecond), FLOAT_TYPES);
 
-    void swapRows(NDArray* matrix, int theFirst, int theSecond) {
-        BUILD_SINGLE_SELECTOR(matrix->dataType(), _swapRows, (matrix, theFirst, theSecond), FLOAT_TYPES);
+    template <>
+    FORCEINLINE bool lapackGetrf<double>(double *a, int n, int *ipiv) {
+        if (!BlasHelper::getInstance()->hasGETRF<double>())
+            return false;
+
+        BlasHelper::getInstance()->dgetrf()(LAPACK_ROW_MAJOR, n, n, a, n, ipiv);
+        return true;
     }
 
     template <typename T>
-    static void _invertLowerMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        int n = inputMatrix->rows();
-        invertedMatrix->assign(0.f);
-#pragma omp parallel for if(n > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-        for (int i = 0; i < n; i++)
-            invertedMatrix->p(i, i, 1.0f);
-
-        if (inputMatrix->isIdentityMatrix()) return;
+    static FORCEINLINE bool lapackPotrf(T *a, int n);
 
-#pragma omp parallel for if(n > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-        for (int i = 1; i < n; i++)
-            invertedMatrix->p(i, i - 1,  -inputMatrix->e<T>(i, i - 1));
+    template <>
+    FORCEINLINE bool lapackPotrf<float>(float *a, int n) {
+        if (!BlasHelper::getInstance()->hasPOTRF<float>())
+            return false;
 
-#pragma omp parallel for if(n > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-        for (int i = 2; i < n; i++) {
-            for (int j = i - 2; j > -1; --j) 
-                for (int k = 0; k < i; k++) 
-                    invertedMatrix->p(i, j, invertedMatrix->e<T>(i, j) - (invertedMatrix->e<T>(k, j) * inputMatrix->e<T>(i, k)));
-        }
+        BlasHelper::getInstance()->spotrf()(LAPACK_ROW_MAJOR, 'L', n, a, n);
+        return true;
     }
 
-    BUILD_SINGLE_TEMPLATE(template void _invertLowerMatrix, (NDArray* inputMatrix, NDArray* invertedMatrix);, FLOAT_TYPES);
+    template <>
+    FORCEINLINE bool lapackPotrf<double>(double *a, int n) {
+        if (!BlasHelper::getInstance()->hasPOTRF<double>())
+            return false;
 
-    void invertLowerMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        BUILD_SINGLE_SELECTOR(inputMatrix->dataType(), _invertLowerMatrix, (inputMatrix, invertedMatrix), FLOAT_TYPES);
+        BlasHelper::getInstance()->dpotrf()(LAPACK_ROW_MAJOR, 'L', n, a, n);
+        return true;
     }
 
+    /**
+     * In-place LU decomposition with partial pivoting of row-major n x n matrix: P * A = L * U,
+     * with unit L stored below diagonal and U on and above it. Row i of P * A is row perm[i] of A.
+     *
+     * Right-looking blocked variant: each panel of LUP_BLOCK columns is factorized with row swaps applied to
+     * whole rows, then U12 is solved against L11 and trailing matrix gets single rank-LUP_BLOCK update.
+     * Columns without non-zero pivot are skipped, just like in unblocked elimination.
+     *
+     * @return number of row swaps
+     */
     template <typename T>
-    static void _invertUpperMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        int n = inputMatrix->rows();
-        invertedMatrix->setIdentity();
+    static int luBlocked(T *a, int n, int *perm, bool parallel) {
+        int swapCount = 0;
+        for (int i = 0; i < n; i++)
+            perm[i] = i;
+
+        std::vector<int> ipiv(n);
+        if (lapackGetrf<T>(a, n, ipiv.data())) {
+            for (int i = 0; i < n; i++)
+                if (ipiv[i] - 1 != i) {
+                    std::swap(perm[i], perm[ipiv[i] - 1]);
+                    swapCount++;
+                }
 
-        if (inputMatrix->isIdentityMatrix()) { // the inverse for I is I
-            return;
+            return swapCount;
         }
 
-#pragma omp parallel for if(n > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-        for (int i = 0; i < n; i++)
-            invertedMatrix->p(i, i, invertedMatrix->e<T>(i, i) / inputMatrix->e<T>(i, i));
+        for (int k0 = 0; k0 < n; k0 += LUP_BLOCK) {
+            const int k1 = nd4j::math::nd4j_min<int>(k0 + LUP_BLOCK, n);
+
+            // panel factorization
+            for (int k = k0; k < k1; k++) {
+                int pivot = k;
+                T pivotValue = nd4j::math::nd4j_abs<T>(a[k * n + k]);
+
+                for (int r = k + 1; r < n; r++) {
+                    auto v = nd4j::math::nd4j_abs<T>(a[r * n + k]);
+                    if (v > pivotValue) {
+                        pivotValue = v;
+                        pivot = r;
+                    }
+                }
+
+                if (pivotValue == (T) 0.f)
+                    continue;
+
+                if (pivot != k) {
+                    std::swap_ranges(a + k * n, a + (k + 1) * n, a + pivot * n);
+                    std::swap(perm[k], perm[pivot]);
+                    swapCount++;
+                }
+
+                const T diagonal = a[k * n + k];
+                const T *uk = a + k * n;
+
+                for (int r = k + 1; r < n; r++) {
+                    T *ar = a + r * n;
+                    const T l = ar[k] / diagonal;
+                    ar[k] = l;
+
+                    #pragma omp simd
+                    for (int j = k + 1; j < k1; j++)
+                        ar[j] -= l * uk[j];
+                }
+            }
+
+            if (k1 >= n)
+                break;
+
+            // U12 = L11^-1 * A12
+            for (int i = k0 + 1; i < k1; i++) {
+                T *ai = a + i * n;
+                for (int k = k0; k < i; k++) {
+                    const T l = ai[k];
+                    const T *uk = a + k * n;
+
+                    #pragma omp simd
+                    for (int j = k1; j < n; j++)
+                        ai[j] -= l * uk[j];
+                }
+            }
+
+            // A22 -= L21 * U12
+            #pragma omp parallel for if (parallel) schedule(static)
+            for (int i = k1; i < n; i++) {
+                T *ai = a + i * n;
+                for (int k = k0; k < k1; k++) {
+                    const T l = ai[k];
+                    if (l == (T) 0.f)
+                        continue;
 
-#pragma omp parallel for if(n > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-        for (int i = 0; i < n - 1; i++)
-            invertedMatrix->p(i, i + 1, invertedMatrix->e<T>(i, i+1) - (inputMatrix->e<T>(i, i + 1) * invertedMatrix->e<T>(i + 1, i + 1) / inputMatrix->e<T>(i, i)));
+                    const T *uk = a + k * n;
 
-#pragma omp parallel for if(n > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-        for (int i = n - 2; i > - 1; i--) {
-            for (int j = i + 2; j < n; j++) 
-                for (int k = i; k < n; k++) 
-                    invertedMatrix->p(i, j, invertedMatrix->e<T>(i, j) - ((invertedMatrix->e<T>(k, j) * inputMatrix->e<T>(i, k) / inputMatrix->e<T>(i, i))));
+                    #pragma omp simd
+                    for (int j = k1; j < n; j++)
+                        ai[j] -= l * uk[j];
+                }
+            }
         }
+
+        return swapCount;
     }
 
-    BUILD_SINGLE_TEMPLATE(template void _invertUpperMatrix, (NDArray* inputMatrix, NDArray* invertedMatrix);, FLOAT_TYPES);
+    /**
+     * In-place Cholesky decomposition of row-major n x n matrix, only lower triangle is referenced.
+     * Right-looking blocked variant: diagonal block, then panel below it, then symmetric rank-LUP_BLOCK update
+     * of the lower triangle of trailing matrix, with all inner products taken over contiguous row segments.
+     * Upper triangle is zeroed afterwards
+     */
+    template <typename T>
+    static void choleskyBlocked(T *a, int n, bool parallel) {
+        if (!lapackPotrf<T>(a, n)) {
+            for (int k0 = 0; k0 < n; k0 += LUP_BLOCK) {
+                const int k1 = nd4j::math::nd4j_min<int>(k0 + LUP_BLOCK, n);
 
-    void invertUpperMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        BUILD_SINGLE_SELECTOR(inputMatrix->dataType(), _invertUpperMatrix, (inputMatrix, invertedMatrix), FLOAT_TYPES);
-    }
+                // diagonal block
+                for (int j = k0; j < k1; j++) {
+                    T *aj = a + j * n;
 
+                    T sum = (T) 0.f;
+                    for (int p = k0; p < j; p++)
+                        sum += aj[p] * aj[p];
 
-    template <typename T>
-    static NDArray _lup(NDArray* input, NDArray* compound, NDArray* permutation) {
+                    aj[j] = nd4j::math::nd4j_sqrt<T, T>(aj[j] - sum);
+
+                    for (int i = j + 1; i < k1; i++) {
+                        T *ai = a + i * n;
+                        T dot = (T) 0.f;
+                        for (int p = k0; p < j; p++)
+                            dot += ai[p] * aj[p];
 
-        const int rowNum = input->rows();
-        const int columnNum = input->columns();
+                        ai[j] = (ai[j] - dot) / aj[j];
+                    }
+                }
 
-        NDArray determinant = NDArrayFactory::create<T>(1.f);
-        std::unique_ptr<NDArray> compoundMatrix(input->dup()); // copy
-        std::unique_ptr<NDArray> permutationMatrix(input->dupUninitialized()); //put identity
-        permutationMatrix->setIdentity();
+                if (k1 >= n)
+                    break;
 
-        T pivotValue; // = T(0.0);
-        int pivot; // = -1;
-        int swapCount = 0;
-//#pragma omp parallel for if(rowNum > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-        for(int i = 0; i < rowNum; i++ ) {
-            pivotValue = T(0.0);
-            pivot = -1;
-
-            for(int rowCounter = i; rowCounter < rowNum; rowCounter++ ) {
-                if(nd4j::math::nd4j_abs(compoundMatrix->e<T>(rowCounter, i)) > pivotValue ) {
-                    pivotValue = nd4j::math::nd4j_abs(compoundMatrix->e<T>(rowCounter, i));
-                    pivot = rowCounter;
+                // L21 = A21 * L11^-T, and then A22 -= L21 * L21^T, lower triangle only
+                #pragma omp parallel for if (parallel) schedule(static)
+                for (int i = k1; i < n; i++) {
+                    T *ai = a + i * n;
+                    for (int j = k0; j < k1; j++) {
+                        const T *aj = a + j * n;
+                        T dot = (T) 0.f;
+                        for (int p = k0; p < j; p++)
+                            dot += ai[p] * aj[p];
+
+                        ai[j] = (ai[j] - dot) / aj[j];
+                    }
                 }
-            }
 
-            if( pivotValue != T(0.0) ) {
-                swapRows(compoundMatrix.get(), pivot, i);
-                swapRows(permutationMatrix.get(), pivot, i);
-                if (pivot != i)
-                    swapCount++;
+                #pragma omp parallel for if (parallel) schedule(dynamic, 8)
+                for (int i = k1; i < n; i++) {
+                    T *ai = a + i * n;
+                    for (int j = k1; j <= i; j++) {
+                        const T *aj = a + j * n;
+                        T dot = (T) 0.f;
 
-                for( int j = i + 1; j < rowNum; j++ ) {
-                    compoundMatrix->p(j, i, compoundMatrix->e<T>(j, i) / compoundMatrix->e<T>(i, i));
-                    for( int k = i + 1; k < rowNum; k++ ) {
-                        T arg = compoundMatrix->e<T>(j, i) * compoundMatrix->e<T>(i, k);
-                        compoundMatrix->p(j, k, compoundMatrix->e<T>(j, k) - arg);
+                        #pragma omp simd reduction(+:dot)
+                        for (int p = k0; p < k1; p++)
+                            dot += ai[p] * aj[p];
+
+                        ai[j] -= dot;
                     }
                 }
             }
         }
-        // nd4j_printf("Pivot: %i, Pivot value: %f.\n", pivot, pivotValue);
-//#pragma omp parallel for
-// if(rowNum > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-        for (int e = 0; e < rowNum; e++) {
-            // nd4j_printf("Compound matrix diag %i %f.\n", e, (*compoundMatrix)(e, e));
-            determinant *= compoundMatrix->e<T>(e, e);
+
+        for (int i = 0; i < n; i++)
+            for (int j = i + 1; j < n; j++)
+                a[i * n + j] = (T) 0.f;
+    }
+
+    /**
+     * This method computes inverse of matrix out of its LU decomposition: inv(A) = inv(U) * inv(L) * P,
+     * as forward and back substitution against permuted identity. Columns are independent, so large matrices
+     * are split into column blocks between threads
+     */
+    template <typename T>
+    static void luInverse(const T *lu, const int *perm, int n, T *inv, bool parallel) {
+        std::fill(inv, inv + n * n, (T) 0.f);
+        for (int i = 0; i < n; i++)
+            inv[i * n + perm[i]] = (T) 1.f;
+
+        const int numBlocks = (n + LUP_BLOCK - 1) / LUP_BLOCK;
+
+        #pragma omp parallel for if (parallel) schedule(static)
+        for (int b = 0; b < numBlocks; b++) {
+            const int c0 = b * LUP_BLOCK;
+            const int c1 = nd4j::math::nd4j_min<int>(c0 + LUP_BLOCK, n);
+
+            // inv(L)
+            for (int i = 1; i < n; i++) {
+                T *xi = inv + i * n;
+                for (int k = 0; k < i; k++) {
+                    const T l = lu[i * n + k];
+                    if (l == (T) 0.f)
+                        continue;
+
+                    const T *xk = inv + k * n;
+
+                    #pragma omp simd
+                    for (int j = c0; j < c1; j++)
+                        xi[j] -= l * xk[j];
+                }
+            }
+
+            // inv(U)
+            for (int i = n - 1; i >= 0; i--) {
+                T *xi = inv + i * n;
+                for (int k = i + 1; k < n; k++) {
+                    const T u = lu[i * n + k];
+                    const T *xk = inv + k * n;
+
+                    #pragma omp simd
+                    for (int j = c0; j < c1; j++)
+                        xi[j] -= u * xk[j];
+                }
+
+                const T diagonal = lu[i * n + i];
+
+                #pragma omp simd
+                for (int j = c0; j < c1; j++)
+                    xi[j] /= diagonal;
+            }
         }
-        if (swapCount % 2) determinant = -determinant;
-        if (compound != nullptr)
-            *compound = *compoundMatrix;
-        if (permutation != nullptr)
-            *permutation = *permutationMatrix;
-        return determinant;
     }
 
-    BUILD_SINGLE_TEMPLATE(template NDArray _lup, (NDArray* input, NDArray* output, NDArray* permutation), FLOAT_TYPES);
+    /**
+     * This class walks through batch of n x n matrices stored in [..., n, n] array: each matrix is copied into
+     * contiguous row-major buffer of compute type, and results are written back from such buffers.
+     * Batch is spread between threads, while single large matrix gets threads within factorization instead
+     */
+    template <typename T>
+    class MatrixBatch {
+    public:
+        typedef LupCompute<T> C;
+
+        MatrixBatch(NDArray *input, NDArray *output) : _output(output) {
+            _n = static_cast<int>(input->sizeAt(-1));
+            _n2 = static_cast<Nd4jLong>(_n) * _n;
+            _count = _n2 > 0 ? input->lengthOf() / _n2 : 0;
+
+            if (input->ews() == 1 && input->ordering() == 'c')
+                _x = input->bufferAsT<T>();
+            else {
+                _xHolder.reset(input->dup('c'));
+                _x = _xHolder->bufferAsT<T>();
+            }
+
+            if (output != nullptr) {
+                if (output->ews() == 1 && output->ordering() == 'c')
+                    _z = output->bufferAsT<T>();
+                else {
+                    _zHolder.reset(output->dup('c'));
+                    _z = _zHolder->bufferAsT<T>();
+                }
+            }
+
+            int maxThreads = omp_get_max_threads();
+            _numThreads = static_cast<int>(nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(maxThreads, _count)));
+            _inner = _numThreads == 1 && _n >= LUP_PARALLEL_ORDER && maxThreads > 1;
+        }
+
+        ~MatrixBatch() {
+            if (_zHolder)
+                _output->assign(_zHolder.get());
+        }
+
+        FORCEINLINE int order() const {
+            return _n;
+        }
 
+        // true if factorizations should use threads on their own
+        FORCEINLINE bool inner() const {
+            return _inner;
+        }
 
+        FORCEINLINE void load(Nd4jLong e, C *buffer) const {
+            auto x = _x + e * _n2;
+            for (Nd4jLong i = 0; i < _n2; i++)
+                buffer[i] = static_cast<C>(x[i]);
+        }
+
+        FORCEINLINE void store(Nd4jLong e, const C *buffer) {
+            auto z = _z + e * _n2;
+            for (Nd4jLong i = 0; i < _n2; i++)
+                z[i] = static_cast<T>(buffer[i]);
+        }
+
+        /**
+         * This method calls func(e, buffer, scratch, perm) for each matrix e, with thread-local buffers:
+         * buffer and scratch hold n * n elements each, and perm holds n
+         */
+        template <typename Func>
+        void forEach(const Func &func) {
+            #pragma omp parallel num_threads(_numThreads) if (_numThreads > 1) default(shared)
+            {
+                std::vector<C> buffer(_n2);
+                std::vector<C> scratch(_n2);
+                std::vector<int> perm(_n);
+
+                #pragma omp for schedule(dynamic)
+                for (Nd4jLong e = 0; e < _count; e++)
+                    func(e, buffer.data(), scratch.data(), perm.data());
+            }
+        }
+
+    protected:
+        NDArray *_output;
+        std::unique_ptr<NDArray> _xHolder;
+        std::unique_ptr<NDArray> _zHolder;
+        T *_x;
+        T *_z = nullptr;
+        int _n;
+        Nd4jLong _n2;
+        Nd4jLong _count;
+        int _numThreads;
+        bool _inner;
+    };
 
     template <typename T>
     static int _determinant(NDArray* input, NDArray* output) {
+        MatrixBatch<T> batch(input, nullptr);
+        const int n = batch.order();
 
-        Nd4jLong n = input->sizeAt(-1);
-        Nd4jLong n2 = n * n;
+        batch.forEach([&] (Nd4jLong e, LupCompute<T> *lu, LupCompute<T> *scratch, int *perm) {
+            batch.load(e, lu);
+            auto swapCount = luBlocked(lu, n, perm, batch.inner());
 
-        auto matrix = NDArrayFactory::create(input->ordering(), {n, n}, input->dataType(), input->getWorkspace()); //, block.getWorkspace());
-//#pragma omp parallel for if(output->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-        for (int e = 0; e < output->lengthOf(); e++) {
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; ++k, ++row) {
-                matrix.p(row, input->e<T>(k));
-            }
+            LupCompute<T> det = 1.f;
+            for (int i = 0; i < n; i++)
+                det *= lu[i * n + i];
 
-            output->p(e, _lup<T>(&matrix, (NDArray*)nullptr, (NDArray*)nullptr));
-        }
+            output->p(e, static_cast<T>(swapCount % 2 ? -det : det));
+        });
 
         return Status::OK();
     }
@@ -190,22 +432,31 @@ namespace helpers {
         BUILD_SINGLE_SELECTOR(input->dataType(), return _determinant, (input, output), FLOAT_TYPES);
     }
 
-template <typename T>
+    template <typename T>
     int log_abs_determinant_(NDArray* input, NDArray* output) {
+        MatrixBatch<T> batch(input, nullptr);
+        const int n = batch.order();
+
+        // logarithms are summed, so large matrices don't overflow determinant on their way
+        batch.forEach([&] (Nd4jLong e, LupCompute<T> *lu, LupCompute<T> *scratch, int *perm) {
+            batch.load(e, lu);
+            luBlocked(lu, n, perm, batch.inner());
+
+            LupCompute<T> logDet = 0.f;
+            for (int i = 0; i < n; i++) {
+                auto diagonal = nd4j::math::nd4j_abs<LupCompute<T>>(lu[i * n + i]);
+
+                // singular matrix has zero determinant, so its logarithm is -inf
+                if (diagonal == 0.f) {
+                    logDet = -std::numeric_limits<LupCompute<T>>::infinity();
+                    break;
+                }
 
-        Nd4jLong n = input->sizeAt(-1);
-        Nd4jLong n2 = n * n;
-
-        NDArray matrix = NDArrayFactory::create(input->ordering(), {n, n}, input->dataType(), input->getWorkspace()); //, block.getWorkspace());
-//#pragma omp parallel for if(output->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-        for (int e = 0; e < output->lengthOf(); e++) {
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; ++k, ++row) {
-                matrix.p(row, input->e<T>(k));
+                logDet += nd4j::math::nd4j_log<LupCompute<T>, LupCompute<T>>(diagonal);
             }
-	    NDArray det = _lup<T>(&matrix, (NDArray*)nullptr, (NDArray*)nullptr);
-	    if (det.e<T>(0) != 0.f)
-             	output->p(e, nd4j::math::nd4j_log<T,T>(nd4j::math::nd4j_abs(det.t<T>(0))));
-        }
+
+            output->p(e, static_cast<T>(logDet));
+        });
 
         return ND4J_STATUS_OK;
     }
@@ -218,55 +469,41 @@ template <typename T>
 
     template <typename T>
     static int _inverse(NDArray* input, NDArray* output) {
-
-        auto n = input->sizeAt(-1);
-        auto n2 = n * n;
-        auto totalCount = output->lengthOf() / n2;
-        
-        output->assign(0.f); // fill up output tensor with zeros
-        auto matrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), input->getWorkspace()); //, block.getWorkspace());
-        auto compound = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), input->getWorkspace()); //, block.getWorkspace());
-        auto permutation = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), input->getWorkspace());
-        auto lowerMatrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), input->getWorkspace());
-        auto upperMatrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), input->getWorkspace());
-
-        for (int e = 0; e < totalCount; e++) {
-            if (e)
-                matrix.assign(0.f);
-
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; k++) {
-                matrix.p(row++, input->e<T>(k));
+        MatrixBatch<T> batch(input, output);
+        const int n = batch.order();
+        std::atomic<bool> singular(false);
+
+        batch.forEach([&] (Nd4jLong e, LupCompute<T> *lu, LupCompute<T> *inv, int *perm) {
+            batch.load(e, lu);
+            luBlocked(lu, n, perm, batch.inner());
+
+            // only zero or non-finite pivot makes matrix singular, wide range of pivots just means it's ill-conditioned
+            LupCompute<T> minPivot = DataTypeUtils::max<LupCompute<T>>(), maxPivot = 0.f;
+            bool finite = true;
+            for (int i = 0; i < n; i++) {
+                auto pivot = nd4j::math::nd4j_abs<LupCompute<T>>(lu[i * n + i]);
+                finite = finite && nd4j::math::nd4j_isfin<LupCompute<T>>(pivot);
+                minPivot = nd4j::math::nd4j_min<LupCompute<T>>(minPivot, pivot);
+                maxPivot = nd4j::math::nd4j_max<LupCompute<T>>(maxPivot, pivot);
             }
-            T det = _lup<T>(&matrix, &compound, &permutation).template e<T>(0);
 
-            // FIXME: and how this is going to work on float16?
-            if (nd4j::math::nd4j_abs<T>(det) < T(0.0000001)) {
-                nd4j_printf("matrix_inverse: The matrix %i has no inverse due determinant is %lf. Quiting...\n", e, det);
-                matrix.printIndexedBuffer("Wrong matrix");
-                return ND4J_STATUS_VALIDATION;
-            }
-            lowerMatrix.setIdentity(); // set up U to identity matrix
-            for (int k = 1; k < n; k++) {  // and then put all values under main diagonal on to it
-                for (int j = 0; j < k; j++)
-                    lowerMatrix.p(k, j, compound.template e<T>(k, j));
-            }
-            upperMatrix.setIdentity(); // set up U to identity matrix
-            for (int k = 0; k < n; k++) {  // and then put all values under main diagonal on to it
-                for (int j = k; j < n; j++)
-                    upperMatrix.p(k, j, compound.template e<T>(k, j));
+            if (minPivot == 0.f || !finite) {
+                nd4j_printf("matrix_inverse: The matrix %i has no inverse due zero or non-finite pivot. Quiting...\n", (int) e);
+                singular = true;
+
+                std::fill(inv, inv + n * n, (LupCompute<T>) 0.f);
+                batch.store(e, inv);
+                return;
             }
-            invertUpperMatrix(&upperMatrix, &matrix);
 
-            invertLowerMatrix(&lowerMatrix, &upperMatrix);
+            if (minPivot <= maxPivot * n * DataTypeUtils::eps<LupCompute<T>>())
+                nd4j_debug("matrix_inverse: The matrix %i is ill-conditioned, its pivots range from %lf to %lf\n", (int) e, (double) minPivot, (double) maxPivot);
 
-            nd4j::MmulHelper::mmul(&matrix, &upperMatrix, &compound, 1.0, 0.0);
-            nd4j::MmulHelper::mmul(&compound, &permutation, &matrix, 1.0, 0.0);
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; k++) {
-                output->p(k, matrix.template e<T>(row++));
-            }
-        }
+            luInverse(lu, perm, n, inv, batch.inner());
+            batch.store(e, inv);
+        });
 
-        return Status::OK();
+        return singular ? ND4J_STATUS_VALIDATION : Status::OK();
     }
 
     int inverse(NDArray* input, NDArray* output) {
@@ -275,43 +512,14 @@ template <typename T>
 
     template <typename T>
     int cholesky_(NDArray* input, NDArray* output, bool inplace) {
-
-        auto n = input->sizeAt(-1);
-        auto n2 = n * n;
-        auto totalCount = output->lengthOf() / n2;
-        if (!inplace)
-             output->assign(0.f); // fill up output tensor with zeros only inplace=false
-
-        std::unique_ptr<NDArray> matrix(NDArrayFactory::create_('c', {n, n}, input->dataType())); //, block.getWorkspace());
-        std::unique_ptr<NDArray> lowerMatrix(NDArrayFactory::create_('c',{n, n}, input->dataType()));
-
-        for (int e = 0; e < totalCount; e++) {
-
-            // fill up matrix
-            for (int k = e * n2, l = 0; k < (e + 1) * n2; k++) {
-                matrix->p(l++, input->e<T>(k));
-            }
-            //if (e) // from the second loop need to zero matrix
-            lowerMatrix->assign(0.f);
-
-            for (Nd4jLong col = 0; col < n; col++) {
-                for (Nd4jLong row = 0; row < col; row++) {
-                    T rowSum = 0;
-                    for (Nd4jLong k = 0; k < row; ++k)
-                        rowSum += (lowerMatrix->e<T>(col, k) * lowerMatrix->e<T>(row, k));
-                    lowerMatrix->p(col, row, (matrix->e<T>(row, col) - rowSum) / lowerMatrix->e<double>(row, row));
-                }
-                T diagonalSum = 0;
-                for (Nd4jLong k = 0; k < col;  ++k)
-                    diagonalSum += lowerMatrix->e<T>(col, k) * lowerMatrix->e<T>(col, k);
-                lowerMatrix->p(col, col, nd4j::math::nd4j_sqrt<T, T>(matrix->e<T>(col, col) - diagonalSum));
-                //nd4j_printf("%i: ", col);
-                //lowerMatrix->printIndexedBuffer("Lower matrix");
-            }
-            for (int k = e * n2, l = 0; k < (e + 1) * n2; k++) {
-                output->p(k, lowerMatrix->e<T>(l++));
-            }
-        }
+        MatrixBatch<T> batch(input, output);
+        const int n = batch.order();
+
+        batch.forEach([&] (Nd4jLong e, LupCompute<T> *lower, LupCompute<T> *scratch, int *perm) {
+            batch.load(e, lower);
+            choleskyBlocked(lower, n, batch.inner());
+            batch.store(e, lower);
+        });
 
         return ND4J_STATUS_OK;
     }
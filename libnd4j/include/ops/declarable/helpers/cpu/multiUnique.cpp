@@ -20,6 +20,7 @@
 
 #include <ops/declarable/helpers/multiUnique.h>
 #include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/unique.h>
 
 namespace nd4j {
 namespace ops {
@@ -44,16 +45,9 @@ namespace helpers {
             border += array->lengthOf();
         }
 
-        nd4j::ops::unique opUnique;
-        auto uResult = opUnique.execute({arrayFull}, {}, {}, {});
-        if (ND4J_STATUS_OK != uResult->status())
-            throw std::runtime_error("multiUnique: cannot execute unique op properly.");
+        // all values are unique if hash table ends up with one entry per element
+        bool res = uniqueCount(arrayFull) == arrayFull->lengthOf();
 
-        auto uniqueVals = uResult->at(0);
-
-        bool res = uniqueVals->lengthOf() == arrayFull->lengthOf();
-
-        delete uResult;
         delete arrayFull;
         return res;
     }
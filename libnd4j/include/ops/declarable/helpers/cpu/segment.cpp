@@ -19,279 +19,208 @@
 //
 
 #include <ops/declarable/helpers/segment.h>
+#include <OmpLaunchHelper.h>
+#include <cmath>
+#include <memory>
+
+// number of row elements reduced by single work item. segments with long rows are split into such column blocks
+#define SEGMENT_BLOCK 1024
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
-    // segment max
+    // reduction applied within segment
     template <typename T>
-    static void segmentMaxFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        if (input->isVector()) {
-            T val = input->e<T>(0);
-#pragma omp parallel for if(indices->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-            for (int e = 1; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // max 
-                   val = nd4j::math::nd4j_max<T>(val, input->e<T>(e));
-                }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->e<T>(e);
-                }
-                output->p<T>(idx, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-#pragma omp parallel for if(input->rankOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
+    struct SegmentSumOp {
+        static FORCEINLINE T update(T a, T b) { return a + b; }
+    };
 
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
+    template <typename T>
+    struct SegmentProdOp {
+        static FORCEINLINE T update(T a, T b) { return a * b; }
+    };
 
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto maxT = listOfOutTensors->at(idx);
+    template <typename T>
+    struct SegmentMaxOp {
+        static FORCEINLINE T update(T a, T b) { return nd4j::math::nd4j_max<T>(a, b); }
+    };
 
-            int pos = 0;
-            maxT->assign(listOfTensors->at(0));
-#pragma omp parallel for if(indices->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-            for (int i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-                    for (int e = 0; e < maxT->lengthOf(); e++) {
-                       maxT->p<T>(e, nd4j::math::nd4j_max(maxT->e<T>(e), listOfTensors->at(i)->e<T>(e)));
-                    }
-                }
-                else {
-                    idx = indices->e<Nd4jLong>(i);
-                    maxT = listOfOutTensors->at(idx);
-                    maxT->assign(listOfTensors->at(i));
-                }
+    template <typename T>
+    struct SegmentMinOp {
+        static FORCEINLINE T update(T a, T b) { return nd4j::math::nd4j_min<T>(a, b); }
+    };
+
+    // post-processing of reduced segment
+    enum SegmentScale {
+        SEGMENT_NONE,
+        SEGMENT_MEAN,
+        SEGMENT_SQRT_N
+    };
+
+    /**
+     * This method builds segment layout: rows of segment c are rows[offsets[c]] ... rows[offsets[c + 1] - 1].
+     * For sorted indices rows of each segment are contiguous already, so rows is left empty and segment c is just
+     * the range [offsets[c], offsets[c + 1]). For unsorted indices rows are bucketed by stable counting sort, with
+     * per-thread histograms, so neither locks nor atomics are needed. Out-of-range indices are skipped
+     */
+    static void segmentLayout(NDArray* indices, Nd4jLong numOfClasses, bool sorted, std::vector<Nd4jLong> &offsets, std::vector<Nd4jLong> &rows) {
+        const Nd4jLong numRows = indices->lengthOf();
+        std::vector<Nd4jLong> idx(numRows);
+        for (Nd4jLong e = 0; e < numRows; e++)
+            idx[e] = indices->e<Nd4jLong>(e);
+
+        offsets.assign(numOfClasses + 1, 0);
+
+        if (sorted) {
+            for (Nd4jLong e = 0; e < numRows; e++)
+                if (idx[e] >= 0 && idx[e] < numOfClasses)
+                    offsets[idx[e] + 1]++;
+
+            for (Nd4jLong c = 0; c < numOfClasses; c++)
+                offsets[c + 1] += offsets[c];
+
+            // skipped rows can only be at the edges of sorted indices, so ranges are shifted to first valid row
+            Nd4jLong first = 0;
+            while (first < numRows && idx[first] < 0)
+                first++;
+
+            for (auto &o : offsets)
+                o += first;
+
+            rows.clear();
+            return;
+        }
+
+        // histograms are per thread, and threads are limited so histograms don't outweigh indices themselves
+        int numThreads = nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(OmpLaunchHelper::betterThreads(numRows), numRows / (numOfClasses + 1)));
+        const Nd4jLong span = (numRows + numThreads - 1) / numThreads;
+        std::vector<Nd4jLong> counts(numThreads * numOfClasses, 0);
+
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(static)
+        for (int t = 0; t < numThreads; t++) {
+            auto hist = counts.data() + t * numOfClasses;
+            for (Nd4jLong e = t * span; e < nd4j::math::nd4j_min<Nd4jLong>(numRows, (t + 1) * span); e++)
+                if (idx[e] >= 0 && idx[e] < numOfClasses)
+                    hist[idx[e]]++;
+        }
 
+        // class-major exclusive scan: rows of each class keep their original order
+        Nd4jLong running = 0;
+        for (Nd4jLong c = 0; c < numOfClasses; c++) {
+            offsets[c] = running;
+            for (int t = 0; t < numThreads; t++) {
+                auto cnt = counts[t * numOfClasses + c];
+                counts[t * numOfClasses + c] = running;
+                running += cnt;
             }
-            delete listOfTensors;
-            delete listOfOutTensors;
         }
-    }
+        offsets[numOfClasses] = running;
 
-    // segmen min 
-    template <typename T>
-    static void segmentMinFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        if (input->isVector()) {
-            T val = input->e<T>(0);
-#pragma omp parallel for if(indices->rankOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-            for (int e = 1; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // min 
-                   val = nd4j::math::nd4j_min<T>(val, input->e<T>(e));
-                }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->e<T>(e);
-                }
-                output->p(idx, val);
-            }
+        rows.resize(running);
+
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(static)
+        for (int t = 0; t < numThreads; t++) {
+            auto position = counts.data() + t * numOfClasses;
+            for (Nd4jLong e = t * span; e < nd4j::math::nd4j_min<Nd4jLong>(numRows, (t + 1) * span); e++)
+                if (idx[e] >= 0 && idx[e] < numOfClasses)
+                    rows[position[idx[e]]++] = e;
         }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-#pragma omp parallel for if(input->rankOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)         
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
+    }
 
-            std::unique_ptr<ResultSet> listOfTensors( input->allTensorsAlongDimension(restDims) );
-            std::unique_ptr<ResultSet> listOfOutTensors( output->allTensorsAlongDimension(restDims) );
+    /**
+     * Segment reduction engine shared by segment_* and unsorted_segment_* ops.
+     * Input is treated as [numRows, rowLength] and output as [numOfClasses, rowLength]. Work is split into
+     * (segment, column block) items, each item is reduced by single thread with simd accumulation over rows,
+     * so items never write to the same output elements. Empty segments are filled with emptyValue
+     */
+    template <typename T, typename OpType>
+    static void segmentReduce_(NDArray* input, NDArray* indices, NDArray* output, bool sorted, T emptyValue, SegmentScale scale) {
+        const Nd4jLong numOfClasses = output->sizeAt(0);
+        const Nd4jLong numRows = indices->lengthOf();
+        const Nd4jLong rowLength = numRows > 0 ? input->lengthOf() / numRows : 0;
 
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto minT = listOfOutTensors->at(idx);
+        std::vector<Nd4jLong> offsets, rows;
+        segmentLayout(indices, numOfClasses, sorted, offsets, rows);
 
-            int pos = 0;
-            minT->assign(listOfTensors->at(0));
-#pragma omp parallel for if(indices->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-            for (int i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<T>(i) == idx) {
-                    for (int e = 0; e < minT->lengthOf(); e++) {
-                       minT->p(e, nd4j::math::nd4j_min(minT->e<T>(e), listOfTensors->at(i)->e<T>(e)));
-                    }
-                }
-                else {
-                    idx = indices->e<T>(i);
-                    minT = listOfOutTensors->at(idx);
-                    minT->assign(listOfTensors->at(i));
-                }
+        // engine works on c-ordered contiguous buffers, anything else goes through temporary copies
+        std::unique_ptr<NDArray> xTemp(input->ordering() == 'c' && input->ews() == 1 ? nullptr : input->dup('c'));
+        std::unique_ptr<NDArray> zTemp(output->ordering() == 'c' && output->ews() == 1 && output->dataType() == input->dataType() ? nullptr :
+                                       new NDArray('c', output->getShapeAsVector(), input->dataType(), output->getWorkspace()));
+
+        auto x = reinterpret_cast<T *>(xTemp ? xTemp->buffer() : input->buffer());
+        auto z = reinterpret_cast<T *>(zTemp ? zTemp->buffer() : output->buffer());
+        auto r = rows.empty() ? nullptr : rows.data();
+
+        const Nd4jLong numBlocks = (rowLength + SEGMENT_BLOCK - 1) / SEGMENT_BLOCK;
+        const Nd4jLong numItems = numOfClasses * numBlocks;
+        int numThreads = nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(OmpLaunchHelper::betterThreads(input->lengthOf()), numItems));
+
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic)
+        for (Nd4jLong item = 0; item < numItems; item++) {
+            const Nd4jLong c = item / numBlocks;
+            const Nd4jLong start = (item % numBlocks) * SEGMENT_BLOCK;
+            const Nd4jLong length = nd4j::math::nd4j_min<Nd4jLong>(SEGMENT_BLOCK, rowLength - start);
+            const Nd4jLong count = offsets[c + 1] - offsets[c];
+            auto zc = z + c * rowLength + start;
+
+            if (count == 0) {
+                for (Nd4jLong e = 0; e < length; e++)
+                    zc[e] = emptyValue;
+                continue;
             }
-        }
-    }
 
-    // segmen mean
-    template <typename T>
-    static void segmentMeanFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        if (input->isVector()) {
-            T val = T(0.f);
-            int count = 0;
-//#pragma omp parallel for if(indices->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-            for (int e = 0; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // mean 
-                   val += input->e<T>(e);
-                   count++;
-                }
-                else {
-                   output->p<T>(idx, val / count);
-                    idx = indices->e<int>(e);
-                    val = input->e<T>(e);
-                    count = 1;
-                }
-                output->p<T>(idx, val / count);
+            auto row = [&] (Nd4jLong k) -> T* {
+                auto rowIdx = r != nullptr ? r[offsets[c] + k] : offsets[c] + k;
+                return x + rowIdx * rowLength + start;
+            };
+
+            auto x0 = row(0);
+#pragma omp simd
+            for (Nd4jLong e = 0; e < length; e++)
+                zc[e] = x0[e];
+
+            for (Nd4jLong k = 1; k < count; k++) {
+                auto xk = row(k);
+#pragma omp simd
+                for (Nd4jLong e = 0; e < length; e++)
+                    zc[e] = OpType::update(zc[e], xk[e]);
             }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-#pragma omp parallel for if(input->rankOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)         
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
 
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto meanT = listOfOutTensors->at(idx);
-            int count = 1;
-            auto meanV = meanT->dup();
-            meanV->assign(listOfTensors->at(0));
-            for (int i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-                    for (int e = 0; e < meanT->lengthOf(); e++) {
-                       meanV->p<T>(e, meanV->e<T>(e) + listOfTensors->at(i)->e<T>(e));
-                    }
-                    count++;
-                }
-                else {
-                    //meanT->assign(meanV);
-                    meanV->applyScalar(scalar::Divide, count, meanT, nullptr);
-                    idx = indices->e<int>(i);
-                    meanT = listOfOutTensors->at(idx);
-                    meanV->assign(listOfTensors->at(i));
-                    count = 1;
-                }
-                meanV->applyScalar(scalar::Divide, count, meanT, nullptr);
+            if (scale != SEGMENT_NONE) {
+                const T divisor = scale == SEGMENT_MEAN ? static_cast<T>(count) : static_cast<T>(std::sqrt(static_cast<double>(count)));
+                for (Nd4jLong e = 0; e < length; e++)
+                    zc[e] = static_cast<T>(zc[e] / divisor);
             }
-            delete meanV;
-            delete listOfTensors;
-            delete listOfOutTensors;
         }
+
+        if (zTemp)
+            output->assign(zTemp.get());
     }
 
     template <typename T>
-    static void segmentSumFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        if (input->isVector()) {
-            T val = T(0.f);
-            int count = 0;
-            for (int e = 0; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // sum 
-                   val += input->e<T>(e);
-                }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->e<T>(e);
-                }
-                output->p(idx, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-#pragma omp parallel for if(input->rankOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)         
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
+    static void segmentMaxFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
+        segmentReduce_<T, SegmentMaxOp<T>>(input, indices, output, true, static_cast<T>(0.f), SEGMENT_NONE);
+    }
 
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
+    template <typename T>
+    static void segmentMinFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
+        segmentReduce_<T, SegmentMinOp<T>>(input, indices, output, true, static_cast<T>(0.f), SEGMENT_NONE);
+    }
 
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto sumT = listOfOutTensors->at(idx);
+    template <typename T>
+    static void segmentMeanFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
+        segmentReduce_<T, SegmentSumOp<T>>(input, indices, output, true, static_cast<T>(0.f), SEGMENT_MEAN);
+    }
 
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-                    for (int e = 0; e < sumT->lengthOf(); e++) {
-                       sumT->p(e, sumT->e<T>(e) +listOfTensors->at(i)->e<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<int>(i);
-                    sumT = listOfOutTensors->at(idx);
-                    sumT->assign(listOfTensors->at(i));
-                }
-            }
-            delete listOfTensors;
-            delete listOfOutTensors;
-        }
+    template <typename T>
+    static void segmentSumFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
+        segmentReduce_<T, SegmentSumOp<T>>(input, indices, output, true, static_cast<T>(0.f), SEGMENT_NONE);
     }
 
     template <typename T>
     static void segmentProdFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        output->assign(1.f);
-        if (input->isVector()) {
-            T val = input->e<T>(0);
-            int count = 0;
-            for (int e = 1; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // sum 
-                   val *= input->e<T>(e);
-                }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->e<T>(e);
-                }
-                output->p(idx, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-#pragma omp parallel for if(input->rankOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)         
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            auto sumT = listOfOutTensors->at(idx);
-            sumT->assign(listOfTensors->at(0));
-            for (int i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i)  == idx) {
-                    for (int e = 0; e < sumT->lengthOf(); e++) {
-                       sumT->p(e, sumT->e<T>(e) * listOfTensors->at(i)->e<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<int>(i);
-                    sumT = listOfOutTensors->at(idx);
-                    sumT->assign(listOfTensors->at(i));
-                }
-            }
-            delete listOfTensors;
-            delete listOfOutTensors;
-        }
+        segmentReduce_<T, SegmentProdOp<T>>(input, indices, output, true, static_cast<T>(1.f), SEGMENT_NONE);
     }
 
     template <typename T>
@@ -356,302 +285,65 @@ namespace helpers {
 
     template <typename T>
     static void unsortedSegmentMaxFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-
-        // if input is a vector: (as if in doc sample)
-        //int idx = static_cast<int>((*indices)(0.));
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(-maxVal);
-//#pragma omp parallel for if(idxs.size() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T val = input->e<T>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    val = nd4j::math::nd4j_max(val, input->e<T>(fi->second.at(idx)));
-                }
-                output->p(fi->first, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong idx = idxs[0][0];
-#pragma omp parallel for if(input->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-//            int numOfClasses = output->sizeAt(0); // number of classes
-//            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-//            NDArray* maxT = listOfOutTensors->at(idx);
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(-maxVal);
-//#pragma omp parallel for schedule(static)
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto maxT = listOfTensors->at(fi->second.at(idx));
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        T val = nd4j::math::nd4j_max(maxT->e<T>(e), outputT->e<T>(e));
-
-                        outputT->p(e, val);
-                    }
-                }
-                //outputT->assign(maxT);
-            }
-        }
+        segmentReduce_<T, SegmentMaxOp<T>>(input, indices, output, false, -DataTypeUtils::max<T>(), SEGMENT_NONE);
     }
-    void unsortedSegmentMaxFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMaxFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
-    }
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMaxFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
     template <typename T>
     static void unsortedSegmentMinFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        // if input is a vector: (as if in doc sample)
-        //int idx = static_cast<int>((*indices)(0.));
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(maxVal);
-//#pragma omp parallel for schedule(static)
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T val = input->e<T>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    val = nd4j::math::nd4j_min(val, input->e<T>(fi->second.at(idx)));
-                }
-                output->p(fi->first, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong idx = idxs[0][0];
-#pragma omp parallel for if(input->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-//            int numOfClasses = output->sizeAt(0); // number of classes
-//            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-//            NDArray* maxT = listOfOutTensors->at(idx);
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(maxVal);
-//#pragma omp parallel for schedule(static)
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto minT = listOfTensors->at(fi->second.at(idx));
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        T val = nd4j::math::nd4j_min(minT->e<T>(e), outputT->e<T>(e));
-
-                        outputT->p(e, val);
-                    }
-                }
-                //outputT->assign(maxT);
-            }
-        }
-
-    }
-    void unsortedSegmentMinFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMinFunctor_, (input, indices, numOfClasses, output),
-                              NUMERIC_TYPES);
+        segmentReduce_<T, SegmentMinOp<T>>(input, indices, output, false, DataTypeUtils::max<T>(), SEGMENT_NONE);
     }
 
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMinFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
-
-    void unsortedSegmentMeanFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-//#pragma omp parallel for schedule(static)
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-                output->p(fi->first, sumValue / fi->second.size());
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-#pragma omp parallel for if(input->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-//            int numOfClasses = output->sizeAt(0); // number of classes
-//            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-//            NDArray* maxT = listOfOutTensors->at(idx);
-//#pragma omp parallel for schedule(static)
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *outputT += *current;
-                }
-                //outputT->assign(maxT);
-                (*outputT) /= double(fi->second.size());
-            }
-        }
+    template <typename T>
+    static void unsortedSegmentMeanFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        segmentReduce_<T, SegmentSumOp<T>>(input, indices, output, false, static_cast<T>(0.f), SEGMENT_MEAN);
     }
 
-    void unsortedSegmentSumFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-//#pragma omp parallel for schedule(static)
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-                output->p(fi->first, sumValue);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-#pragma omp parallel for if(input->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-//            int numOfClasses = output->sizeAt(0); // number of classes
-//            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-//            NDArray* maxT = listOfOutTensors->at(idx);
-//#pragma omp parallel for schedule(static)
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *(outputT) += *current;
-                }
-                //outputT->assign(maxT);
-            }
-        }
+    template <typename T>
+    static void unsortedSegmentSumFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        segmentReduce_<T, SegmentSumOp<T>>(input, indices, output, false, static_cast<T>(0.f), SEGMENT_NONE);
     }
 
     template <typename T>
-    void unsortedSegmentProdFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
+    static void unsortedSegmentProdFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        segmentReduce_<T, SegmentProdOp<T>>(input, indices, output, false, static_cast<T>(1.f), SEGMENT_NONE);
+    }
 
-        //std::sort(idxs.begin(), idxs.end());
+    template <typename T>
+    static void unsortedSegmentSqrtNFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        segmentReduce_<T, SegmentSumOp<T>>(input, indices, output, false, static_cast<T>(0.f), SEGMENT_SQRT_N);
+    }
 
-        output->assign(1.f);
+    void unsortedSegmentMaxFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMaxFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+    }
 
-        if (input->isVector()) { // 1D case
-//#pragma omp parallel for schedule(static)
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T prodValue = input->e<T>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    prodValue *= input->e<T>(fi->second.at(idx));
-                }
-                output->p(fi->first, prodValue);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-#pragma omp parallel for if(input->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
+    void unsortedSegmentMinFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMinFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+    }
 
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+    void unsortedSegmentMeanFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMeanFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+    }
 
-//            int numOfClasses = output->sizeAt(0); // number of classes
-//            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-//            NDArray* maxT = listOfOutTensors->at(idx);
-//#pragma omp parallel for schedule(static)
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-
-                    *outputT *= *current;
-                }
-            }
-        }
+    void unsortedSegmentSumFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentSumFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
     }
 
     void unsortedSegmentProdFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
         BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentProdFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
     }
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentProdFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
     void unsortedSegmentSqrtNFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-//#pragma omp parallel for schedule(static)
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-                output->p(fi->first, sumValue / nd4j::math::nd4j_sqrt<Nd4jLong, double>(fi->second.size()));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-#pragma omp parallel for if(input->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-//            int numOfClasses = output->sizeAt(0); // number of classes
-//            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-//            NDArray* maxT = listOfOutTensors->at(idx);
-//#pragma omp parallel for schedule(static)
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *outputT += *current;
-                }
-                //outputT->assign(maxT);
-                (*outputT) /= nd4j::math::nd4j_sqrt<size_t, double>(fi->second.size());
-            }
-        }
+        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentSqrtNFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
     }
 
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMaxFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMinFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMeanFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentSumFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentProdFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentSqrtNFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+
     // -------------------------------------------------------------------------------------------------------------- //
     // Backpropagate ops helpers
     // -------------------------------------------------------------------------------------------------------------- //
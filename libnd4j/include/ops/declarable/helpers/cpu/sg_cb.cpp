@@ -22,6 +22,7 @@
 #include <AveragingArrayProxy.h>
 #include <helpers/AveragingArrayProxy.h>
 #include <specials.h>
+#include <vector>
 
 #define HS_MAX_EXP 6.0f
 
@@ -73,6 +74,21 @@ namespace nd4j {
                 }
             }
 
+            // gradient of negative sampling round for given dot product, 0 if dot product falls out of expTable
+            template <typename T>
+            static FORCEINLINE T nsGradient(T dot, int code, double alpha, T *expTable, int expLength) {
+                if (dot > HS_MAX_EXP)
+                    return static_cast<T>((code - 1) * alpha);
+                else if (dot < (T) - HS_MAX_EXP)
+                    return static_cast<T>((code - 0) * alpha);
+
+                int idx = (int) ((dot + (T) HS_MAX_EXP) * ((T) expLength / HS_MAX_EXP / 2.0));
+                if (idx >= expLength || idx < 0)
+                    return (T) 0.0f;
+
+                return static_cast<T>(((T) code - expTable[idx]) * alpha);
+            }
+
             template <typename T>
             void nSampling_(void *vsyn0, void *vsyn1Neg, void *vexpTable, void *vneu1e, double alpha, int vectorLength, int code, int expLength, bool isInference) {
                 auto syn0 = reinterpret_cast<T*>(vsyn0);
@@ -88,20 +104,9 @@ namespace nd4j {
                     dot += syn0[e] * syn1Neg[e];
                 }
 
-                if (dot > HS_MAX_EXP)
-                    g = (code - 1) * alpha;
-                else if (dot < (T) - HS_MAX_EXP)
-                    g = (code - 0) * alpha;
-                else {
-                    int idx = (int) ((dot + (T) HS_MAX_EXP) * ((T) expLength / HS_MAX_EXP / 2.0));
-                    if (idx >= expLength)
-                        return;
-
-                    if (idx < 0)
-                        return;
-
-                    g = ((T) code - expTable[idx]) * alpha;
-                }
+                g = nsGradient<T>(dot, code, alpha, expTable, expLength);
+                if (g == (T) 0.0f)
+                    return;
 
                 // axpy1
                 #pragma omp simd
@@ -296,6 +301,323 @@ namespace nd4j {
                 return (haystack[halfIndex] == needle) ? halfIndex : -1;
             }
 
+            // draws next negative word out of negTable, the same way per-pair rounds do
+            template <typename T>
+            static FORCEINLINE int nextNegative(unsigned long long &randomValue, T *negTable, const int negLength, const int vocabSize) {
+                randomValue = randomValue * (unsigned long long) 25214903917 + 11;
+                auto idx = nd4j::math::nd4j_abs<Nd4jLong>((randomValue >> 16) % negLength);
+                int irow = idx >= negLength ? -1 : static_cast<int>(negTable[idx]);
+
+                if (irow < 0 || irow >= vocabSize)
+                    irow = randomValue % (vocabSize - 1) + 1;
+
+                return irow;
+            }
+
+            /**
+             * Negative sampling for minibatch of hidden rows h [batchSize x vectorLength]. Row b is trained against its own
+             * positive syn1Neg row, and against numNegatives rows shared by the whole minibatch.
+             *
+             * Output rows are gathered once, so dot products and updates become small dense products:
+             * scores = h x out^T, neu1e += grads x out, delta = grads^T x h. Each touched syn1Neg row then gets
+             * single write-back per minibatch instead of one axpy per pair
+             *
+             * scratch must hold (batchSize + 2 * numNegatives) * vectorLength + batchSize * (numNegatives + 1) elements
+             */
+            template <typename T>
+            static void nSamplingBatch_(T *h, T *neu1e, const int batchSize, const int *positives, const double *alphas, const int *negatives, const int numNegatives, T *syn1Neg, T *expTable, const int vectorLength, const int expLength, T *scratch) {
+                const int numColumns = numNegatives + 1;
+                auto out = scratch;
+                auto grads = out + (batchSize + numNegatives) * vectorLength;
+                auto delta = grads + batchSize * numColumns;
+
+                // column 0 of row b is its positive word, columns 1..numNegatives are shared negatives
+                auto column = [&] (int b, int j) -> T* {
+                    return j == 0 ? out + b * vectorLength : out + (batchSize + j - 1) * vectorLength;
+                };
+
+                for (int b = 0; b < batchSize; b++)
+                    memcpy(out + b * vectorLength, syn1Neg + positives[b] * vectorLength, vectorLength * sizeof(T));
+
+                for (int k = 0; k < numNegatives; k++)
+                    memcpy(out + (batchSize + k) * vectorLength, syn1Neg + negatives[k] * vectorLength, vectorLength * sizeof(T));
+
+                // scores and gradients
+                for (int b = 0; b < batchSize; b++) {
+                    auto hb = h + b * vectorLength;
+
+                    for (int j = 0; j < numColumns; j++) {
+                        // negative that happens to be positive word of this row is skipped, as in per-pair rounds
+                        if (j > 0 && negatives[j - 1] == positives[b]) {
+                            grads[b * numColumns + j] = (T) 0.0f;
+                            continue;
+                        }
+
+                        auto oj = column(b, j);
+                        T dot = (T) 0.0f;
+
+                        #pragma omp simd reduction(sumT:dot)
+                        for (int e = 0; e < vectorLength; e++)
+                            dot += hb[e] * oj[e];
+
+                        grads[b * numColumns + j] = nsGradient<T>(dot, j == 0 ? 1 : 0, alphas[b], expTable, expLength);
+                    }
+                }
+
+                // errors of hidden rows
+                for (int b = 0; b < batchSize; b++) {
+                    auto eb = neu1e + b * vectorLength;
+
+                    for (int j = 0; j < numColumns; j++) {
+                        const T g = grads[b * numColumns + j];
+                        if (g == (T) 0.0f)
+                            continue;
+
+                        auto oj = column(b, j);
+
+                        #pragma omp simd
+                        for (int e = 0; e < vectorLength; e++)
+                            eb[e] += g * oj[e];
+                    }
+                }
+
+                // positive rows may repeat within minibatch, but gradients were taken from gathered copies and updates are additive, so they're applied right away
+                for (int b = 0; b < batchSize; b++) {
+                    const T g = grads[b * numColumns];
+                    auto hb = h + b * vectorLength;
+                    auto row = syn1Neg + positives[b] * vectorLength;
+
+                    #pragma omp simd
+                    for (int e = 0; e < vectorLength; e++)
+                        row[e] += g * hb[e];
+                }
+
+                // shared rows accumulate contributions of the whole minibatch first
+                memset(delta, 0, numNegatives * vectorLength * sizeof(T));
+                for (int b = 0; b < batchSize; b++) {
+                    auto hb = h + b * vectorLength;
+
+                    for (int k = 0; k < numNegatives; k++) {
+                        const T g = grads[b * numColumns + k + 1];
+                        if (g == (T) 0.0f)
+                            continue;
+
+                        auto dk = delta + k * vectorLength;
+
+                        #pragma omp simd
+                        for (int e = 0; e < vectorLength; e++)
+                            dk[e] += g * hb[e];
+                    }
+                }
+
+                for (int k = 0; k < numNegatives; k++) {
+                    auto dk = delta + k * vectorLength;
+                    auto row = syn1Neg + negatives[k] * vectorLength;
+
+                    #pragma omp simd
+                    for (int e = 0; e < vectorLength; e++)
+                        row[e] += dk[e];
+                }
+            }
+
+            /**
+             * Minibatched skipgram: consecutive targets are grouped into minibatches of minibatchSize pairs, and each minibatch
+             * shares nsRounds negative words, drawn with random value of its first pair.
+             *
+             * Rows are updated lock-free, hogwild-style, just like in per-pair batched mode, but every syn0 row and every
+             * shared syn1Neg row is written back once per minibatch, out of rows gathered by the thread
+             */
+            template <typename T>
+            static void skipgramMinibatch_(NDArray &s0, NDArray &s1, NDArray &s1n, T *expTable, T *negTable, NDArray &targets, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, const int nsRounds, const int vocabSize, const int vectorLength, const int expLength, const int negLength, const int minibatchSize, const int numThreads) {
+                const auto syn0 = s0.bufferAsT<T>();
+                const auto syn1 = s1.bufferAsT<T>();
+                const auto syn1Neg = s1n.bufferAsT<T>();
+
+                const auto idxShift = indices.isEmpty() ? 0 : indices.sizeAt(1);
+                const auto hsRounds = codes.isEmpty() ? 0 : codes.sizeAt(1);
+                const bool useNS = nsRounds > 0 && !negStarters.isEmpty();
+                const auto numNegatives = useNS ? nsRounds : 0;
+
+                const auto numTargets = targets.lengthOf();
+                const auto numBatches = (numTargets + minibatchSize - 1) / minibatchSize;
+
+                const auto bTarget = targets.bufferAsT<int>();
+                const auto bIndices = indices.bufferAsT<int>();
+                const auto bCodes = codes.bufferAsT<int8_t>();
+                const auto bStarters = negStarters.bufferAsT<int>();
+
+#pragma omp parallel num_threads(numThreads) default(shared)
+                {
+                    std::vector<T> h(minibatchSize * vectorLength);
+                    std::vector<T> neu1e(minibatchSize * vectorLength);
+                    std::vector<T> scratch((minibatchSize + 2 * numNegatives) * vectorLength + minibatchSize * (numNegatives + 1));
+                    std::vector<int> positives(minibatchSize);
+                    std::vector<int> negatives(numNegatives);
+                    std::vector<double> alphas(minibatchSize);
+
+#pragma omp for schedule(static)
+                    for (Nd4jLong m = 0; m < numBatches; m++) {
+                        const Nd4jLong first = m * minibatchSize;
+                        const int batchSize = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(minibatchSize, numTargets - first));
+
+                        memset(neu1e.data(), 0, batchSize * vectorLength * sizeof(T));
+
+                        for (int b = 0; b < batchSize; b++) {
+                            memcpy(h.data() + b * vectorLength, syn0 + bTarget[first + b] * vectorLength, vectorLength * sizeof(T));
+                            alphas[b] = lr.e<double>(first + b);
+                        }
+
+                        // syn1 rows of hierarchic softmax are specific to each target word, so they aren't shared
+                        for (int b = 0; b < batchSize && hsRounds > 0; b++) {
+                            auto cShift = (first + b) * idxShift;
+
+                            for (int e = 0; e < hsRounds; e++) {
+                                auto irow = bIndices[e + cShift];
+                                if (irow < 0 || irow >= vocabSize)
+                                    continue;
+
+                                hSoftmax_<T>(h.data() + b * vectorLength, syn1 + irow * vectorLength, expTable, neu1e.data() + b * vectorLength, alphas[b], vectorLength, bCodes[e + cShift], expLength, false);
+                            }
+                        }
+
+                        if (useNS) {
+                            unsigned long long randomValue = nextRandom.e<Nd4jLong>(first);
+                            for (int r = 0; r < numNegatives; r++)
+                                negatives[r] = nextNegative<T>(randomValue, negTable, negLength, vocabSize);
+
+                            for (int b = 0; b < batchSize; b++)
+                                positives[b] = bStarters[first + b];
+
+                            nSamplingBatch_<T>(h.data(), neu1e.data(), batchSize, positives.data(), alphas.data(), negatives.data(), numNegatives, syn1Neg, expTable, vectorLength, expLength, scratch.data());
+                        }
+
+                        for (int b = 0; b < batchSize; b++) {
+                            auto syn0row = syn0 + bTarget[first + b] * vectorLength;
+                            auto eb = neu1e.data() + b * vectorLength;
+
+                            #pragma omp simd
+                            for (int e = 0; e < vectorLength; e++)
+                                syn0row[e] += eb[e];
+                        }
+                    }
+                }
+            }
+
+            /**
+             * Minibatched CBOW: the same as skipgramMinibatch_, with averaged context windows as hidden rows
+             */
+            template <typename T>
+            static void cbowMinibatch_(NDArray &s0, NDArray &s1, NDArray &s1n, T *expTable, T *negTable, NDArray &context, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, NDArray &nLabels, const int nsRounds, const int vocabSize, const int vectorLength, const int expLength, const int negLength, const bool trainWords, const int minibatchSize, const int numThreads) {
+                const auto syn0 = s0.bufferAsT<T>();
+                const auto syn1 = s1.bufferAsT<T>();
+                const auto syn1Neg = s1n.bufferAsT<T>();
+
+                const auto numIndices = indices.isEmpty() ? 0 : indices.sizeAt(1);
+                const bool useNS = nsRounds > 0 && !negStarters.isEmpty();
+                const auto numNegatives = useNS ? nsRounds : 0;
+
+                const auto numTargets = context.sizeAt(0);
+                const int contextWidth = context.sizeAt(1);
+                const auto numBatches = (numTargets + minibatchSize - 1) / minibatchSize;
+
+                const auto bContext = context.bufferAsT<int>();
+                const auto bIndices = indices.bufferAsT<int>();
+                const auto bCodes = codes.bufferAsT<int8_t>();
+                const auto bStarters = negStarters.bufferAsT<int>();
+
+#pragma omp parallel num_threads(numThreads) default(shared)
+                {
+                    std::vector<T> h(minibatchSize * vectorLength);
+                    std::vector<T> neu1e(minibatchSize * vectorLength);
+                    std::vector<T> scratch((minibatchSize + 2 * numNegatives) * vectorLength + minibatchSize * (numNegatives + 1));
+                    std::vector<int> positives(minibatchSize);
+                    std::vector<int> negatives(numNegatives);
+                    std::vector<double> alphas(minibatchSize);
+
+#pragma omp for schedule(static)
+                    for (Nd4jLong m = 0; m < numBatches; m++) {
+                        const Nd4jLong first = m * minibatchSize;
+                        const int batchSize = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(minibatchSize, numTargets - first));
+
+                        memset(h.data(), 0, batchSize * vectorLength * sizeof(T));
+                        memset(neu1e.data(), 0, batchSize * vectorLength * sizeof(T));
+
+                        // averaged context windows
+                        for (int b = 0; b < batchSize; b++) {
+                            auto hb = h.data() + b * vectorLength;
+                            auto bc = bContext + (first + b) * contextWidth;
+                            int actualContext = 0;
+
+                            for (int c = 0; c < contextWidth; c++) {
+                                // skipping padded values
+                                if (bc[c] < 0)
+                                    continue;
+
+                                T *syn0word = syn0 + (bc[c] * vectorLength);
+
+                                #pragma omp simd
+                                for (int i = 0; i < vectorLength; i++)
+                                    hb[i] += syn0word[i];
+
+                                actualContext++;
+                            }
+
+                            if (actualContext > 1) {
+                                #pragma omp simd
+                                for (int i = 0; i < vectorLength; i++)
+                                    hb[i] /= actualContext;
+                            }
+
+                            alphas[b] = lr.e<double>(first + b);
+                        }
+
+                        for (int b = 0; b < batchSize && numIndices > 0; b++) {
+                            for (int i = 0; i < numIndices; i++) {
+                                const int cIndex = bIndices[((first + b) * numIndices) + i];
+                                const int cCode = bCodes[((first + b) * numIndices) + i];
+
+                                // we're skipping padded values
+                                if (cIndex < 0)
+                                    continue;
+
+                                hSoftmax_<T>(h.data() + b * vectorLength, syn1 + (cIndex * vectorLength), expTable, neu1e.data() + b * vectorLength, alphas[b], vectorLength, cCode, expLength, false);
+                            }
+                        }
+
+                        if (useNS) {
+                            unsigned long long randomValue = nextRandom.e<Nd4jLong>(first);
+                            for (int r = 0; r < numNegatives; r++)
+                                negatives[r] = nextNegative<T>(randomValue, negTable, negLength, vocabSize);
+
+                            for (int b = 0; b < batchSize; b++)
+                                positives[b] = bStarters[first + b];
+
+                            nSamplingBatch_<T>(h.data(), neu1e.data(), batchSize, positives.data(), alphas.data(), negatives.data(), numNegatives, syn1Neg, expTable, vectorLength, expLength, scratch.data());
+                        }
+
+                        for (int b = 0; b < batchSize; b++) {
+                            auto bc = bContext + (first + b) * contextWidth;
+                            auto eb = neu1e.data() + b * vectorLength;
+
+                            // if we're skipping labels
+                            auto numLabels = nLabels.isEmpty() ? 0 : nLabels.e<int>(first + b);
+                            int starter = trainWords == 1 ? 0 : contextWidth - numLabels;
+
+                            for (int c = starter; c < contextWidth; c++) {
+                                if (bc[c] < 0)
+                                    continue;
+
+                                T *syn0word = syn0 + (bc[c] * vectorLength);
+
+                                #pragma omp simd
+                                for (int i = 0; i < vectorLength; i++)
+                                    syn0word[i] += eb[i];
+                            }
+                        }
+                    }
+                }
+            }
+
             template <typename T>
             static void do_update(const int target, const int rowIndex, const int count, T *syn0, T *neu1t, const int vectorLength) {
 
@@ -349,7 +671,7 @@ namespace nd4j {
             }
 
             template <typename T>
-            void skipgramBatchExec_(NDArray &s0, NDArray &s1, NDArray &s1n, void *vexpTable, void *vnegTable, void *vinfVector, NDArray &targets, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, const int nsRounds, const int vocabSize, const int vectorLength, const int expLength, const int negLength, const bool preciseMode, const int numThreads) {
+            void skipgramBatchExec_(NDArray &s0, NDArray &s1, NDArray &s1n, void *vexpTable, void *vnegTable, void *vinfVector, NDArray &targets, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, const int nsRounds, const int vocabSize, const int vectorLength, const int expLength, const int negLength, const bool preciseMode, const int numThreads, const int minibatchSize) {
                 //auto syn0 = reinterpret_cast<T*>(vsyn0);
                 //auto syn1 = reinterpret_cast<T*>(vsyn1);
                 //auto syn1Neg = reinterpret_cast<T*>(vsyn1Neg);
@@ -357,6 +679,11 @@ namespace nd4j {
                 const auto negTable = reinterpret_cast<T*>(vnegTable);
                 const auto infVector = reinterpret_cast<T*>(vinfVector);
 
+                if (minibatchSize > 1) {
+                    skipgramMinibatch_<T>(s0, s1, s1n, expTable, negTable, targets, negStarters, indices, codes, lr, nextRandom, nsRounds, vocabSize, vectorLength, expLength, negLength, minibatchSize, numThreads);
+                    return;
+                }
+
                 T sneu1e[600];
 
                 //const auto numThreads = omp_get_max_threads();
@@ -430,11 +757,11 @@ namespace nd4j {
                             delete[] neu1e;
                     }
             }
-            BUILD_SINGLE_TEMPLATE(template void skipgramBatchExec_, (NDArray &s0, NDArray &s1, NDArray &s1n, void *vexpTable, void *vnegTable, void *vinfVector, NDArray &targets, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, const int nsRounds, const int vocabSize, const int vectorLength, const int expLength, const int negLength, const bool preciseMode, const int numThreads), FLOAT_TYPES);
+            BUILD_SINGLE_TEMPLATE(template void skipgramBatchExec_, (NDArray &s0, NDArray &s1, NDArray &s1n, void *vexpTable, void *vnegTable, void *vinfVector, NDArray &targets, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, const int nsRounds, const int vocabSize, const int vectorLength, const int expLength, const int negLength, const bool preciseMode, const int numThreads, const int minibatchSize), FLOAT_TYPES);
 
 
             template <typename T>
-            void cbowBatchExec_(NDArray &s0, NDArray &s1, NDArray &s1n, void *vexpTable, void *vnegTable, void *vinfVector, NDArray &context, NDArray &targets, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, NDArray &nLabels, const int nsRounds, const int vocabSize, const int vectorLength, const int expLength, const int negLength, const bool trainWords, const int numThreads) {
+            void cbowBatchExec_(NDArray &s0, NDArray &s1, NDArray &s1n, void *vexpTable, void *vnegTable, void *vinfVector, NDArray &context, NDArray &targets, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, NDArray &nLabels, const int nsRounds, const int vocabSize, const int vectorLength, const int expLength, const int negLength, const bool trainWords, const int numThreads, const int minibatchSize) {
                 const auto syn0 = s0.bufferAsT<T>();
                 const auto syn1 = s1.bufferAsT<T>();
                 const auto syn1Neg = s1n.bufferAsT<T>();
@@ -443,6 +770,11 @@ namespace nd4j {
                 const auto negTable = reinterpret_cast<T*>(vnegTable);
                 const auto infVector = reinterpret_cast<T*>(vinfVector);
 
+                if (minibatchSize > 1) {
+                    cbowMinibatch_<T>(s0, s1, s1n, expTable, negTable, context, negStarters, indices, codes, lr, nextRandom, nLabels, nsRounds, vocabSize, vectorLength, expLength, negLength, trainWords, minibatchSize, numThreads);
+                    return;
+                }
+
 
                 T sneu1[600];
                 T sneu1e[600];
@@ -571,9 +903,9 @@ namespace nd4j {
                     }
                 }
             }
-            BUILD_SINGLE_TEMPLATE(template void cbowBatchExec_, (NDArray &s0, NDArray &s1, NDArray &s1n, void *vexpTable, void *vnegTable, void *vinfVector, NDArray &context, NDArray &targets, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, NDArray &nLabels, const int nsRounds, const int vocabSize, const int vectorLength, const int expLength, const int negLength,  const bool trainWords, const int numThreads), FLOAT_TYPES);
+            BUILD_SINGLE_TEMPLATE(template void cbowBatchExec_, (NDArray &s0, NDArray &s1, NDArray &s1n, void *vexpTable, void *vnegTable, void *vinfVector, NDArray &context, NDArray &targets, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, NDArray &nLabels, const int nsRounds, const int vocabSize, const int vectorLength, const int expLength, const int negLength,  const bool trainWords, const int numThreads, const int minibatchSize), FLOAT_TYPES);
 
-            void skipgram(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, NDArray &target, NDArray &ngStarter, int nsRounds, NDArray &indices, NDArray &codes, NDArray &alpha, NDArray &randomValue, NDArray &inferenceVector, const bool preciseMode, const int numWorkers) {
+            void skipgram(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, NDArray &target, NDArray &ngStarter, int nsRounds, NDArray &indices, NDArray &codes, NDArray &alpha, NDArray &randomValue, NDArray &inferenceVector, const bool preciseMode, const int numWorkers, const int minibatchSize) {
                 auto xType = syn0.dataType();
 
                 // single round case
@@ -584,12 +916,12 @@ namespace nd4j {
                 } else if (ngStarter.isVector() || target.isVector()){
                     // batch mode
 
-                    BUILD_SINGLE_SELECTOR(xType, skipgramBatchExec_, (syn0, syn1, syn1Neg, expTable.buffer(), negTable.buffer(), nullptr, target, ngStarter, indices, codes, alpha, randomValue, nsRounds, syn0.sizeAt(0), syn0.sizeAt(1), expTable.lengthOf(), negTable.lengthOf(), preciseMode, numWorkers), FLOAT_TYPES);
+                    BUILD_SINGLE_SELECTOR(xType, skipgramBatchExec_, (syn0, syn1, syn1Neg, expTable.buffer(), negTable.buffer(), nullptr, target, ngStarter, indices, codes, alpha, randomValue, nsRounds, syn0.sizeAt(0), syn0.sizeAt(1), expTable.lengthOf(), negTable.lengthOf(), preciseMode, numWorkers, minibatchSize), FLOAT_TYPES);
                 } else
                     throw std::runtime_error("SkipGram: target must have rank 0 or 1");
             }
 
-            void cbow(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, NDArray &target, NDArray &ngStarter, int nsRounds, NDArray &context, NDArray &indices, NDArray &codes, NDArray &alpha, NDArray &randomValue, NDArray &numLabels, NDArray &inferenceVector, const bool trainWords, int numWorkers) {
+            void cbow(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, NDArray &target, NDArray &ngStarter, int nsRounds, NDArray &context, NDArray &indices, NDArray &codes, NDArray &alpha, NDArray &randomValue, NDArray &numLabels, NDArray &inferenceVector, const bool trainWords, int numWorkers, const int minibatchSize) {
                 auto xType = syn0.dataType();
 
                 // single round case
@@ -600,7 +932,7 @@ namespace nd4j {
                 } else if (context.isMatrix()) {
                     // batch mode
 
-                    BUILD_SINGLE_SELECTOR(xType, cbowBatchExec_, (syn0, syn1, syn1Neg, expTable.buffer(), negTable.buffer(), nullptr, context, target, ngStarter, indices, codes, alpha, randomValue, numLabels, nsRounds, syn0.sizeAt(0), syn0.sizeAt(1), expTable.lengthOf(), negTable.isEmpty() ? 0 : negTable.lengthOf(), trainWords, numWorkers), FLOAT_TYPES);
+                    BUILD_SINGLE_SELECTOR(xType, cbowBatchExec_, (syn0, syn1, syn1Neg, expTable.buffer(), negTable.buffer(), nullptr, context, target, ngStarter, indices, codes, alpha, randomValue, numLabels, nsRounds, syn0.sizeAt(0), syn0.sizeAt(1), expTable.lengthOf(), negTable.isEmpty() ? 0 : negTable.lengthOf(), trainWords, numWorkers, minibatchSize), FLOAT_TYPES);
                 } else
                     throw std::runtime_error("CBOW: context must have rank 0/1 or 2");
             }
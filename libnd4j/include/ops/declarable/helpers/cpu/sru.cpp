@@ -22,6 +22,8 @@
 
 #include<ops/declarable/helpers/sru.h>
 #include <NDArrayFactory.h>
+#include <helpers/MmulHelper.h>
+#include <memory>
 
 namespace nd4j    {
 namespace ops     {
@@ -146,6 +148,72 @@ void sruCell(const NDArray* x, const NDArray* c0, const NDArray* w, const NDArra
 //     dLdX->assign((*dLdH) * (oneMinusR + dHdR * (*w)({{},{2*inSize, 3*inSize}}) + dHdC * dCdX) + (*dLdC) * dCdX);   
 // }
 
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void sruTimeLoop_(const NDArray* x, const NDArray* c0, const NDArray* w, const NDArray* b, NDArray* h, NDArray* c) {
+
+    const Nd4jLong bS     = x->sizeAt(0);
+    const Nd4jLong inSize = x->sizeAt(1);
+    const Nd4jLong time   = x->sizeAt(2);
+
+    // SRU has no recurrent matmul, so input projection for all time steps is done by single gemm: [time*bS x inSize] * [inSize x 3*inSize]
+    std::unique_ptr<NDArray> xP(x->permute({2, 0, 1}));                                    // [time x bS x inSize]
+    std::unique_ptr<NDArray> xFlat(xP->dup('c'));
+    xFlat->reshapei('c', {time * bS, inSize});
+
+    std::unique_ptr<NDArray> wT(w->transpose());                                            // [3*inSize x inSize] -> [inSize x 3*inSize]
+
+    NDArray wi('f', {time * bS, 3 * inSize}, x->dataType(), x->getWorkspace());
+    MmulHelper::mmul(xFlat.get(), wT.get(), &wi, 1.0, 0.0);
+
+    std::unique_ptr<NDArray> bC(b->ews() == 1 ? nullptr : const_cast<NDArray*>(b)->dup('c'));
+
+    const T* pWi   = wi.bufferAsT<T>();
+    const T* pBias = (bC ? bC.get() : b)->bufferAsT<T>();
+    const T* pX    = x->bufferAsT<T>();
+    const T* pInit = c0->bufferAsT<T>();
+    T* pHt = h->bufferAsT<T>();
+    T* pCt = c->bufferAsT<T>();
+
+    const Nd4jLong ldWi = time * bS;
+    const auto xStride  = x->stridesOf();
+    const auto iStride  = c0->stridesOf();
+    const auto hStride  = h->stridesOf();
+    const auto cStride  = c->stridesOf();
+
+    // each feature of each batch entry is independent recurrence over time, so whole time loop is fused into single pass
+    #pragma omp parallel for collapse(2) if(bS * inSize > Environment::getInstance()->elementwiseThreshold()) schedule(static)
+    for (Nd4jLong e = 0; e < bS; ++e) {
+        for (Nd4jLong k = 0; k < inSize; ++k) {
+
+            const T bF = pBias[k];
+            const T bR = pBias[inSize + k];
+
+            const T* zc = pWi + k * ldWi + e;
+            const T* zf = pWi + (inSize + k) * ldWi + e;
+            const T* zr = pWi + (2*inSize + k) * ldWi + e;
+
+            T cur = pInit[e * iStride[0] + k * iStride[1]];
+
+            for (Nd4jLong t = 0; t < time; ++t) {
+                const auto offset = t * bS;
+
+                // forget gate = sigmoid(x*Wf + bf), reset gate = sigmoid(x*Wr + br)
+                const T ft = nd4j::math::nd4j_sigmoid<T,T>(zf[offset] + bF);
+                const T rt = nd4j::math::nd4j_sigmoid<T,T>(zr[offset] + bR);
+
+                // current sell state = f◦c0 + (1 - f)◦(x*Wc)
+                cur = ft * cur + ((T) 1.f - ft) * zc[offset];
+
+                // current cell output = r◦activation(c) + (1 - r)◦x
+                const T xt = pX[e * xStride[0] + k * xStride[1] + t * xStride[2]];
+                pHt[e * hStride[0] + k * hStride[1] + t * hStride[2]] = rt * nd4j::math::nd4j_tanh<T,T>(cur) + ((T) 1.f - rt) * xt;
+                pCt[e * cStride[0] + k * cStride[1] + t * cStride[2]] = cur;
+            }
+        }
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 void sruTimeLoop(const NDArray* x, const NDArray* c0, const NDArray* w, const NDArray* b, NDArray* h, NDArray* c) {
     
@@ -157,26 +225,11 @@ void sruTimeLoop(const NDArray* x, const NDArray* c0, const NDArray* w, const ND
     // h   cell outputs [bS x inSize x time]
     // c   cell states  [bS x inSize x time]
 
-    w = w->transpose();                             // [3*inSize x inSize] -> [inSize x 3*inSize] 
-
-    const int time  = x->sizeAt(2);
-
-    NDArray ct_1(*c0);
-
-    // loop through time steps
-    for (int t = 0; t < time; ++t) {
-
-        auto xt = (*x)({0,0, 0,0, t,t+1});
-        auto ht = (*h)({0,0, 0,0, t,t+1});
-        auto ct = (*c)({0,0, 0,0, t,t+1});
-
-        helpers::sruCell(&xt, &ct_1, w, b,  &ht, &ct);
-        ct_1.assign(ct);
-    }    
-
-    delete w;
+    BUILD_SINGLE_SELECTOR(x->dataType(), sruTimeLoop_, (x, c0, w, b, h, c), FLOAT_TYPES);
 }
 
+BUILD_SINGLE_TEMPLATE(template void sruTimeLoop_, (const NDArray* x, const NDArray* c0, const NDArray* w, const NDArray* b, NDArray* h, NDArray* c), FLOAT_TYPES);
+
 //////////////////////////////////////////////////////////////////////////
 template <typename T>
 static void sruBI_(NDArray* x, const NDArray* w, const NDArray* b, const NDArray* c0, const NDArray* mask, NDArray* ht, NDArray* ct) {
@@ -20,174 +20,189 @@
 
 #include <ops/declarable/helpers/top_k.h>
 #include <ops/declarable/headers/parity_ops.h>
-#include <NDArrayFactory.h>
+#include <helpers/ConstantTadHelper.h>
+#include <OmpLaunchHelper.h>
+#include <algorithm>
+#include <vector>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    // k below width / TOPK_HEAP_RATIO is selected via bounded heap, bigger k via introselect over the whole row
+#define TOPK_HEAP_RATIO 8
+
+    /**
+     * Row element ordering used by top_k and in_top_k: bigger value goes first, and for equal values lower index goes first
+     */
     template <typename T>
-    static int topKFunctor_(NDArray* input, NDArray* values, NDArray* indeces, int k, bool needSort) {
-        Nd4jLong width = input->sizeAt(-1);
-//        Nd4jLong lastDim = input->rankOf() - 1;
-//      FIX ME: lastDim should be Nd4Long not int only?
-        int lastDim = input->rankOf() - 1;
-//        std::unique_ptr<ResultSet> lastDimList(input->allTensorsAlongDimension({lastDim}));
-// ----------------------------------------------------------------------------------------------- //
-// this assumption is right:
-//        if (values->lengthOf() != k * lastDimList->size()) {
-//            nd4j_printf("top_k: something is wrong. %i expected, but %i given.\n",
-//                values->lengthOf(), k * lastDimList->size());
-//        }
-// ----------------------------------------------------------------------------------------------- //
-        std::vector<int> dimsToExclude(input->rankOf() - 1);
-        for (int d = 0; d < dimsToExclude.size(); ++d)
-            dimsToExclude[d] = d;
-
-        const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(input->getShapeInfo(), dimsToExclude);
-
-            if (k == 1) {
-                int pos = 0;
-//#pragma omp parallel for if(numOfSubArrs > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-                for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
-                    auto trial = (*input)(e, dimsToExclude);
-                    //int maxPos = //lastDimList->at(e)->argMax();
-                    Nd4jLong maxPos = 0;
-                    //trial.printIndexedBuffer("TRIAL:");
-                    T maxVal = trial.e<T>(0);
-                    for (Nd4jLong pos = 1; pos < trial.lengthOf(); pos++)
-                        if (maxVal < trial.e<T>(pos)) {
-                            maxPos = pos;
-                            maxVal = trial.e<T>(pos);
-                        }
-                    if (indeces)
-                        indeces->p(e, maxPos); //topIndex;
-                    if (values)
-                        values->p(e, maxVal);
+    struct TopKGreater {
+        FORCEINLINE bool operator()(const std::pair<T, Nd4jLong> &a, const std::pair<T, Nd4jLong> &b) const {
+            return a.first > b.first || (a.first == b.first && a.second < b.second);
+        }
+    };
+
+    /**
+     * This method selects top k elements of row x of given length and stride into first k entries of scratch.
+     * scratch must be able to hold width elements, it's never reallocated here.
+     * Selected entries are sorted by value (descending) if needSort is true, or by index otherwise
+     */
+    template <typename T>
+    static void topKRow(const T *x, Nd4jLong stride, Nd4jLong width, int k, bool needSort, std::vector<std::pair<T, Nd4jLong>> &scratch) {
+        TopKGreater<T> greater;
+        // raw pointers keep offsets below free of iterator overloads, ambiguous for float16 and bfloat16 pairs
+        auto begin = scratch.data();
+
+        if (k == 1) {
+            Nd4jLong maxPos = 0;
+            T maxVal = x[0];
+            for (Nd4jLong e = 1; e < width; e++) {
+                T v = x[e * stride];
+                if (maxVal < v) {
+                    maxVal = v;
+                    maxPos = e;
                 }
             }
-            else { 
-                int nextPos = 0;
-
-//#pragma omp parallel for if(lastDimList->size() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-                for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
-                    auto trial = (*input)(e, dimsToExclude);
-
-                    //auto trialTo = lastDimList->at(e); // a vector to be search
-                    //nd4j_printf("%i: ", e);
-                    //trial.printIndexedBuffer("TRIAL:");
-                    //trialTo->printIndexedBuffer("TOTRI:");
-                    //std::vector<Nd4jLong> topIndices(k);
-                    //std::vector<T> topValues(k);
-
-                    // fill up the first k elements
-                    NDArray topValues = NDArrayFactory::create<T>('c', {k});
-                    NDArray sortedVals = NDArrayFactory::create<T>('c', {k});
-                    NDArray topIndices = NDArrayFactory::create<Nd4jLong>('c', {k});
-                    for (Nd4jLong pos = 0; pos < k; ++pos) {
-                        topIndices.t<Nd4jLong>(pos) = pos;
-                        topValues.t<T>(pos) = trial.t<T>(pos);
-                    }
-                    //std::vector<T> sortedVals(topValues);
-                    sortedVals.assign(topValues);// = NDArrayFactory::create<T>('c', {k});
-                    //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-                    SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
-                    for (int i = k; i < width; ++i) {
-                        T val = trial.e<T>(i);
-                        T minTopVal = sortedVals.t<T>(0);
-                        if (minTopVal < val) { // value should be inserted to top k
-                            // only if it is not contained in
-                            T* begin = reinterpret_cast<T*>(sortedVals.buffer());
-                            T* end = begin + k;
-                            bool exists = std::binary_search(begin, end, val);
-                            if (!exists) {
-                                //exchangePos - a distance between begin and minimal existed to be suppressed by val
-                                T* topBegin = reinterpret_cast<T*>(topValues.buffer());
-                                T* topEnd = topBegin + k;
-                                auto exchangePos = std::distance(topBegin, std::find(topBegin, topEnd, sortedVals.t<T>(0)));
-                                topValues.t<T>(exchangePos) = val; //*exchangeIt = val;
-                                topIndices.t<Nd4jLong>(exchangePos) = i;
-                                sortedVals.t<T>(0) = val; // suppress in sorted
-                                //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-                                SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
-                            }
-                        }
-                    }
-                    if (needSort) {
-                        SpecialMethods<T>::sortGeneric(topValues.buffer(), topValues.shapeInfo(), true);
-
-                        for (int j = 0; j < width; j++)
-                            for (int pos = 0; pos < k; ++pos)
-                                if (topValues.t<T>(pos) == trial.t<T>(j))
-                                    topIndices.t<Nd4jLong>(pos) = j;
-                    }
-                    else { // else sort by indices
-                        std::map<Nd4jLong, T> sortValsMap;
-                        //std::vector<std::pair<int, T>> data(topValues.lengthOf());
-                        for (size_t e = 0; e < topValues.lengthOf(); ++e) {
-                            sortValsMap[topIndices.t<Nd4jLong>(e)] = topValues.t<T>(e);
-                        }
-
-                        //std::sort(data.begin(), data.end(), [](std::pair<int, T> const& a, std::pair<int, T> const& b) {
-                        //    return a.first < b.first;
-                        //});
-                        Nd4jLong e = 0;
-                        for (auto it = sortValsMap.begin(); it != sortValsMap.end(); ++it, e++) {
-                            topIndices.t<Nd4jLong>(e) = it->first;
-                            topValues.t<T>(e) = it->second;
-                        }
-
-                    }
-                    if (values)
-                    (*values)(e, dimsToExclude).assign(topValues);
-                    if (indeces)
-                    (*indeces)(e, dimsToExclude).assign(topIndices);
+
+            scratch[0] = std::make_pair(maxVal, maxPos);
+            return;
+        }
+
+        if (k * TOPK_HEAP_RATIO <= width) {
+            // heap root is the worst of current top k, so each candidate costs single comparison unless it gets in
+            for (Nd4jLong e = 0; e < k; e++)
+                scratch[e] = std::make_pair(x[e * stride], e);
+
+            std::make_heap(begin, begin + k, greater);
+
+            for (Nd4jLong e = k; e < width; e++) {
+                auto candidate = std::make_pair(x[e * stride], e);
+                if (greater(candidate, scratch[0])) {
+                    std::pop_heap(begin, begin + k, greater);
+                    scratch[k - 1] = candidate;
+                    std::push_heap(begin, begin + k, greater);
                 }
-                //indeces->printIndexedBuffer("Indices as is");
+            }
+        } else {
+            for (Nd4jLong e = 0; e < width; e++)
+                scratch[e] = std::make_pair(x[e * stride], e);
+
+            if (k < width)
+                std::nth_element(begin, begin + k - 1, begin + width, greater);
         }
+
+        if (needSort)
+            std::sort(begin, begin + k, greater);
+        else
+            std::sort(begin, begin + k, [] (const std::pair<T, Nd4jLong> &a, const std::pair<T, Nd4jLong> &b) -> bool { return a.second < b.second; });
+    }
+
+    template <typename T, typename I>
+    static int topKFunctor_(NDArray* input, NDArray* values, NDArray* indeces, int k, bool needSort) {
+        const int lastDim = input->rankOf() - 1;
+        const Nd4jLong width = input->sizeAt(-1);
+
+        // all arrays are walked as TADs along last dimension: input rows and output rows always match by TAD index
+        auto inPack = ConstantTadHelper::getInstance()->tadForDimensions(input->shapeInfo(), {lastDim});
+        auto numRows = inPack->numberOfTads();
+        auto inOffsets = inPack->primaryOffsets();
+        auto inStride = input->stridesOf()[lastDim];
+        auto x = reinterpret_cast<T *>(input->buffer());
+
+        std::shared_ptr<TadPack> valPack, idxPack;
+        if (values != nullptr)
+            valPack = ConstantTadHelper::getInstance()->tadForDimensions(values->shapeInfo(), {lastDim});
+        if (indeces != nullptr)
+            idxPack = ConstantTadHelper::getInstance()->tadForDimensions(indeces->shapeInfo(), {lastDim});
+
+        auto valStride = values != nullptr ? values->stridesOf()[lastDim] : 0;
+        auto idxStride = indeces != nullptr ? indeces->stridesOf()[lastDim] : 0;
+        auto v = values != nullptr ? reinterpret_cast<T *>(values->buffer()) : nullptr;
+        auto z = indeces != nullptr ? reinterpret_cast<I *>(indeces->buffer()) : nullptr;
+
+        int numThreads = nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(OmpLaunchHelper::betterThreads(numRows * width), numRows));
+
+#pragma omp parallel num_threads(numThreads) if (numThreads > 1) default(shared)
+        {
+            // scratch is allocated once per thread and reused for all its rows
+            std::vector<std::pair<T, Nd4jLong>> scratch(k * TOPK_HEAP_RATIO <= width ? k : width);
+
+#pragma omp for schedule(static)
+            for (Nd4jLong r = 0; r < numRows; r++) {
+                topKRow<T>(x + inOffsets[r], inStride, width, k, needSort, scratch);
+
+                if (v != nullptr) {
+                    auto vr = v + valPack->primaryOffsets()[r];
+                    for (int e = 0; e < k; e++)
+                        vr[e * valStride] = scratch[e].first;
+                }
+
+                if (z != nullptr) {
+                    auto zr = z + idxPack->primaryOffsets()[r];
+                    for (int e = 0; e < k; e++)
+                        zr[e * idxStride] = static_cast<I>(scratch[e].second);
+                }
+            }
+        }
+
         return Status::OK();
     }
 // ----------------------------------------------------------------------------------------------- //
 
     template <typename T>
     static int inTopKFunctor_(NDArray* input, NDArray* target, NDArray* result, int k) {
+        const int lastDim = input->rankOf() - 1;
+        const Nd4jLong width = input->sizeAt(-1);
+
+        auto inPack = ConstantTadHelper::getInstance()->tadForDimensions(input->shapeInfo(), {lastDim});
+        auto numRows = inPack->numberOfTads();
+        auto inOffsets = inPack->primaryOffsets();
+        auto inStride = input->stridesOf()[lastDim];
+        auto x = reinterpret_cast<T *>(input->buffer());
+
+        // whole row is selected, so every valid target is within top k
+        if (k >= width) {
+            for (Nd4jLong r = 0; r < numRows; r++) {
+                auto t = target->e<Nd4jLong>(r);
+                result->p<bool>(r, t >= 0 && t < width);
+            }
 
-            std::vector<Nd4jLong> shapeI(input->rankOf());
-            for (int i = 0; i < input->rankOf() - 1; i++)
-                shapeI[i] = input->sizeAt(i);
-            shapeI[input->rankOf() - 1] = k;
-            std::unique_ptr<NDArray> indices(NDArrayFactory::create_<Nd4jLong>(input->ordering(), shapeI));
-            NDArray* values = nullptr;
-            int status = topKFunctor(input, values, indices.get(), k, true);
-
-            if (status == ND4J_STATUS_OK) {
-#pragma omp parallel for if(target->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-                for (int e = 0; e < target->lengthOf(); e++) {
-                    bool found = false;
-                    for (int j = 0; j < k; j++) {
-                        if (target->e<Nd4jLong>(e) == indices->e<Nd4jLong>(e * k + j)) {
-                            found = true;
-                            break;
-                        }
-                    }
-                    if (found)
-                        result->p<bool>(e, true);
-                }
+            return Status::OK();
+        }
+
+        int numThreads = nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(OmpLaunchHelper::betterThreads(numRows * width), numRows));
+
+#pragma omp parallel num_threads(numThreads) if (numThreads > 1) default(shared)
+        {
+            std::vector<std::pair<T, Nd4jLong>> scratch(k * TOPK_HEAP_RATIO <= width ? k : width);
+
+#pragma omp for schedule(static)
+            for (Nd4jLong r = 0; r < numRows; r++) {
+                // indices order doesn't matter here, so selected entries are left sorted by index
+                topKRow<T>(x + inOffsets[r], inStride, width, k, false, scratch);
+
+                auto t = target->e<Nd4jLong>(r);
+                bool found = false;
+                for (int e = 0; e < k && !found; e++)
+                    found = scratch[e].second == t;
+
+                result->p<bool>(r, found);
             }
-            return status; 
+        }
 
+        return Status::OK();
     }
 
         int topKFunctor(NDArray* input, NDArray* values, NDArray* indeces, int k, bool needSort) {
-            BUILD_SINGLE_SELECTOR(input->dataType(), return topKFunctor_, (input, values, indeces, k, needSort), NUMERIC_TYPES);
+            BUILD_DOUBLE_SELECTOR(input->dataType(), indeces != nullptr ? indeces->dataType() : nd4j::DataType::INT64, return topKFunctor_, (input, values, indeces, k, needSort), NUMERIC_TYPES, INTEGER_TYPES);
         }
 
         int inTopKFunctor(NDArray* input, NDArray* target, NDArray* result, int k) {
             BUILD_SINGLE_SELECTOR(input->dataType(), return inTopKFunctor_, (input, target, result, k), NUMERIC_TYPES);
         }
 
-        BUILD_SINGLE_TEMPLATE(template int topKFunctor_, (NDArray* input, NDArray* values, NDArray* indeces, int k, bool needSort), NUMERIC_TYPES);
+        BUILD_DOUBLE_TEMPLATE(template int topKFunctor_, (NDArray* input, NDArray* values, NDArray* indeces, int k, bool needSort), NUMERIC_TYPES, INTEGER_TYPES);
         BUILD_SINGLE_TEMPLATE(template int inTopKFunctor_, (NDArray* input, NDArray* target, NDArray* result, int k), NUMERIC_TYPES);
 }
 }
-}
\ No newline at end of file
+}
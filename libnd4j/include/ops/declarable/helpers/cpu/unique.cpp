@@ -19,7 +19,10 @@
 //
 
 #include <ops/declarable/helpers/unique.h>
+#include <ops/declarable/helpers/helpers.h>
 #include <Status.h>
+#include <helpers/HashUnique.h>
+#include <memory>
 
 namespace nd4j {
 namespace ops {
@@ -27,18 +30,11 @@ namespace helpers {
 
     template <typename T>
     static Nd4jLong uniqueCount_(NDArray* input) {
-        Nd4jLong count = 0;
+        std::unique_ptr<NDArray> holder;
+        auto x = contiguous(input, holder);
 
-        std::vector<T> values;
-
-        for (int e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(values.begin(), values.end(), v) == values.end()) {
-                values.push_back(v);
-                count++;
-            }
-        }
-        return count;
+        HashUnique<T> unique(x->bufferAsT<T>(), x->lengthOf(), false);
+        return unique.size();
     }
 
     Nd4jLong uniqueCount(NDArray* input) {
@@ -50,35 +46,40 @@ namespace helpers {
 
     template <typename T>
     static Nd4jStatus uniqueFunctor_(NDArray* input, NDArray* values, NDArray* indices, NDArray* counts) {
-    
-        std::vector<T> valuesVector;
-        std::map<T, int> indicesMap;
-        std::map<T, int> countsMap;
-
-        for (int e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(valuesVector.begin(), valuesVector.end(), v) == valuesVector.end()) {
-                valuesVector.push_back(v);
-                indicesMap[v] = e;
-                countsMap[v] = 1;
-            }
-            else {
-                countsMap[v]++;
-            }
-        }
-
-#pragma omp parallel for if(values->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-        for (int e = 0; e < values->lengthOf(); e++) {
-            values->p(e, static_cast<T>(valuesVector[e]));
-            if (counts != nullptr) 
-                counts->p(e, countsMap[valuesVector[e]]);
-        }
-
-//#pragma omp parallel for if(indices->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-        for (int e = 0; e < indices->lengthOf(); e++) {
-            auto posI = std::find(valuesVector.begin(), valuesVector.end(), input->e<T>(e));
-            auto dist = std::distance(valuesVector.begin(), posI);
-            indices->p(e, Nd4jLong(dist));//indicesMap[(*input)(e)];
+        std::unique_ptr<NDArray> holder;
+        auto x = contiguous(input, holder);
+        auto bx = x->bufferAsT<T>();
+        auto length = x->lengthOf();
+
+        HashUnique<T> unique(bx, length, true);
+
+        if (unique.size() != values->lengthOf())
+            throw std::runtime_error("unique: output/actual size mismatch");
+
+        const bool directValues = values->ews() == 1 && values->ordering() == 'c';
+        const bool directCounts = counts != nullptr && counts->dataType() == nd4j::DataType::INT64 && counts->ews() == 1 && counts->ordering() == 'c';
+
+        unique.forEach([&] (typename HashUnique<T>::Entry &entry) {
+            if (directValues)
+                values->bufferAsT<T>()[entry.position] = entry.key;
+            else
+                values->p(entry.position, entry.key);
+
+            if (directCounts)
+                counts->bufferAsT<Nd4jLong>()[entry.position] = entry.count;
+            else if (counts != nullptr)
+                counts->p(entry.position, entry.count);
+        });
+
+        const bool directIndices = indices->dataType() == nd4j::DataType::INT64 && indices->ews() == 1 && indices->ordering() == 'c';
+        auto numThreads = OmpLaunchHelper::betterThreads(length);
+
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(static)
+        for (Nd4jLong e = 0; e < length; e++) {
+            if (directIndices)
+                indices->bufferAsT<Nd4jLong>()[e] = unique.positionOf(bx[e]);
+            else
+                indices->p(e, unique.positionOf(bx[e]));
         }
 
         return Status::OK();
@@ -19,6 +19,9 @@
 //
 
 #include <ops/declarable/helpers/weights.h>
+#include <OmpLaunchHelper.h>
+#include <memory>
+#include <algorithm>
 
 namespace nd4j {
 namespace ops {
@@ -26,15 +29,49 @@ namespace helpers {
 
     template <typename T>
     static void adjustWeights_(NDArray* input, NDArray* weights, NDArray* output, int minLength, int maxLength) {
-            for (int e = 0; e < input->lengthOf(); e++) {
-                int val = input->e<int>(e);
-                if (val < maxLength) {
-                    if (weights != nullptr)
-                        output->p(val, output->e<T>(val) + weights->e<T>(e));
-                    else
-                        output->p(val, output->e<T>(val) + 1);
-                }
+        const auto length = input->lengthOf();
+        const auto numBins = nd4j::math::nd4j_min<Nd4jLong>(maxLength, output->lengthOf());
+        if (numBins <= 0)
+            return;
+
+        // every thread accumulates its own histogram, so total size of partial histograms is kept in check
+        int numThreads = OmpLaunchHelper::betterThreads(length);
+        numThreads = static_cast<int>(nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(numThreads, length / numBins)));
+
+        const bool directInput = input->dataType() == nd4j::DataType::INT32 && input->ews() == 1 && input->ordering() == 'c';
+        const bool directWeights = weights != nullptr && weights->dataType() == output->dataType() && weights->ews() == 1 && weights->ordering() == 'c';
+
+        auto span = OmpLaunchHelper::betterSpan(length, numThreads);
+        std::unique_ptr<T[]> partials(new T[numThreads * numBins]);
+        std::fill(partials.get(), partials.get() + numThreads * numBins, (T) 0.0f);
+
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(static)
+        for (int t = 0; t < numThreads; t++) {
+            auto start = nd4j::math::nd4j_min<Nd4jLong>(t * span, length);
+            auto stop = nd4j::math::nd4j_min<Nd4jLong>(start + span, length);
+            auto bins = partials.get() + t * numBins;
+
+            for (Nd4jLong e = start; e < stop; e++) {
+                int val = directInput ? input->bufferAsT<int>()[e] : input->e<int>(e);
+                if (val < 0 || val >= numBins)
+                    continue;
+
+                if (weights == nullptr)
+                    bins[val] += (T) 1.0f;
+                else
+                    bins[val] += directWeights ? weights->bufferAsT<T>()[e] : weights->e<T>(e);
             }
+        }
+
+        // partial histograms are combined in fixed order, so results don't depend on scheduling
+#pragma omp parallel for if (numBins > Environment::getInstance()->elementwiseThreshold()) schedule(static)
+        for (Nd4jLong b = 0; b < numBins; b++) {
+            T sum = output->e<T>(b);
+            for (int t = 0; t < numThreads; t++)
+                sum += partials[t * numBins + b];
+
+            output->p(b, sum);
+        }
     }
 
     void adjustWeights(NDArray* input, NDArray* weights, NDArray* output, int minLength, int maxLength) {
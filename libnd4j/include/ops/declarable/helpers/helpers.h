@@ -30,6 +30,7 @@
 #include <NDArray.h>
 #include <vector>
 #include <array>
+#include <memory>
 #include <Status.h>
 #include <NDArrayFactory.h>
 
@@ -42,4 +43,23 @@
 #include <stdlib.h>
 #endif // CUDACC
 
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    /**
+     * Returns input itself if it's c-ordered with unit element-wise stride, otherwise c-ordered copy of it,
+     * owned by holder, so helpers working on raw buffers don't need to care about strides
+     */
+    inline NDArray* contiguous(NDArray* input, std::unique_ptr<NDArray> &holder) {
+        if (input->ews() == 1 && input->ordering() == 'c')
+            return input;
+
+        holder.reset(input->dup('c'));
+        return holder.get();
+    }
+}
+}
+}
+
 #endif // LIBND4J_HELPERS_H
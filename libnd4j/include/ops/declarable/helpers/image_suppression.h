@@ -28,6 +28,13 @@ namespace helpers {
 
     void nonMaxSuppressionV2(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output);
 
+    /**
+     * This method applies NMS independently to each of batch entries: boxes [batch, num_boxes, 4], scales [batch, num_boxes],
+     * output [batch, max_size]. Batch dimension may be images, or classes for per-class suppression.
+     * Output slots left without selected box are set to -1
+     */
+    void nonMaxSuppressionBatched(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output);
+
 }
 }
 }
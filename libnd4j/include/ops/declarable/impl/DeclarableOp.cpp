@@ -168,8 +168,23 @@ namespace nd4j {
                     shapeStart = std::chrono::system_clock::now();
                 }
 
-                auto outSha = this->calculateOutputShape(&inSha, ctx);
-                results = outSha->size();
+                // shape function is skipped if inputs are the same as during previous execution of this node
+                auto memo = ctx.shapeMemo();
+                ShapeList *outSha = nullptr;
+                std::vector<Nd4jLong*> *outShapes = nullptr;
+
+                if (memo != nullptr && memo->match(this->getOpDescriptor()->isShapeMemoizable(), ctx, inSha)) {
+                    outShapes = memo->shapes();
+                } else {
+                    outSha = this->calculateOutputShape(&inSha, ctx);
+
+                    if (memo != nullptr)
+                        memo->update(*outSha);
+
+                    outShapes = outSha->asVector();
+                }
+
+                results = outShapes->size();
 
                 // optionally saving shapeTime
                 if (Environment::getInstance()->isProfiling() && node != nullptr) {
@@ -180,8 +195,11 @@ namespace nd4j {
                     arrayStart = std::chrono::system_clock::now();
                 }
 
+                // outputs might have precomputed place within arena
+                auto plan = ctx.getVariableSpace() != nullptr ? ctx.getVariableSpace()->memoryPlan() : nullptr;
+
                 int cnt = 0;
-                for (auto out: *outSha->asVector()) {
+                for (auto out: *outShapes) {
                     // we need to check, if Z is really needed
                     std::pair<int, int> pair(ctx.nodeId(), cnt++);
 
@@ -189,7 +207,9 @@ namespace nd4j {
                         if (Environment::getInstance()->isDebugAndVerbose())
                             shape::printShapeInfoLinear("Going to create variable with shape", out);
                         
-                        auto outArr = new NDArray(out, true, workspace);
+                        auto outArr = plan != nullptr ? plan->allocate(pair, out, workspace) : nullptr;
+                        if (outArr == nullptr)
+                            outArr = new NDArray(out, true, workspace);
 
                         ctx.pushNDArrayToVariableSpace(pair, outArr);
                     } else {
@@ -197,12 +217,21 @@ namespace nd4j {
                         auto var = ctx.variable(pair);
                         auto shape = var->getNDArray()->shapeInfo();
 
-                        if (!shape::equalsSoft(out, shape)) {
+                        // array left by previous run of this node (i.e. pooled session) is replaced if op produces shape that depends on values
+                        if (!shape::equalsSoft(out, shape) && var->isRemovable() && !var->isReadOnly() && !var->isExternal()) {
+                            auto outArr = plan != nullptr ? plan->allocate(pair, out, workspace) : nullptr;
+                            if (outArr == nullptr)
+                                outArr = new NDArray(out, true, workspace);
+
+                            ctx.pushNDArrayToVariableSpace(pair, outArr);
+                        } else if (!shape::equalsSoft(out, shape)) {
                             auto eShape = ShapeUtils::shapeAsString(out);
                             auto aShape = ShapeUtils::shapeAsString(shape);
 
-                            outSha->destroy();
-                            delete outSha;
+                            if (outSha != nullptr) {
+                                outSha->destroy();
+                                delete outSha;
+                            }
 
                             nd4j_printf("Expected vs provided shapes mismatch: %s vs %s\n", eShape.c_str(), aShape.c_str());
                             throw std::runtime_error("Expected vs provided shapes mismatch");
@@ -210,8 +239,10 @@ namespace nd4j {
                     }
                 }
 
-                outSha->destroy();
-                delete outSha;
+                if (outSha != nullptr) {
+                    outSha->destroy();
+                    delete outSha;
+                }
 
                 // saving arrayTime
                 if (Environment::getInstance()->isProfiling() && node != nullptr) {
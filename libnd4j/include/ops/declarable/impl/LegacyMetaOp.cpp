@@ -0,0 +1,266 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <ops/declarable/LegacyMetaOp.h>
+#include <helpers/ConstantShapeHelper.h>
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/OmpLaunchHelper.h>
+#include <NativeOpExcutioner.h>
+#include <NDArrayFactory.h>
+#include <op_enums.h>
+#include <Status.h>
+
+// number of elements processed by all stages before moving on to the next block
+#define META_BLOCK 8192
+
+namespace nd4j {
+    namespace ops {
+        LegacyMetaOp::LegacyMetaOp() : LegacyOp::LegacyOp(1) {
+            // just a no-op
+        }
+
+        LegacyMetaOp::LegacyMetaOp(const std::vector<Stage> &stages) : LegacyOp::LegacyOp(1) {
+            _stages = stages;
+
+            for (auto &s: _stages)
+                if (s.input >= _numInputs)
+                    _numInputs = s.input + 1;
+        }
+
+        LegacyOp* LegacyMetaOp::clone() {
+            return new LegacyMetaOp(_stages);
+        }
+
+        std::vector<LegacyMetaOp::Stage>* LegacyMetaOp::stages() {
+            return &_stages;
+        }
+
+        bool LegacyMetaOp::isFusable(nd4j::graph::OpType opType, int opNum) {
+            switch (opType) {
+                case nd4j::graph::OpType_TRANSFORM_SAME:
+                    return opNum != transform::Col2Im && opNum != transform::Im2col && opNum != transform::Reverse;
+                case nd4j::graph::OpType_TRANSFORM_STRICT:
+                    return opNum != transform::SoftMax && opNum != transform::SoftMaxDerivative && opNum != transform::LogSoftMax;
+                case nd4j::graph::OpType_TRANSFORM_FLOAT:
+                    return opNum != transform::Histogram && opNum != transform::Pooling2D;
+                case nd4j::graph::OpType_SCALAR:
+                case nd4j::graph::OpType_PAIRWISE:
+                case nd4j::graph::OpType_BROADCAST:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        /**
+        *   Output shape is always equal to input[0] shape: each stage keeps shape of its X operand
+        */
+        ShapeList *LegacyMetaOp::calculateOutputShape(ShapeList *inputShape, nd4j::graph::Context &block) {
+            auto inShape = inputShape->at(0);
+
+            Nd4jLong *newShape;
+            COPY_SHAPE(inShape, newShape);
+
+            return SHAPELIST(newShape);
+        }
+
+        void LegacyMetaOp::executeStage(const Stage &stage, void *x, Nd4jLong *xShapeInfo, void *z, Nd4jLong *zShapeInfo, void *y, Nd4jLong *yShapeInfo, TadPack *tadX, TadPack *tadZ) {
+            auto extras = const_cast<double *>(stage.extraParams.data());
+
+            switch (stage.opType) {
+                case nd4j::graph::OpType_TRANSFORM_SAME:
+                    NativeOpExcutioner::execTransformSame(stage.opNum, x, xShapeInfo, z, zShapeInfo, extras, nullptr, nullptr);
+                    break;
+                case nd4j::graph::OpType_TRANSFORM_FLOAT:
+                    NativeOpExcutioner::execTransformFloat(stage.opNum, x, xShapeInfo, z, zShapeInfo, extras, nullptr, nullptr);
+                    break;
+                case nd4j::graph::OpType_TRANSFORM_STRICT:
+                    NativeOpExcutioner::execTransformStrict(stage.opNum, x, xShapeInfo, z, zShapeInfo, extras, nullptr, nullptr);
+                    break;
+                case nd4j::graph::OpType_SCALAR:
+                    NativeOpExcutioner::execScalar(stage.opNum, x, xShapeInfo, z, zShapeInfo, y, yShapeInfo, extras);
+                    break;
+                case nd4j::graph::OpType_PAIRWISE:
+                    NativeOpExcutioner::execPairwiseTransform(stage.opNum, x, xShapeInfo, y, yShapeInfo, z, zShapeInfo, extras);
+                    break;
+                case nd4j::graph::OpType_BROADCAST: {
+                        auto dims = const_cast<int *>(stage.dimensions.data());
+                        NativeOpExcutioner::execBroadcast(stage.opNum, x, xShapeInfo, y, yShapeInfo, z, zShapeInfo, dims, (int) stage.dimensions.size(), tadX->primaryShapeInfo(), tadX->primaryOffsets(), tadZ->primaryShapeInfo(), tadZ->primaryOffsets());
+                    }
+                    break;
+                default:
+                    throw std::runtime_error("LegacyMetaOp: unsupported stage op type");
+            }
+        }
+
+        /**
+        *   Blocked execution requires plain c-order buffers, same-shaped pairwise operands, and broadcasts along last dimension only,
+        *   so any contiguous range of whole rows can be processed independently
+        */
+        bool LegacyMetaOp::canExecuteBlocked(NDArray *x, NDArray *z, std::vector<NDArray *> &operands) {
+            if (x->isEmpty() || x->ordering() != 'c' || x->ews() != 1 || z->ordering() != 'c' || z->ews() != 1)
+                return false;
+
+            if (x->dataType() != z->dataType() || x->lengthOf() != z->lengthOf() || x->rankOf() < 1)
+                return false;
+
+            for (int e = 0; e < (int) _stages.size(); e++) {
+                auto &s = _stages[e];
+                auto y = operands[e];
+
+                if (s.opType == nd4j::graph::OpType_PAIRWISE) {
+                    if (!y->isSameShape(x) || y->ordering() != 'c' || y->ews() != 1)
+                        return false;
+                } else if (s.opType == nd4j::graph::OpType_BROADCAST) {
+                    if (s.dimensions.size() != 1 || y->lengthOf() != x->sizeAt(-1) || y->ews() != 1)
+                        return false;
+
+                    auto dim = s.dimensions[0] < 0 ? s.dimensions[0] + x->rankOf() : s.dimensions[0];
+                    if (dim != x->rankOf() - 1)
+                        return false;
+                } else if (s.opType == nd4j::graph::OpType_SCALAR) {
+                    if (y->lengthOf() != 1)
+                        return false;
+                }
+            }
+
+            return true;
+        }
+
+        void LegacyMetaOp::executeBlocked(NDArray *x, NDArray *z, std::vector<NDArray *> &operands) {
+            const Nd4jLong length = x->lengthOf();
+            const int numStages = (int) _stages.size();
+
+            // within block broadcasts are always applied along dimension 1 of [rows, columns] block
+            std::vector<Stage> stages(_stages);
+            bool hasBroadcast = false;
+            for (auto &s: stages)
+                if (s.opType == nd4j::graph::OpType_BROADCAST) {
+                    s.dimensions = {1};
+                    hasBroadcast = true;
+                }
+
+            // with broadcast stages each block holds whole rows only
+            const Nd4jLong columns = hasBroadcast ? x->sizeAt(-1) : META_BLOCK;
+            const Nd4jLong rowsPerBlock = hasBroadcast ? nd4j::math::nd4j_max<Nd4jLong>(1, META_BLOCK / columns) : 1;
+            const Nd4jLong blockLength = rowsPerBlock * columns;
+            const Nd4jLong numBlocks = (length + blockLength - 1) / blockLength;
+            const Nd4jLong tailLength = length - (numBlocks - 1) * blockLength;
+
+            // shapes of full and tail blocks, plus per-stage operand shapes and TADs, are prepared in advance
+            Nd4jLong *blockShape[2];
+            std::vector<Nd4jLong *> yShapes[2];
+            std::vector<std::shared_ptr<TadPack>> tads[2];
+
+            for (int k = 0; k < 2; k++) {
+                auto len = k == 0 ? blockLength : tailLength;
+                std::vector<Nd4jLong> shape = {hasBroadcast ? len / columns : 1, hasBroadcast ? columns : len};
+
+                blockShape[k] = ConstantShapeHelper::getInstance()->createShapeInfo(x->dataType(), 'c', shape);
+                yShapes[k].resize(numStages, nullptr);
+                tads[k].resize(numStages);
+
+                for (int e = 0; e < numStages; e++) {
+                    auto &s = stages[e];
+                    if (s.opType == nd4j::graph::OpType_PAIRWISE)
+                        yShapes[k][e] = ConstantShapeHelper::getInstance()->createShapeInfo(operands[e]->dataType(), 'c', shape);
+                    else if (s.opType == nd4j::graph::OpType_BROADCAST)
+                        tads[k][e] = ConstantTadHelper::getInstance()->tadForDimensions(blockShape[k], s.dimensions);
+                }
+            }
+
+            int numThreads = nd4j::math::nd4j_min<Nd4jLong>(nd4j::OmpLaunchHelper::betterThreads(length), numBlocks);
+
+            #pragma omp parallel for schedule(static) num_threads(numThreads) if (numThreads > 1) default(shared)
+            for (Nd4jLong b = 0; b < numBlocks; b++) {
+                const int k = b == numBlocks - 1 && tailLength != blockLength ? 1 : 0;
+                const Nd4jLong offset = b * blockLength;
+
+                auto bz = z->bufferWithOffset(offset);
+
+                for (int e = 0; e < numStages; e++) {
+                    auto &s = stages[e];
+
+                    // first stage reads X, all others are applied to Z in place
+                    auto bx = e == 0 ? x->bufferWithOffset(offset) : bz;
+
+                    void *y = nullptr;
+                    Nd4jLong *yShapeInfo = nullptr;
+                    if (s.opType == nd4j::graph::OpType_PAIRWISE) {
+                        y = operands[e]->bufferWithOffset(offset);
+                        yShapeInfo = yShapes[k][e];
+                    } else if (operands[e] != nullptr) {
+                        y = operands[e]->buffer();
+                        yShapeInfo = operands[e]->shapeInfo();
+                    }
+
+                    executeStage(s, bx, blockShape[k], bz, blockShape[k], y, yShapeInfo, tads[k][e].get(), tads[k][e].get());
+                }
+            }
+        }
+
+        Nd4jStatus LegacyMetaOp::validateAndExecute(Context &block) {
+            auto x = INPUT_VARIABLE(0);
+            auto z = OUTPUT_VARIABLE(0);
+
+            REQUIRE_TRUE(!_stages.empty(), 0, "LegacyMetaOp: at least one stage is required");
+
+            // side operands are resolved once per call. scalar operands are created with data type of X
+            std::vector<NDArray> scalars(_stages.size());
+            std::vector<NDArray *> operands(_stages.size(), nullptr);
+            for (int e = 0; e < (int) _stages.size(); e++) {
+                auto &s = _stages[e];
+                if (s.input >= 0) {
+                    operands[e] = INPUT_VARIABLE(s.input);
+                } else if (s.opType == nd4j::graph::OpType_SCALAR) {
+                    scalars[e] = NDArrayFactory::create(x->dataType(), s.scalar, block.getWorkspace());
+                    operands[e] = &scalars[e];
+                }
+            }
+
+            if (canExecuteBlocked(x, z, operands)) {
+                executeBlocked(x, z, operands);
+            } else {
+                // generic layouts: stages are applied to whole arrays one by one, still without intermediate arrays
+                for (int e = 0; e < (int) _stages.size(); e++) {
+                    auto &s = _stages[e];
+                    auto in = e == 0 ? x : z;
+                    auto y = operands[e];
+
+                    std::shared_ptr<TadPack> tadX, tadZ;
+                    if (s.opType == nd4j::graph::OpType_PAIRWISE) {
+                        REQUIRE_TRUE(in->isSameShape(y) || y->isScalar(), 0, "LegacyMetaOp: for Pairwise stages shapes of both operands should be equal");
+                    } else if (s.opType == nd4j::graph::OpType_BROADCAST) {
+                        tadX = ConstantTadHelper::getInstance()->tadForDimensions(in->shapeInfo(), s.dimensions);
+                        tadZ = in == z ? tadX : ConstantTadHelper::getInstance()->tadForDimensions(z->shapeInfo(), s.dimensions);
+
+                        REQUIRE_TRUE(shape::length(tadX->primaryShapeInfo()) == y->lengthOf(), 0, "LegacyMetaOp: length of broadcast TAD should be equal to length of Y operand, but got [%i] vs [%i]", (int) shape::length(tadX->primaryShapeInfo()), (int) y->lengthOf());
+                    }
+
+                    executeStage(s, in->buffer(), in->shapeInfo(), z->buffer(), z->shapeInfo(), y != nullptr ? y->buffer() : nullptr, y != nullptr ? y->shapeInfo() : nullptr, tadX.get(), tadZ.get());
+                }
+            }
+
+            STORE_RESULT(*z);
+
+            return Status::OK();
+        }
+    }
+}
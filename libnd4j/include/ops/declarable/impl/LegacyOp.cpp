@@ -25,11 +25,17 @@ namespace nd4j {
     namespace ops {
         LegacyOp::LegacyOp(int numInputs) : DeclarableOp::DeclarableOp(numInputs , 1, "LegacyOp", true) {
             _numInputs = numInputs;
+
+            // shapes of legacy ops are defined by input shapes and dimensions
+            _descriptor->setShapeMemoizable(true);
         }
 
         LegacyOp::LegacyOp(int numInputs, int opNum) : DeclarableOp::DeclarableOp(numInputs , 1, "LegacyOp", true) {
             _opNum = opNum;
             _numInputs = numInputs;
+
+            // shapes of legacy ops are defined by input shapes and dimensions
+            _descriptor->setShapeMemoizable(true);
         }
     }
 }
\ No newline at end of file
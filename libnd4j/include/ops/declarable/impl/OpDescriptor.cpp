@@ -270,6 +270,15 @@ namespace nd4j {
             return _sameMode;
         }
 
+        OpDescriptor* OpDescriptor::setShapeMemoizable(bool memoizable) {
+            _shapeMemoizable = memoizable;
+            return this;
+        }
+
+        bool OpDescriptor::isShapeMemoizable() {
+            return _shapeMemoizable;
+        }
+
         bool OpDescriptor::isInherit(int index) {
             if (std::find(_allowedOuts.begin(), _allowedOuts.end(), nd4j::DataType::INHERIT) != _allowedOuts.end())
                 return true;
@@ -34,9 +34,34 @@ namespace nd4j {
          static inline int linearIndexC(int rows, int cols, int r, int c);
          static inline int linearIndexF(int rows, int cols, int r, int c);
 
+         /**
+          * Accumulation type used by packed kernels: everything except double is accumulated in float,
+          * so HALF/BFLOAT16 products don't lose precision along K
+          */
+         template <typename Z>
+         struct GemmAccumulator {
+             typedef float type;
+         };
+
+         template <>
+         struct GemmAccumulator<double> {
+             typedef double type;
+         };
+
+         /**
+          * Column-major GEMM: C = alpha * op(A) * op(B) + beta * C
+          *
+          * Operands are packed into MR/NR-wide panels (converted to accumulation type), and C is computed tile by tile
+          * with register-blocked micro-kernel. Tiles are processed in parallel.
+          */
          template <typename X, typename Y, typename Z>
          class GEMM {
          protected:
+             typedef typename GemmAccumulator<Z>::type Acc;
+
+             static void packA(bool transA, X *A, int lda, int rowStart, int rows, int kStart, int depth, Acc *packed);
+             static void packB(bool transB, Y *B, int ldb, int K, int N, Acc *packed);
+             static void microKernel(int depth, Acc *a, Acc *b, Acc *c, int ldc);
          public:
              static void op(int Order, int TransA, int TransB, int M, int N, int K, double alpha, void *A, int lda, void *B, int ldb, double beta, void *C, int ldc);
          };
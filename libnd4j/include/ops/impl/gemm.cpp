@@ -21,6 +21,7 @@
 
 #include <gemm.h>
 #include <types/types.h>
+#include <cstring>
 
 namespace nd4j {
     namespace blas {
@@ -44,6 +45,96 @@ namespace nd4j {
             return ret;
         }
 
+        // micro-kernel dimensions: MR rows of A panel by NR columns of B panel
+        static const int GEMM_MR = 8;
+        static const int GEMM_NR = 4;
+
+        // cache blocking: A block is MC x KC, C tile is MC x NT
+        static const int GEMM_MC = 128;
+        static const int GEMM_KC = 256;
+        static const int GEMM_NT = 64;
+
+        // problems smaller than this (M * N * K) are computed by single thread
+        static const Nd4jLong GEMM_PARALLEL_THRESHOLD = 32768L;
+
+        static const int GEMV_BLOCK = 256;
+
+        template <typename X, typename Y, typename Z>
+        void GEMM<X, Y, Z>::packA(bool transA, X *A, int lda, int rowStart, int rows, int kStart, int depth, Acc *packed) {
+            // panels of MR rows, each stored k-major. tail rows are padded with zeros
+            for (int ir = 0; ir < rows; ir += GEMM_MR) {
+                auto panel = packed + ir * depth;
+                int mr = nd4j::math::nd4j_min<int>(GEMM_MR, rows - ir);
+
+                for (int k = 0; k < depth; k++) {
+                    auto dst = panel + k * GEMM_MR;
+                    Nd4jLong col = kStart + k;
+
+                    if (transA) {
+                        for (int i = 0; i < mr; i++)
+                            dst[i] = static_cast<Acc>(A[col + (Nd4jLong) (rowStart + ir + i) * lda]);
+                    } else {
+                        auto src = A + col * lda + rowStart + ir;
+                        for (int i = 0; i < mr; i++)
+                            dst[i] = static_cast<Acc>(src[i]);
+                    }
+
+                    for (int i = mr; i < GEMM_MR; i++)
+                        dst[i] = static_cast<Acc>(0.0f);
+                }
+            }
+        }
+
+        template <typename X, typename Y, typename Z>
+        void GEMM<X, Y, Z>::packB(bool transB, Y *B, int ldb, int K, int N, Acc *packed) {
+            int numPanels = (N + GEMM_NR - 1) / GEMM_NR;
+
+            // panels of NR columns, each stored k-major over full K. tail columns are padded with zeros
+#pragma omp parallel for if ((Nd4jLong) K * N > GEMM_PARALLEL_THRESHOLD) schedule(static)
+            for (int p = 0; p < numPanels; p++) {
+                auto panel = packed + (Nd4jLong) p * K * GEMM_NR;
+                int c0 = p * GEMM_NR;
+                int nr = nd4j::math::nd4j_min<int>(GEMM_NR, N - c0);
+
+                for (int k = 0; k < K; k++) {
+                    auto dst = panel + (Nd4jLong) k * GEMM_NR;
+
+                    for (int j = 0; j < nr; j++)
+                        dst[j] = static_cast<Acc>(transB ? B[c0 + j + (Nd4jLong) k * ldb] : B[k + (Nd4jLong) (c0 + j) * ldb]);
+
+                    for (int j = nr; j < GEMM_NR; j++)
+                        dst[j] = static_cast<Acc>(0.0f);
+                }
+            }
+        }
+
+        template <typename X, typename Y, typename Z>
+        void GEMM<X, Y, Z>::microKernel(int depth, Acc *a, Acc *b, Acc *c, int ldc) {
+            Acc r[GEMM_NR][GEMM_MR];
+
+            for (int j = 0; j < GEMM_NR; j++)
+#pragma omp simd
+                for (int i = 0; i < GEMM_MR; i++)
+                    r[j][i] = static_cast<Acc>(0.0f);
+
+            for (int k = 0; k < depth; k++) {
+                auto ak = a + k * GEMM_MR;
+                auto bk = b + k * GEMM_NR;
+
+                for (int j = 0; j < GEMM_NR; j++) {
+                    auto bv = bk[j];
+#pragma omp simd
+                    for (int i = 0; i < GEMM_MR; i++)
+                        r[j][i] += ak[i] * bv;
+                }
+            }
+
+            for (int j = 0; j < GEMM_NR; j++)
+#pragma omp simd
+                for (int i = 0; i < GEMM_MR; i++)
+                    c[i + j * ldc] += r[j][i];
+        }
+
         template <typename X, typename Y, typename Z>
         void GEMM<X, Y, Z>::op(int Order, int TransA, int TransB,
                        int M, int N, int K,
@@ -60,45 +151,79 @@ namespace nd4j {
             bool transAFlag = TransA == CblasTrans;
             bool transBFlag = TransB == CblasTrans;
 
-            if (beta == 0.0) {
-                int length = M*N;
-                if (length <= 8192) {
-#pragma omp simd
-                    for (int r = 0; r < length; r++)
-                        C[r] = static_cast<Z>(0.0f);
-                } else {
-#pragma omp parallel for simd
-                    for (int r = 0; r < length; r++)
-                        C[r] = static_cast<Z>(0.0f);
-                }
+            if (M < 1 || N < 1)
+                return;
+
+            // nothing to multiply, only C scaling is possible here
+            if (alpha == 0.0 || K < 1) {
+                for (int c = 0; c < N; c++)
+                    for (int r = 0; r < M; r++) {
+                        auto zIdx = r + (Nd4jLong) c * ldc;
+                        C[zIdx] = beta == 0.0 ? static_cast<Z>(0.0f) : static_cast<Z>(beta * static_cast<Acc>(C[zIdx]));
+                    }
+                return;
             }
 
+            Nd4jLong numPanelsB = (N + GEMM_NR - 1) / GEMM_NR;
+            auto packedB = new Acc[numPanelsB * GEMM_NR * K];
+            packB(transBFlag, B, ldb, K, N, packedB);
+
+            int tilesM = (M + GEMM_MC - 1) / GEMM_MC;
+            int tilesN = (N + GEMM_NT - 1) / GEMM_NT;
+            int numTiles = tilesM * tilesN;
+            bool parallel = numTiles > 1 && (Nd4jLong) M * N * K > GEMM_PARALLEL_THRESHOLD;
 
-#pragma omp parallel for simd collapse(2) proc_bind(close)
-            for (int r = 0; r < M; r++) {
-                for (int c = 0; c < N; c++) {
-                    int zIdx = linearIndexF(M, N, r, c);
+            auto a = static_cast<Acc>(alpha);
+            auto b = static_cast<Acc>(beta);
 
-                    Z dot = static_cast<Z>(0.0f);
+#pragma omp parallel if (parallel) default(shared)
+            {
+                // each thread packs its own A blocks and accumulates its own C tile
+                auto packedA = new Acc[GEMM_MC * GEMM_KC];
+                auto tile = new Acc[GEMM_MC * GEMM_NT];
 
-                    if (alpha != 0.0) {
-                        int bIdx; // = linearIndexF(K, N, 0, c);
-                        int aIdx;
+#pragma omp for schedule(dynamic)
+                for (int t = 0; t < numTiles; t++) {
+                    int ic = (t / tilesN) * GEMM_MC;
+                    int jc = (t % tilesN) * GEMM_NT;
+                    int mc = nd4j::math::nd4j_min<int>(GEMM_MC, M - ic);
+                    int nc = nd4j::math::nd4j_min<int>(GEMM_NT, N - jc);
 
-                        for (int k = 0; k < K; k++) {
-                            aIdx = (transAFlag ? linearIndexC(M, K, r, k) : linearIndexF(M, K, r, k));
-                            bIdx = (transBFlag ? linearIndexC(K, N, k, c) : linearIndexF(K,N, k, c));
-                            dot += static_cast<Z>(alpha) * static_cast<Z>(A[aIdx]) * static_cast<Z>(B[bIdx]);//A[aIdx]nd4j::math::nd4j_dot<T>(aX, bX, K) * alpha;
+                    memset(tile, 0, sizeof(Acc) * GEMM_MC * GEMM_NT);
+
+                    for (int pc = 0; pc < K; pc += GEMM_KC) {
+                        int kc = nd4j::math::nd4j_min<int>(GEMM_KC, K - pc);
+
+                        packA(transAFlag, A, lda, ic, mc, pc, kc, packedA);
+
+                        for (int jr = 0; jr < nc; jr += GEMM_NR) {
+                            auto panelB = packedB + (Nd4jLong) ((jc + jr) / GEMM_NR) * K * GEMM_NR + (Nd4jLong) pc * GEMM_NR;
+
+                            for (int ir = 0; ir < mc; ir += GEMM_MR)
+                                microKernel(kc, packedA + ir * kc, panelB, tile + ir + jr * GEMM_MC, GEMM_MC);
                         }
                     }
 
-                    if (beta != 0.0) {
-                        C[zIdx] = static_cast<Z>(dot + beta * C[zIdx]);
-                    } else {
-                        C[zIdx] = static_cast<Z>(dot);
+                    // alpha & beta are applied once, when tile is complete
+                    for (int j = 0; j < nc; j++) {
+                        auto z = C + ic + (Nd4jLong) (jc + j) * ldc;
+                        auto acc = tile + j * GEMM_MC;
+
+                        if (beta == 0.0) {
+                            for (int i = 0; i < mc; i++)
+                                z[i] = static_cast<Z>(a * acc[i]);
+                        } else {
+                            for (int i = 0; i < mc; i++)
+                                z[i] = static_cast<Z>(a * acc[i] + b * static_cast<Acc>(z[i]));
+                        }
                     }
                 }
+
+                delete[] packedA;
+                delete[] tile;
             }
+
+            delete[] packedB;
         }
 
 
@@ -113,23 +238,57 @@ namespace nd4j {
                                void* vZ,
                                int incy ) {
 
+            typedef typename GemmAccumulator<Z>::type Acc;
+
             auto x = reinterpret_cast<X *>(vX);
             auto y = reinterpret_cast<Y *>(vY);
             auto z = reinterpret_cast<Z *>(vZ);
 
-            auto aT = TRANS == CblasTrans ? reinterpret_cast<X *>(nd4j::blas::transpose<X>(CblasColMajor, CblasRowMajor, M, N, reinterpret_cast<void *>(x))) : x;
+            auto a = static_cast<Acc>(alpha);
+            auto b = static_cast<Acc>(beta);
 
-#pragma omp parallel for proc_bind(close)
-            for (int r = 0; r < M; r++) {
-                int aIdx = linearIndexC(M, N, r, 0);
-                auto aX = aT + aIdx;
+            int numBlocks = (M + GEMV_BLOCK - 1) / GEMV_BLOCK;
+            bool parallel = numBlocks > 1 && (Nd4jLong) M * N > GEMM_PARALLEL_THRESHOLD;
 
-                auto dot = nd4j::math::nd4j_dot<X, Y, Z>(aX, y, lda) * alpha;
-                z[r] =  beta == 0.0f ? dot : dot + beta * z[r];
-            }
+            if (TRANS == CblasTrans) {
+                // A is in f order: columns are contiguous, so each block of rows is accumulated column by column
+#pragma omp parallel for if (parallel) schedule(static)
+                for (int bl = 0; bl < numBlocks; bl++) {
+                    Acc sum[GEMV_BLOCK];
+                    int r0 = bl * GEMV_BLOCK;
+                    int rows = nd4j::math::nd4j_min<int>(GEMV_BLOCK, M - r0);
 
-            if (TRANS == CblasTrans)
-                delete[] aT;
+                    for (int i = 0; i < rows; i++)
+                        sum[i] = static_cast<Acc>(0.0f);
+
+                    for (int c = 0; c < N; c++) {
+                        auto yv = static_cast<Acc>(y[(Nd4jLong) c * incx]);
+                        auto col = x + (Nd4jLong) c * M + r0;
+
+#pragma omp simd
+                        for (int i = 0; i < rows; i++)
+                            sum[i] += static_cast<Acc>(col[i]) * yv;
+                    }
+
+                    for (int i = 0; i < rows; i++) {
+                        auto zIdx = (Nd4jLong) (r0 + i) * incy;
+                        z[zIdx] = static_cast<Z>(beta == 0.0 ? a * sum[i] : a * sum[i] + b * static_cast<Acc>(z[zIdx]));
+                    }
+                }
+            } else {
+                // A is in c order: plain dot product per row
+#pragma omp parallel for if (parallel) schedule(static)
+                for (int r = 0; r < M; r++) {
+                    auto row = x + (Nd4jLong) r * N;
+                    Acc dot = static_cast<Acc>(0.0f);
+
+                    for (int c = 0; c < N; c++)
+                        dot += static_cast<Acc>(row[c]) * static_cast<Acc>(y[(Nd4jLong) c * incx]);
+
+                    auto zIdx = (Nd4jLong) r * incy;
+                    z[zIdx] = static_cast<Z>(beta == 0.0 ? a * dot : a * dot + b * static_cast<Acc>(z[zIdx]));
+                }
+            }
         }
 
         BUILD_TRIPLE_TEMPLATE(template class  GEMV, , LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
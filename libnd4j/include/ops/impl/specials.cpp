@@ -28,6 +28,7 @@
 #include <NDArray.h>
 #include <ops/declarable/CustomOperations.h>
 #include <types/types.h>
+#include <type_traits>
 
 namespace nd4j {
 
@@ -61,6 +62,38 @@ void SpecialMethods<T>::concatCpuGeneric(int dimension, int numArrays, Nd4jPoint
         delete inputs[i];
 }
 
+// number of elements processed across all sources at once. a few sources plus output chunk stay within L2
+#define ACCUMULATE_CHUNK 4096
+
+/**
+ * This method adds sources [first, n) to z, within chunk [offset, offset + length).
+ * Sources are consumed 4 at a time, so each z element is loaded and stored once per 4 sources
+ */
+    template <typename T>
+    static FORCEINLINE void accumulateChunk(T **x, int first, int n, T *z, Nd4jLong offset, Nd4jLong length) {
+        auto zc = z + offset;
+        int ar = first;
+
+        for (; ar + 4 <= n; ar += 4) {
+            auto x0 = x[ar] + offset;
+            auto x1 = x[ar + 1] + offset;
+            auto x2 = x[ar + 2] + offset;
+            auto x3 = x[ar + 3] + offset;
+
+#pragma omp simd
+            for (Nd4jLong i = 0; i < length; i++)
+                zc[i] += (x0[i] + x1[i]) + (x2[i] + x3[i]);
+        }
+
+        for (; ar < n; ar++) {
+            auto x0 = x[ar] + offset;
+
+#pragma omp simd
+            for (Nd4jLong i = 0; i < length; i++)
+                zc[i] += x0[i];
+        }
+    }
+
 /**
  * This kernel accumulates X arrays, and stores result into Z
  *
@@ -75,20 +108,14 @@ void SpecialMethods<T>::concatCpuGeneric(int dimension, int numArrays, Nd4jPoint
         auto z = reinterpret_cast<T *>(vz);
         auto x = reinterpret_cast<T **>(vx);
 
-        // aggregation step
-#ifdef _OPENMP
-        int _threads = omp_get_max_threads();
-#else
-        // we can use whatever we want here, this value won't be used if there's no omp
-    int _threads = 4;
-#endif
-
-#pragma omp parallel for simd num_threads(_threads) schedule(guided) default(shared) proc_bind(close)
-        for (Nd4jLong i = 0; i < length; i++) {
+        const Nd4jLong numChunks = (length + ACCUMULATE_CHUNK - 1) / ACCUMULATE_CHUNK;
+        const int _threads = nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(omp_get_max_threads(), numChunks));
 
-            for (Nd4jLong ar = 0; ar < n; ar++) {
-                z[i] += x[ar][i];
-            }
+        // each chunk is read from all sources while it's hot in cache
+#pragma omp parallel for num_threads(_threads) if (_threads > 1) schedule(static) default(shared) proc_bind(close)
+        for (Nd4jLong c = 0; c < numChunks; c++) {
+            auto offset = c * ACCUMULATE_CHUNK;
+            accumulateChunk<T>(x, 0, n, z, offset, nd4j::math::nd4j_min<Nd4jLong>(ACCUMULATE_CHUNK, length - offset));
         }
     }
 
@@ -108,62 +135,53 @@ void SpecialMethods<T>::concatCpuGeneric(int dimension, int numArrays, Nd4jPoint
         auto z = reinterpret_cast<T *>(vz);
         auto x = reinterpret_cast<T **>(vx);
 
-        if (z == nullptr) {
-            //code branch for absent Z
+        // for absent Z result is stored into first source
+        const bool inplace = z == nullptr;
+        if (inplace)
             z = x[0];
 
-#pragma omp simd
-            for (Nd4jLong i = 0; i < length; i++) {
-                z[i] /= n;
-            }
+        // sum of n sources overflows half types, and changes truncation of integer ones, so those are scaled source by source
+        const bool perSource = std::is_integral<T>::value || sizeof(T) < sizeof(float);
 
-#ifdef _OPENNMP
-            int _threads = omp_get_max_threads(); //nd4j::math::nd4j_min<int>(omp_get_max_threads() / 2, 4);
-#else
-            // we can use whatever we want here, this value won't be used if there's no omp
-            int _threads = 4;
-#endif
+        const Nd4jLong numChunks = (length + ACCUMULATE_CHUNK - 1) / ACCUMULATE_CHUNK;
+        const int _threads = nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(omp_get_max_threads(), numChunks));
 
-#pragma omp parallel for simd num_threads(_threads) schedule(guided) default(shared) proc_bind(close)
-            for (Nd4jLong i = 0; i < length; i++) {
+        // zeroing, sum, scale and propagation are done chunk by chunk, so averaged chunk is copied to sources while still in cache
+#pragma omp parallel for num_threads(_threads) if (_threads > 1) schedule(static) default(shared) proc_bind(close)
+        for (Nd4jLong c = 0; c < numChunks; c++) {
+            auto offset = c * ACCUMULATE_CHUNK;
+            auto chunk = nd4j::math::nd4j_min<Nd4jLong>(ACCUMULATE_CHUNK, length - offset);
+            auto zc = z + offset;
 
-                for (Nd4jLong ar = 1; ar < n; ar++) {
-                    z[i] += x[ar][i] / n;
-                }
-            }
-
-            // instead of doing element-wise propagation, we just issue memcpy to propagate data
-#pragma omp parallel for num_threads(_threads) default(shared) proc_bind(close)
-            for (Nd4jLong ar = 1; ar < n; ar++) {
-                memcpy(x[ar], z, length * sizeof(T));
-            }
-        } else {
-            // code branch for existing Z
+            if (perSource) {
+                if (inplace) {
+#pragma omp simd
+                    for (Nd4jLong i = 0; i < chunk; i++)
+                        zc[i] /= n;
+                } else
+                    memset(zc, 0, chunk * sizeof(T));
 
-            // memset before propagation
-            memset(z, 0, length * sizeof(T));
+                for (int ar = inplace ? 1 : 0; ar < n; ar++) {
+                    auto x0 = x[ar] + offset;
 
-            // aggregation step
-#ifdef _OPENNMP
-            int _threads = omp_get_max_threads(); //nd4j::math::nd4j_min<int>(omp_get_max_threads() / 2, 4);
-#else
-            // we can use whatever we want here, this value won't be used if there's no omp
-            int _threads = 4;
-#endif
+#pragma omp simd
+                    for (Nd4jLong i = 0; i < chunk; i++)
+                        zc[i] += x0[i] / n;
+                }
+            } else {
+                if (!inplace)
+                    memset(zc, 0, chunk * sizeof(T));
 
-#pragma omp parallel for simd num_threads(_threads) schedule(guided) default(shared) proc_bind(close)
-            for (Nd4jLong i = 0; i < length; i++) {
+                accumulateChunk<T>(x, inplace ? 1 : 0, n, z, offset, chunk);
 
-                for (Nd4jLong ar = 0; ar < n; ar++) {
-                    z[i] += x[ar][i] / n;
-                }
+#pragma omp simd
+                for (Nd4jLong i = 0; i < chunk; i++)
+                    zc[i] /= n;
             }
 
             // instead of doing element-wise propagation, we just issue memcpy to propagate data
-#pragma omp parallel for num_threads(_threads) default(shared) proc_bind(close)
-            for (Nd4jLong ar = 0; ar < n; ar++) {
-                memcpy(x[ar], z, length * sizeof(T));
-            }
+            for (int ar = inplace ? 1 : 0; ar < n; ar++)
+                memcpy(x[ar] + offset, zc, chunk * sizeof(T));
         }
     }
 
@@ -24,6 +24,7 @@
 #include <ops/random_ops.h>
 #include <helpers/shape.h>
 #include <graph/RandomGenerator.h>
+#include <helpers/RandomFill.h>
 
 namespace randomOps {
 
@@ -323,6 +324,20 @@ namespace randomOps {
             const T mean = extraArguments[0];
             const T stddev = extraArguments[1];
 
+            if (zEWS == 1) {
+                // contiguous output is filled in bulk, via ziggurat over counter-based generator
+                nd4j::RandomFill::normal<T>(*rng, z, zLength, y == z ? mean : static_cast<T>(0.f), stddev);
+
+                if (y != z) {
+#pragma omp parallel for simd num_threads(_threads) if (_threads > 1) schedule(static)
+                    for (Nd4jLong e = 0; e < zLength; e++)
+                        z[e] += y[e * yEWS];
+                }
+
+                rng->rewindH(zLength);
+                return;
+            }
+
             const T epsilon = static_cast<T>(1e-5);
 
 #pragma omp parallel for num_threads(_threads) if (_threads > 1) proc_bind(spread)
@@ -720,6 +735,16 @@ namespace randomOps {
 
         static inline void
         specialOp(Nd4jPointer state, T *x, Nd4jLong *xShapeBuffer, T *y, Nd4jLong *yShapeBuffer, T *z, Nd4jLong *zShapeBuffer, T *extraArguments) {
+            if (y == z && shape::elementWiseStride(zShapeBuffer) == 1) {
+                // out-of-range values are redrawn from per-element streams, so no fix-up pass is needed
+                auto rng = reinterpret_cast<nd4j::graph::RandomGenerator*>(state);
+                Nd4jLong zLength = shape::length(zShapeBuffer);
+
+                nd4j::RandomFill::truncatedNormal<T>(*rng, z, zLength, extraArguments[0], extraArguments[1]);
+                rng->rewindH(zLength);
+                return;
+            }
+
             GaussianDistribution<T>::specialOp(state, x, xShapeBuffer, y, yShapeBuffer, z, zShapeBuffer, extraArguments);
             Nd4jLong zLength = shape::length(zShapeBuffer);
             //auto yEWS = shape::elementWiseStride(yShapeBuffer);
@@ -935,6 +960,18 @@ namespace randomOps {
 
             const T mean = extraArguments[0];
             const T stddev = extraArguments[1];
+
+            if (zEWS == 1) {
+                nd4j::RandomFill::normal<T>(*rng, z, zLength, y == z ? mean : static_cast<T>(0.f), stddev);
+
+#pragma omp parallel for simd num_threads(_threads) if (_threads > 1) schedule(static)
+                for (Nd4jLong e = 0; e < zLength; e++)
+                    z[e] = nd4j::math::nd4j_exp<T,T>(y == z ? z[e] : z[e] + y[e * yEWS]);
+
+                rng->rewindH(zLength);
+                return;
+            }
+
             const T epsilon = static_cast<T>(1e-5);
 
 #pragma omp parallel num_threads(_threads) if (_threads > 1) proc_bind(spread)
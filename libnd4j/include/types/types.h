@@ -85,6 +85,10 @@
 #define FLOAT_TYPES_3 \
         (nd4j::DataType::BFLOAT16, bfloat16)
 
+#define FLOAT_NATIVE \
+        (nd4j::DataType::FLOAT32, float), \
+        (nd4j::DataType::DOUBLE, double)
+
 #define LIBND4J_TYPES_0 \
         (nd4j::DataType::HALF, float16)
 
@@ -19,6 +19,14 @@
 //
 
 #include "testinclude.h"
+#include <cnpy/cnpy.h>
+#include <helpers/MappedNumpy.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+using namespace nd4j;
 
 class FileTest : public testing::Test {
 
@@ -57,4 +65,206 @@ TEST_F(LoadFromStringTest,PathTest) {
     delete[] loaded;
 }
 
-*/
\ No newline at end of file
+*/
+
+TEST_F(FileTest, Test_Writer_Map_1) {
+    const char *fileName = "cnpy_writer_map_1.npy";
+    auto x = NDArrayFactory::create<float>('c', {3, 4}, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+
+    // data is streamed row by row
+    cnpy::NpyWriter writer(fileName, 'f', sizeof(float), {3, 4});
+    for (int r = 0; r < 3; r++)
+        writer.write(x.bufferAsT<float>() + r * 4, 4 * sizeof(float));
+    writer.close();
+
+    auto mapped = MappedNumpy::fromNpy(fileName);
+    ASSERT_EQ(1, mapped->size());
+
+    auto z = mapped->at(0);
+    ASSERT_TRUE(x.isSameShape(z));
+    ASSERT_EQ(x.dataType(), z->dataType());
+    ASSERT_TRUE(x.equalsTo(z));
+
+    // writes go to private pages, so file keeps original values
+    z->p(0, 42.f);
+    delete mapped;
+
+    auto npy = cnpy::npyMap(fileName);
+    ASSERT_EQ(0, reinterpret_cast<uintptr_t>(npy.data) % 64);
+    ASSERT_EQ(1.f, reinterpret_cast<float *>(npy.data)[0]);
+    npy.destruct();
+
+    remove(fileName);
+}
+
+// appends value in little-endian order, as zip and npy headers want
+template <typename T>
+static void putLE(std::string &buffer, T value) {
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+// builds v1.0 npy image, with header padded so data starts at 64-byte boundary
+static std::string npyImage(const std::string &descr, const std::string &shape, const void *data, size_t bytes) {
+    std::string dict = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': " + shape + ", }";
+    dict += std::string((64 - (10 + dict.size() + 1) % 64) % 64, ' ') + "\n";
+
+    std::string result("\x93NUMPY\x01\x00", 8);
+    putLE<uint16_t>(result, static_cast<uint16_t>(dict.size()));
+    result += dict;
+    result.append(reinterpret_cast<const char *>(data), bytes);
+    return result;
+}
+
+struct ZipMember {
+    std::string name;
+    std::string data;
+    uint16_t compression;
+    uint32_t localOffset;
+    std::string extra;
+};
+
+// writes zip archive with members stored as is, local offsets are filled in unless given in member itself
+static void writeZip(const char *fileName, std::vector<ZipMember> members) {
+    std::string zip;
+    for (auto &m: members) {
+        if (m.localOffset == 0)
+            m.localOffset = static_cast<uint32_t>(zip.size());
+
+        putLE<uint32_t>(zip, 0x04034b50);
+        putLE<uint16_t>(zip, 20);
+        putLE<uint16_t>(zip, 0);
+        putLE<uint16_t>(zip, m.compression);
+        putLE<uint32_t>(zip, 0);
+        putLE<uint32_t>(zip, 0);
+        putLE<uint32_t>(zip, static_cast<uint32_t>(m.data.size()));
+        putLE<uint32_t>(zip, static_cast<uint32_t>(m.data.size()));
+        putLE<uint16_t>(zip, static_cast<uint16_t>(m.name.size()));
+        putLE<uint16_t>(zip, 0);
+        zip += m.name;
+        zip += m.data;
+    }
+
+    const auto cdOffset = zip.size();
+    for (auto &m: members) {
+        putLE<uint32_t>(zip, 0x02014b50);
+        putLE<uint16_t>(zip, 20);
+        putLE<uint16_t>(zip, 20);
+        putLE<uint16_t>(zip, 0);
+        putLE<uint16_t>(zip, m.compression);
+        putLE<uint32_t>(zip, 0);
+        putLE<uint32_t>(zip, 0);
+        putLE<uint32_t>(zip, static_cast<uint32_t>(m.data.size()));
+        putLE<uint32_t>(zip, static_cast<uint32_t>(m.data.size()));
+        putLE<uint16_t>(zip, static_cast<uint16_t>(m.name.size()));
+        putLE<uint16_t>(zip, static_cast<uint16_t>(m.extra.size()));
+        putLE<uint16_t>(zip, 0);
+        putLE<uint16_t>(zip, 0);
+        putLE<uint16_t>(zip, 0);
+        putLE<uint32_t>(zip, 0);
+        putLE<uint32_t>(zip, m.localOffset);
+        zip += m.name;
+        zip += m.extra;
+    }
+
+    const auto cdSize = zip.size() - cdOffset;
+    putLE<uint32_t>(zip, 0x06054b50);
+    putLE<uint16_t>(zip, 0);
+    putLE<uint16_t>(zip, 0);
+    putLE<uint16_t>(zip, static_cast<uint16_t>(members.size()));
+    putLE<uint16_t>(zip, static_cast<uint16_t>(members.size()));
+    putLE<uint32_t>(zip, static_cast<uint32_t>(cdSize));
+    putLE<uint32_t>(zip, static_cast<uint32_t>(cdOffset));
+    putLE<uint16_t>(zip, 0);
+
+    std::ofstream file(fileName, std::ios::binary);
+    file.write(zip.data(), zip.size());
+}
+
+TEST_F(FileTest, Test_Npz_Map_1) {
+    const char *fileName = "cnpy_npz_map_1.npz";
+    float x[] = {1, 2, 3, 4, 5, 6};
+    int y[] = {7, 8, 9, 10};
+
+    writeZip(fileName, {{"x.npy", npyImage("<f4", "(2, 3)", x, sizeof(x)), 0, 0, ""},
+                        {"y.npy", npyImage("<i4", "(4,)", y, sizeof(y)), 0, 0, ""}});
+
+    auto arrays = cnpy::npzMap(fileName);
+    ASSERT_EQ(2, arrays.size());
+
+    auto &ax = arrays["x"];
+    ASSERT_EQ(std::vector<unsigned int>({2, 3}), ax.shape);
+    ASSERT_EQ(4, ax.wordSize);
+    ASSERT_EQ('f', ax.type);
+    for (int e = 0; e < 6; e++)
+        ASSERT_EQ(x[e], reinterpret_cast<float *>(ax.data)[e]);
+
+    arrays.destruct();
+
+    // arrays are found by names without .npy suffix
+    auto mapped = MappedNumpy::fromNpz(fileName);
+    ASSERT_EQ(2, mapped->size());
+    ASSERT_TRUE(mapped->at("z") == nullptr);
+
+    auto z = mapped->at("y");
+    ASSERT_TRUE(z != nullptr);
+
+    auto exp = NDArrayFactory::create<int>('c', {4}, {7, 8, 9, 10});
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_EQ(exp.dataType(), z->dataType());
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    delete mapped;
+    remove(fileName);
+}
+
+TEST_F(FileTest, Test_Npz_Map_2) {
+    const char *fileName = "cnpy_npz_map_2.npz";
+    float x[] = {1, 2, 3, 4};
+
+    // deflated members can't be mapped
+    writeZip(fileName, {{"x.npy", npyImage("<f4", "(4,)", x, sizeof(x)), 8, 0, ""}});
+    ASSERT_THROW(cnpy::npzMap(fileName), std::runtime_error);
+    ASSERT_THROW(MappedNumpy::fromNpz(fileName), std::runtime_error);
+
+    remove(fileName);
+}
+
+TEST_F(FileTest, Test_Npz_Map_3) {
+    const char *fileName = "cnpy_npz_map_3.npz";
+    float x[] = {1, 2, 3, 4};
+    auto npy = npyImage("<f4", "(4,)", x, sizeof(x));
+
+    // zip64 field which is too short for saturated local offset
+    std::string extra;
+    putLE<uint16_t>(extra, 0x0001);
+    putLE<uint16_t>(extra, 4);
+    putLE<uint32_t>(extra, 0);
+    writeZip(fileName, {{"x.npy", npy, 0, 0xFFFFFFFFU, extra}});
+    ASSERT_THROW(cnpy::npzMap(fileName), std::runtime_error);
+
+    // extra field which claims more bytes than record has
+    extra.clear();
+    putLE<uint16_t>(extra, 0x0001);
+    putLE<uint16_t>(extra, 64);
+    writeZip(fileName, {{"x.npy", npy, 0, 0, extra}});
+    ASSERT_THROW(cnpy::npzMap(fileName), std::runtime_error);
+
+    // name which runs past the end of file
+    writeZip(fileName, {{"x.npy", npy, 0, 0, ""}});
+    {
+        std::fstream file(fileName, std::ios::binary | std::ios::in | std::ios::out);
+        std::string zip((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        auto record = zip.find(std::string("PK\x01\x02", 4));
+        ASSERT_NE(std::string::npos, record);
+
+        file.seekp(record + 28);
+        file.write("\xff\xff", 2);
+    }
+    ASSERT_THROW(cnpy::npzMap(fileName), std::runtime_error);
+
+    // shape which doesn't fit into 64 bits
+    writeZip(fileName, {{"x.npy", npyImage("<f4", "(4294967295, 4294967295, 4294967295)", x, sizeof(x)), 0, 0, ""}});
+    ASSERT_THROW(cnpy::npzMap(fileName), std::runtime_error);
+
+    remove(fileName);
+}
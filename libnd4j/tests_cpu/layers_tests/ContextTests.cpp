@@ -20,6 +20,7 @@
 
 #include "testlayers.h"
 #include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/LegacyTransformSameOp.h>
 
 using namespace nd4j;
 using namespace nd4j::ops;
@@ -283,4 +284,86 @@ TEST_F(ContextTests, Prototype_Test_2) {
     ASSERT_EQ(0, ctx.getTArguments()->size());
     ASSERT_EQ(0, ctx.getIArguments()->size());
 
-}
\ No newline at end of file
+}
+
+TEST_F(ContextTests, Shape_Memo_1) {
+    ShapeMemo memo;
+    nd4j::ops::reshape op;
+
+    // shape argument is passed as input here, so its values are the part of memo key
+    std::vector<std::vector<Nd4jLong>> shapes = {{3, 4}, {3, 4}, {4, 3}};
+    std::vector<Nd4jLong> hits = {0, 1, 1};
+
+    for (int e = 0; e < (int) shapes.size(); e++) {
+        VariableSpace variableSpace;
+        variableSpace.putVariable(-1, NDArrayFactory::create_<float>('c', {2, 6}));
+        variableSpace.putVariable(-2, NDArrayFactory::create_<Nd4jLong>('c', {2}, shapes[e]));
+
+        Context block(1, &variableSpace);
+        block.fillInputs({-1, -2});
+        block.setShapeMemo(&memo);
+
+        ASSERT_EQ(Status::OK(), op.execute(&block));
+
+        auto z = variableSpace.getVariable(1)->getNDArray();
+        ASSERT_TRUE(z->isSameShape(shapes[e]));
+
+        ASSERT_EQ(hits[e], memo.hits());
+        ASSERT_EQ(e + 1 - hits[e], memo.misses());
+    }
+}
+
+TEST_F(ContextTests, Shape_Memo_2) {
+    ShapeMemo memo;
+    nd4j::ops::unique op;
+
+    // input is too large to be the part of key, but unique doesn't declare its shapes memoizable, so it's never memoized
+    std::vector<Nd4jLong> lengths = {100, 1};
+
+    for (int e = 0; e < (int) lengths.size(); e++) {
+        VariableSpace variableSpace;
+
+        auto x = NDArrayFactory::create_<float>('c', {100});
+        if (e == 0)
+            x->linspace(1);
+        else
+            x->assign(1.0f);
+
+        variableSpace.putVariable(-1, x);
+
+        Context block(1, &variableSpace);
+        block.fillInputs({-1});
+        block.setShapeMemo(&memo);
+
+        ASSERT_EQ(Status::OK(), op.execute(&block));
+        ASSERT_EQ(lengths[e], variableSpace.getVariable(1)->getNDArray()->lengthOf());
+    }
+
+    ASSERT_EQ(0, memo.hits());
+}
+
+TEST_F(ContextTests, Shape_Memo_3) {
+    // memoization is opt-in: ops have to declare that their shapes don't depend on values of large inputs
+    nd4j::ops::gather_nd gatherNd;
+    nd4j::ops::LegacyTransformSameOp abs(transform::Abs);
+
+    ShapeMemo memo;
+    for (int e = 0; e < 3; e++) {
+        VariableSpace variableSpace;
+        variableSpace.putVariable(-1, NDArrayFactory::create_<float>('c', {4, 5}));
+        variableSpace.putVariable(-2, NDArrayFactory::create_<int>('c', {2, 1}, {1, 3}));
+
+        Context block(1, &variableSpace);
+        block.fillInputs({-1, -2});
+        block.setShapeMemo(&memo);
+
+        ASSERT_EQ(Status::OK(), gatherNd.execute(&block));
+        ASSERT_TRUE(variableSpace.getVariable(1)->getNDArray()->isSameShape({2, 5}));
+    }
+
+    ASSERT_EQ(0, memo.hits());
+
+    // flags of custom ops are set by registerTypes(), which is called upon first execution
+    ASSERT_TRUE(abs.getOpDescriptor()->isShapeMemoizable());
+    ASSERT_FALSE(gatherNd.getOpDescriptor()->isShapeMemoizable());
+}
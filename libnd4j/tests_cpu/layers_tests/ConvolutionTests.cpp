@@ -2715,5 +2715,191 @@ TEST_F(ConvolutionTests, depthwise_conv2d_test5) {
         ASSERT_EQ(output.e<float>(i) != unique, true);
 }
 
+//////////////////////////////////////////////////////////////////////
+// straightforward convolution used as reference for conv2d engines, weights are [kH, kW, iC, oC] or [kH, kW, iC, mC] if depthwise
+static NDArray conv2dReference(const NDArray& input, const NDArray& weights, const NDArray& bias, int oH, int oW, int sH, int sW, int pH, int pW, int dH, int dW, bool isNCHW, bool isDepthwise) {
+    const int bS = input.sizeAt(0);
+    const int iC = input.sizeAt(isNCHW ? 1 : 3);
+    const int iH = input.sizeAt(isNCHW ? 2 : 1);
+    const int iW = input.sizeAt(isNCHW ? 3 : 2);
+    const int kH = weights.sizeAt(0);
+    const int kW = weights.sizeAt(1);
+    const int mC = weights.sizeAt(3);
+    const int oC = isDepthwise ? iC * mC : mC;
+
+    NDArray output('c', isNCHW ? std::vector<Nd4jLong>({bS, oC, oH, oW}) : std::vector<Nd4jLong>({bS, oH, oW, oC}), input.dataType());
+
+    for (int b = 0; b < bS; b++)
+        for (int oc = 0; oc < oC; oc++)
+            for (int oh = 0; oh < oH; oh++)
+                for (int ow = 0; ow < oW; ow++) {
+                    double sum = bias.e<double>(oc);
+                    for (int kh = 0; kh < kH; kh++)
+                        for (int kw = 0; kw < kW; kw++) {
+                            const int ih = oh * sH - pH + kh * dH;
+                            const int iw = ow * sW - pW + kw * dW;
+                            if (ih < 0 || ih >= iH || iw < 0 || iw >= iW)
+                                continue;
+
+                            for (int ic = isDepthwise ? oc / mC : 0; ic < (isDepthwise ? oc / mC + 1 : iC); ic++) {
+                                double x = isNCHW ? input.e<double>(b, ic, ih, iw) : input.e<double>(b, ih, iw, ic);
+                                sum += x * weights.e<double>(kh, kw, ic, isDepthwise ? oc % mC : oc);
+                            }
+                        }
+
+                    if (isNCHW)
+                        output.p(b, oc, oh, ow, sum);
+                    else
+                        output.p(b, oh, ow, oc, sum);
+                }
+
+    return output;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests, conv2d_winograd_1) {
+
+    int bS=2, iH=10,iW=9,  iC=16,oC=5,  kH=3,kW=3,  sH=1,sW=1,  pH=1,pW=1,  dH=1,dW=1;
+    int oH=10,oW=9;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+    int dataFormat  = 0;             // 1-NHWC, 0-NCHW
+
+    auto input   = NDArrayFactory::create<float>('c', {bS, iC, iH, iW});
+    auto weights = NDArrayFactory::create<float>('c', {kH, kW, iC, oC});
+    auto bias    = NDArrayFactory::create<float>('c', {oC});
+    input.linspace(-1., 0.003);
+    weights.linspace(0.5, -0.01);
+    bias.linspace(0.1, 0.1);
+
+    auto expected = conv2dReference(input, weights, bias, oH, oW, sH, sW, pH, pW, dH, dW, true, false);
+
+    nd4j::ops::conv2d op;
+    auto results = op.execute({&input, &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+    ASSERT_EQ(Status::OK(), results->status());
+
+    auto output = results->at(0);
+    ASSERT_TRUE(expected.isSameShape(output));
+    ASSERT_TRUE(expected.equalsTo(output, 1e-4));
+
+    delete results;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests, conv2d_winograd_2) {
+
+    int bS=1, iH=7,iW=6,  iC=3,oC=4,  kH=3,kW=3,  sH=1,sW=1,  pH=0,pW=0,  dH=1,dW=1;
+    int oH=5,oW=4;
+    int paddingMode = 0;             // 1-SAME, 0-VALID;
+    int dataFormat  = 1;             // 1-NHWC, 0-NCHW
+
+    auto input   = NDArrayFactory::create<double>('c', {bS, iH, iW, iC});
+    auto weights = NDArrayFactory::create<double>('c', {kH, kW, iC, oC});
+    auto bias    = NDArrayFactory::create<double>('c', {oC});
+    input.linspace(1., 0.5);
+    weights.linspace(-0.3, 0.02);
+
+    auto expected = conv2dReference(input, weights, bias, oH, oW, sH, sW, pH, pW, dH, dW, false, false);
+
+    nd4j::ops::conv2d op;
+    auto results = op.execute({&input, &weights}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+    ASSERT_EQ(Status::OK(), results->status());
+
+    auto output = results->at(0);
+    ASSERT_TRUE(expected.isSameShape(output));
+    ASSERT_TRUE(expected.equalsTo(output));
+
+    delete results;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests, conv2d_winograd_3) {
+
+    // output channels span more than one WINOGRAD_OC_BLOCK, last block is partial for oC = 80
+    int bS=2, iH=9,iW=10,  iC=16,  kH=3,kW=3,  sH=1,sW=1,  pH=1,pW=1,  dH=1,dW=1;
+    int oH=9,oW=10;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+
+    for (int oC: {80, 128}) {
+        for (int dataFormat = 0; dataFormat < 2; dataFormat++) {
+            auto input   = NDArrayFactory::create<double>('c', dataFormat ? std::vector<Nd4jLong>({bS, iH, iW, iC}) : std::vector<Nd4jLong>({bS, iC, iH, iW}));
+            auto weights = NDArrayFactory::create<double>('c', {kH, kW, iC, oC});
+            auto bias    = NDArrayFactory::create<double>('c', {oC});
+            input.linspace(-1., 0.001);
+            weights.linspace(0.5, -0.0001);
+            bias.linspace(0.1, 0.01);
+
+            auto expected = conv2dReference(input, weights, bias, oH, oW, sH, sW, pH, pW, dH, dW, dataFormat == 0, false);
+
+            nd4j::ops::conv2d op;
+            auto results = op.execute({&input, &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+            ASSERT_EQ(Status::OK(), results->status());
+
+            auto output = results->at(0);
+            ASSERT_TRUE(expected.isSameShape(output));
+            ASSERT_TRUE(expected.equalsTo(output));
+
+            delete results;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests, conv2d_pointwise_direct_1) {
+
+    int bS=2, iH=7,iW=9,  iC=5,oC=19,  kH=1,kW=1,  sH=2,sW=2,  pH=1,pW=1,  dH=1,dW=1;
+    int oH=5,oW=6;
+    int paddingMode = 0;             // 1-SAME, 0-VALID;
+
+    for (int dataFormat = 0; dataFormat < 2; dataFormat++) {
+        auto input   = NDArrayFactory::create<float>('c', dataFormat ? std::vector<Nd4jLong>({bS, iH, iW, iC}) : std::vector<Nd4jLong>({bS, iC, iH, iW}));
+        auto weights = NDArrayFactory::create<float>('c', {kH, kW, iC, oC});
+        auto bias    = NDArrayFactory::create<float>('c', {oC});
+        input.linspace(-2., 0.01);
+        weights.linspace(0.1, 0.05);
+        bias = 2.f;
+
+        auto expected = conv2dReference(input, weights, bias, oH, oW, sH, sW, pH, pW, dH, dW, dataFormat == 0, false);
+
+        nd4j::ops::conv2d op;
+        auto results = op.execute({&input, &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+        ASSERT_EQ(Status::OK(), results->status());
+
+        auto output = results->at(0);
+        ASSERT_TRUE(expected.isSameShape(output));
+        ASSERT_TRUE(expected.equalsTo(output));
+
+        delete results;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests, depthwise_conv2d_direct_1) {
+
+    int bS=2, iH=9,iW=8,  iC=3,mC=2,  kH=3,kW=2,  sH=2,sW=1,  pH=1,pW=0,  dH=2,dW=3;
+    int oC=iC*mC;
+    int oH=4,oW=5;
+    int paddingMode = 0;             // 1-SAME, 0-VALID;
+    int dataFormat  = 0;             // 1-NHWC, 0-NCHW
+
+    auto input   = NDArrayFactory::create<float>('c', {bS, iC, iH, iW});
+    auto weights = NDArrayFactory::create<float>('c', {kH, kW, iC, mC});
+    auto bias    = NDArrayFactory::create<float>('c', {oC});
+    input.linspace(0.5, 0.25);
+    weights.linspace(-1., 0.1);
+    bias.linspace(1., 1.);
+
+    auto expected = conv2dReference(input, weights, bias, oH, oW, sH, sW, pH, pW, dH, dW, true, true);
+
+    nd4j::ops::depthwise_conv2d op;
+    auto results = op.execute({&input, &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+    ASSERT_EQ(Status::OK(), results->status());
+
+    auto output = results->at(0);
+    ASSERT_TRUE(expected.isSameShape(output));
+    ASSERT_TRUE(expected.equalsTo(output));
+
+    delete results;
+}
+
 #endif //LIBND4J_CONVOLUTIONTESTS_H
 
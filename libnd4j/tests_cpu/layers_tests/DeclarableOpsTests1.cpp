@@ -34,6 +34,56 @@
 using namespace nd4j;
 using namespace nd4j::graph;
 
+// column-major reference: C = alpha * op(A) * op(B) + beta * C
+template <typename X, typename Y, typename Z>
+static void referenceGemm(bool transA, bool transB, int M, int N, int K, double alpha, X *A, int lda, Y *B, int ldb, double beta, Z *C, int ldc) {
+    for (int r = 0; r < M; r++)
+        for (int c = 0; c < N; c++) {
+            double sum = 0.0;
+            for (int k = 0; k < K; k++) {
+                auto a = static_cast<double>(transA ? A[k + (Nd4jLong) r * lda] : A[r + (Nd4jLong) k * lda]);
+                auto b = static_cast<double>(transB ? B[c + (Nd4jLong) k * ldb] : B[k + (Nd4jLong) c * ldb]);
+                sum += a * b;
+            }
+
+            auto zIdx = r + (Nd4jLong) c * ldc;
+            C[zIdx] = static_cast<Z>(alpha * sum + beta * static_cast<double>(C[zIdx]));
+        }
+}
+
+template <typename X, typename Y, typename Z>
+static double checkGemm(bool transA, bool transB, int M, int N, int K, int pad, double alpha, double beta) {
+    // leading dimensions are padded, so they differ from both M and K
+    int lda = (transA ? K : M) + pad;
+    int ldb = (transB ? N : K) + pad;
+    int ldc = M + pad;
+
+    std::vector<X> A((Nd4jLong) lda * (transA ? M : K));
+    std::vector<Y> B((Nd4jLong) ldb * (transB ? K : N));
+    std::vector<Z> C((Nd4jLong) ldc * N), exp((Nd4jLong) ldc * N);
+
+    for (size_t e = 0; e < A.size(); e++)
+        A[e] = static_cast<X>(static_cast<float>((e * 7) % 11) / 4.f - 1.f);
+    for (size_t e = 0; e < B.size(); e++)
+        B[e] = static_cast<Y>(static_cast<float>((e * 5) % 13) / 4.f - 1.5f);
+    for (size_t e = 0; e < C.size(); e++)
+        C[e] = exp[e] = static_cast<Z>(static_cast<float>(e % 5) - 2.f);
+
+    nd4j::blas::GEMM<X, Y, Z>::op(CblasColMajor, transA ? CblasTrans : CblasNoTrans, transB ? CblasTrans : CblasNoTrans, M, N, K, alpha, A.data(), lda, B.data(), ldb, beta, C.data(), ldc);
+    referenceGemm<X, Y, Z>(transA, transB, M, N, K, alpha, A.data(), lda, B.data(), ldb, beta, exp.data(), ldc);
+
+    // padding of C must stay untouched
+    double maxError = 0.0;
+    for (int c = 0; c < N; c++)
+        for (int r = 0; r < ldc; r++) {
+            auto zIdx = r + (Nd4jLong) c * ldc;
+            auto diff = nd4j::math::nd4j_abs<double>(static_cast<double>(C[zIdx]) - static_cast<double>(exp[zIdx]));
+            maxError = nd4j::math::nd4j_max<double>(maxError, r < M ? diff / (1.0 + nd4j::math::nd4j_abs<double>(static_cast<double>(exp[zIdx]))) : diff);
+        }
+
+    return maxError;
+}
+
 class DeclarableOpsTests1 : public testing::Test {
 public:
 
@@ -1625,6 +1675,55 @@ TEST_F(DeclarableOpsTests1, TestGemv1) {
 
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests1, TestGemm_Packed_1) {
+    // M and N aren't multiples of micro-kernel size, N spans two tiles and K spans two K chunks
+    for (int transA = 0; transA < 2; transA++)
+        for (int transB = 0; transB < 2; transB++) {
+            ASSERT_NEAR(0.0, (checkGemm<float, float, float>(transA, transB, 37, 71, 300, 3, 1.5, 0.5)), 1e-5);
+            ASSERT_NEAR(0.0, (checkGemm<double, double, double>(transA, transB, 133, 9, 5, 2, 1.0, 0.0)), 1e-10);
+        }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests1, TestGemm_Packed_2) {
+    ASSERT_NEAR(0.0, (checkGemm<float16, float16, float16>(false, true, 19, 13, 40, 1, 1.0, 0.0)), 1e-2);
+    ASSERT_NEAR(0.0, (checkGemm<float16, bfloat16, float>(true, false, 19, 13, 300, 1, 1.0, 1.0)), 1e-5);
+    ASSERT_NEAR(0.0, (checkGemm<int, float, double>(true, true, 19, 13, 30, 1, 2.0, 1.0)), 1e-10);
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests1, TestGemv_Packed_1) {
+    // 300 rows span two row blocks
+    const int M = 300, N = 7;
+    auto x = NDArrayFactory::create<float>('f', {M, N});
+    auto y = NDArrayFactory::create<float>('c', {N});
+    auto z = NDArrayFactory::create<float>('c', {M});
+    x.linspace(-1.0, 0.01);
+    y.linspace(0.5, 0.25);
+    z.assign(2.0);
+
+    auto exp = NDArrayFactory::create<float>('c', {M});
+    for (int r = 0; r < M; r++) {
+        double sum = 0.0;
+        for (int c = 0; c < N; c++)
+            sum += x.e<double>(r, c) * y.e<double>(c);
+
+        exp.p(r, 1.5 * sum + 0.5 * 2.0);
+    }
+
+    nd4j::blas::GEMV<float, float, float>::op(CblasTrans, M, N, 1.5, x.getBuffer(), M, y.getBuffer(), 1, 0.5, z.getBuffer(), 1);
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    // same matrix in c order
+    auto xc = x.dup('c');
+    z.assign(2.0);
+    nd4j::blas::GEMV<float, float, float>::op(CblasNoTrans, M, N, 1.5, xc->getBuffer(), N, y.getBuffer(), 1, 0.5, z.getBuffer(), 1);
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    delete xc;
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests1, Reshape1) {
     const std::vector<Nd4jLong> xShape = {5,4,3};
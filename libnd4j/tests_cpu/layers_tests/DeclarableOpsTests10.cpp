@@ -2400,6 +2400,105 @@ TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressing_2) {
     delete results;
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressing_3) {
+    // batched mode: second entry has the same boxes with reversed scores
+    NDArray boxes    = NDArrayFactory::create<float>('c', {2,6,4}, {0, 0, 1, 1, 0, 0.1f, 1, 1.1f, 0, -0.1f, 1.f, 0.9f,
+                                         0, 10, 1, 11, 0, 10.1f, 1.f, 11.1f, 0, 100, 1, 101,
+                                         0, 0, 1, 1, 0, 0.1f, 1, 1.1f, 0, -0.1f, 1.f, 0.9f,
+                                         0, 10, 1, 11, 0, 10.1f, 1.f, 11.1f, 0, 100, 1, 101});
+    NDArray scales = NDArrayFactory::create<float>('c', {2,6}, {0.9f, .75f, .6f, .95f, .5f, .3f,
+                                                                .3f, .5f, .95f, .6f, .75f, .9f});
+    NDArray expected = NDArrayFactory::create<float>('c', {2,4}, {3.,0.,5.,-1., 2.,5.,4.,-1.});
+
+    nd4j::ops::non_max_suppression op;
+    auto results = op.execute({&boxes, &scales}, {0.5}, {4});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    NDArray* result = results->at(0);
+
+    ASSERT_TRUE(expected.isSameShapeStrict(result));
+    ASSERT_TRUE(expected.equalsTo(result));
+
+    delete results;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressing_4) {
+    // maxSize above NMS_GRID_THRESHOLD goes through the spatial grid, result must match plain greedy suppression
+    const int numCells = 200;
+    const int numBoxes = 2 * numCells;
+    std::vector<float> b(numBoxes * 4), s(numBoxes);
+    for (int e = 0; e < numCells; e++) {
+        float y = (e / 20) * 2.f, x = (e % 20) * 2.f;
+        float score = 0.5f + ((e * 37) % numCells) / (float) numCells;
+
+        // unit boxes which don't overlap each other
+        b[e * 4 + 0] = y; b[e * 4 + 1] = x; b[e * 4 + 2] = y + 1.f; b[e * 4 + 3] = x + 1.f;
+        s[e] = score;
+
+        // shifted copy with lower score, suppressed by its neighbour, with corners given in reverse order
+        int f = numCells + e;
+        b[f * 4 + 0] = y + 1.1f; b[f * 4 + 1] = x + 1.1f; b[f * 4 + 2] = y + 0.1f; b[f * 4 + 3] = x + 0.1f;
+        s[f] = score - 0.45f;
+    }
+
+    // reference: greedy suppression over all pairs
+    std::vector<int> order(numBoxes);
+    for (int e = 0; e < numBoxes; e++)
+        order[e] = e;
+    std::stable_sort(order.begin(), order.end(), [&s] (int l, int r) -> bool { return s[l] > s[r]; });
+
+    auto iou = [&b] (int l, int r) -> float {
+        float ly0 = nd4j::math::nd4j_min<float>(b[l * 4], b[l * 4 + 2]), lx0 = nd4j::math::nd4j_min<float>(b[l * 4 + 1], b[l * 4 + 3]);
+        float ly1 = nd4j::math::nd4j_max<float>(b[l * 4], b[l * 4 + 2]), lx1 = nd4j::math::nd4j_max<float>(b[l * 4 + 1], b[l * 4 + 3]);
+        float ry0 = nd4j::math::nd4j_min<float>(b[r * 4], b[r * 4 + 2]), rx0 = nd4j::math::nd4j_min<float>(b[r * 4 + 1], b[r * 4 + 3]);
+        float ry1 = nd4j::math::nd4j_max<float>(b[r * 4], b[r * 4 + 2]), rx1 = nd4j::math::nd4j_max<float>(b[r * 4 + 1], b[r * 4 + 3]);
+        float h = nd4j::math::nd4j_max<float>(0.f, nd4j::math::nd4j_min<float>(ly1, ry1) - nd4j::math::nd4j_max<float>(ly0, ry0));
+        float w = nd4j::math::nd4j_max<float>(0.f, nd4j::math::nd4j_min<float>(lx1, rx1) - nd4j::math::nd4j_max<float>(lx0, rx0));
+        float inter = h * w;
+        return inter / ((ly1 - ly0) * (lx1 - lx0) + (ry1 - ry0) * (rx1 - rx0) - inter);
+    };
+
+    const int maxSize = 150;
+    std::vector<int> reference;
+    for (int i = 0; i < numBoxes && (int) reference.size() < maxSize; i++) {
+        bool keep = true;
+        for (auto r: reference)
+            if (iou(order[i], r) > 0.5f) {
+                keep = false;
+                break;
+            }
+
+        if (keep)
+            reference.push_back(order[i]);
+    }
+    ASSERT_EQ(maxSize, (int) reference.size());
+
+    NDArray boxes = NDArrayFactory::create<float>('c', {numBoxes, 4}, b);
+    NDArray scales = NDArrayFactory::create<float>('c', {numBoxes}, s);
+
+    nd4j::ops::non_max_suppression op;
+    auto results = op.execute({&boxes, &scales}, {0.5}, {maxSize});
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    auto result = results->at(0);
+    ASSERT_EQ(maxSize, result->lengthOf());
+    for (int e = 0; e < maxSize; e++)
+        ASSERT_EQ(reference[e], result->e<int>(e));
+
+    // linear path, maxSize within NMS_GRID_THRESHOLD, must give the same prefix
+    auto linear = op.execute({&boxes, &scales}, {0.5}, {64});
+    ASSERT_EQ(ND4J_STATUS_OK, linear->status());
+    ASSERT_EQ(64, linear->at(0)->lengthOf());
+    for (int e = 0; e < 64; e++)
+        ASSERT_EQ(result->e<int>(e), linear->at(0)->e<int>(e));
+
+    delete linear;
+    delete results;
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests10, Image_CropAndResize_1) {
 
@@ -163,6 +163,38 @@ TEST_F(DeclarableOpsTests3, Test_Unique_2) {
     delete result;
 }
 
+TEST_F(DeclarableOpsTests3, Test_Unique_3) {
+    // long enough input to be split between threads, values first occur at positions 0..999
+    const int length = 100000;
+    auto x = NDArrayFactory::create<int>('c', {length});
+    for (int e = 0; e < length; e++)
+        x.p(e, (e * 7) % 1000);
+
+    nd4j::ops::unique_with_counts op;
+    auto result = op.execute({&x}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_EQ(3, result->size());
+
+    auto v = result->at(0);
+    auto i = result->at(1);
+    auto c = result->at(2);
+
+    ASSERT_EQ(1000, v->lengthOf());
+    ASSERT_EQ(length, i->lengthOf());
+    ASSERT_EQ(1000, c->lengthOf());
+
+    for (int e = 0; e < 1000; e++) {
+        ASSERT_EQ((e * 7) % 1000, v->e<int>(e));
+        ASSERT_EQ(100, c->e<Nd4jLong>(e));
+    }
+
+    for (int e = 0; e < length; e++)
+        ASSERT_EQ(e % 1000, i->e<Nd4jLong>(e));
+
+    delete result;
+}
+
 TEST_F(DeclarableOpsTests3, Test_Rint_1) {
     auto x= NDArrayFactory::create<float>('c', {1, 7}, {-1.7, -1.5, -0.2, 0.2, 1.5, 1.7, 2.0});
     auto exp= NDArrayFactory::create<float>('c', {1, 7}, {-2., -2., -0., 0., 2., 2., 2.});
@@ -399,6 +431,68 @@ TEST_F(DeclarableOpsTests3, Test_ListDiff_1) {
     delete result;
 }
 
+TEST_F(DeclarableOpsTests3, Test_ListDiff_2) {
+    // long enough input to be split between threads, keep has duplicates
+    const int length = 100000;
+    auto x = NDArrayFactory::create<int>('c', {length});
+    auto y = NDArrayFactory::create<int>('c', {668});
+    for (int e = 0; e < length; e++)
+        x.p(e, e % 1000);
+
+    for (int e = 0; e < 334; e++) {
+        y.p(e, e * 3);
+        y.p(334 + e, e * 3);
+    }
+
+    nd4j::ops::listdiff op;
+    auto result = op.execute({&x, &y}, {}, {});
+
+    ASSERT_EQ(Status::OK(), result->status());
+
+    auto z0 = result->at(0);
+    auto z1 = result->at(1);
+
+    Nd4jLong pos = 0;
+    for (int e = 0; e < length; e++) {
+        if ((e % 1000) % 3 == 0)
+            continue;
+
+        ASSERT_EQ(e % 1000, z0->e<int>(pos));
+        ASSERT_EQ(e, z1->e<Nd4jLong>(pos));
+        pos++;
+    }
+
+    ASSERT_EQ(pos, z0->lengthOf());
+    ASSERT_EQ(pos, z1->lengthOf());
+
+    delete result;
+}
+
+TEST_F(DeclarableOpsTests3, Test_ListDiff_3) {
+    // -0.0 and 0.0 are the same value
+    auto x= NDArrayFactory::create<float>('c', {5}, {0.f, 1.f, -0.f, 2.f, 0.f});
+    auto y= NDArrayFactory::create<float>('c', {1}, {-0.f});
+
+    auto exp0= NDArrayFactory::create<float>('c', {2}, {1, 2});
+    auto exp1= NDArrayFactory::create<Nd4jLong>('c', {2}, {1, 3});
+
+    nd4j::ops::listdiff op;
+    auto result = op.execute({&x, &y}, {}, {});
+
+    ASSERT_EQ(Status::OK(), result->status());
+
+    auto z0 = result->at(0);
+    auto z1 = result->at(1);
+
+    ASSERT_TRUE(exp0.isSameShape(z0));
+    ASSERT_TRUE(exp0.equalsTo(z0));
+
+    ASSERT_TRUE(exp1.isSameShape(z1));
+    ASSERT_TRUE(exp1.equalsTo(z1));
+
+    delete result;
+}
+
 TEST_F(DeclarableOpsTests3, Test_Range_1) {
     auto start = NDArrayFactory::create<float>(0.3);
     auto stop = NDArrayFactory::create<float>(-5);
@@ -756,6 +850,57 @@ TEST_F(DeclarableOpsTests3, Test_Batched_Gemm_7) {
     delete result;
 }
 
+TEST_F(DeclarableOpsTests3, Test_Batched_Gemm_8) {
+    // packed implementation uses 64x64 tiles of C and chunks of 256 along K, so every dimension spans several of them
+    const int M = 70, N = 130, K = 300, batchSize = 3;
+    const float alphas[] = {1.0f, 0.5f, 2.0f};
+    const float betas[] = {0.0f, 0.5f, 1.0f};
+
+    auto alpha = NDArrayFactory::create<float>('c', {1, 3}, {alphas[0], alphas[1], alphas[2]});
+    auto beta = NDArrayFactory::create<float>('c', {1, 3}, {betas[0], betas[1], betas[2]});
+
+    for (int transA = 0; transA < 2; transA++) {
+        for (int transB = 0; transB < 2; transB++) {
+            // transposed operands are c-ordered, so op(A) and op(B) are still [M, K] and [K, N]
+            std::vector<NDArray> a, b, c, exp;
+            for (int e = 0; e < batchSize; e++) {
+                a.emplace_back(NDArrayFactory::create<float>(transA ? 'c' : 'f', {M, K}));
+                b.emplace_back(NDArrayFactory::create<float>(transB ? 'c' : 'f', {K, N}));
+                c.emplace_back(NDArrayFactory::create<float>('f', {M, N}));
+                exp.emplace_back(NDArrayFactory::create<float>('f', {M, N}));
+            }
+
+            std::vector<NDArray*> inputs = {&alpha, &beta};
+            std::vector<NDArray*> outputs;
+            for (int e = 0; e < batchSize; e++) {
+                a[e].linspace(-1.0 + e, 1.0 / (M * K));
+                b[e].linspace(1.0 - e, -1.0 / (K * N));
+                c[e].linspace(0.5, 0.001);
+                exp[e].assign(c[e]);
+
+                MmulHelper::mmul(&a[e], &b[e], &exp[e], alphas[e], betas[e]);
+
+                inputs.emplace_back(&a[e]);
+                outputs.emplace_back(&c[e]);
+            }
+
+            for (int e = 0; e < batchSize; e++)
+                inputs.emplace_back(&b[e]);
+
+            std::vector<double> tArgs;
+            std::vector<Nd4jLong> iArgs = {transA ? 112 : 111, transB ? 112 : 111, M, N, K, transA ? K : M, transB ? N : K, M, batchSize};
+            std::vector<bool> bArgs;
+
+            nd4j::ops::batched_gemm op;
+            auto status = op.execute(inputs, outputs, tArgs, iArgs, bArgs);
+            ASSERT_EQ(ND4J_STATUS_OK, status);
+
+            for (int e = 0; e < batchSize; e++)
+                ASSERT_TRUE(exp[e].equalsTo(c[e], 1e-3));
+        }
+    }
+}
+
 TEST_F(DeclarableOpsTests3, Test_Batched_Gemm_Validation_1) {
     auto a = NDArrayFactory::create<float>('c', {1, 3}, {1, 1, 1});
     auto b = NDArrayFactory::create<double>('c', {1, 3}, {0, 0, 0});
@@ -1417,6 +1417,66 @@ TEST_F(DeclarableOpsTests4, lstm_test1) {
 } 
 
 
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests4, lstm_test2) {
+
+    const int time      = 4;
+    const int batchSize = 3;
+    const int inSize    = 5;
+    const int numProj   = 2;
+    const int numUnits  = 4;
+
+    auto x   = NDArrayFactory::create<double>('c', {time, batchSize, inSize});
+    auto h0  = NDArrayFactory::create<double>('c', {batchSize, numProj});
+    auto c0  = NDArrayFactory::create<double>('c', {batchSize, numUnits});
+    auto Wx  = NDArrayFactory::create<double>('c', {inSize, 4*numUnits});
+    auto Wh  = NDArrayFactory::create<double>('c', {numProj, 4*numUnits});
+    auto Wc  = NDArrayFactory::create<double>('c', {3*numUnits});
+    auto Wp  = NDArrayFactory::create<double>('c', {numUnits, numProj});
+    auto b   = NDArrayFactory::create<double>('c', {4*numUnits});
+
+    x.linspace(-1., 0.03);
+    h0.linspace(0.1, 0.1);
+    c0.linspace(-0.5, 0.2);
+    Wx.linspace(-0.4, 0.01);
+    Wh.linspace(0.3, -0.02);
+    Wc.linspace(0.1, 0.05);
+    Wp.linspace(-0.2, 0.07);
+    b.linspace(0.5, -0.05);
+
+    // peephole connections and projection are on, so all parts of sequence loop are compared against step-by-step lstmCell
+    nd4j::ops::lstm op;
+    auto results = op.execute({&x, &h0, &c0, &Wx, &Wh, &Wc, &Wp, &b}, {0., 0., 1.}, {1, 1});
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    auto h = results->at(0);
+    auto c = results->at(1);
+
+    nd4j::ops::lstmCell cellOp;
+    auto ht_1 = h0.dup();
+    auto ct_1 = c0.dup();
+
+    for (int t = 0; t < time; t++) {
+        auto xt = x({t,t+1, 0,0, 0,0});
+        auto step = cellOp.execute({&xt, ht_1, ct_1, &Wx, &Wh, &Wc, &Wp, &b}, {0., 0., 1.}, {1, 1});
+        ASSERT_EQ(ND4J_STATUS_OK, step->status());
+
+        auto ht = (*h)({t,t+1, 0,0, 0,0});
+        auto ct = (*c)({t,t+1, 0,0, 0,0});
+
+        ASSERT_TRUE(step->at(0)->equalsTo(&ht));
+        ASSERT_TRUE(step->at(1)->equalsTo(&ct));
+
+        ht_1->assign(step->at(0));
+        ct_1->assign(step->at(1));
+        delete step;
+    }
+
+    delete ht_1;
+    delete ct_1;
+    delete results;
+}
+
 ///////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests4, gru_test1) {
     
@@ -1117,6 +1117,38 @@ TEST_F(DeclarableOpsTests5, Test_TopK_5) {
     delete result;
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, Test_TopK_6) {
+    // second row has ties only: lower indices win
+    auto x = NDArrayFactory::create<float>('c', {2, 20});
+    for (int e = 0; e < 20; e++) {
+        x.p(0, e, static_cast<float>((e * 7) % 20));
+        x.p(1, e, 1.0f);
+    }
+
+    nd4j::ops::top_k op;
+
+    // bounded heap path
+    auto result = op.execute({&x}, {}, {2}, {true});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto expV = NDArrayFactory::create<float>('c', {2, 2}, {19.f, 18.f, 1.f, 1.f});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {2, 2}, {17, 14, 0, 1});
+    ASSERT_TRUE(expV.equalsTo(result->at(0)));
+    ASSERT_TRUE(expI.equalsTo(result->at(1)));
+    delete result;
+
+    // selection path, sorted by index
+    result = op.execute({&x}, {}, {5}, {false});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto expV2 = NDArrayFactory::create<float>('c', {2, 5}, {15.f, 16.f, 17.f, 18.f, 19.f, 1.f, 1.f, 1.f, 1.f, 1.f});
+    auto expI2 = NDArrayFactory::create<Nd4jLong>('c', {2, 5}, {5, 8, 11, 14, 17, 0, 1, 2, 3, 4});
+    ASSERT_TRUE(expV2.equalsTo(result->at(0)));
+    ASSERT_TRUE(expI2.equalsTo(result->at(1)));
+    delete result;
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests5, Test_InTopK_1) {
     auto x = NDArrayFactory::create<double>('c', {2, 3}, {1.0, 11.0, 3.0, 14.0, 5.0, 6.0});
@@ -1210,6 +1242,36 @@ TEST_F(DeclarableOpsTests5, Test_InTopK_3) {
     delete result;
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, Test_InTopK_4) {
+    auto x = NDArrayFactory::create<double>('c', {2, 3}, {1.0, 11.0, 3.0, 14.0, 5.0, 6.0});
+    auto y = NDArrayFactory::create<Nd4jLong>('c', {2}, {0, 2});
+    auto expV = NDArrayFactory::create<bool>('c', {2}, {true, true});
+
+    nd4j::ops::in_top_k op;
+
+    // k == width and k > width: every target is within top k
+    for (int k: {3, 5}) {
+        auto result = op.execute({&x, &y}, {}, {k});
+        ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+        auto v = result->at(0);
+        ASSERT_TRUE(expV.isSameShape(v));
+        ASSERT_TRUE(expV.equalsTo(v));
+
+        delete result;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, Test_InTopK_5) {
+    auto x = NDArrayFactory::create<double>('c', {2, 3}, {1.0, 11.0, 3.0, 14.0, 5.0, 6.0});
+    auto y = NDArrayFactory::create<Nd4jLong>('c', {2}, {0, 2});
+
+    nd4j::ops::in_top_k op;
+    ASSERT_THROW(op.execute({&x, &y}, {}, {0}), std::invalid_argument);
+}
+
 ///////////////////////////////////////////////////////////
 
 TEST_F(DeclarableOpsTests5, Test_Moments_1) {
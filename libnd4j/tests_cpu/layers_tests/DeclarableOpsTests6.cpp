@@ -24,6 +24,9 @@
 #include <helpers/helper_hash.h>
 #include <NDArray.h>
 #include <array/NDArrayList.h>
+#include <helpers/BlasHelper.h>
+#include <atomic>
+#include <cmath>
 
 
 using namespace nd4j;
@@ -508,6 +511,56 @@ TEST_F(DeclarableOpsTests6, BinCount_4) {
     delete res;
 }
 
+/////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, BinCount_5) {
+    // negative values and values beyond maxLength are skipped
+    auto x = NDArrayFactory::create<double>('c', {8}, {
+        -1, 0, 1, 5, 2, -3, 1, 7}
+    );
+
+    auto weights = NDArrayFactory::create<double>('c', {8}, {
+        10, 1, 2, 10, 3, 10, 4, 10}
+    );
+
+// ------------------------------------
+
+    auto exp = NDArrayFactory::create<double>({1., 6., 3., 0.});
+
+    nd4j::ops::bincount op;
+
+    auto res = op.execute({&x, &weights}, {}, {0, 4});
+
+    ASSERT_EQ(ND4J_STATUS_OK, res->status());
+    ASSERT_TRUE(exp.isSameShape(res->at(0)));
+    ASSERT_TRUE(exp.equalsTo(res->at(0)));
+
+    delete res;
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, BinCount_6) {
+    // long enough input to be split between thread-local histograms, with values -1..5 and only 5 bins
+    const int length = 100000;
+    auto x = NDArrayFactory::create<int>('c', {length});
+    for (int e = 0; e < length; e++)
+        x.p(e, e % 7 - 1);
+
+    NDArray exp('c', {5}, nd4j::DataType::INT32);
+    for (int e = 0; e < length; e++)
+        if (e % 7 >= 1 && e % 7 <= 5)
+            exp.p(e % 7 - 1, exp.e<int>(e % 7 - 1) + 1);
+
+    nd4j::ops::bincount op;
+
+    auto res = op.execute({&x}, {}, {0, 5});
+
+    ASSERT_EQ(ND4J_STATUS_OK, res->status());
+    ASSERT_TRUE(exp.isSameShape(res->at(0)));
+    ASSERT_TRUE(exp.equalsTo(res->at(0)));
+
+    delete res;
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests6, BroadcastDynamicShape_1) {
 
@@ -1019,6 +1072,272 @@ TEST_F(DeclarableOpsTests6, MatrixInverse_4) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, MatrixInverse_5) {
+    // batch of matrices larger than single panel of blocked decomposition
+    const int bS = 3;
+    const int n = 70;
+    auto x = NDArrayFactory::create<double>('c', {bS, n, n});
+    for (int b = 0; b < bS; b++)
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                x.p(b * n * n + i * n + j, ((i * 31 + j * 17 + b * 7) % 23) / 23.0 + (i == (j + b) % n ? 20.0 : 0.0));
+
+    nd4j::ops::matrix_inverse op;
+    auto result = op.execute({&x}, {}, {}, {}, false, nd4j::DataType::DOUBLE);
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto z = result->at(0);
+    ASSERT_TRUE(x.isSameShape(z));
+
+    // x * inv(x) must be identity
+    for (int b = 0; b < bS; b++)
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++) {
+                double sum = 0.;
+                for (int k = 0; k < n; k++)
+                    sum += x.e<double>(b * n * n + i * n + k) * z->e<double>(b * n * n + k * n + j);
+
+                ASSERT_NEAR(i == j ? 1.0 : 0.0, sum, 1e-8);
+            }
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, MatrixInverse_6) {
+    // small pivots alone don't make matrix singular
+    auto x = NDArrayFactory::create<float>('c', {2, 2}, {1e-4f, 0.f, 0.f, 1e-4f});
+    auto exp = NDArrayFactory::create<float>('c', {2, 2}, {1e4f, 0.f, 0.f, 1e4f});
+
+    nd4j::ops::matrix_inverse op;
+    auto result = op.execute({&x}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, MatrixInverse_7) {
+    // second row is first one times 2
+    auto x = NDArrayFactory::create<float>('c', {3, 3}, {1.f, 2.f, 3.f, 2.f, 4.f, 6.f, 1.f, 0.f, 1.f});
+
+    nd4j::ops::matrix_inverse op;
+    auto result = op.execute({&x}, {}, {});
+
+    ASSERT_NE(ND4J_STATUS_OK, result->status());
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, MatrixInverse_8) {
+    // ill-conditioned, but invertible
+    auto x = NDArrayFactory::create<float>('c', {2, 2}, {1e4f, 0.f, 0.f, 1e-4f});
+    auto exp = NDArrayFactory::create<float>('c', {2, 2}, {1e-4f, 0.f, 0.f, 1e4f});
+
+    nd4j::ops::matrix_inverse op;
+    auto result = op.execute({&x}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, LogMatrixDeterminant_2) {
+    // determinant of 70 x 70 matrix is way beyond float range, while its logarithm isn't
+    const int n = 70;
+    auto x = NDArrayFactory::create<float>('c', {n, n});
+
+    // rows of upper triangular matrix in reverse order, so every column needs pivoting
+    double expected = 0.;
+    for (int i = 0; i < n; i++) {
+        for (int j = i; j < n; j++)
+            x.p((n - 1 - i) * n + j, i == j ? 20.f + (i % 5) : ((i * 31 + j * 17) % 23) / 23.f);
+
+        expected += std::log(20. + (i % 5));
+    }
+
+    nd4j::ops::log_matrix_determinant op;
+    auto result = op.execute({&x}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_NEAR(expected, result->at(0)->e<double>(0), 1e-3);
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, LogMatrixDeterminant_3) {
+    // second matrix of the batch is singular
+    auto x = NDArrayFactory::create<double>('c', {2, 3, 3}, {-3.0, 0.0, 0.0, 0.0, 4.0, 0.0, 0.0, 0.0, -3.0,   1.0, 2.0, 3.0, 2.0, 4.0, 6.0, 0.0, 1.0, 1.0});
+
+    nd4j::ops::log_matrix_determinant op;
+    auto result = op.execute({&x}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto z = result->at(0);
+    ASSERT_NEAR(3.58351893845611, z->e<double>(0), 1e-8);
+    ASSERT_TRUE(std::isinf(z->e<double>(1)));
+    ASSERT_TRUE(z->e<double>(1) < 0.);
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// plain LAPACKE-compatible kernels, so decompositions can be routed through BlasHelper without LAPACK at hand
+static std::atomic<int> lapackCalls(0);
+
+static int referenceDgetrf(LAPACK_LAYOUT layout, int m, int n, double *a, int lda, int *ipiv) {
+    lapackCalls++;
+    int info = 0;
+    for (int k = 0; k < n; k++) {
+        int pivot = k;
+        for (int r = k + 1; r < m; r++)
+            if (std::abs(a[r * lda + k]) > std::abs(a[pivot * lda + k]))
+                pivot = r;
+
+        // pivots are 1-based, and every row swap is applied to the whole row
+        ipiv[k] = pivot + 1;
+        if (pivot != k)
+            for (int j = 0; j < n; j++)
+                std::swap(a[k * lda + j], a[pivot * lda + j]);
+
+        if (a[k * lda + k] == 0.) {
+            if (info == 0)
+                info = k + 1;
+            continue;
+        }
+
+        for (int r = k + 1; r < m; r++) {
+            a[r * lda + k] /= a[k * lda + k];
+            for (int j = k + 1; j < n; j++)
+                a[r * lda + j] -= a[r * lda + k] * a[k * lda + j];
+        }
+    }
+
+    return info;
+}
+
+static int referenceDpotrf(LAPACK_LAYOUT layout, char uplo, int n, double *a, int lda) {
+    lapackCalls++;
+    for (int j = 0; j < n; j++) {
+        for (int p = 0; p < j; p++)
+            a[j * lda + j] -= a[j * lda + p] * a[j * lda + p];
+
+        a[j * lda + j] = std::sqrt(a[j * lda + j]);
+
+        for (int i = j + 1; i < n; i++) {
+            for (int p = 0; p < j; p++)
+                a[i * lda + j] -= a[i * lda + p] * a[j * lda + p];
+
+            a[i * lda + j] /= a[j * lda + j];
+        }
+    }
+
+    return 0;
+}
+
+// routes double getrf/potrf of BlasHelper to reference kernels, and restores previous function table afterwards
+class LapackGuard {
+public:
+    LapackGuard() {
+        auto blas = BlasHelper::getInstance();
+        _saved[0] = blas->hasGETRF<float>() ? (Nd4jPointer) blas->sgetrf() : nullptr;
+        _saved[1] = blas->hasGETRF<double>() ? (Nd4jPointer) blas->dgetrf() : nullptr;
+        _saved[2] = blas->hasPOTRF<float>() ? (Nd4jPointer) blas->spotrf() : nullptr;
+        _saved[3] = blas->hasPOTRF<double>() ? (Nd4jPointer) blas->dpotrf() : nullptr;
+
+        Nd4jPointer functions[4];
+        std::copy(_saved, _saved + 4, functions);
+        functions[1] = (Nd4jPointer) &referenceDgetrf;
+        functions[3] = (Nd4jPointer) &referenceDpotrf;
+        blas->initializeLapackFunctions(functions);
+    }
+
+    ~LapackGuard() {
+        BlasHelper::getInstance()->initializeLapackFunctions(_saved);
+    }
+
+private:
+    Nd4jPointer _saved[4];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, MatrixInverse_Lapack_1) {
+    // dominant elements sit off diagonal, so LAPACK pivots have to be turned into permutation with cycles
+    const int bS = 3;
+    const int n = 40;
+    auto x = NDArrayFactory::create<double>('c', {bS, n, n});
+    for (int b = 0; b < bS; b++)
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                x.p(b * n * n + i * n + j, ((i * 31 + j * 17 + b * 7) % 23) / 23.0 + (i == (j * (b + 1) + b) % n ? 20.0 : 0.0) + (b == 2 && i == j ? 30.0 : 0.0));
+
+    // symmetric positive definite matrices for cholesky
+    auto y = NDArrayFactory::create<double>('c', {bS, n, n});
+    for (int b = 0; b < bS; b++)
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                y.p(b * n * n + i * n + j, ((i * j + b) % 7) / 7.0 + (i == j ? n : 0.0));
+
+    nd4j::ops::matrix_determinant det;
+    nd4j::ops::log_matrix_determinant logDet;
+    nd4j::ops::matrix_inverse inverse;
+    nd4j::ops::cholesky cholesky;
+
+    auto expDet = det.execute({&x}, {}, {});
+    auto expLogDet = logDet.execute({&x}, {}, {});
+    auto expInverse = inverse.execute({&x}, {}, {}, {}, false, nd4j::DataType::DOUBLE);
+    auto expCholesky = cholesky.execute({&y}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, expDet->status());
+    ASSERT_EQ(ND4J_STATUS_OK, expLogDet->status());
+    ASSERT_EQ(ND4J_STATUS_OK, expInverse->status());
+    ASSERT_EQ(ND4J_STATUS_OK, expCholesky->status());
+
+    lapackCalls = 0;
+    {
+        LapackGuard guard;
+
+        auto resDet = det.execute({&x}, {}, {});
+        auto resLogDet = logDet.execute({&x}, {}, {});
+        auto resInverse = inverse.execute({&x}, {}, {}, {}, false, nd4j::DataType::DOUBLE);
+        auto resCholesky = cholesky.execute({&y}, {}, {});
+
+        ASSERT_EQ(4 * bS, lapackCalls.load());
+
+        ASSERT_EQ(ND4J_STATUS_OK, resDet->status());
+        ASSERT_EQ(ND4J_STATUS_OK, resLogDet->status());
+        ASSERT_EQ(ND4J_STATUS_OK, resInverse->status());
+        ASSERT_EQ(ND4J_STATUS_OK, resCholesky->status());
+
+        // determinant signs depend on permutation parity
+        for (int b = 0; b < bS; b++)
+            ASSERT_NEAR(1.0, resDet->at(0)->e<double>(b) / expDet->at(0)->e<double>(b), 1e-10);
+
+        ASSERT_TRUE(expLogDet->at(0)->equalsTo(resLogDet->at(0), 1e-10));
+        ASSERT_TRUE(expInverse->at(0)->equalsTo(resInverse->at(0), 1e-10));
+        ASSERT_TRUE(expCholesky->at(0)->equalsTo(resCholesky->at(0), 1e-10));
+
+        delete resDet;
+        delete resLogDet;
+        delete resInverse;
+        delete resCholesky;
+    }
+
+    delete expDet;
+    delete expLogDet;
+    delete expInverse;
+    delete expCholesky;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests6, ReluLayer_1) {
     auto x = NDArrayFactory::create<double>('c', {3, 4}, {1.0, -2.0, 3.0, 4.0, 5.0, -6.0, 7.0, 8.0, 9.0, -10.0, 11.0, 12});
@@ -1748,6 +1748,35 @@ TEST_F(DeclarableOpsTests7, TestUnsortedSegmentSum_4) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, TestUnsortedSegmentSum_5) {
+    // rows are longer than single column block, and input is 'f'-ordered
+    auto x = NDArrayFactory::create<float>('f', {6, 1500});
+    auto idx = NDArrayFactory::create<int>({2, 0, 2, 0, 3, 2});
+    auto exp = NDArrayFactory::create<float>('c', {5, 1500});
+
+    for (int r = 0; r < 6; r++)
+        for (int c = 0; c < 1500; c++)
+            x.p(r, c, static_cast<float>(r + 1));
+
+    for (int c = 0; c < 1500; c++) {
+        exp.p(0, c, 6.f);
+        exp.p(1, c, 0.f);
+        exp.p(2, c, 10.f);
+        exp.p(3, c, 5.f);
+        exp.p(4, c, 0.f);
+    }
+
+    nd4j::ops::unsorted_segment_sum op;
+
+    auto result = op.execute({&x, &idx}, {}, {5});
+    ASSERT_EQ(result->status(), Status::OK());
+    ASSERT_TRUE(exp.isSameShape(result->at(0)));
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+    delete result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests7, TestSegmentProd_1) {
     auto x = NDArrayFactory::create<double>({1.8, 2.5, 4.,  9., 2.1, 2.4,3.,9., 2.1, 2.1,0.7, 0.1, 3., 4.2, 2.2, 1.});
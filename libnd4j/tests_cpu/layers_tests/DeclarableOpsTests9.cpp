@@ -2741,6 +2741,42 @@ TEST_F(DeclarableOpsTests9, Cholesky_Test_2) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests9, Cholesky_Test_3) {
+    // matrices span several panels of blocked decomposition
+    const int bS = 2;
+    const int n = 70;
+    auto x = NDArrayFactory::create<double>('c', {bS, n, n});
+    for (int b = 0; b < bS; b++)
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                x.p(b * n * n + i * n + j, ((i * j + i + j + b) % 11) / 11.0 + (i == j ? n : 0.0));
+
+    nd4j::ops::cholesky op;
+
+    auto result = op.execute({&x}, {}, {});
+    ASSERT_EQ(result->status(), ND4J_STATUS_OK);
+    auto res = result->at(0);
+    ASSERT_TRUE(x.isSameShape(res));
+
+    // lower triangular, and L * L^T must give input back
+    for (int b = 0; b < bS; b++)
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++) {
+                if (j > i) {
+                    ASSERT_EQ(0.0, res->e<double>(b * n * n + i * n + j));
+                }
+
+                double sum = 0.;
+                for (int k = 0; k <= nd4j::math::nd4j_min<int>(i, j); k++)
+                    sum += res->e<double>(b * n * n + i * n + k) * res->e<double>(b * n * n + j * n + k);
+
+                ASSERT_NEAR(x.e<double>(b * n * n + i * n + j), sum, 1e-8);
+            }
+
+    delete result;
+}
+
 ////////////////////////////////////////////////////////////////////
 // TEST_F(DeclarableOpsTests9, gru_bp_test1) {
 
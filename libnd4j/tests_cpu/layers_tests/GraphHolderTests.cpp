@@ -20,6 +20,8 @@
 
 #include "testlayers.h"
 #include <graph/GraphHolder.h>
+#include <GraphExecutioner.h>
+#include <ops/declarable/CustomOperations.h>
 
 using namespace nd4j;
 using namespace nd4j::ops;
@@ -83,4 +85,180 @@ TEST_F(GraphHolderTests, SimpleTests_3) {
 
 
     delete graph2;
-}
\ No newline at end of file
+}
+
+TEST_F(GraphHolderTests, Sessions_Reuse_1) {
+    auto graph = new Graph;
+    Nd4jLong graphId = 121;
+
+    graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {3, 3}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {}));
+
+    GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    auto session = GraphHolder::getInstance()->checkoutSession(graphId);
+    ASSERT_TRUE(session->graph() != graph);
+
+    // busy session can't be given away
+    auto other = GraphHolder::getInstance()->checkoutSession(graphId);
+    ASSERT_TRUE(other != session);
+
+    auto x = NDArrayFactory::create<float>('c', {3, 3});
+    x.assign(-2.0f);
+    std::vector<Variable*> inputs({new Variable(new NDArray(x), nullptr, -1, 0)});
+    session->feed(inputs);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(session->graph()));
+
+    auto input = session->graph()->getVariableSpace()->getVariable(-1)->getNDArray();
+    auto output = session->graph()->getVariableSpace()->getVariable(1)->getNDArray();
+    ASSERT_NEAR(2.0f, output->meanNumber().e<float>(0), 1e-5);
+
+    // original graph is left intact
+    ASSERT_FALSE(graph->getVariableSpace()->getVariable(-1)->getNDArray() == input);
+
+    session->reset();
+    GraphHolder::getInstance()->releaseSession(graphId, session);
+
+    auto reused = GraphHolder::getInstance()->checkoutSession(graphId);
+    ASSERT_TRUE(reused == session);
+
+    // same shape: arrays stay in place, only data is updated
+    x.assign(-3.0f);
+    std::vector<Variable*> inputs2({new Variable(new NDArray(x), nullptr, -1, 0)});
+    reused->feed(inputs2);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(reused->graph()));
+
+    ASSERT_TRUE(input == reused->graph()->getVariableSpace()->getVariable(-1)->getNDArray());
+    ASSERT_TRUE(output == reused->graph()->getVariableSpace()->getVariable(1)->getNDArray());
+    ASSERT_NEAR(3.0f, output->meanNumber().e<float>(0), 1e-5);
+
+    GraphHolder::getInstance()->releaseSession(graphId, reused);
+    GraphHolder::getInstance()->releaseSession(graphId, other);
+
+    GraphHolder::getInstance()->dropGraphAny(graphId);
+    ASSERT_FALSE(GraphHolder::getInstance()->hasGraph(graphId));
+}
+
+TEST_F(GraphHolderTests, Sessions_Guard_1) {
+    auto graph = new Graph;
+    Nd4jLong graphId = 123;
+
+    graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {3, 3}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {}));
+
+    auto holder = GraphHolder::getInstance();
+    holder->registerGraph(graphId, graph);
+
+    // any exception, not only std::exception, drops the session and releases the lock
+    try {
+        GraphSessionGuard guard(holder, graphId);
+        throw 42;
+    } catch (int e) {
+        //
+    }
+
+    ASSERT_EQ(0, holder->idleSessions(graphId));
+
+    {
+        GraphSessionGuard guard(holder, graphId);
+        guard.release();
+    }
+
+    ASSERT_EQ(1, holder->idleSessions(graphId));
+
+    // idle pool is bounded
+    std::vector<GraphSession*> sessions;
+    for (int e = 0; e < GRAPH_HOLDER_MAX_IDLE_SESSIONS + 4; e++)
+        sessions.emplace_back(holder->checkoutSession(graphId));
+
+    for (auto session: sessions)
+        holder->releaseSession(graphId, session);
+
+    ASSERT_EQ(GRAPH_HOLDER_MAX_IDLE_SESSIONS, holder->idleSessions(graphId));
+
+    // would dead-lock if any read lock was left behind
+    holder->dropGraphAny(graphId);
+    ASSERT_FALSE(holder->hasGraph(graphId));
+    ASSERT_EQ(0, holder->idleSessions(graphId));
+}
+
+TEST_F(GraphHolderTests, Sessions_Memory_Plan_1) {
+    auto graph = new Graph;
+    Nd4jLong graphId = 122;
+
+    graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {4, 4}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Neg, 2, {1}, {}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Neg, 3, {2}, {}));
+
+    GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    auto x = NDArrayFactory::create<float>('c', {4, 4});
+
+    for (int e = 1; e <= 3; e++) {
+        auto session = GraphHolder::getInstance()->checkoutSession(graphId);
+
+        x.assign(-e);
+        std::vector<Variable*> inputs({new Variable(new NDArray(x), nullptr, -1, 0)});
+        session->feed(inputs);
+
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(session->graph()));
+
+        auto z = session->graph()->getVariableSpace()->getVariable(3)->getNDArray();
+        ASSERT_NEAR((float) e, z->meanNumber().e<float>(0), 1e-5);
+
+        // since second run, intermediate arrays are placed within plan arena
+        if (e > 1) {
+            ASSERT_TRUE(session->memoryPlan() != nullptr);
+
+            ASSERT_TRUE(session->graph()->getVariableSpace()->memoryPlan() == session->memoryPlan());
+
+            // nodes 1 and 2 are planned, node 3 is graph output
+            ASSERT_EQ(2, session->memoryPlan()->numberOfPlanned());
+            ASSERT_EQ(2 * 64, session->memoryPlan()->arenaSize());
+        }
+
+        session->reset();
+        GraphHolder::getInstance()->releaseSession(graphId, session);
+    }
+
+    GraphHolder::getInstance()->dropGraphAny(graphId);
+}
+
+TEST_F(GraphHolderTests, Sessions_Reuse_2) {
+    nd4j::ops::unique op;
+
+    auto graph = new Graph;
+    Nd4jLong graphId = 124;
+
+    graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {6}));
+    graph->addNode(new Node(&op, 1, {-1}));
+
+    auto holder = GraphHolder::getInstance();
+    holder->registerGraph(graphId, graph);
+
+    // same input shape, but number of unique values differs between runs
+    std::vector<std::vector<float>> values = {{1, 2, 3, 4, 5, 6}, {1, 1, 2, 2, 2, 1}, {3, 3, 3, 3, 3, 3}, {6, 5, 4, 3, 2, 1}};
+    std::vector<Nd4jLong> lengths = {6, 2, 1, 6};
+
+    for (int e = 0; e < (int) values.size(); e++) {
+        auto session = holder->checkoutSession(graphId);
+
+        std::vector<Variable*> inputs({new Variable(NDArrayFactory::create_<float>('c', {6}, values[e]), nullptr, -1, 0)});
+        session->feed(inputs);
+
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(session->graph()));
+
+        auto z = session->graph()->getVariableSpace()->getVariable(1, 0)->getNDArray();
+        auto i = session->graph()->getVariableSpace()->getVariable(1, 1)->getNDArray();
+        ASSERT_EQ(lengths[e], z->lengthOf());
+        ASSERT_EQ(6, i->lengthOf());
+
+        session->reset();
+        holder->releaseSession(graphId, session);
+    }
+
+    holder->dropGraphAny(graphId);
+}
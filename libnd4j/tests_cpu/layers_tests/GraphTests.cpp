@@ -25,9 +25,13 @@
 #include <graph/Node.h>
 #include <graph/Graph.h>
 #include <graph/GraphUtils.h>
+#include <graph/MemoryPlan.h>
 #include <NDArray.h>
 #include <ops/declarable/DeclarableOp.h>
 #include <ops/declarable/generic/parity_ops.cpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -1636,3 +1640,199 @@ TEST_F(GraphTests, Test_Minifier_3) {
     //ASSERT_EQ(0, unlink("libnd4j_mini3.hpp"));
 
 }
+
+#ifdef _OPENMP
+// dataflow executor is used only if more than one thread is available, so we force threads for the scope of test
+class OmpThreadsGuard {
+private:
+    int _threads;
+
+public:
+    explicit OmpThreadsGuard(int threads) : _threads(omp_get_max_threads()) { omp_set_num_threads(threads); }
+    ~OmpThreadsGuard() { omp_set_num_threads(_threads); }
+};
+#endif
+
+TEST_F(GraphTests, Test_Dataflow_Execution_1) {
+#ifdef _OPENMP
+    OmpThreadsGuard guard(4);
+#endif
+
+    auto graph = new Graph();
+    graph->getExecutorConfiguration()->_executionMode = ExecutionMode_AUTO;
+
+    auto x = NDArrayFactory::create_<float>('c', {5, 5});
+    x->assign(-2.0);
+
+    auto y = NDArrayFactory::create_<float>('c', {5, 5});
+    y->assign(-1.0);
+
+    auto z = NDArrayFactory::create_<float>('c', {5, 5});
+
+    graph->getVariableSpace()->putVariable(-1, x);
+    graph->getVariableSpace()->putVariable(-2, y);
+    graph->getVariableSpace()->putVariable(-3, z);
+
+    // two independent towers, joined by the last node
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {3});
+    auto nodeB = new Node(OpType_TRANSFORM_SAME, transform::Abs, 2, {-2}, {4});
+    auto nodeC = new Node(OpType_TRANSFORM_SAME, transform::Square, 3, {1}, {5});
+    auto nodeD = new Node(OpType_TRANSFORM_SAME, transform::Neg, 4, {2}, {5});
+    auto nodeE = new Node(OpType_PAIRWISE, pairwise::Add, 5, {3, 4}, {-3});
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+    graph->addNode(nodeC);
+    graph->addNode(nodeD);
+    graph->addNode(nodeE);
+
+    ASSERT_EQ(2, graph->rootNodes());
+    ASSERT_EQ(5, graph->totalNodes());
+
+    auto status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    ASSERT_NEAR(3.0, z->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+
+    delete graph;
+}
+
+TEST_F(GraphTests, Test_Memory_Plan_1) {
+    Graph graph;
+
+    graph.getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {5, 5}));
+
+    graph.addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {}));
+    graph.addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 2, {1}, {}));
+    graph.addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 3, {2}, {}));
+    graph.addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 4, {3}, {}));
+
+    ASSERT_EQ(Status::OK(), graph.buildGraph());
+
+    std::map<std::pair<int, int>, Nd4jLong> sizes;
+    for (int e = 1; e <= 4; e++)
+        sizes[{e, 0}] = 100;
+
+    MemoryPlan plan(&graph, sizes);
+
+    std::pair<int, int> p1(1, 0), p2(2, 0), p3(3, 0), p4(4, 0);
+
+    // graph output isn't planned
+    ASSERT_FALSE(plan.hasOffset(p4));
+    ASSERT_EQ(3, plan.numberOfPlanned());
+
+    // node 3 output reuses memory of node 1 output, which is dead by then
+    ASSERT_EQ(plan.offset(p1), plan.offset(p3));
+    ASSERT_NE(plan.offset(p1), plan.offset(p2));
+
+    ASSERT_EQ(300, plan.totalSize());
+    ASSERT_EQ(2 * 128, plan.arenaSize());
+}
+
+// graph fusion is a process-wide switch, so it's restored even if test fails
+class GraphFusionGuard {
+private:
+    bool _fusion;
+
+public:
+    explicit GraphFusionGuard(bool fusion) : _fusion(Environment::getInstance()->isGraphFusion()) { Environment::getInstance()->setGraphFusion(fusion); }
+    ~GraphFusionGuard() { Environment::getInstance()->setGraphFusion(_fusion); }
+};
+
+TEST_F(GraphTests, Test_Elementwise_Fusion_1) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {64, 300});
+    auto b = NDArrayFactory::create_<float>('c', {300});
+    auto y = NDArrayFactory::create_<float>('c', {64, 300});
+    x->linspace(-3.0, 0.001);
+    b->linspace(-1.0, 0.01);
+    y->assign(0.5f);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+    graph->getVariableSpace()->putVariable(-2, b);
+    graph->getVariableSpace()->putVariable(-3, y);
+
+    // |(x + b) * 2| - y
+    auto nodeA = new Node(OpType_BROADCAST, broadcast::Add, 1, {-1, -2}, {2}, {1});
+    auto nodeB = new Node(OpType_SCALAR, scalar::Multiply, 2, {1}, {3}, {}, 2.0f);
+    auto nodeC = new Node(OpType_TRANSFORM_SAME, transform::Abs, 3, {2}, {4});
+    auto nodeD = new Node(OpType_PAIRWISE, pairwise::Subtract, 4, {3, -3}, {});
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+    graph->addNode(nodeC);
+    graph->addNode(nodeD);
+
+    {
+        GraphFusionGuard guard(true);
+        graph->buildGraph();
+    }
+
+    // whole chain is collapsed into its last node
+    ASSERT_EQ(1, graph->totalNodes());
+
+    auto status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    ASSERT_TRUE(graph->getVariableSpace()->hasVariable(4));
+    auto z = graph->getVariableSpace()->getVariable(4)->getNDArray();
+
+    for (int r = 0; r < 64; r++)
+        for (int c = 0; c < 300; c++) {
+            auto exp = nd4j::math::nd4j_abs<float>((x->e<float>(r, c) + b->e<float>(c)) * 2.0f) - 0.5f;
+            ASSERT_NEAR(exp, z->e<float>(r, c), 1e-4);
+        }
+
+    delete graph;
+}
+
+TEST_F(GraphTests, Test_Elementwise_Fusion_2) {
+    auto graph = new Graph();
+
+    // f-ordered operands and broadcast along first dimension rule out blocked execution
+    auto x = NDArrayFactory::create_<float>('f', {30, 40});
+    auto b = NDArrayFactory::create_<float>('c', {30});
+    auto y = NDArrayFactory::create_<float>('f', {30, 40});
+    x->linspace(-3.0, 0.005);
+    b->linspace(-1.0, 0.05);
+    y->linspace(0.5, 0.001);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+    graph->getVariableSpace()->putVariable(-2, b);
+    graph->getVariableSpace()->putVariable(-3, y);
+
+    // |(x + b) * 2| - y
+    auto nodeA = new Node(OpType_BROADCAST, broadcast::Add, 1, {-1, -2}, {2}, {0});
+    auto nodeB = new Node(OpType_SCALAR, scalar::Multiply, 2, {1}, {3}, {}, 2.0f);
+    auto nodeC = new Node(OpType_TRANSFORM_SAME, transform::Abs, 3, {2}, {4});
+    auto nodeD = new Node(OpType_PAIRWISE, pairwise::Subtract, 4, {3, -3}, {});
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+    graph->addNode(nodeC);
+    graph->addNode(nodeD);
+
+    {
+        GraphFusionGuard guard(true);
+        graph->buildGraph();
+    }
+
+    ASSERT_EQ(1, graph->totalNodes());
+    ASSERT_FALSE(Environment::getInstance()->isGraphFusion());
+
+    auto status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    ASSERT_TRUE(graph->getVariableSpace()->hasVariable(4));
+    auto z = graph->getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_TRUE(z->isSameShape(x));
+
+    for (int r = 0; r < 30; r++)
+        for (int c = 0; c < 40; c++) {
+            auto exp = nd4j::math::nd4j_abs<float>((x->e<float>(r, c) + b->e<float>(r)) * 2.0f) - y->e<float>(r, c);
+            ASSERT_NEAR(exp, z->e<float>(r, c), 1e-4);
+        }
+
+    delete graph;
+}
@@ -26,6 +26,7 @@
 #include <ops/declarable/helpers/rnn.h>
 #include <ops/declarable/helpers/sg_cb.h>
 #include <MmulHelper.h>
+#include <helpers/StridedIterator.h>
 #include <GradCheck.h>
 #include <ops/declarable/CustomOperations.h>
 
@@ -2055,4 +2056,117 @@ TEST_F(HelpersTests1, mmulMxV_7) {
 
     nd4j::MmulHelper::mmul(&a, &x, &y, 1., 0.);    
     ASSERT_TRUE(y.equalsTo(&exp));    
-}
\ No newline at end of file
+}
+
+//////////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, StridedIterator_1) {
+    NDArray x('c', {3, 4, 5}, nd4j::DataType::FLOAT32);
+    x.permutei({2, 0, 1});
+
+    // every c-order logical index of permuted view matches shape::getIndexOffset
+    Nd4jLong index = 0;
+    bool matches = true;
+    StridedIterator::loop(0, x.lengthOf(), x.getShapeInfo(), [&](Nd4jLong offset) {
+        matches &= offset == shape::getIndexOffset(index++, x.getShapeInfo(), x.lengthOf());
+    });
+
+    ASSERT_TRUE(matches);
+    ASSERT_EQ(x.lengthOf(), index);
+}
+
+//////////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, StridedIterator_2) {
+    Nd4jLong shapeInfo[] = {2, 3, 0, 0, 1, 0, 1, 99};
+
+    // arrays with zero dimension are visited without any element
+    StridedCursor cursor(shapeInfo);
+    cursor.seek(0);
+    ASSERT_EQ(0, cursor.offset());
+    ASSERT_EQ(0, cursor.innerRemaining());
+
+    int visited = 0;
+    StridedIterator::loop(0, 0, shapeInfo, [&](Nd4jLong offset) {
+        visited++;
+    });
+
+    ASSERT_EQ(0, visited);
+}
+
+#ifdef HAVE_MKLDNN
+///////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, MKLDNNStreamCache_1) {
+    auto cache = MKLDNNStreamCache::getInstance();
+    cache->setCapacity(2);
+
+    auto group = [] () { return std::vector<MKLDNNStream>{MKLDNNStream("cache_test")}; };
+
+    cache->release("a", group());
+    cache->release("b", group());
+
+    // "a" is checked out and released again, so "b" becomes least recently used group
+    std::vector<MKLDNNStream> streams;
+    ASSERT_TRUE(cache->checkout("a", streams));
+    ASSERT_EQ(1, cache->cachedEntries());
+    cache->release("a", std::move(streams));
+    cache->release("c", group());
+
+    ASSERT_EQ(2, cache->cachedEntries());
+    ASSERT_FALSE(cache->checkout("b", streams));
+    ASSERT_TRUE(cache->checkout("c", streams));
+    ASSERT_TRUE(cache->checkout("a", streams));
+    ASSERT_FALSE(cache->checkout("a", streams));
+    ASSERT_EQ(0, cache->cachedEntries());
+
+    // the same key might be pooled more than once, i.e. by concurrent calls
+    cache->release("d", group());
+    cache->release("d", group());
+    ASSERT_EQ(2, cache->cachedEntries());
+    ASSERT_TRUE(cache->checkout("d", streams));
+    ASSERT_TRUE(cache->checkout("d", streams));
+    ASSERT_FALSE(cache->checkout("d", streams));
+
+    cache->setCapacity(1024);
+}
+
+///////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, MKLDNNStream_Bindings_1) {
+    auto x = NDArrayFactory::create<float>('c', {4, 5});
+    auto z = NDArrayFactory::create<float>('c', {4, 5});
+    std::vector<float> scratch(20);
+
+    std::vector<MKLDNNStream> streams = {MKLDNNStream("bindings_test")};
+    ASSERT_TRUE(MKLDNNStream::acquire(streams, {&x}, {&z}, {1.f}, {2}));
+
+    mkldnn::memory::desc md({4, 5}, mkldnn::memory::data_type::f32, mkldnn::memory::format::nc);
+    mkldnn::memory::primitive_desc pd(md, streams[0].getEngine());
+    streams[0].setMemory({mkldnn::memory(pd, x.buffer()), mkldnn::memory(pd, scratch.data()), mkldnn::memory(pd, z.buffer())});
+
+    MKLDNNStream::release(streams);
+    ASSERT_TRUE(streams.empty());
+
+    // same shapes and arguments: memory is pointed to buffers of new arrays, while memory owned by stream stays intact
+    auto x2 = NDArrayFactory::create<float>('c', {4, 5});
+    auto z2 = NDArrayFactory::create<float>('c', {4, 5});
+
+    streams = {MKLDNNStream("bindings_test")};
+    ASSERT_FALSE(MKLDNNStream::acquire(streams, {&x2}, {&z2}, {1.f}, {2}));
+
+    auto memory = streams[0].getMemory();
+    ASSERT_EQ(3, memory.size());
+    ASSERT_TRUE(memory[0].get_data_handle() == x2.buffer());
+    ASSERT_TRUE(memory[1].get_data_handle() == scratch.data());
+    ASSERT_TRUE(memory[2].get_data_handle() == z2.buffer());
+
+    // arrays are rebound on every call, even if shapes are the same
+    ASSERT_FALSE(MKLDNNStream::acquire(streams, {&z2}, {&x2}, {1.f}, {2}));
+    memory = streams[0].getMemory();
+    ASSERT_TRUE(memory[0].get_data_handle() == z2.buffer());
+    ASSERT_TRUE(memory[2].get_data_handle() == x2.buffer());
+
+    // other arguments: built group goes back to cache, and fresh one has to be built
+    ASSERT_TRUE(MKLDNNStream::acquire(streams, {&x2}, {&z2}, {1.f}, {3}));
+    ASSERT_EQ(1, streams.size());
+    ASSERT_TRUE(streams[0].getMemory().empty());
+    ASSERT_EQ(std::string("bindings_test"), streams[0].getOpName());
+}
+#endif
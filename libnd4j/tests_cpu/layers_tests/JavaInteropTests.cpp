@@ -1174,4 +1174,97 @@ TEST_F(JavaInteropTests, Test_Results_Conversion_1) {
 
 
 //     ops.execAggregateBatchFloat(nullptr, numAggregates, opNum, maxArgs, maxShapes, maxIntArrays, maxIntArraySize, maxIndexArguments, maxRealArguments, pointer.data());
-// }
\ No newline at end of file
+// }
+
+TEST_F(JavaInteropTests, Test_Average_Accumulate_1) {
+    const int n = 6;
+    const int length = 10000;
+    std::vector<NDArray> arrays;
+    std::vector<Nd4jPointer> pointers(n);
+
+    for (int e = 0; e < n; e++)
+        arrays.emplace_back(NDArrayFactory::create<float>('c', {length}));
+
+    for (int e = 0; e < n; e++) {
+        arrays[e].linspace(e + 1.0f);
+        pointers[e] = reinterpret_cast<Nd4jPointer>(arrays[e].buffer());
+    }
+
+    // sum of linspace(e + 1) over e = 0..5 is 21 + 6 * i
+    auto expSum = NDArrayFactory::create<float>('c', {length});
+    expSum.linspace(21.0f, 6.0f);
+    auto expAvg = expSum / 6.0f;
+
+    auto z = NDArrayFactory::create<float>('c', {length});
+    z.assign(0.0f);
+
+    NativeOps nativeOps;
+    nativeOps.accumulate(nullptr, pointers.data(), z.shapeInfo(), nullptr, nullptr, z.buffer(), z.shapeInfo(), nullptr, nullptr, n, length);
+    ASSERT_TRUE(expSum.equalsTo(&z, 1e-5));
+
+    nativeOps.average(nullptr, pointers.data(), z.shapeInfo(), nullptr, nullptr, z.buffer(), z.shapeInfo(), nullptr, nullptr, n, length, true);
+    ASSERT_TRUE(expAvg.equalsTo(&z, 1e-5));
+
+    // averaged values are propagated back to all sources
+    for (int e = 0; e < n; e++)
+        ASSERT_TRUE(expAvg.equalsTo(&arrays[e], 1e-5));
+}
+
+TEST_F(JavaInteropTests, Test_Average_Inplace_1) {
+    const int n = 6;
+    const int length = 10000;
+    std::vector<NDArray> arrays;
+    std::vector<Nd4jPointer> pointers(n);
+
+    for (int e = 0; e < n; e++)
+        arrays.emplace_back(NDArrayFactory::create<float>('c', {length}));
+
+    for (int e = 0; e < n; e++) {
+        arrays[e].linspace(e + 1.0f);
+        pointers[e] = reinterpret_cast<Nd4jPointer>(arrays[e].buffer());
+    }
+
+    auto expAvg = NDArrayFactory::create<float>('c', {length});
+    expAvg.linspace(3.5f);
+
+    // without Z, result is stored into the first source
+    NativeOps nativeOps;
+    nativeOps.average(nullptr, pointers.data(), arrays[0].shapeInfo(), nullptr, nullptr, nullptr, arrays[0].shapeInfo(), nullptr, nullptr, n, length, true);
+
+    for (int e = 0; e < n; e++)
+        ASSERT_TRUE(expAvg.equalsTo(&arrays[e], 1e-5));
+}
+
+TEST_F(JavaInteropTests, Test_Average_Inplace_2) {
+    const int n = 4;
+    const int length = 5000;
+
+    // sum of sources doesn't fit into half, while each source and average do
+    std::vector<NDArray> halfs;
+    std::vector<Nd4jPointer> hPointers(n);
+    for (int e = 0; e < n; e++) {
+        halfs.emplace_back(NDArrayFactory::create<float16>('c', {length}));
+        halfs[e].assign(30000.f);
+        hPointers[e] = reinterpret_cast<Nd4jPointer>(halfs[e].buffer());
+    }
+
+    // integer sources are scaled one by one: 3 / 4 truncates to 0 for each of them
+    std::vector<NDArray> ints;
+    std::vector<Nd4jPointer> iPointers(n);
+    for (int e = 0; e < n; e++) {
+        ints.emplace_back(NDArrayFactory::create<int>('c', {length}));
+        ints[e].assign(3);
+        iPointers[e] = reinterpret_cast<Nd4jPointer>(ints[e].buffer());
+    }
+
+    NativeOps nativeOps;
+    nativeOps.average(nullptr, hPointers.data(), halfs[0].shapeInfo(), nullptr, nullptr, nullptr, halfs[0].shapeInfo(), nullptr, nullptr, n, length, true);
+    nativeOps.average(nullptr, iPointers.data(), ints[0].shapeInfo(), nullptr, nullptr, nullptr, ints[0].shapeInfo(), nullptr, nullptr, n, length, true);
+
+    for (int e = 0; e < n; e++) {
+        ASSERT_NEAR(30000.f, halfs[e].e<float>(0), 30.f);
+        ASSERT_NEAR(30000.f, halfs[e].e<float>(length - 1), 30.f);
+        ASSERT_EQ(0, ints[e].e<int>(0));
+        ASSERT_EQ(0, ints[e].e<int>(length - 1));
+    }
+}
@@ -321,6 +321,60 @@ TEST_F(LegacyOpsTests, ReduceTests_8) {
 }
 
 
+TEST_F(LegacyOpsTests, ReduceTests_9) {
+    // long rows: reduction gets split within each row
+    auto x = NDArrayFactory::create<float>('c', {3, 50000});
+    x.assign(0.1f);
+    x.p(1, 12345, 7.0f);
+
+    auto expSum = NDArrayFactory::create<float>('c', {3}, {5000.0f, 5006.9f, 5000.0f});
+    auto expMax = NDArrayFactory::create<float>('c', {3}, {0.1f, 7.0f, 0.1f});
+
+    auto sum = x.reduceAlongDims(reduce::Sum, {1});
+    auto max = x.reduceAlongDims(reduce::Max, {1});
+
+    ASSERT_TRUE(expSum.equalsTo(&sum, 1e-2));
+    ASSERT_TRUE(expMax.equalsTo(&max));
+
+    // results are the same for f order, where TADs aren't contiguous
+    auto xF = x.dup('f');
+    auto sumF = xF->reduceAlongDims(reduce::Sum, {1});
+    ASSERT_TRUE(sum.equalsTo(&sumF, 0.0));
+
+    delete xF;
+}
+
+
+TEST_F(LegacyOpsTests, Test_Permuted_Views_1) {
+    auto x = NDArrayFactory::create<float>('c', {4, 3, 50});
+    x.linspace(1);
+
+    // non-ews view, so strided paths are used
+    auto xP = x.permute({2, 0, 1});
+    auto xC = xP->dup('c');
+
+    auto zP = NDArrayFactory::create<float>('c', {50, 4, 3});
+    auto zC = NDArrayFactory::create<float>('c', {50, 4, 3});
+
+    xP->applyScalar(scalar::Multiply, 2.0f, &zP);
+    xC->applyScalar(scalar::Multiply, 2.0f, &zC);
+    ASSERT_TRUE(zC.equalsTo(&zP));
+
+    xP->applyPairwiseTransform(pairwise::Add, xP, &zP, nullptr);
+    xC->applyPairwiseTransform(pairwise::Add, xC, &zC, nullptr);
+    ASSERT_TRUE(zC.equalsTo(&zP));
+
+    auto sumP = xP->reduceAlongDims(reduce::Sum, {0});
+    auto sumC = xC->reduceAlongDims(reduce::Sum, {0});
+    ASSERT_TRUE(sumC.equalsTo(&sumP));
+
+    ASSERT_NEAR(xC->reduceNumber(reduce::Sum).e<float>(0), xP->reduceNumber(reduce::Sum).e<float>(0), 1e-5);
+
+    delete xP;
+    delete xC;
+}
+
+
 TEST_F(LegacyOpsTests, IndexReduceTests_1) {
     auto x = NDArrayFactory::create<float>('c', {5, 5});
     x.linspace(1);
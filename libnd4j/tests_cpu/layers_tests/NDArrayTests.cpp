@@ -2685,3 +2685,36 @@ TEST_F(NDArrayTest, assign_test1) {
     x.reshapei('c',{3, 2});    
     ASSERT_TRUE(x.equalsTo(y));
 }
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest, Test_Constant_Shape_1) {
+
+    auto x = NDArrayFactory::create<float>('c', {2, 3, 4});
+    auto y = NDArrayFactory::create<float>('c', {2, 3, 4});
+    auto z = NDArrayFactory::create<double>('c', {2, 3, 4});
+
+    ASSERT_TRUE(x.shapeInfo() == y.shapeInfo());
+    ASSERT_FALSE(x.shapeInfo() == z.shapeInfo());
+    ASSERT_TRUE(ConstantShapeHelper::getInstance()->isInterned(x.shapeInfo()));
+
+    // copies and views reference interned shapes as well
+    NDArray c(x);
+    ASSERT_TRUE(c.shapeInfo() == x.shapeInfo());
+
+    auto p0 = x.permute({2, 0, 1});
+    auto p1 = y.permute({2, 0, 1});
+    ASSERT_TRUE(p0->shapeInfo() == p1->shapeInfo());
+
+    // in-place changes never touch shared descriptor
+    y.permutei({1, 0, 2});
+    ASSERT_EQ(3, y.sizeAt(0));
+    ASSERT_EQ(2, x.sizeAt(0));
+    ASSERT_EQ(2, c.sizeAt(0));
+
+    y.reshapei('c', {6, 4});
+    ASSERT_EQ(3, x.rankOf());
+    ASSERT_EQ(4, p0->sizeAt(0));
+
+    delete p0;
+    delete p1;
+}
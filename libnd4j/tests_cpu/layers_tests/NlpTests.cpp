@@ -504,6 +504,93 @@ TEST_F(NlpTests, test_sg_ns_batch_1) {
     delete result;
 }
 
+TEST_F(NlpTests, test_sg_ns_minibatch_1) {
+    auto target = NDArrayFactory::create<int>('c', {2}, {0, 5});
+    auto ngStarter = NDArrayFactory::create<int>('c', {2}, {3, 8});
+    auto indices = NDArrayFactory::empty<int>();
+    auto codes = NDArrayFactory::empty<int8_t>();
+    auto syn0 = NDArrayFactory::create<float>('c', {100, 10});
+    auto syn1Neg = NDArrayFactory::create<float>('c', {100, 10});
+    auto syn1 = NDArrayFactory::empty<float>();
+    auto expTable = NDArrayFactory::create<float>('c', {10000});
+    auto negTable = NDArrayFactory::create<float>('c', {100000});
+
+    auto alpha = NDArrayFactory::create<double>('c', {2}, {0.025, 0.025});
+    auto randomValue = NDArrayFactory::create<Nd4jLong>('c', {2}, {1L, 3L});
+    auto inferenceVector = NDArrayFactory::empty<float>();
+    auto neu1e = NDArrayFactory::create<float>('c', {2, 10});
+
+    syn0.assign(0.01);
+    syn1Neg.assign(0.02);
+    expTable.assign(0.5);
+    negTable.assign(7);
+
+    // both pairs share single minibatch, so both of them are trained against the same 2 negatives, which are both word 7
+    nd4j::ops::skipgram op;
+    auto result = op.execute({&target, &ngStarter, &indices, &codes, &syn0, &syn1, &syn1Neg, &expTable, &negTable, &alpha, &randomValue, &inferenceVector, &neu1e}, {}, {1, 2, 2}, {false, true}, true);
+    ASSERT_EQ(Status::OK(), result->status());
+
+    for (int e = 0; e < 10; e++) {
+        // syn0: 0.01 + 0.0125 * 0.02 - 2 * 0.0125 * 0.02
+        ASSERT_NEAR(0.00975f, syn0.e<float>(0 * 10 + e), 1e-6);
+        ASSERT_NEAR(0.00975f, syn0.e<float>(5 * 10 + e), 1e-6);
+        ASSERT_NEAR(0.01f, syn0.e<float>(2 * 10 + e), 1e-6);
+
+        // positives: 0.02 + 0.0125 * 0.01
+        ASSERT_NEAR(0.020125f, syn1Neg.e<float>(3 * 10 + e), 1e-6);
+        ASSERT_NEAR(0.020125f, syn1Neg.e<float>(8 * 10 + e), 1e-6);
+
+        // shared negative gets contributions of 2 pairs x 2 rounds: 0.02 - 4 * 0.0125 * 0.01
+        ASSERT_NEAR(0.0195f, syn1Neg.e<float>(7 * 10 + e), 1e-6);
+    }
+
+    delete result;
+}
+
+TEST_F(NlpTests, test_cbow_ns_minibatch_1) {
+    auto target = NDArrayFactory::create<int>('c', {2}, {0, 0});
+    auto ngStarter = NDArrayFactory::create<int>('c', {2}, {3, 3});
+    auto context = NDArrayFactory::create<int>('c', {2, 3}, {0, 1, 2,  4, 5, -1});
+    auto indices = NDArrayFactory::empty<int>();
+    auto codes = NDArrayFactory::empty<int8_t>();
+    auto syn0 = NDArrayFactory::create<float>('c', {100, 10});
+    auto syn1 = NDArrayFactory::empty<float>();
+    auto syn1Neg = NDArrayFactory::create<float>('c', {100, 10});
+    auto expTable = NDArrayFactory::create<float>('c', {10000});
+    auto negTable = NDArrayFactory::create<float>('c', {100000});
+    auto numWords = NDArrayFactory::create<int>('c', {2}, {0, 0});
+
+    syn0.assign(0.01);
+    syn1Neg.assign(0.02);
+    expTable.assign(0.5);
+    negTable.assign(7);
+
+    auto alpha = NDArrayFactory::create<double>('c', {2}, {0.025, 0.025});
+    auto randomValue = NDArrayFactory::create<Nd4jLong>('c', {2}, {1L, 3L});
+    auto inferenceVector = NDArrayFactory::empty<float>();
+
+    // both windows share single minibatch and the same positive word, and are trained against the same 2 negatives, which are both word 7
+    nd4j::ops::cbow op;
+    auto result = op.execute({&target, &ngStarter, &context, &indices, &codes, &syn0, &syn1, &syn1Neg, &expTable, &negTable, &alpha, &randomValue, &numWords, &inferenceVector}, {}, {1, 2, 2}, {true}, true);
+    ASSERT_EQ(Status::OK(), result->status());
+
+    for (int e = 0; e < 10; e++) {
+        // context words: 0.01 + 0.0125 * 0.02 - 2 * 0.0125 * 0.02
+        for (auto w: {0, 1, 2, 4, 5})
+            ASSERT_NEAR(0.00975f, syn0.e<float>(w * 10 + e), 1e-6);
+
+        ASSERT_NEAR(0.01f, syn0.e<float>(3 * 10 + e), 1e-6);
+
+        // shared positive gets contributions of both windows: 0.02 + 2 * 0.0125 * 0.01
+        ASSERT_NEAR(0.02025f, syn1Neg.e<float>(3 * 10 + e), 1e-6);
+
+        // shared negative gets contributions of 2 windows x 2 rounds: 0.02 - 4 * 0.0125 * 0.01
+        ASSERT_NEAR(0.0195f, syn1Neg.e<float>(7 * 10 + e), 1e-6);
+    }
+
+    delete result;
+}
+
 TEST_F(NlpTests, test_cbow_hs_batch_1) {
     auto target = NDArrayFactory::create<int>(0);
     auto ngStarter = NDArrayFactory::empty<int>();
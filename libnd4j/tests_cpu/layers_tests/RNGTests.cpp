@@ -22,6 +22,7 @@
 #include <chrono>
 #include <NDArray.h>
 #include <helpers/RandomLauncher.h>
+#include <helpers/RandomFill.h>
 #include <ops/declarable/LegacyRandomOp.h>
 #include <ops/declarable/CustomOperations.h>
 
@@ -314,6 +315,29 @@ TEST_F(RNGTests, Test_Gaussian_3) {
 }
 
 
+TEST_F(RNGTests, Test_RandomFill_Normal_1) {
+    auto x0 = NDArrayFactory::create<float>('c', {1000000});
+    auto x1 = NDArrayFactory::create<float>('c', {1000000 + 5000});
+
+    // every element depends only on its index, so neither output length nor split between threads matter
+    RandomFill::normal<float>(_rngA, x0.bufferAsT<float>(), x0.lengthOf(), 0.f, 1.f);
+    RandomFill::normal<float>(_rngB, x1.bufferAsT<float>(), x1.lengthOf(), 0.f, 1.f);
+
+    for (Nd4jLong e = 0; e < x0.lengthOf(); e++)
+        ASSERT_EQ(x0.e<float>(e), x1.e<float>(e));
+
+    auto mean = x0.meanNumber().e<double>(0);
+    auto stdev = x0.varianceNumber(nd4j::variance::SummaryStatsStandardDeviation, false).e<double>(0);
+
+    ASSERT_NEAR(0.0, mean, 5e-3);
+    ASSERT_NEAR(1.0, stdev, 5e-3);
+
+    RandomFill::truncatedNormal<float>(_rngA, x0.bufferAsT<float>(), x0.lengthOf(), 1.f, 2.f);
+
+    ASSERT_TRUE(x0.reduceNumber(reduce::Max).e<float>(0) <= 5.f);
+    ASSERT_TRUE(x0.reduceNumber(reduce::Min).e<float>(0) >= -3.f);
+}
+
 TEST_F(RNGTests, Test_LogNormal_1) {
     auto x0 = NDArrayFactory::create<float>('c', {10, 10});
     auto x1 = NDArrayFactory::create<float>('c', {10, 10});
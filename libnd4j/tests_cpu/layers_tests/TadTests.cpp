@@ -24,6 +24,7 @@
 #include "testlayers.h"
 #include <NDArray.h>
 #include <helpers/TAD.h>
+#include <helpers/ConstantTadHelper.h>
 #include <array>
 
 using namespace nd4j;
@@ -179,6 +180,58 @@ TEST_F(TadTests, Tad_1D_1) {
 }
 */
 
+TEST_F(TadTests, Test_Tad_Cache_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4, 5});
+    std::vector<int> dimensions = {0, 2};
+
+    auto packA = ConstantTadHelper::getInstance()->tadForDimensions(x.shapeInfo(), dimensions);
+    auto packB = ConstantTadHelper::getInstance()->tadForDimensions(x.shapeInfo(), dimensions);
+
+    // same shape & dimensions should give us exactly the same pack
+    ASSERT_TRUE(packA.get() == packB.get());
+
+    shape::TAD tad(x.shapeInfo(), dimensions.data(), dimensions.size());
+    tad.createTadOnlyShapeInfo();
+    tad.createOffsets();
+
+    ASSERT_EQ(tad.numTads, packA->numberOfTads());
+    ASSERT_TRUE(shape::equalsStrict(tad.tadOnlyShapeInfo, packA->primaryShapeInfo()));
+
+    for (int e = 0; e < tad.numTads; e++)
+        ASSERT_EQ(tad.tadOffsets[e], packA->primaryOffsets()[e]);
+
+    // different dimensions must produce different pack
+    auto packC = ConstantTadHelper::getInstance()->tadForDimensions(x.shapeInfo(), {1});
+    ASSERT_FALSE(packA.get() == packC.get());
+    ASSERT_EQ(15, packC->numberOfTads());
+}
+
+///////////////////////////////////////////////////////////////////
+TEST_F(TadTests, Tad_Cache_Eviction_1) {
+    auto helper = ConstantTadHelper::getInstance();
+    helper->setCapacity(16);
+
+    // recently used pack survives eviction
+    auto x = NDArrayFactory::create<float>('c', {3, 7});
+    auto hot = helper->tadForDimensions(x.shapeInfo(), {1});
+
+    for (int e = 1; e <= 40; e++) {
+        auto y = NDArrayFactory::create<float>('c', {e, 5});
+        auto pack = helper->tadForDimensions(y.shapeInfo(), {1});
+        ASSERT_EQ(e, pack->numberOfTads());
+        ASSERT_TRUE(helper->cachedEntries() <= 16);
+
+        ASSERT_TRUE(hot.get() == helper->tadForDimensions(x.shapeInfo(), {1}).get());
+    }
+
+    // evicted packs stay valid for holders
+    helper->purge();
+    ASSERT_EQ(0, helper->cachedEntries());
+    ASSERT_EQ(3, hot->numberOfTads());
+
+    helper->setCapacity(4096);
+}
+
 ///////////////////////////////////////////////////////////////////
 /*
 TEST_F(TadTests, TestShapeTad_2) {
@@ -63,4 +63,115 @@ TEST_F(TypeCastTests, Test_ConvertDtype_1) {
 
     for (int e = 0; e < 5; e++)
         ASSERT_NEAR(exp[e], dst[e], (float16) 0.01f);
-}
\ No newline at end of file
+}
+
+TEST_F(TypeCastTests, Test_Threshold_Encode_Decode_1) {
+    const int length = 5000;
+    const int numBlocks = (length + 1023) / 1024;
+    const float threshold = 0.5f;
+
+    auto x = NDArrayFactory::create<float>('c', {length});
+    auto original = NDArrayFactory::create<float>('c', {length});
+    auto decoded = NDArrayFactory::create<float>('c', {length});
+    decoded.assign(0.0f);
+
+    int expCount = 0;
+    for (int e = 0; e < length; e++) {
+        float v = (e % 7 == 0 ? 0.7f : 0.1f) * (e % 2 == 0 ? 1.0f : -1.0f);
+        expCount += e % 7 == 0 ? 1 : 0;
+        x.p(e, v);
+        original.p(e, v);
+    }
+
+    std::vector<int> counts(numBlocks + 1);
+    std::vector<int> offsets(numBlocks);
+
+    NativeOps ops;
+    ops.encodeThresholdP1(nullptr, x.buffer(), x.shapeInfo(), length, counts.data(), threshold);
+    ASSERT_EQ(expCount, counts[0]);
+
+    ops.encodeThresholdP2Int(nullptr, counts.data(), numBlocks, offsets.data());
+    ASSERT_EQ(0, offsets[0]);
+    ASSERT_EQ(counts[1], offsets[1]);
+
+    std::vector<int> encoded(expCount + 4);
+    FloatBits fb;
+    fb.f_ = threshold;
+    encoded[0] = expCount;
+    encoded[1] = length;
+    encoded[2] = fb.i_;
+    encoded[3] = 0;
+
+    ops.encodeThresholdP3(nullptr, x.buffer(), x.shapeInfo(), offsets.data(), length, encoded.data());
+
+    // indices must be stored in ascending order, same as GPU does
+    for (int e = 4; e < expCount + 3; e++)
+        ASSERT_TRUE(std::abs(encoded[e]) < std::abs(encoded[e + 1]));
+
+    ops.decodeThreshold(nullptr, encoded.data(), length, decoded.buffer(), decoded.shapeInfo());
+
+    // decoded update plus residual left in x restores original values
+    x += decoded;
+    ASSERT_TRUE(original.equalsTo(&x, 1e-5));
+}
+
+TEST_F(TypeCastTests, Test_Threshold_Encode_Decode_2) {
+    // more than 4096 blocks, so prefix sum of block counts is done in parallel
+    const int numBlocks = 4096 * 2 + 3;
+    const int length = numBlocks * 1024 - 100;
+    const float threshold = 0.5f;
+
+    auto x = NDArrayFactory::create<float>('c', {length});
+    auto decoded = NDArrayFactory::create<float>('c', {length});
+    decoded.assign(0.0f);
+
+    auto xb = reinterpret_cast<float *>(x.buffer());
+    std::vector<int> eligible;
+    for (int e = 0; e < length; e++) {
+        xb[e] = (e % 1031 == 0 ? 0.7f : 0.1f) * (e % 2 == 0 ? 1.0f : -1.0f);
+        if (e % 1031 == 0)
+            eligible.emplace_back(e);
+    }
+
+    auto original = x.dup();
+
+    std::vector<int> counts(numBlocks + 1);
+    std::vector<int> offsets(numBlocks);
+
+    NativeOps ops;
+    ops.encodeThresholdP1(nullptr, x.buffer(), x.shapeInfo(), length, counts.data(), threshold);
+    ASSERT_EQ((int) eligible.size(), counts[0]);
+
+    ops.encodeThresholdP2Int(nullptr, counts.data(), numBlocks, offsets.data());
+
+    int sum = 0;
+    for (int b = 0; b < numBlocks; b++) {
+        ASSERT_EQ(sum, offsets[b]);
+        sum += counts[b + 1];
+    }
+
+    // buffer holds fewer elements than eligible: same as CUDA, first limit elements by index are encoded, others stay in x untouched
+    const int limit = (int) eligible.size() / 3;
+    std::vector<int> encoded(limit + 4);
+    FloatBits fb;
+    fb.f_ = threshold;
+    encoded[0] = limit;
+    encoded[1] = length;
+    encoded[2] = fb.i_;
+    encoded[3] = 0;
+
+    ops.encodeThresholdP3(nullptr, x.buffer(), x.shapeInfo(), offsets.data(), length, encoded.data());
+
+    for (int e = 0; e < limit; e++)
+        ASSERT_EQ(eligible[e] + 1, std::abs(encoded[e + 4]));
+
+    for (int e = limit; e < (int) eligible.size(); e++)
+        ASSERT_EQ(original->e<float>(eligible[e]), x.e<float>(eligible[e]));
+
+    ops.decodeThreshold(nullptr, encoded.data(), length, decoded.buffer(), decoded.shapeInfo());
+
+    x += decoded;
+    ASSERT_TRUE(original->equalsTo(&x, 1e-5));
+
+    delete original;
+}
@@ -252,6 +252,120 @@ TEST_F(WorkspaceTests, Test_Externalized_1) {
     ASSERT_NEAR(2.0f, m, 1e-5);
 }
 
+TEST_F(WorkspaceTests, Test_Interned_Shapes_1) {
+    Workspace ws(65536);
+
+    auto x = NDArrayFactory::create<float>('c', {10, 10}, &ws);
+    auto y = NDArrayFactory::create<float>('c', {10, 10});
+    auto z = NDArrayFactory::create<float>('c', {10, 10});
+
+    // workspace-backed array keeps its own shapeInfo in workspace, others share interned one
+    ASSERT_EQ(64 + 400, ws.getCurrentOffset());
+    ASSERT_FALSE(ConstantShapeHelper::getInstance()->isInterned(x.shapeInfo()));
+    ASSERT_TRUE(ConstantShapeHelper::getInstance()->isInterned(y.shapeInfo()));
+    ASSERT_TRUE(y.shapeInfo() == z.shapeInfo());
+    ASSERT_TRUE(x.isSameShape(y));
+
+    // copy of interned shapeInfo is not interned
+    Nd4jLong copy[MAX_SHAPEINFOLENGTH];
+    memcpy(copy, y.shapeInfo(), shape::shapeInfoByteLength(y.shapeInfo()));
+    ASSERT_FALSE(ConstantShapeHelper::getInstance()->isInterned(copy));
+
+    // known shape doesn't add new entries
+    auto entries = ConstantShapeHelper::getInstance()->cachedEntries();
+    auto chunks = ConstantShapeHelper::getInstance()->allocatedChunks();
+    NDArray c(y);
+    auto d = NDArrayFactory::create<float>('c', {10, 10});
+    ASSERT_TRUE(c.shapeInfo() == y.shapeInfo());
+    ASSERT_EQ(entries, ConstantShapeHelper::getInstance()->cachedEntries());
+    ASSERT_EQ(chunks, ConstantShapeHelper::getInstance()->allocatedChunks());
+    ASSERT_TRUE(chunks > 0 && chunks <= SHAPE_ARENA_MAX_CHUNKS);
+
+    // in-place change of workspace-backed array stays in its own shapeInfo
+    x.permutei({1, 0});
+    ASSERT_FALSE(ConstantShapeHelper::getInstance()->isInterned(x.shapeInfo()));
+    ASSERT_EQ('c', y.ordering());
+    ASSERT_EQ(10, y.stridesOf()[0]);
+}
+
+TEST_F(WorkspaceTests, Test_Interned_Shapes_2) {
+    Workspace ws(65536);
+
+    auto y = NDArrayFactory::create<float>('c', {10, 10});
+
+    // arrays created from shapeInfo within workspace keep shapeInfo in workspace as well
+    NDArray x(y.shapeInfo(), true, &ws);
+    NDArray z(y.shapeInfo(), nd4j::DataType::DOUBLE, true, &ws);
+
+    ASSERT_FALSE(ConstantShapeHelper::getInstance()->isInterned(x.shapeInfo()));
+    ASSERT_FALSE(ConstantShapeHelper::getInstance()->isInterned(z.shapeInfo()));
+    ASSERT_TRUE(x.isSameShape(y));
+    ASSERT_TRUE(z.isSameShape(y));
+    ASSERT_EQ(nd4j::DataType::DOUBLE, z.dataType());
+
+    NDArray c(y.shapeInfo(), true, nullptr);
+    ASSERT_TRUE(c.shapeInfo() == y.shapeInfo());
+}
+
+TEST_F(WorkspaceTests, Test_Concurrent_Allocation_1) {
+    Workspace ws(8 * 1024 * 1024);
+
+    const int numThreads = 4;
+    const int numAllocations = 1000;
+    std::vector<Nd4jLong*> pointers(numThreads * numAllocations);
+
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+    for (int t = 0; t < numThreads; t++) {
+        for (int e = 0; e < numAllocations; e++) {
+            auto ptr = reinterpret_cast<Nd4jLong *>(ws.allocateBytes(sizeof(Nd4jLong) * (1 + e % 16)));
+            ptr[0] = t * numAllocations + e;
+            pointers[t * numAllocations + e] = ptr;
+        }
+    }
+
+    // every allocation must be intact, i.e. nobody else has written there
+    for (int e = 0; e < numThreads * numAllocations; e++)
+        ASSERT_EQ(e, pointers[e][0]);
+
+    ws.scopeOut();
+    ASSERT_EQ(0, ws.getCurrentOffset());
+}
+
+TEST_F(WorkspaceTests, Test_Spills_Reuse_1) {
+    Workspace ws(1024);
+
+    ws.allocateBytes(1024);
+
+    auto p0 = ws.allocateBytes(256);
+    auto p1 = ws.allocateBytes(256);
+
+    ASSERT_EQ(512, ws.getSpilledSize());
+
+    // small spills are carved from the same overflow chunk
+    ASSERT_EQ(reinterpret_cast<char *>(p0) + 256, reinterpret_cast<char *>(p1));
+
+    ws.scopeOut();
+    ws.scopeIn();
+
+    ASSERT_EQ(0, ws.getSpilledSize());
+    ASSERT_EQ(1024 + 512, ws.getCurrentSize());
+}
+
+TEST_F(WorkspaceTests, Test_Slabs_Alternating_1) {
+    // both workspaces are big enough to serve small allocations from thread-local slabs
+    Workspace ws1(8 * 1024 * 1024);
+    Workspace ws2(8 * 1024 * 1024);
+
+    for (int e = 0; e < 10; e++) {
+        ws1.allocateBytes(64);
+        ws2.allocateBytes(64);
+    }
+
+    // each workspace keeps its own slab, so switching between them doesn't reserve new ones
+    ASSERT_EQ(65536, ws1.getCurrentOffset());
+    ASSERT_EQ(65536, ws2.getCurrentOffset());
+}
+
 // TODO: uncomment this test once long shapes are introduced
 /*
 TEST_F(WorkspaceTests, Test_Big_Allocation_1) {
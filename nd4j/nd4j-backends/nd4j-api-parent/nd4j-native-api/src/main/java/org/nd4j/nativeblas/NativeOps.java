@@ -685,6 +685,8 @@ public abstract class NativeOps extends Pointer {
 
     public abstract void initializeFunctions(PointerPointer functions);
 
+    public abstract void initializeLapackFunctions(PointerPointer functions);
+
     public abstract Pointer mallocHost(long memorySize, int flags);
 
     public abstract Pointer mallocDevice(long memorySize, Pointer ptrToDeviceId, int flags);
@@ -1593,6 +1593,12 @@ public static class NativeOps extends org.nd4j.nativeblas.NativeOps {
 
     public native void initializeFunctions(@Cast("Nd4jPointer*") PointerPointer functions);
 
+    /**
+     * This method sets LAPACKE factorization functions: sgetrf, dgetrf, spotrf, dpotrf.
+     * Backends without LAPACK support have dummy method for JNI compatibility reasons.
+     */
+    public native void initializeLapackFunctions(@Cast("Nd4jPointer*") PointerPointer functions);
+
     /**
      * This method acquires memory chunk of requested size on host side
      *
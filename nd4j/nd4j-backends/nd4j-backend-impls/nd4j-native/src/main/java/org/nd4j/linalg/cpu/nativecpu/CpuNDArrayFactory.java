@@ -105,6 +105,13 @@ public class CpuNDArrayFactory extends BaseNativeNDArrayFactory {
         functions.put(8, Loader.addressof("LAPACKE_sgesdd"));
         functions.put(9, Loader.addressof("LAPACKE_dgesdd"));
         nativeOps.initializeFunctions(functions);
+
+        PointerPointer lapack = new PointerPointer(4);
+        lapack.put(0, Loader.addressof("LAPACKE_sgetrf"));
+        lapack.put(1, Loader.addressof("LAPACKE_dgetrf"));
+        lapack.put(2, Loader.addressof("LAPACKE_spotrf"));
+        lapack.put(3, Loader.addressof("LAPACKE_dpotrf"));
+        nativeOps.initializeLapackFunctions(lapack);
     }
 
     @Override